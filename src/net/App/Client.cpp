@@ -7,25 +7,59 @@
 // Pimpl 实现
 struct Client::Impl
 {
-    asio::io_context ioc;
+    asio::io_context ioc; // 只承载会话的接收回调，由 poll() 驱动
+    SessionHandlers handlers;
 
     Impl() : ioc() {}
 };
 
 Client::Client(IUdpTransport& transport) : KcpEndpoint(transport), m_impl(std::make_unique<Impl>()) {}
 
-Client::~Client() = default;
+Client::~Client()
+{
+    // 关闭会话并执行完挂起的接收回调，释放回调持有的会话引用
+    for (auto& [conv, entry] : m_sessions)
+    {
+        entry.session->close();
+    }
+    m_impl->ioc.poll();
+}
 
 std::shared_ptr<KcpSession> Client::connect(uint32_t conv, const NetAddress& server_addr)
 {
     auto [iter, inserted] = m_sessions.try_emplace(conv);
+    auto& entry = iter->second;
     if (inserted)
     {
-        iter->second = createSession(conv, server_addr);
-        m_lastActive[conv] = std::chrono::steady_clock::now();
-        onSession(conv, iter->second);
+        entry.session = createSession(conv, server_addr);
+        entry.peer = server_addr;
+        entry.lastActive = std::chrono::steady_clock::now();
+        onSession(conv, entry.session);
     }
-    return iter->second;
+    return entry.session;
+}
+
+bool Client::resume(uint32_t conv)
+{
+    auto iter = m_sessions.find(conv);
+    if (iter == m_sessions.end() || iter->second.token == 0)
+    {
+        return false;
+    }
+    auto& entry = iter->second;
+    entry.resumePending = true;
+    sendControl(entry.peer, SessionControl{.conv = conv, .cmd = SESSION_CMD_RESUME, .token = entry.token});
+    return true;
+}
+
+size_t Client::poll()
+{
+    return m_impl->ioc.poll();
+}
+
+void Client::setSessionHandlers(SessionHandlers handlers)
+{
+    m_impl->handlers = std::move(handlers);
 }
 
 std::shared_ptr<KcpSession> Client::createSession(uint32_t conv, const NetAddress& peer)
@@ -37,3 +71,41 @@ uint32_t Client::selectConv([[maybe_unused]] const NetAddress& from, std::span<c
 {
     return peekConv(data);
 }
+
+void Client::onSession(uint32_t conv, std::shared_ptr<KcpSession> session)
+{
+    receive(conv, std::move(session));
+}
+
+void Client::onSessionResumed(uint32_t conv, [[maybe_unused]] const std::shared_ptr<KcpSession>& session)
+{
+    if (m_impl->handlers.resumed)
+    {
+        m_impl->handlers.resumed(conv);
+    }
+}
+
+void Client::receive(uint32_t conv, std::shared_ptr<KcpSession> session)
+{
+    auto* raw = session.get();
+    raw->recvAsync(
+        [this, conv, session = std::move(session)](auto result) mutable
+        {
+            if (!result)
+            {
+                return;
+            }
+            if (auto token = parseSessionToken(*result))
+            {
+                if (auto iter = m_sessions.find(conv); iter != m_sessions.end())
+                {
+                    iter->second.token = *token;
+                }
+            }
+            else if (m_impl->handlers.received)
+            {
+                m_impl->handlers.received(conv, std::move(*result));
+            }
+            receive(conv, std::move(session));
+        });
+}
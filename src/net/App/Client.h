@@ -14,6 +14,7 @@
  */
 #pragma once
 #include "KcpEndpoint.h"
+#include <functional>
 #include <memory>
 #include <utility>
 #include "PeekConv.h"
@@ -24,6 +25,7 @@ public:
     /**
      * @brief 构造函数
      * @param transport UDP 传输层实现
+     * @note 会话的接收回调在调用 poll() 的线程上执行
      */
     explicit Client(IUdpTransport& transport);
     ~Client();
@@ -36,6 +38,33 @@ public:
      */
     std::shared_ptr<KcpSession> connect(uint32_t conv, const NetAddress& server_addr);
 
+    /**
+     * @brief 本地地址变化或长时间未收到数据后，向服务器发送 RESUME 报文恢复会话
+     * @return 会话不存在或尚未收到服务器下发的令牌时返回 false；应答丢失时可重复调用
+     */
+    bool resume(uint32_t conv);
+
+    /**
+     * @brief 执行已就绪的接收回调，与 input()/update() 在同一线程调用
+     *
+     * SESSION_TOKEN 帧在这里被取走并记下令牌，不交给 SessionHandlers::received
+     * @return 执行的回调数
+     */
+    size_t poll();
+
+    /**
+     * @brief 会话通知，在调用 input()/poll() 的线程上触发
+     */
+    struct SessionHandlers
+    {
+        // 收到一个完整的 KCP 包（一帧），在 poll() 中触发
+        std::function<void(uint32_t conv, KcpSession::Packet packet)> received;
+        // 服务器应答了 RESUME，会话已迁移到当前地址；随后服务器会补发局面
+        std::function<void(uint32_t conv)> resumed;
+    };
+
+    void setSessionHandlers(SessionHandlers handlers);
+
     /**
      * @brief 更新所有会话状态
      * @param now_ms 当前时间点
@@ -54,8 +83,20 @@ protected:
      */
     std::shared_ptr<KcpSession> createSession(uint32_t conv, const NetAddress& peer) override;
 
+    /**
+     * @brief 会话创建回调：开始接收循环
+     */
+    void onSession(uint32_t conv, std::shared_ptr<KcpSession> session) override;
+
+    void onSessionResumed(uint32_t conv, const std::shared_ptr<KcpSession>& session) override;
+
 private:
+    /**
+     * @brief 接收循环：令牌帧记入会话表，其余帧交给 received；会话关闭时循环结束
+     */
+    void receive(uint32_t conv, std::shared_ptr<KcpSession> session);
+
     // Pimpl 声明：隐藏 ASIO 实现细节
     struct Impl;
     std::unique_ptr<Impl> m_impl;
-};
\ No newline at end of file
+};
@@ -7,7 +7,7 @@
  * @version 0.1
  * @brief KCP 端点定义
     外部使用网络模块的接口基类
-    管理多个 KCP 会话，处理输入输出分发，并支持会话超时清理
+    管理多个 KCP 会话，处理输入输出分发，并支持会话超时挂起、令牌恢复与地址迁移
  *
  * ************************************************************************
  * @copyright Copyright (c) 2025 AnakinLiu
@@ -18,8 +18,10 @@
 #pragma once
 #include "../Session/KcpSession.h"
 #include "../common/NetAddress.h"
+#include "../protocol/SessionControl.h"
 #include <unordered_map>
 #include <chrono>
+#include <random>
 #include <utility>
 
 class KcpEndpoint
@@ -27,6 +29,19 @@ class KcpEndpoint
 protected:
     explicit KcpEndpoint(IUdpTransport& transport) : m_transport(transport) {}
 
+    /**
+     * @brief 会话表项
+     */
+    struct SessionEntry
+    {
+        std::shared_ptr<KcpSession> session;
+        NetAddress peer;                                  // 当前绑定的对端地址
+        uint64_t token = 0;                               // 恢复令牌，0 表示不可恢复
+        std::chrono::steady_clock::time_point lastActive; // 最近一次收到数据的时间
+        bool detached = false;                            // 超时挂起，等待恢复
+        bool resumePending = false;                       // 客户端已发出 RESUME，尚未收到 RESUMED
+    };
+
 public:
     virtual ~KcpEndpoint() = default;
 
@@ -40,50 +55,74 @@ public:
             return;
         }
 
+        if (auto control = peekSessionControl(data)) [[unlikely]]
+        {
+            handleControl(from, *control);
+            return;
+        }
+
         uint32_t conv = selectConv(from, data);
+        const auto now = std::chrono::steady_clock::now();
 
         // 优化：try_emplace 避免了重复查找和冗余构造
         auto [iter, inserted] = m_sessions.try_emplace(conv);
+        auto& entry = iter->second;
 
         if (inserted) [[unlikely]]
         {
-            iter->second = createSession(conv, from);
-            onSession(conv, iter->second); // 传递 shared_ptr 保证生命周期
+            entry.session = createSession(conv, from);
+            entry.peer = from;
+            entry.token = issueToken();
+            entry.lastActive = now;
+            onSession(conv, entry.session); // 传递 shared_ptr 保证生命周期
+        }
+        else if (entry.peer != from) [[unlikely]]
+        {
+            // 已知 conv 出现在新地址上：须先用令牌 RESUME，否则丢弃，防止会话被劫持
+            return;
         }
 
-        iter->second->input(data);
-        m_lastActive[conv] = std::chrono::steady_clock::now(); // 更新活跃时间
+        entry.session->input(data);
+        entry.lastActive = now; // 更新活跃时间
+        if (entry.detached) [[unlikely]]
+        {
+            // 同一地址上恢复通信（例如短暂断网）
+            entry.detached = false;
+            onSessionResumed(conv, entry.session);
+        }
     }
 
     /**
-     * @brief 更新所有会话状态，并清理超时会话
+     * @brief 更新所有会话状态：空闲超时的会话先挂起等待恢复，挂起超过恢复窗口后才关闭
      * @param now_ms 当前时间点
-     * @param timeout_sec 会话超时阈值（默认30秒）
+     * @param timeout_sec 会话空闲超时阈值（默认30秒）
+     * @param resume_window 挂起后允许恢复的时长（默认120秒）
      */
-    void update(uint32_t now_ms, std::chrono::seconds timeout_sec = std::chrono::seconds(30))
+    void update(uint32_t now_ms,
+                std::chrono::seconds timeout_sec = std::chrono::seconds(30),
+                std::chrono::seconds resume_window = std::chrono::seconds(120))
     {
         auto now_tp = std::chrono::steady_clock::now();
         for (auto iter = m_sessions.begin(); iter != m_sessions.end();)
         {
-            auto& [conv, sess] = *iter;
+            auto& [conv, entry] = *iter;
+            const auto idle = now_tp - entry.lastActive;
 
-            // 驱动 KCP
-            sess->update(now_ms);
-
-            // 检查超时清理
-            auto last_iter = m_lastActive.find(conv);
-            if (last_iter == m_lastActive.end())
+            if (!entry.detached)
             {
-                m_lastActive.emplace(conv, now_tp);
+                // 驱动 KCP；挂起期间不驱动，避免向失效地址重传，恢复后未确认的分段会立即重发
+                entry.session->update(now_ms);
+                if (idle > timeout_sec)
+                {
+                    entry.detached = true;
+                    onSessionDetached(conv);
+                }
                 ++iter;
-                continue;
             }
-
-            if (now_tp - last_iter->second > timeout_sec)
+            else if (idle > timeout_sec + resume_window)
             {
-                sess->close();
+                entry.session->close();
                 onSessionClosed(conv);
-                m_lastActive.erase(conv);
                 iter = m_sessions.erase(iter); // 安全删除
             }
             else
@@ -112,14 +151,83 @@ protected:
      */
     virtual void onSession([[maybe_unused]] uint32_t conv, [[maybe_unused]] std::shared_ptr<KcpSession> session) {}
 
+    /**
+     * @brief 会话空闲超时被挂起（会话与游戏状态仍保留）
+     */
+    virtual void onSessionDetached([[maybe_unused]] uint32_t conv) {}
+
+    /**
+     * @brief 挂起的会话恢复，或会话迁移到了新地址；客户端在收到 RESUMED 应答时触发
+     */
+    virtual void onSessionResumed([[maybe_unused]] uint32_t conv,
+                                  [[maybe_unused]] const std::shared_ptr<KcpSession>& session)
+    {
+    }
+
     /**
      * @brief 会话关闭回调
      * @param conv 会话的 Conv ID
      */
     virtual void onSessionClosed([[maybe_unused]] uint32_t conv) {}
 
+    /**
+     * @brief 生成不可预测的恢复令牌（仅在会话创建时调用）
+     */
+    uint64_t issueToken()
+    {
+        uint64_t token = 0;
+        while (token == 0)
+        {
+            token = (static_cast<uint64_t>(m_random()) << 32U) | m_random();
+        }
+        return token;
+    }
+
+    void sendControl(const NetAddress& to, const SessionControl& control)
+    {
+        const auto packet = encodeSessionControl(control);
+        m_transport.send(to, packet);
+    }
+
+private:
+    void handleControl(const NetAddress& from, const SessionControl& control)
+    {
+        auto iter = m_sessions.find(control.conv);
+        if (iter == m_sessions.end() || iter->second.token == 0 || iter->second.token != control.token)
+        {
+            return;
+        }
+        auto& entry = iter->second;
+        entry.lastActive = std::chrono::steady_clock::now();
+        if (control.cmd != SESSION_CMD_RESUME)
+        {
+            // 对端确认了恢复；重复的应答只通知一次
+            if (std::exchange(entry.resumePending, false))
+            {
+                entry.detached = false;
+                onSessionResumed(control.conv, entry.session);
+            }
+            return;
+        }
+        // 重复的 RESUME（应答丢失后的重试）同样应答，但只通知一次
+        const bool changed = entry.detached || entry.peer != from;
+        if (entry.peer != from)
+        {
+            entry.peer = from;
+            entry.session->setPeer(from);
+        }
+        entry.detached = false;
+        sendControl(from, SessionControl{.conv = control.conv, .cmd = SESSION_CMD_RESUMED, .token = control.token});
+        if (changed)
+        {
+            onSessionResumed(control.conv, entry.session);
+        }
+    }
+
 protected:
     IUdpTransport& m_transport;
-    std::unordered_map<uint32_t, std::shared_ptr<KcpSession>> m_sessions;
-    std::unordered_map<uint32_t, std::chrono::steady_clock::time_point> m_lastActive;
+    std::unordered_map<uint32_t, SessionEntry> m_sessions;
+
+private:
+    std::random_device m_random;
 };
\ No newline at end of file
@@ -6,52 +6,65 @@
 // Pimpl 实现
 struct Server::Impl
 {
-    asio::io_context ioc;
-    asio::thread_pool pool;
+    asio::io_context ioc; // 只承载会话的接收回调，由 poll() 驱动
+    SessionHandlers handlers;
 
-    explicit Impl(size_t thread_count) : ioc(), pool(thread_count) {}
-
-    // 玩家业务协程
-    static asio::awaitable<void> playerRoutine(uint32_t conv, std::shared_ptr<KcpSession> session)
+    /**
+     * @brief 接收循环：每收到一包回调一次再续订；会话关闭时通道返回错误，循环结束并释放会话引用
+     */
+    void receive(uint32_t conv, std::shared_ptr<KcpSession> session)
     {
-        try
-        {
-            while (true)
+        auto* raw = session.get();
+        raw->recvAsync(
+            [this, conv, session = std::move(session)](auto result) mutable
             {
-                // 使用回调模式接收数据
-                std::optional<std::expected<KcpSession::Packet, std::error_code>> result;
-                session->recvAsync([&result](auto res) { result = std::move(res); });
-
-                // 等待结果（简化示例，实际应使用同步机制）
-                co_await asio::steady_timer(co_await asio::this_coro::executor, std::chrono::milliseconds(10))
-                    .async_wait(asio::use_awaitable);
-
-                if (!result || !result->has_value())
+                if (!result)
                 {
-                    break;
+                    return;
                 }
-
-                const auto& msg = **result;
-                // 处理业务逻辑
-                session->send(msg);
-            }
-        }
-        catch (const std::exception&)
-        {
-        }
+                if (handlers.received)
+                {
+                    handlers.received(conv, std::move(*result));
+                }
+                else
+                {
+                    session->send(*result);
+                }
+                receive(conv, std::move(session));
+            });
     }
 };
 
-Server::Server(IUdpTransport& transport, size_t thread_count)
-    : KcpEndpoint(transport), m_impl(std::make_unique<Impl>(thread_count))
+Server::Server(IUdpTransport& transport) : KcpEndpoint(transport), m_impl(std::make_unique<Impl>()) {}
+
+Server::~Server()
 {
+    stop();
 }
 
-Server::~Server() = default;
-
 void Server::stop()
 {
-    m_impl->pool.join();
+    for (auto& [conv, entry] : m_sessions)
+    {
+        entry.session->close();
+    }
+    m_impl->ioc.poll();
+}
+
+size_t Server::poll()
+{
+    return m_impl->ioc.poll();
+}
+
+bool Server::send(uint32_t conv, const SharedFrame& frame)
+{
+    auto iter = m_sessions.find(conv);
+    if (iter == m_sessions.end() || iter->second.detached)
+    {
+        return false;
+    }
+    iter->second.session->send(frame);
+    return true;
 }
 
 uint32_t Server::selectConv([[maybe_unused]] const NetAddress& from, std::span<const uint8_t> data)
@@ -64,8 +77,42 @@ std::shared_ptr<KcpSession> Server::createSession(uint32_t conv, const NetAddres
     return std::make_shared<KcpSession>(conv, m_transport, peer, m_impl->ioc.get_executor());
 }
 
+void Server::setSessionHandlers(SessionHandlers handlers)
+{
+    m_impl->handlers = std::move(handlers);
+}
+
 void Server::onSession(std::uint32_t conv, std::shared_ptr<KcpSession> session)
 {
-    auto player_executor = asio::make_strand(m_impl->pool.get_executor());
-    asio::co_spawn(player_executor, Impl::playerRoutine(conv, std::move(session)), asio::detached);
-}
\ No newline at end of file
+    // 第一帧下发恢复令牌，客户端断线或换地址后凭它 RESUME
+    session->send(encodeSessionToken(m_sessions.at(conv).token));
+    if (m_impl->handlers.opened)
+    {
+        m_impl->handlers.opened(conv, session);
+    }
+    m_impl->receive(conv, std::move(session));
+}
+
+void Server::onSessionDetached(uint32_t conv)
+{
+    if (m_impl->handlers.detached)
+    {
+        m_impl->handlers.detached(conv);
+    }
+}
+
+void Server::onSessionResumed(uint32_t conv, const std::shared_ptr<KcpSession>& session)
+{
+    if (m_impl->handlers.resumed)
+    {
+        m_impl->handlers.resumed(conv, session);
+    }
+}
+
+void Server::onSessionClosed(uint32_t conv)
+{
+    if (m_impl->handlers.closed)
+    {
+        m_impl->handlers.closed(conv);
+    }
+}
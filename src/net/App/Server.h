@@ -2,6 +2,7 @@
 #include "KcpEndpoint.h"
 #include <bit>
 #include <cstring>
+#include <functional>
 #include <utility>
 #include <memory>
 #include "PeekConv.h"
@@ -9,12 +10,42 @@
 class Server : public KcpEndpoint
 {
 public:
-    // 构造函数：需要 UDP 传输层和线程池大小
-    Server(IUdpTransport& transport, size_t thread_count);
+    // 构造函数：需要 UDP 传输层；会话的接收回调在调用 poll() 的线程上执行，不再单独创建线程
+    explicit Server(IUdpTransport& transport);
     ~Server();
-    // 停止服务器，等待线程池结束
+    // 停止服务器：关闭所有会话，并执行完它们尚未完成的接收回调
     void stop();
 
+    /**
+     * @brief 执行已就绪的接收回调（SessionHandlers::received），与 input()/update() 在同一线程调用
+     * @return 执行的回调数
+     */
+    size_t poll();
+
+    /**
+     * @brief 向会话发送共享帧，与 input()/update() 在同一线程调用
+     * @return 会话不存在或已挂起时返回 false，帧被丢弃；恢复时房间会补发局面快照，挂起期间无需排队
+     */
+    bool send(uint32_t conv, const SharedFrame& frame);
+
+    /**
+     * @brief 会话生命周期通知，在调用 input()/update() 的线程上触发
+     */
+    struct SessionHandlers
+    {
+        std::function<void(uint32_t conv, const std::shared_ptr<KcpSession>& session)> opened;
+        // 空闲超时挂起，玩家应保留座位
+        std::function<void(uint32_t conv)> detached;
+        // 令牌恢复或同地址恢复通信，应向玩家补发当前局面
+        std::function<void(uint32_t conv, const std::shared_ptr<KcpSession>& session)> resumed;
+        // 恢复窗口已过，玩家应离开房间
+        std::function<void(uint32_t conv)> closed;
+        // 收到一个完整的 KCP 包（一帧），在 poll() 中触发；未设置时原样回显
+        std::function<void(uint32_t conv, KcpSession::Packet packet)> received;
+    };
+
+    void setSessionHandlers(SessionHandlers handlers);
+
 protected:
     /**
      * @brief 识别逻辑：直接解析包里的 conv
@@ -33,6 +64,10 @@ protected:
      */
     void onSession(uint32_t conv, std::shared_ptr<KcpSession> session) override;
 
+    void onSessionDetached(uint32_t conv) override;
+    void onSessionResumed(uint32_t conv, const std::shared_ptr<KcpSession>& session) override;
+    void onSessionClosed(uint32_t conv) override;
+
 private:
     // Pimpl 声明：隐藏 ASIO 实现细节
     struct Impl;
@@ -39,6 +39,8 @@ struct KcpSession::Impl
     asio::experimental::channel<asio::any_io_executor, void(std::error_code, Packet)> channel;
     std::atomic<size_t> droppedPackets{0};
     std::atomic<bool> closed{false};
+    std::mutex pendingMutex;
+    std::vector<SharedFrame> pendingFrames; // 已登记、尚未拷入 KCP 的共享帧
 
     Impl(uint32_t conv, IUdpTransport& trans, const NetAddress& peerAddr, const asio::any_io_executor& exec)
         : kcp(ikcp_create(conv, this)), transport(trans), peer(peerAddr), channel(exec, CHANNEL_CAPACITY)
@@ -77,6 +79,35 @@ struct KcpSession::Impl
         return 0;
     }
 
+    /**
+     * @brief 把登记的共享帧按顺序拷入 KCP 发送队列，随后释放引用
+     *
+     * 在锁内把待发帧换到局部容器，锁外调用 ikcp_send；发送完后若期间没有新登记的帧，把容量还给 pendingFrames
+     */
+    void flushPending()
+    {
+        std::vector<SharedFrame> frames;
+        {
+            std::lock_guard lock(pendingMutex);
+            if (pendingFrames.empty())
+            {
+                return;
+            }
+            frames.swap(pendingFrames);
+        }
+        for (const auto& frame : frames)
+        {
+            auto bytes = frame.bytes();
+            ikcp_send(kcp, reinterpret_cast<const char*>(bytes.data()), static_cast<int>(bytes.size()));
+        }
+        frames.clear();
+        std::lock_guard lock(pendingMutex);
+        if (pendingFrames.empty())
+        {
+            pendingFrames.swap(frames);
+        }
+    }
+
     // 协程接收
     asio::awaitable<std::expected<Packet, std::error_code>> recvCoro()
     {
@@ -153,13 +184,40 @@ void KcpSession::send(std::span<const uint8_t> data)
     {
         return;
     }
+    // 先送出之前登记的共享帧，保持发送顺序
+    m_impl->flushPending();
     ikcp_send(m_impl->kcp, reinterpret_cast<const char*>(data.data()), static_cast<int>(data.size()));
 }
 
+void KcpSession::send(const SharedFrame& frame)
+{
+    if (m_impl->kcp == nullptr || frame.empty() || m_impl->closed.load(std::memory_order_acquire))
+    {
+        return;
+    }
+    std::lock_guard lock(m_impl->pendingMutex);
+    m_impl->pendingFrames.push_back(frame);
+}
+
+size_t KcpSession::broadcast(std::span<const std::shared_ptr<KcpSession>> sessions, const SharedFrame& frame)
+{
+    size_t delivered = 0;
+    for (const auto& session : sessions)
+    {
+        if (session != nullptr && !session->m_impl->closed.load(std::memory_order_acquire))
+        {
+            session->send(frame);
+            ++delivered;
+        }
+    }
+    return delivered;
+}
+
 void KcpSession::update(uint32_t now)
 {
     if (m_impl->kcp != nullptr && !m_impl->closed.load(std::memory_order_acquire))
     {
+        m_impl->flushPending();
         ikcp_update(m_impl->kcp, now);
     }
 }
@@ -173,12 +231,24 @@ uint32_t KcpSession::check(uint32_t now) const
     return ikcp_check(m_impl->kcp, now);
 }
 
+void KcpSession::setPeer(const NetAddress& peer)
+{
+    m_impl->peer = peer;
+}
+
+const NetAddress& KcpSession::peer() const noexcept
+{
+    return m_impl->peer;
+}
+
 void KcpSession::close()
 {
     bool expected = false;
     if (m_impl->closed.compare_exchange_strong(expected, true, std::memory_order_acq_rel))
     {
         m_impl->channel.close();
+        std::lock_guard lock(m_impl->pendingMutex);
+        m_impl->pendingFrames.clear();
     }
 }
 
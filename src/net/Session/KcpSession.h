@@ -15,6 +15,7 @@
 #pragma once
 #include "../transport/IUdpTransport.h"
 #include "../common/NetAddress.h"
+#include "../protocol/SharedFrame.h"
 #include <expected>
 #include <span>
 #include <memory>
@@ -67,6 +68,25 @@ public:
      */
     void send(std::span<const uint8_t> data);
 
+    /**
+     * @brief 发送共享帧：只登记引用，下次 update()/send() 时才拷入 KCP 分段
+     */
+    void send(const SharedFrame& frame);
+
+    /**
+     * @brief 广播：同一帧投递给多个会话，各会话只增加引用计数
+     * @return 实际投递的会话数（跳过空指针与已关闭的会话）
+     */
+    static size_t broadcast(std::span<const std::shared_ptr<KcpSession>> sessions, const SharedFrame& frame);
+
+    /**
+     * @brief 会话迁移到新的对端地址（令牌校验通过后由 Endpoint 调用）
+     * @note 与 update() 在同一线程调用
+     */
+    void setPeer(const NetAddress& peer);
+
+    [[nodiscard]] const NetAddress& peer() const noexcept;
+
     /**
      * @brief 主动关闭会话
      */
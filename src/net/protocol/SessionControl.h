@@ -0,0 +1,96 @@
+/**
+ * ************************************************************************
+ *
+ * @file SessionControl.h
+ * @author AnakinLiu (azrael2759@qq.com)
+ * @date 2026-10-16
+ * @version 0.1
+ * @brief 会话控制报文与会话令牌
+    - 会话建立后服务器通过 KCP 下发 SESSION_TOKEN 帧，载荷为 8 字节令牌
+    - 客户端地址变化（NAT 重绑定、切换网络）后发送裸 UDP 的 RESUME 报文，携带 conv 与令牌，
+      服务器校验通过后把会话迁移到新地址并回复 RESUMED；未经校验的新地址上的 KCP 包一律丢弃
+    - 控制报文固定 16 字节，第 5 字节的命令值不与 KCP 分段命令 (81-84) 冲突，
+      且 KCP 分段至少 24 字节，二者不会混淆
+ *
+ * ************************************************************************
+ * @copyright Copyright (c) 2026 AnakinLiu
+ * For study and research only, no reprinting.
+ * ************************************************************************
+ */
+#pragma once
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <span>
+#include "FrameCodec.h"
+#include "src/shared/common/CommandID.h"
+
+constexpr size_t SESSION_CONTROL_SIZE = 16;
+constexpr uint8_t SESSION_CMD_RESUME = 0xF0;  // 客户端 -> 服务器：以令牌恢复会话
+constexpr uint8_t SESSION_CMD_RESUMED = 0xF1; // 服务器 -> 客户端：恢复成功
+
+static_assert(std::endian::native == std::endian::little, "session control packets are little-endian");
+
+/**
+ * @brief 控制报文：conv(4) | cmd(1) | reserved(3) | token(8)
+ */
+struct SessionControl
+{
+    uint32_t conv = 0;
+    uint8_t cmd = 0;
+    uint64_t token = 0;
+};
+
+inline std::array<uint8_t, SESSION_CONTROL_SIZE> encodeSessionControl(const SessionControl& control)
+{
+    std::array<uint8_t, SESSION_CONTROL_SIZE> packet{};
+    std::memcpy(packet.data(), &control.conv, sizeof(control.conv));
+    packet[4] = control.cmd;
+    std::memcpy(packet.data() + 8, &control.token, sizeof(control.token));
+    return packet;
+}
+
+/**
+ * @brief 识别控制报文；普通 KCP 分段返回空
+ */
+inline std::optional<SessionControl> peekSessionControl(std::span<const uint8_t> data)
+{
+    if (data.size() != SESSION_CONTROL_SIZE || (data[4] != SESSION_CMD_RESUME && data[4] != SESSION_CMD_RESUMED))
+    {
+        return std::nullopt;
+    }
+    SessionControl control;
+    std::memcpy(&control.conv, data.data(), sizeof(control.conv));
+    control.cmd = data[4];
+    std::memcpy(&control.token, data.data() + 8, sizeof(control.token));
+    return control;
+}
+
+/**
+ * @brief 编码 SESSION_TOKEN 帧（FrameHeader + 8 字节令牌）
+ */
+inline std::array<uint8_t, sizeof(FrameHeader) + sizeof(uint64_t)> encodeSessionToken(uint64_t token)
+{
+    std::array<uint8_t, sizeof(FrameHeader) + sizeof(uint64_t)> frame{};
+    std::array<uint8_t, sizeof(uint64_t)> payload{};
+    std::memcpy(payload.data(), &token, sizeof(token));
+    encodeFrame(frame, CommandID::SESSION_TOKEN, payload);
+    return frame;
+}
+
+/**
+ * @brief 从收到的帧中取出会话令牌（由 Client 的接收循环调用）；不是 SESSION_TOKEN 帧时返回空
+ */
+inline std::optional<uint64_t> parseSessionToken(std::span<const uint8_t> frame)
+{
+    auto decoded = decodeFrame(frame);
+    if (!decoded || decoded->cmd != CommandID::SESSION_TOKEN || decoded->payload.size() != sizeof(uint64_t))
+    {
+        return std::nullopt;
+    }
+    uint64_t token = 0;
+    std::memcpy(&token, decoded->payload.data(), sizeof(token));
+    return token;
+}
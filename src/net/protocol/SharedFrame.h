@@ -0,0 +1,69 @@
+/**
+ * ************************************************************************
+ *
+ * @file SharedFrame.h
+ * @author AnakinLiu (azrael2759@qq.com)
+ * @date 2026-10-16
+ * @version 0.1
+ * @brief 引用计数的不可变帧
+    广播时消息只编码一次，各会话持有同一块帧数据的引用，而不是各自拷贝一份
+ *
+ * ************************************************************************
+ * @copyright Copyright (c) 2026 AnakinLiu
+ * For study and research only, no reprinting.
+ * ************************************************************************
+ */
+#pragma once
+#include <cstdint>
+#include <expected>
+#include <memory>
+#include <span>
+#include <vector>
+#include "FrameCodec.h"
+
+class SharedFrame
+{
+public:
+    SharedFrame() = default;
+
+    /**
+     * @brief 接管已编码好的完整帧（包含 FrameHeader），不拷贝
+     *
+     * 帧数据沿用 vector 原有的缓冲区，make_shared 另做一次分配存放引用计数与 vector 对象；
+     * 每帧共两次分配，与持有它的会话数无关
+     */
+    explicit SharedFrame(std::vector<uint8_t> frame)
+        : m_bytes(std::make_shared<const std::vector<uint8_t>>(std::move(frame)))
+    {
+    }
+
+    /**
+     * @brief 由命令 ID 与载荷编码一帧
+     */
+    static std::expected<SharedFrame, CodecError> encode(uint16_t cmd, std::span<const uint8_t> payload)
+    {
+        std::vector<uint8_t> frame(sizeof(FrameHeader) + payload.size());
+        auto encoded = encodeFrame(frame, cmd, payload);
+        if (!encoded)
+        {
+            return std::unexpected(encoded.error());
+        }
+        return SharedFrame(std::move(frame));
+    }
+
+    [[nodiscard]] std::span<const uint8_t> bytes() const noexcept
+    {
+        return m_bytes ? std::span<const uint8_t>(*m_bytes) : std::span<const uint8_t>{};
+    }
+
+    [[nodiscard]] size_t size() const noexcept { return m_bytes ? m_bytes->size() : 0; }
+    [[nodiscard]] bool empty() const noexcept { return size() == 0; }
+
+    /**
+     * @brief 当前持有该帧的引用数（调试/测试用）
+     */
+    [[nodiscard]] long useCount() const noexcept { return m_bytes.use_count(); }
+
+private:
+    std::shared_ptr<const std::vector<uint8_t>> m_bytes;
+};
@@ -8,25 +8,47 @@
  * @brief 技能接口定义
     所有技能均实现该接口
     提供使用技能和筛选目标的方法
+    目标筛选结果写入调用方提供的位集，第 i 位对应候选列表中的第 i 个实体
  *
  * ************************************************************************
  * @copyright Copyright (c) 2025 AnakinLiu
  * For study and research only, no reprinting.
  * ************************************************************************
  */
+#pragma once
+#include <bitset>
+#include <span>
 #include <entt/entt.hpp>
 #include <entt/poly/poly.hpp>
-#include "src/context/GameContext.h"
-#include "absl/container/flat_hash_map.h"
+#include "src/server/context/GameContext.h"
+#include "src/server/events/Events.h"
+
+constexpr std::size_t MAX_SKILL_TARGETS = 8; // 单次筛选的最大候选数（与房间座位数一致）
+using TargetMask = std::bitset<MAX_SKILL_TARGETS>;
+
 struct ISkill : entt::type_list<>
 {
     template <typename Base>
     struct type : Base
     {
-        void onUse() const { return this->template invoke<0>(*this); }
-        absl::flat_hash_map<entt::entity, bool> filterTargets(entt::entity pt1) const
+        /**
+         * @brief 触发技能
+         * @param owner 技能持有者
+         * @param event 触发该技能的时机
+         */
+        void onUse(entt::entity owner, const events::TriggerMoment& event) const
+        {
+            entt::poly_call<0>(*this, owner, event);
+        }
+        /**
+         * @brief 筛选可选目标
+         * @param user 技能使用者
+         * @param candidates 候选实体列表（长度不超过 MAX_SKILL_TARGETS，SkillSystem 会截断超出的部分）
+         * @param out 输出位集，可选目标对应位被置 1
+         */
+        void filterTargets(entt::entity user, std::span<const entt::entity> candidates, TargetMask& out) const
         {
-            return this->template invoke<1>(*this, pt1);
+            entt::poly_call<1>(*this, user, candidates, out);
         }
     };
 
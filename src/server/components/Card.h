@@ -15,20 +15,25 @@
 
 #pragma once
 #include <cstdint>
-#include <string>
+#include <string_view>
 #include <functional>
 #include <entt/entt.hpp>
 #include <span> // 需要包含 span
 #include "src/shared/common/Common.h"
+#include "src/server/context/RoomMemory.h"
+#include "src/server/data/DefinitionTable.h"
 
 // --------------------------------------------------------------------------
 // 1. 卡牌组件定义 (Component: Data Only)
 // --------------------------------------------------------------------------
 
+/**
+ * @brief 卡牌名称与描述引用静态存储（定义表映射内存或字符串字面量），各房间不复制
+ */
 struct MetaCardInfo
 {
-    std::string name;
-    std::string description;
+    std::string_view name;
+    std::string_view description;
     CardType type = CardType::BASIC;
 };
 
@@ -79,7 +84,7 @@ struct EquipCardTypeTag
 // 3. 实体创建函数 (Factory: Component Assembly)
 // --------------------------------------------------------------------------
 
-inline entt::entity CreateCard(entt::registry& reg,
+inline entt::entity CreateCard(RoomRegistry& reg,
                                const MetaCardInfo& metaInfo,
                                const CardCost& cost,
                                const CardTarget& target,
@@ -94,7 +99,7 @@ inline entt::entity CreateCard(entt::registry& reg,
     return ent;
 }
 
-inline entt::entity CreateBasicCard(entt::registry& reg,
+inline entt::entity CreateBasicCard(RoomRegistry& reg,
                                     const MetaCardInfo& metaInfo,
                                     const CardCost& cost,
                                     const CardTarget& target,
@@ -106,7 +111,7 @@ inline entt::entity CreateBasicCard(entt::registry& reg,
     return ent;
 }
 
-inline entt::entity CreateStrategyCard(entt::registry& reg,
+inline entt::entity CreateStrategyCard(RoomRegistry& reg,
                                        const MetaCardInfo& metaInfo,
                                        const CardCost& cost,
                                        const CardTarget& target,
@@ -118,7 +123,7 @@ inline entt::entity CreateStrategyCard(entt::registry& reg,
     return ent;
 }
 
-inline entt::entity CreateEquipCard(entt::registry& reg,
+inline entt::entity CreateEquipCard(RoomRegistry& reg,
                                     const MetaCardInfo& metaInfo,
                                     const CardCost& cost,
                                     const CardTarget& target,
@@ -140,7 +145,7 @@ inline entt::entity CreateEquipCard(entt::registry& reg,
  * @param pointAndSuit 点数和花色
  * @return entt::entity 实体ID
  */
-inline entt::entity CreateStrickCard(entt::registry& reg, const CardPointAndSuit& pointAndSuit)
+inline entt::entity CreateStrickCard(RoomRegistry& reg, const CardPointAndSuit& pointAndSuit)
 {
     CardTarget target{
         .needTarget = true,
@@ -166,7 +171,7 @@ inline entt::entity CreateStrickCard(entt::registry& reg, const CardPointAndSuit
  * @param pointAndSuit 点数和花色
  * @return entt::entity 实体ID
  */
-inline entt::entity CreateDodgeCard(entt::registry& reg, const CardPointAndSuit& pointAndSuit)
+inline entt::entity CreateDodgeCard(RoomRegistry& reg, const CardPointAndSuit& pointAndSuit)
 {
     CardTarget target{.needTarget = false, .maxTargets = 0, .minTargets = 0, .range = 0};
     MetaCardInfo metaInfo{.name = "闪", .description = "用于抵消一张杀的伤害", .type = CardType::BASIC};
@@ -177,7 +182,7 @@ inline entt::entity CreateDodgeCard(entt::registry& reg, const CardPointAndSuit&
     return CreateBasicCard(reg, metaInfo, cost, target, pointAndSuit, BasicCardType::DODGE);
 }
 
-inline entt::entity CreatePeachCard(entt::registry& reg, const CardPointAndSuit& pointAndSuit)
+inline entt::entity CreatePeachCard(RoomRegistry& reg, const CardPointAndSuit& pointAndSuit)
 {
     MetaCardInfo metaInfo{.name = "桃", .description = "回复一点体力", .type = CardType::BASIC};
     CardTarget target{};
@@ -198,7 +203,7 @@ inline entt::entity CreatePeachCard(entt::registry& reg, const CardPointAndSuit&
  * @param pointAndSuit 点数和花色
  * @return entt::entity 实体ID
  */
-inline entt::entity CreateAlcoholCard(entt::registry& reg, const CardPointAndSuit& pointAndSuit)
+inline entt::entity CreateAlcoholCard(RoomRegistry& reg, const CardPointAndSuit& pointAndSuit)
 {
     CardTarget target{};
     target.needTarget = true;
@@ -223,7 +228,7 @@ inline entt::entity CreateAlcoholCard(entt::registry& reg, const CardPointAndSui
  * @param pointAndSuit 点数和花色
  * @return entt::entity 实体ID
  */
-inline entt::entity CreateFireAttackCard(entt::registry& reg, const CardPointAndSuit& pointAndSuit)
+inline entt::entity CreateFireAttackCard(RoomRegistry& reg, const CardPointAndSuit& pointAndSuit)
 {
     CardTarget target{};
     target.needTarget = true;
@@ -248,7 +253,7 @@ inline entt::entity CreateFireAttackCard(entt::registry& reg, const CardPointAnd
  * @param pointAndSuit 点数和花色
  * @return entt::entity 实体ID
  */
-inline entt::entity CreateDuelCard(entt::registry& reg, const CardPointAndSuit& pointAndSuit)
+inline entt::entity CreateDuelCard(RoomRegistry& reg, const CardPointAndSuit& pointAndSuit)
 {
     CardTarget target{
         .needTarget = true,
@@ -267,4 +272,52 @@ inline entt::entity CreateDuelCard(entt::registry& reg, const CardPointAndSuit&
     // **Effect 逻辑已移除**
 
     return CreateStrategyCard(reg, metaInfo, cost, target, pointAndSuit, StrategyCardType::DUEL);
-}
\ No newline at end of file
+}
+// --------------------------------------------------------------------------
+// 5. 由定义表创建卡牌 (Factory: Data-Driven)
+// --------------------------------------------------------------------------
+
+/**
+ * @brief 按定义表中的卡牌定义创建实体
+ * @param reg 注册表
+ * @param table 定义表，须比注册表活得久（名称/描述直接引用表内存）
+ * @param def 卡牌定义
+ * @param pointAndSuit 点数和花色
+ * @return entt::entity 实体ID
+ */
+inline entt::entity CreateCardFromDefinition(RoomRegistry& reg,
+                                             const data::DefinitionTable& table,
+                                             const data::CardDef& def,
+                                             const CardPointAndSuit& pointAndSuit)
+{
+    MetaCardInfo metaInfo{.name = table.text(def.name), .description = table.text(def.description), .type = def.type};
+    CardTarget target{.needTarget = def.needTarget != 0,
+                      .maxTargets = def.maxTargets,
+                      .minTargets = def.minTargets,
+                      .range = def.range};
+    switch (def.type)
+    {
+        case CardType::BASIC:
+            return CreateBasicCard(reg, metaInfo, {}, target, pointAndSuit, static_cast<BasicCardType>(def.subType));
+        case CardType::STRATEGY:
+            return CreateStrategyCard(
+                reg, metaInfo, {}, target, pointAndSuit, static_cast<StrategyCardType>(def.subType));
+        default:
+            return CreateEquipCard(reg, metaInfo, {}, target, pointAndSuit, static_cast<EquipCardType>(def.subType));
+    }
+}
+
+/**
+ * @brief 按定义表的牌堆组成创建整副牌
+ * @param out 依次追加新建的卡牌实体
+ */
+template <typename Container>
+void CreateDeckFromDefinition(RoomRegistry& reg, const data::DefinitionTable& table, Container& out)
+{
+    const auto cards = table.cards();
+    for (const auto& entry : table.deck())
+    {
+        out.push_back(CreateCardFromDefinition(
+            reg, table, cards[entry.card], CardPointAndSuit{.point = entry.point, .suit = entry.suit}));
+    }
+}
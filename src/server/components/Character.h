@@ -15,16 +15,20 @@
 #pragma once
 
 #include <entt/entity/fwd.hpp>
-#include <string>
+#include <string_view>
+#include <utility>
 #include <cstdint>
 #include <entt/entt.hpp>
 #include "src/shared/common/Common.h"
+#include "src/server/components/Skill.h"
+#include "src/server/context/RoomMemory.h"
+#include "src/server/data/DefinitionTable.h"
 
 struct MetaCharacterInfo
 {
-    std::string name;
+    std::string_view name; // 引用定义表或字面量
     uint32_t id;
-    std::string tag;
+    std::string_view tag;
 };
 
 struct Gender
@@ -37,26 +41,41 @@ struct Faction
     FactionType type;
 };
 
+/**
+ * @brief 技能列表，容器须由调用方带上房间的分配器构造，不提供默认构造
+ */
 struct Skills
 {
-    std::vector<entt::entity> skillList;
+    explicit Skills(memory::Vector<entt::entity> skills) : skillList(std::move(skills)) {}
+
+    memory::Vector<entt::entity> skillList;
 };
 
-struct Attributes
+/**
+ * @brief 热数据：每次伤害、回复、出杀都会读写，单独成一个 12 字节的组件，与冷属性分开存放
+ */
+struct CombatState
 {
+    int32_t currentHealth = 4;
     uint32_t maxHealth = 4;
+    uint8_t attackTimes = 1; // 本回合剩余出杀次数
+    bool isAlive = true;
+};
+
+/**
+ * @brief 冷数据：距离、装备区开关等，只在合法性检查时读取
+ */
+struct Attributes
+{
     uint32_t attackPower = 1;
     uint32_t defense = 0;
     uint32_t attackRange = 1;
     uint32_t movement = 1;
     uint8_t rank = 0;
-    uint8_t attackTimes = 1;
-    int32_t currentHealth = 4;
     bool weaponAreaEnabled = true;
     bool armorAreaEnabled = true;
     bool attackhorseAreaEnabled = true;
     bool defensehorseAreaEnabled = true;
-    bool isAlive = true;
 };
 
 struct Status
@@ -68,19 +87,62 @@ struct Status
 
 struct StatusFlags
 {
-    std::vector<Status> statusList; // 角色状态列表
+    explicit StatusFlags(memory::Vector<Status> statuses) : statusList(std::move(statuses)) {}
+
+    memory::Vector<Status> statusList; // 角色状态列表
 };
 
 inline entt::entity
-    CreateCharacter(entt::registry& reg, const MetaCharacterInfo& info, FactionType faction, const Skills& skills)
+    CreateCharacter(RoomRegistry& reg, const MetaCharacterInfo& info, FactionType faction, const Skills& skills)
 {
     auto ent = reg.create();
+    // 组件内的容器使用注册表所属房间的内存
+    const auto allocator = reg.get_allocator();
 
     reg.emplace<MetaCharacterInfo>(ent, info);
     reg.emplace<Faction>(ent, Faction{faction});
-    reg.emplace<Attributes>(ent, Attributes{});
-    reg.emplace<StatusFlags>(ent);
-    reg.emplace<Skills>(ent, skills);
+    reg.emplace<CombatState>(ent);
+    reg.emplace<Attributes>(ent);
+    reg.emplace<StatusFlags>(ent, StatusFlags{memory::Vector<Status>(allocator)});
+    reg.emplace<Skills>(
+        ent, Skills{memory::Vector<entt::entity>(skills.skillList.begin(), skills.skillList.end(), allocator)});
+
+    return ent;
+}
+
+/**
+ * @brief 按定义表创建武将及其技能实体
+ * @param table 定义表，须比注册表活得久（名称直接引用表内存）
+ */
+inline entt::entity
+    CreateCharacterFromDefinition(RoomRegistry& reg, const data::DefinitionTable& table, const data::CharacterDef& def)
+{
+    Skills skills{memory::Vector<entt::entity>(reg.get_allocator())};
+    const auto skillDefs = table.skills();
+    for (uint16_t index : table.skillsOf(def))
+    {
+        const auto& skillDef = skillDefs[index];
+        auto skill = reg.create();
+        reg.emplace<MetaSkillInfo>(skill,
+                                   MetaSkillInfo{.name = table.text(skillDef.name),
+                                                 .description = table.text(skillDef.description),
+                                                 .needTarget = skillDef.needTarget != 0,
+                                                 .maxTargets = skillDef.maxTargets,
+                                                 .minTargets = skillDef.minTargets});
+        auto& triggers = reg.emplace<SkillTriggers>(skill);
+        for (const auto& trigger : table.triggersOf(skillDef))
+        {
+            triggers.triggers.push_back(SkillTrigger{.phase = trigger.phase, .moment = trigger.moment});
+        }
+        skills.skillList.push_back(skill);
+    }
 
+    auto ent = CreateCharacter(
+        reg, MetaCharacterInfo{.name = table.text(def.name), .id = def.id, .tag = table.text(def.tag)}, def.faction,
+        skills);
+    reg.emplace<Gender>(ent, Gender{def.gender});
+    auto& combat = reg.get<CombatState>(ent);
+    combat.maxHealth = def.maxHealth;
+    combat.currentHealth = def.maxHealth;
     return ent;
 }
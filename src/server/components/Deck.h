@@ -16,10 +16,11 @@
 #pragma once
 #include <entt/entt.hpp>
 #include <vector>
+#include "src/server/context/RoomMemory.h"
 
 struct Deck
 {
-    std::vector<entt::entity> drawPile;       // 抽牌堆
-    std::vector<entt::entity> discardPile;    // 弃牌堆
-    std::vector<entt::entity> processingArea; // 处理区
+    memory::Vector<entt::entity> drawPile;       // 抽牌堆
+    memory::Vector<entt::entity> discardPile;    // 弃牌堆
+    memory::Vector<entt::entity> processingArea; // 处理区
 };
@@ -0,0 +1,45 @@
+/**
+ * ************************************************************************
+ *
+ * @file Groups.h
+ * @author AnakinLiu (azrael2759@qq.com)
+ * @date 2026-10-16
+ * @version 0.1
+ * @brief 房间注册表中的拥有型 group
+    - 被 group 拥有的组件在各自的存储中按同一顺序排在最前，遍历时顺序访问各数组，不再逐个实体查找
+    - 同一组件只能被一个 group 拥有，所有拥有型 group 都在这里声明，系统只通过这些函数获取
+    - group 句柄很轻，系统在构造时取得并保存；首次获取时才建立，已有实体会被重新排列
+ *
+ * ************************************************************************
+ * @copyright Copyright (c) 2026 AnakinLiu
+ * For study and research only, no reprinting.
+ * ************************************************************************
+ */
+#pragma once
+#include <utility>
+#include <entt/entt.hpp>
+#include "src/server/components/Character.h"
+#include "src/server/components/Player.h"
+#include "src/server/context/RoomMemory.h"
+
+namespace groups
+{
+/**
+ * @brief 玩家区域：手牌与装备，发牌、弃牌、检索手牌时遍历
+ */
+inline auto PlayerZones(RoomRegistry& registry)
+{
+    return registry.group<HandCards, Equipments>();
+}
+
+/**
+ * @brief 参战角色：体力（热）与属性（冷）同序存放，伤害结算与全体遍历时使用
+ */
+inline auto Combatants(RoomRegistry& registry)
+{
+    return registry.group<CombatState, Attributes>();
+}
+
+using PlayerZonesGroup = decltype(PlayerZones(std::declval<RoomRegistry&>()));
+using CombatantsGroup = decltype(Combatants(std::declval<RoomRegistry&>()));
+} // namespace groups
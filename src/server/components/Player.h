@@ -15,9 +15,13 @@
 
 #pragma once
 #include <entt/entt.hpp>
+#include <array>
 #include <string>
+#include <utility>
 #include <cstdint>
+#include <absl/container/inlined_vector.h>
 #include "src/shared/common/Common.h"
+#include "src/server/context/RoomMemory.h"
 
 constexpr uint32_t DEFAULT_PLAYER_ID = 0xFFFFFFFF;
 struct MetaPlayerInfo
@@ -31,17 +35,38 @@ struct CharacterInfo
     entt::entity characterCard = entt::null; // 角色卡牌实体
 };
 
+constexpr std::size_t HAND_INLINE_CAPACITY = 8; // 手牌不超过此数时直接存放在组件内，超出才从房间内存分配
+
+/**
+ * @brief 手牌区：小数组内联在组件中，遍历手牌不再跳到堆上；溢出时使用的分配器须由调用方给出，不提供默认构造
+ */
 struct HandCards
 {
-    std::vector<entt::entity> handCards;
+    using Zone = absl::InlinedVector<entt::entity, HAND_INLINE_CAPACITY, memory::Allocator<entt::entity>>;
+
+    explicit HandCards(Zone zone) : handCards(std::move(zone)) {}
+
+    Zone handCards;
 };
 
+enum class EquipSlot : uint8_t
+{
+    Weapon,
+    Armor,
+    AttackHorse,
+    DefenseHorse
+};
+constexpr std::size_t EQUIP_SLOT_COUNT = 4;
+
+/**
+ * @brief 装备区：按 EquipSlot 下标存放，空位为 entt::null
+ */
 struct Equipments
 {
-    entt::entity weapon = entt::null;
-    entt::entity armor = entt::null;
-    entt::entity attackhorse = entt::null;
-    entt::entity defensehorse = entt::null;
+    std::array<entt::entity, EQUIP_SLOT_COUNT> slots{entt::null, entt::null, entt::null, entt::null};
+
+    [[nodiscard]] entt::entity& operator[](EquipSlot slot) { return slots[static_cast<std::size_t>(slot)]; }
+    [[nodiscard]] entt::entity operator[](EquipSlot slot) const { return slots[static_cast<std::size_t>(slot)]; }
 };
 
 struct Identity
@@ -54,7 +79,7 @@ struct LiveStatus
     bool isAlive = true;
 };
 
-inline entt::entity CreatePlayer(entt::registry& registry,
+inline entt::entity CreatePlayer(RoomRegistry& registry,
                                  MetaPlayerInfo& metaInfo,
                                  CharacterInfo& characterInfo,
                                  HandCards& handCards,
@@ -63,7 +88,10 @@ inline entt::entity CreatePlayer(entt::registry& registry,
     entt::entity player = registry.create();
     registry.emplace<MetaPlayerInfo>(player, metaInfo);
     registry.emplace<CharacterInfo>(player, characterInfo);
-    registry.emplace<HandCards>(player, handCards);
+    // 手牌溢出内联容量时从注册表所属房间的内存分配
+    registry.emplace<HandCards>(
+        player,
+        HandCards{{handCards.handCards.begin(), handCards.handCards.end(), registry.get_allocator()}});
     registry.emplace<Equipments>(player, equipments);
     registry.emplace<LiveStatus>(player, liveStatus);
     return player;
@@ -16,17 +16,32 @@
 #pragma once
 #include <cstdint>
 #include <entt/entity/fwd.hpp>
-#include <string>
+#include <string_view>
 #include <functional>
 #include <entt/entt.hpp>
 #include <array>
+#include <absl/container/inlined_vector.h>
 #include "src/shared/common/Common.h"
 
 struct MetaSkillInfo
 {
-    absl::string name;
-    absl::string description; // 新增描述字段
+    std::string_view name;        // 引用定义表或字面量
+    std::string_view description; // 新增描述字段
     bool needTarget = true;
     uint8_t maxTargets = 1;
     uint8_t minTargets = 1;
 };
+
+struct SkillTrigger
+{
+    TurnPhase phase = TurnPhase::START;            // 监听的阶段
+    TriggerMoment moment = TriggerMoment::DURING; // 监听的时机
+};
+
+/**
+ * @brief 技能监听的触发点列表，SkillSystem 据此建立 (时机, 阶段) -> 技能 的索引
+ */
+struct SkillTriggers
+{
+    absl::InlinedVector<SkillTrigger, 2> triggers;
+};
@@ -2,27 +2,60 @@
 #include <spdlog/spdlog.h>
 #include <spdlog/sinks/basic_file_sink.h>
 #include <memory>
+#include <mutex>
 #include <spdlog/sinks/rotating_file_sink.h>
 #include <filesystem>
 #include <spdlog/sinks/stdout_color_sinks.h>
+#include "src/utils/AsyncLogSink.h"
 static constexpr size_t MAX_LOG_FILE_SIZE = static_cast<size_t>(1024 * 1024 * 5); // 5MB
 static constexpr size_t MAX_LOG_FILES = 1;
+
+/**
+ * @brief 创建（或复用）房间日志器
+ *
+ * 默认异步：游戏 tick 上的 logger->info 只格式化消息并写入无锁队列，
+ * 文件与控制台 I/O 由 AsyncLogSink 的写线程完成；定义 PMK_SYNC_LOGGING 切回同步写出
+ */
 inline std::shared_ptr<spdlog::logger> CreateRollingLogger()
 {
+    // 同一进程内的多个房间共用一个文件日志器，重复注册会抛异常；
+    // 房间可能在不同线程上同时创建，查找与注册在同一把锁内完成
+    static std::mutex mutex;
+    std::lock_guard lock(mutex);
+    if (auto existing = spdlog::get("game_logger"))
+    {
+        return existing;
+    }
     std::filesystem::create_directories("logs");
 
-    auto logger = spdlog::rotating_logger_mt("game_logger",
-                                             "logs/debug.log",
-                                             MAX_LOG_FILE_SIZE, // 5MB
-                                             MAX_LOG_FILES      // 保留1个文件
+#if defined(PMK_SYNC_LOGGING)
+    using FileSink = spdlog::sinks::rotating_file_sink_mt;
+    using ConsoleSink = spdlog::sinks::stdout_color_sink_mt;
+#else
+    // 后端 sink 只在 AsyncLogSink 的锁内访问，无需自带锁
+    using FileSink = spdlog::sinks::rotating_file_sink_st;
+    using ConsoleSink = spdlog::sinks::stdout_color_sink_st;
+#endif
+    auto fileSink = std::make_shared<FileSink>("logs/debug.log",
+                                               MAX_LOG_FILE_SIZE, // 5MB
+                                               MAX_LOG_FILES      // 保留1个文件
     );
+    fileSink->set_pattern("[%Y-%m-%d %H:%M:%S.%e] [%l] %v");
+    auto consoleSink = std::make_shared<ConsoleSink>();
+    consoleSink->set_pattern("[%Y-%m-%d %H:%M:%S.%e] [%^%l%$] %v");
+    consoleSink->set_level(spdlog::level::debug);
 
-    logger->set_pattern("[%Y-%m-%d %H:%M:%S.%e] [%l] %v");
-    logger->set_level(spdlog::level::debug);
+    std::vector<spdlog::sink_ptr> sinks{fileSink, consoleSink};
+#if defined(PMK_SYNC_LOGGING)
+    auto logger = std::make_shared<spdlog::logger>("game_logger", sinks.begin(), sinks.end());
     logger->flush_on(spdlog::level::info);
-    auto sink = std::make_shared<spdlog::sinks::stdout_color_sink_mt>();
-    sink->set_pattern("[%Y-%m-%d %H:%M:%S.%e] [%^%l%$] %v");
-    sink->set_level(spdlog::level::debug);
-    logger->sinks().push_back(sink);
+#else
+    auto logger =
+        std::make_shared<spdlog::logger>("game_logger", std::make_shared<utils::AsyncLogSink>(std::move(sinks)));
+    // 异步模式下 flush 只是通知写线程，写线程每排空一批都会刷新
+    logger->flush_on(spdlog::level::warn);
+#endif
+    logger->set_level(spdlog::level::debug);
+    spdlog::register_logger(logger);
     return logger;
-}
\ No newline at end of file
+}
@@ -16,11 +16,18 @@
 
 #include <entt/entt.hpp>
 #include "CreateLogger.h"
-#include <asio/thread_pool.hpp>
+#include "InstrumentedDispatcher.h"
+#include "RoomMemory.h"
+#include "src/server/data/DefinitionTable.h"
+
+/**
+ * @brief 房间上下文；房间逻辑运行在共享的 utils::TaskScheduler 上，房间自身不持有线程
+ */
 struct GameContext
 {
-    entt::registry registry;     // 实体组件系统注册表
-    entt::dispatcher dispatcher; // 事件分发器
+    memory::RoomMemory roomMemory; // 房间内存，须最先构造、最后析构
+    RoomRegistry registry{memory::Allocator<entt::entity>{roomMemory.resource()}}; // 实体组件系统注册表
+    GameDispatcher dispatcher;   // 事件分发器（PMK_DISPATCH_PROFILING 开启时带统计）
     std::shared_ptr<spdlog::logger> logger = CreateRollingLogger();
-    asio::thread_pool threadPool{static_cast<std::size_t>(std::thread::hardware_concurrency()) * 2}; // 线程池
+    std::shared_ptr<const data::DefinitionTable> definitions = data::DefinitionTable::shared(); // 所有房间共享，只读
 };
\ No newline at end of file
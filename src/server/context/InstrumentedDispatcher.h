@@ -0,0 +1,358 @@
+/**
+ * ************************************************************************
+ *
+ * @file InstrumentedDispatcher.h
+ * @author AnakinLiu (azrael2759@qq.com)
+ * @date 2026-10-16
+ * @version 0.1
+ * @brief 带统计的事件分发器（可选）
+    开启 PMK_DISPATCH_PROFILING 后，GameContext::dispatcher 替换为 InstrumentedDispatcher：
+    - 按事件类型统计触发次数、处理耗时（含/不含嵌套）与耗时直方图
+    - trigger 与 enqueue + update 两条投递路径都计入统计（房间 tick 走后者）
+    - 记录 trigger 级联深度
+    - 统计每个 tick 的触发总数与总耗时
+    - 可导出为 Chrome Trace JSON (chrome://tracing / Perfetto)
+    未开启时 GameDispatcher 即 entt::dispatcher，不产生任何额外开销
+ *
+ * ************************************************************************
+ * @copyright Copyright (c) 2026 AnakinLiu
+ * For study and research only, no reprinting.
+ * ************************************************************************
+ */
+
+#pragma once
+#include <entt/entt.hpp>
+
+#if defined(PMK_DISPATCH_PROFILING)
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <chrono>
+#include <cstdint>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include <absl/container/flat_hash_map.h>
+#include <nlohmann/json.hpp>
+
+namespace profiling
+{
+constexpr std::size_t HISTOGRAM_BUCKETS = 32;          // 第 n 个桶统计耗时位于 [2^(n-1), 2^n) 纳秒
+constexpr std::size_t MAX_TRACE_EVENTS = 1U << 16U;    // Chrome Trace 事件上限，超出后丢弃（按需增长，不预留）
+constexpr std::size_t MAX_TICK_HISTORY = 1024;         // 保留的 tick 统计数
+
+/**
+ * @brief 单个事件类型的统计
+ */
+struct EventStats
+{
+    std::string_view name;
+    uint64_t count = 0;
+    uint64_t totalNs = 0; // 含嵌套 trigger 的耗时
+    uint64_t selfNs = 0;  // 扣除嵌套 trigger 后的耗时
+    uint64_t maxNs = 0;
+    uint32_t maxDepth = 0;
+    std::array<uint64_t, HISTOGRAM_BUCKETS> histogram{};
+};
+
+/**
+ * @brief 单个 tick 的统计
+ */
+struct TickStats
+{
+    uint64_t index = 0;
+    uint64_t triggers = 0;
+    uint64_t totalNs = 0; // 顶层 trigger 的耗时之和
+    uint32_t maxDepth = 0;
+};
+
+/**
+ * @brief Chrome Trace 中的一次完整事件 ("ph": "X")
+ */
+struct TraceEvent
+{
+    std::string_view name;
+    uint64_t beginNs;
+    uint64_t durationNs;
+    uint32_t depth;
+};
+
+class DispatchProfiler
+{
+public:
+    using clock = std::chrono::steady_clock;
+
+    DispatchProfiler() : m_origin(clock::now()) {}
+
+    /**
+     * @brief 标记一个 tick 开始
+     */
+    void beginTick() { m_currentTick = TickStats{.index = m_tickCount++}; }
+
+    /**
+     * @brief 标记一个 tick 结束，并保存其统计
+     */
+    void endTick()
+    {
+        if (m_ticks.size() < MAX_TICK_HISTORY)
+        {
+            m_ticks.push_back(m_currentTick);
+        }
+        else
+        {
+            m_ticks[m_currentTick.index % MAX_TICK_HISTORY] = m_currentTick;
+        }
+    }
+
+    /**
+     * @brief 进入一次 trigger，返回开始时间戳
+     */
+    uint64_t enter()
+    {
+        m_childNs.push_back(0);
+        ++m_depth;
+        return nowNs();
+    }
+
+    /**
+     * @brief 离开一次投递并记录统计
+     * @param delivered 本次投递的事件数：trigger 为 1，update 为队列中一次投递的事件数
+     */
+    void leave(entt::id_type type, std::string_view name, uint64_t beginNs, uint64_t delivered = 1)
+    {
+        uint64_t duration = nowNs() - beginNs;
+        uint64_t childNs = m_childNs.back();
+        m_childNs.pop_back();
+        uint32_t depth = m_depth--;
+        if (!m_childNs.empty())
+        {
+            m_childNs.back() += duration;
+        }
+
+        auto& stats = m_events[type];
+        stats.name = name;
+        stats.count += delivered;
+        stats.totalNs += duration;
+        stats.selfNs += duration - childNs;
+        stats.maxNs = std::max(stats.maxNs, duration);
+        stats.maxDepth = std::max(stats.maxDepth, depth);
+        ++stats.histogram[std::min<std::size_t>(std::bit_width(duration), HISTOGRAM_BUCKETS - 1)];
+
+        m_currentTick.triggers += delivered;
+        m_currentTick.maxDepth = std::max(m_currentTick.maxDepth, depth);
+        if (depth == 1)
+        {
+            m_currentTick.totalNs += duration;
+        }
+
+        if (m_traceEvents.size() < MAX_TRACE_EVENTS)
+        {
+            m_traceEvents.push_back(
+                TraceEvent{.name = name, .beginNs = beginNs, .durationNs = duration, .depth = depth});
+        }
+        else
+        {
+            ++m_droppedTraceEvents;
+        }
+    }
+
+    [[nodiscard]] const absl::flat_hash_map<entt::id_type, EventStats>& events() const { return m_events; }
+    [[nodiscard]] const std::vector<TickStats>& ticks() const { return m_ticks; }
+    [[nodiscard]] uint64_t droppedTraceEvents() const { return m_droppedTraceEvents; }
+
+    /**
+     * @brief 清空所有统计
+     */
+    void reset()
+    {
+        m_events.clear();
+        m_ticks.clear();
+        m_traceEvents.clear();
+        m_droppedTraceEvents = 0;
+        m_tickCount = 0;
+        m_currentTick = {};
+        m_origin = clock::now();
+    }
+
+    /**
+     * @brief 导出按事件类型汇总的统计
+     */
+    [[nodiscard]] nlohmann::json summaryJson() const
+    {
+        nlohmann::json result = nlohmann::json::array();
+        for (const auto& [type, stats] : m_events)
+        {
+            result.push_back({{"event", stats.name},
+                              {"count", stats.count},
+                              {"totalNs", stats.totalNs},
+                              {"selfNs", stats.selfNs},
+                              {"maxNs", stats.maxNs},
+                              {"maxDepth", stats.maxDepth},
+                              {"histogramLog2Ns", stats.histogram}});
+        }
+        return result;
+    }
+
+    /**
+     * @brief 导出 Chrome Trace 格式 JSON
+     */
+    [[nodiscard]] nlohmann::json chromeTraceJson() const
+    {
+        constexpr double NS_PER_US = 1000.0;
+        nlohmann::json traceEvents = nlohmann::json::array();
+        for (const auto& event : m_traceEvents)
+        {
+            traceEvents.push_back({{"name", event.name},
+                                   {"cat", "dispatcher"},
+                                   {"ph", "X"},
+                                   {"ts", static_cast<double>(event.beginNs) / NS_PER_US},
+                                   {"dur", static_cast<double>(event.durationNs) / NS_PER_US},
+                                   {"pid", 0},
+                                   {"tid", 0},
+                                   {"args", {{"depth", event.depth}}}});
+        }
+        return {{"traceEvents", std::move(traceEvents)},
+                {"displayTimeUnit", "ns"},
+                {"otherData", {{"summary", summaryJson()}, {"droppedEvents", m_droppedTraceEvents}}}};
+    }
+
+private:
+    [[nodiscard]] uint64_t nowNs() const
+    {
+        return static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - m_origin).count());
+    }
+
+    clock::time_point m_origin;
+    absl::flat_hash_map<entt::id_type, EventStats> m_events;
+    std::vector<TickStats> m_ticks;
+    std::vector<TraceEvent> m_traceEvents;
+    std::vector<uint64_t> m_childNs; // 每层 trigger 中嵌套 trigger 的累计耗时
+    TickStats m_currentTick;
+    uint64_t m_tickCount = 0;
+    uint64_t m_droppedTraceEvents = 0;
+    uint32_t m_depth = 0;
+};
+
+/**
+ * @brief entt::dispatcher 的统计包装，接口与 entt::dispatcher 保持一致
+ */
+class InstrumentedDispatcher
+{
+public:
+    template <typename Type>
+    [[nodiscard]] auto sink(const entt::id_type id = entt::type_hash<Type>::value())
+    {
+        return m_dispatcher.sink<Type>(id);
+    }
+
+    template <typename Type>
+    void trigger(Type&& value = {})
+    {
+        using EventType = std::decay_t<Type>;
+        const uint64_t begin = m_profiler.enter();
+        m_dispatcher.trigger(std::forward<Type>(value));
+        m_profiler.leave(entt::type_hash<EventType>::value(), entt::type_name<EventType>::value(), begin);
+    }
+
+    template <typename Type, typename... Args>
+    void enqueue(Args&&... args)
+    {
+        track<Type>();
+        m_dispatcher.enqueue<Type>(std::forward<Args>(args)...);
+    }
+
+    template <typename Type>
+    void enqueue(Type&& value)
+    {
+        track<std::decay_t<Type>>();
+        m_dispatcher.enqueue(std::forward<Type>(value));
+    }
+
+    template <typename Type>
+    void update()
+    {
+        deliver<Type>(*this);
+    }
+
+    /**
+     * @brief 按类型逐个投递队列中的事件；处理函数新入队的类型在同一次 update 中投递
+     */
+    void update()
+    {
+        for (std::size_t index = 0; index < m_queuedTypes.size(); ++index)
+        {
+            m_queuedTypes[index].deliver(*this);
+        }
+        m_dispatcher.update();
+    }
+
+    template <typename Type>
+    void clear()
+    {
+        m_dispatcher.clear<Type>();
+    }
+
+    void clear() { m_dispatcher.clear(); }
+
+    template <typename Type>
+    void disconnect(Type& value_or_instance)
+    {
+        m_dispatcher.disconnect(value_or_instance);
+    }
+
+    DispatchProfiler& profiler() { return m_profiler; }
+    [[nodiscard]] const DispatchProfiler& profiler() const { return m_profiler; }
+
+private:
+    /**
+     * @brief 入队过的事件类型及其投递函数
+     */
+    struct QueuedType
+    {
+        entt::id_type type;
+        void (*deliver)(InstrumentedDispatcher&);
+    };
+
+    template <typename Type>
+    void track()
+    {
+        constexpr entt::id_type TYPE = entt::type_hash<Type>::value();
+        if (std::ranges::find(m_queuedTypes, TYPE, &QueuedType::type) == m_queuedTypes.end())
+        {
+            m_queuedTypes.push_back(QueuedType{.type = TYPE, .deliver = &InstrumentedDispatcher::deliver<Type>});
+        }
+    }
+
+    template <typename Type>
+    static void deliver(InstrumentedDispatcher& self)
+    {
+        const std::size_t pending = self.m_dispatcher.size<Type>();
+        if (pending == 0)
+        {
+            return;
+        }
+        const uint64_t begin = self.m_profiler.enter();
+        self.m_dispatcher.update<Type>();
+        self.m_profiler.leave(entt::type_hash<Type>::value(), entt::type_name<Type>::value(), begin, pending);
+    }
+
+    entt::dispatcher m_dispatcher;
+    DispatchProfiler m_profiler;
+    std::vector<QueuedType> m_queuedTypes; // 按首次入队顺序
+};
+} // namespace profiling
+
+using GameDispatcher = profiling::InstrumentedDispatcher;
+
+#define PMK_DISPATCH_TICK_BEGIN(dispatcher) (dispatcher).profiler().beginTick()
+#define PMK_DISPATCH_TICK_END(dispatcher) (dispatcher).profiler().endTick()
+
+#else
+
+using GameDispatcher = entt::dispatcher;
+
+#define PMK_DISPATCH_TICK_BEGIN(dispatcher) ((void)0)
+#define PMK_DISPATCH_TICK_END(dispatcher) ((void)0)
+
+#endif
@@ -0,0 +1,296 @@
+/**
+ * ************************************************************************
+ *
+ * @file RoomMemory.h
+ * @author AnakinLiu (azrael2759@qq.com)
+ * @date 2026-10-16
+ * @version 0.1
+ * @brief 房间级内存资源
+    每个房间 (GameContext) 持有一个 RoomMemory：
+    - 注册表存储、手牌/牌堆/状态列表以及事件中的临时容器都从房间内存分配
+    - 内存池不加锁（同一房间同一时刻只在一个线程上运行），不同房间之间无分配竞争
+    - 小块 (<= MAX_POOLED_BLOCK) 从 arena 切出，释放后进入分级空闲链表复用，房间销毁时整块归还
+    - 大块与对齐要求更高的块直接向 mimalloc 申请，释放即归还，不在 arena 中滞留
+    - stats() 报告房间占用的内存
+    分配器 memory::Allocator 没有默认构造，资源必须显式传入（通常取 registry.get_allocator()），
+    容器落到哪个房间的内存只取决于构造它的代码，与调用线程无关
+ *
+ * ************************************************************************
+ * @copyright Copyright (c) 2026 AnakinLiu
+ * For study and research only, no reprinting.
+ * ************************************************************************
+ */
+
+#pragma once
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <new>
+#include <vector>
+#include <entt/entt.hpp>
+#include <mimalloc.h>
+
+namespace memory
+{
+constexpr std::size_t INITIAL_ARENA_SIZE = static_cast<std::size_t>(64 * 1024); // 房间首块大小
+constexpr std::size_t MAX_POOLED_BLOCK = static_cast<std::size_t>(4 * 1024);    // 超过此大小直接向 mimalloc 申请
+
+/**
+ * @brief 以 mimalloc 为后端的内存资源（线程本地空闲链表，跨线程无锁）
+ */
+class MimallocResource final : public std::pmr::memory_resource
+{
+public:
+    static MimallocResource* instance()
+    {
+        static MimallocResource resource;
+        return &resource;
+    }
+
+private:
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override
+    {
+        void* ptr = mi_malloc_aligned(bytes, alignment);
+        if (ptr == nullptr)
+        {
+            throw std::bad_alloc();
+        }
+        return ptr;
+    }
+
+    void do_deallocate(void* ptr, std::size_t bytes, std::size_t alignment) override
+    {
+        mi_free_size_aligned(ptr, bytes, alignment);
+    }
+
+    [[nodiscard]] bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+    {
+        return this == &other;
+    }
+};
+
+/**
+ * @brief 统计经过的分配量
+ *
+ * 只允许一个线程分配/释放（房间线程），计数用 relaxed 原子量的 load/store 而非 RMW，
+ * 热路径上没有 lock 前缀指令，其他线程读取报告时也不会读到撕裂的值
+ */
+class CountingResource final : public std::pmr::memory_resource
+{
+public:
+    explicit CountingResource(std::pmr::memory_resource* upstream) : m_upstream(upstream) {}
+
+    [[nodiscard]] std::size_t bytesInUse() const { return m_bytesInUse.load(std::memory_order_relaxed); }
+    [[nodiscard]] std::size_t peakBytes() const { return m_peakBytes.load(std::memory_order_relaxed); }
+    [[nodiscard]] uint64_t allocations() const { return m_allocations.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief 上游已整体释放时调用，清零占用量
+     */
+    void resetInUse() { m_bytesInUse.store(0, std::memory_order_relaxed); }
+
+private:
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override
+    {
+        void* ptr = m_upstream->allocate(bytes, alignment);
+        std::size_t inUse = m_bytesInUse.load(std::memory_order_relaxed) + bytes;
+        m_bytesInUse.store(inUse, std::memory_order_relaxed);
+        if (inUse > m_peakBytes.load(std::memory_order_relaxed))
+        {
+            m_peakBytes.store(inUse, std::memory_order_relaxed);
+        }
+        m_allocations.store(m_allocations.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        return ptr;
+    }
+
+    void do_deallocate(void* ptr, std::size_t bytes, std::size_t alignment) override
+    {
+        m_upstream->deallocate(ptr, bytes, alignment);
+        m_bytesInUse.store(m_bytesInUse.load(std::memory_order_relaxed) - bytes, std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+    {
+        return this == &other;
+    }
+
+    std::pmr::memory_resource* m_upstream;
+    std::atomic<std::size_t> m_bytesInUse{0};
+    std::atomic<std::size_t> m_peakBytes{0};
+    std::atomic<uint64_t> m_allocations{0};
+};
+
+/**
+ * @brief 按 2 的幂分级的空闲链表，块从上游 arena 切出
+ *
+ * 与 std::pmr::unsynchronized_pool_resource 相比，释放时直接按大小定位链表（O(1)），
+ * 不需要在块列表中查找指针所属的 chunk；超过 MAX_POOLED_BLOCK 或对齐超过 16 的请求交给 large，
+ * 释放时原样归还（arena 只增不减，大块放在 arena 中释放后无法复用）
+ */
+class FreeListResource final : public std::pmr::memory_resource
+{
+public:
+    FreeListResource(std::pmr::memory_resource* arena, std::pmr::memory_resource* large)
+        : m_upstream(arena), m_large(large)
+    {
+    }
+
+    /**
+     * @brief 丢弃所有空闲链表（上游 arena 随后整体释放）
+     */
+    void release() { m_freeLists.fill(nullptr); }
+
+private:
+    static constexpr std::size_t MIN_BLOCK = 16;
+    static constexpr std::size_t CLASS_COUNT = std::bit_width(MAX_POOLED_BLOCK / MIN_BLOCK) + 1;
+
+    struct FreeBlock
+    {
+        FreeBlock* next;
+    };
+
+    static std::size_t classOf(std::size_t bytes)
+    {
+        return static_cast<std::size_t>(std::bit_width((std::max(bytes, MIN_BLOCK) - 1) / MIN_BLOCK));
+    }
+
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override
+    {
+        if (bytes > MAX_POOLED_BLOCK || alignment > MIN_BLOCK)
+        {
+            return m_large->allocate(bytes, alignment);
+        }
+        std::size_t index = classOf(bytes);
+        if (FreeBlock* block = m_freeLists[index])
+        {
+            m_freeLists[index] = block->next;
+            return block;
+        }
+        return m_upstream->allocate(MIN_BLOCK << index, MIN_BLOCK);
+    }
+
+    void do_deallocate(void* ptr, std::size_t bytes, std::size_t alignment) override
+    {
+        if (bytes > MAX_POOLED_BLOCK || alignment > MIN_BLOCK)
+        {
+            m_large->deallocate(ptr, bytes, alignment);
+            return;
+        }
+        std::size_t index = classOf(bytes);
+        m_freeLists[index] = ::new (ptr) FreeBlock{m_freeLists[index]};
+    }
+
+    [[nodiscard]] bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+    {
+        return this == &other;
+    }
+
+    std::pmr::memory_resource* m_upstream; // arena，小块的来源
+    std::pmr::memory_resource* m_large;    // 大块直接申请与归还
+    std::array<FreeBlock*, CLASS_COUNT> m_freeLists{};
+};
+
+/**
+ * @brief 房间内存报告
+ */
+struct MemoryStats
+{
+    std::size_t reservedBytes = 0; // 向 mimalloc 申请的 arena 块与大块总量
+    std::size_t inUseBytes = 0;    // 房间内容器当前占用
+    std::size_t peakInUseBytes = 0;
+    uint64_t allocations = 0;      // 房间内累计分配次数
+};
+
+/**
+ * @brief 房间内存：mimalloc -> arena (monotonic) -> 不加锁的分级空闲链表；大块绕过 arena 直接走 mimalloc
+ */
+class RoomMemory
+{
+public:
+    RoomMemory() = default;
+    RoomMemory(const RoomMemory&) = delete;
+    RoomMemory& operator=(const RoomMemory&) = delete;
+    RoomMemory(RoomMemory&&) = delete;
+    RoomMemory& operator=(RoomMemory&&) = delete;
+    ~RoomMemory() = default;
+
+    [[nodiscard]] std::pmr::memory_resource* resource() { return &m_usage; }
+
+    [[nodiscard]] MemoryStats stats() const
+    {
+        return MemoryStats{.reservedBytes = m_reserved.bytesInUse(),
+                           .inUseBytes = m_usage.bytesInUse(),
+                           .peakInUseBytes = m_usage.peakBytes(),
+                           .allocations = m_usage.allocations()};
+    }
+
+    /**
+     * @brief 一次性归还房间的全部内存
+     * @warning 调用前须确保房间内不再有存活的容器（注册表已清空、系统已销毁）
+     */
+    void release()
+    {
+        m_pool.release();
+        m_arena.release();
+        m_usage.resetInUse();
+    }
+
+private:
+    // 声明顺序即依赖顺序：析构时由上到下逆序释放
+    CountingResource m_reserved{MimallocResource::instance()};
+    std::pmr::monotonic_buffer_resource m_arena{INITIAL_ARENA_SIZE, &m_reserved};
+    FreeListResource m_pool{&m_arena, &m_reserved};
+    CountingResource m_usage{&m_pool};
+};
+
+/**
+ * @brief 房间分配器
+ *
+ * 与 std::pmr::polymorphic_allocator 的区别：
+ * - 没有默认构造，资源须显式传入，不会悄悄落到进程级默认资源
+ * - 不提供 construct()，不会对元素做 uses-allocator 构造（EnTT 存储要求如此）
+ * - 拷贝容器时沿用源容器的资源
+ */
+template <typename T>
+class Allocator
+{
+public:
+    using value_type = T;
+
+    explicit Allocator(std::pmr::memory_resource* resource) noexcept : m_resource(resource) {}
+    template <typename U>
+    Allocator(const Allocator<U>& other) noexcept : m_resource(other.resource()) // NOLINT(google-explicit-constructor)
+    {
+    }
+
+    [[nodiscard]] T* allocate(std::size_t count)
+    {
+        return static_cast<T*>(m_resource->allocate(count * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T* ptr, std::size_t count) noexcept { m_resource->deallocate(ptr, count * sizeof(T), alignof(T)); }
+
+    [[nodiscard]] std::pmr::memory_resource* resource() const noexcept { return m_resource; }
+
+    template <typename U>
+    bool operator==(const Allocator<U>& other) const noexcept
+    {
+        return m_resource == other.resource() || m_resource->is_equal(*other.resource());
+    }
+
+private:
+    std::pmr::memory_resource* m_resource;
+};
+
+template <typename T>
+using Vector = std::vector<T, Allocator<T>>;
+} // namespace memory
+
+/**
+ * @brief 房间注册表：组件存储从房间内存分配
+ */
+using RoomRegistry = entt::basic_registry<entt::entity, memory::Allocator<entt::entity>>;
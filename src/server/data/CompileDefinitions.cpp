@@ -0,0 +1,63 @@
+/**
+ * ************************************************************************
+ *
+ * @file CompileDefinitions.cpp
+ * @author AnakinLiu (azrael2759@qq.com)
+ * @date 2026-10-16
+ * @version 0.1
+ * @brief 定义表编译工具（构建时运行）
+    用法: PestManKillDefc <输出.pmkd> <输入.json>...
+    各输入文件的同名数组按命令行顺序拼接后编译
+ *
+ * ************************************************************************
+ * @copyright Copyright (c) 2026 AnakinLiu
+ * For study and research only, no reprinting.
+ * ************************************************************************
+ */
+
+#include <fstream>
+#include <iostream>
+#include <nlohmann/json.hpp>
+#include "src/server/data/DefinitionCompiler.h"
+
+int main(int argc, char** argv)
+{
+    if (argc < 3)
+    {
+        std::cerr << "usage: " << argv[0] << " <output.pmkd> <input.json>...\n";
+        return 2;
+    }
+
+    nlohmann::json root = nlohmann::json::object();
+    for (int index = 2; index < argc; ++index)
+    {
+        std::ifstream input(argv[index]);
+        if (!input)
+        {
+            std::cerr << argv[index] << ": cannot open\n";
+            return 1;
+        }
+        nlohmann::json document = nlohmann::json::parse(input, nullptr, false);
+        if (document.is_discarded() || !document.is_object())
+        {
+            std::cerr << argv[index] << ": expected a JSON object\n";
+            return 1;
+        }
+        data::MergeDefinitions(root, document);
+    }
+
+    auto table = data::CompileDefinitions(root);
+    if (!table)
+    {
+        std::cerr << "definition error: " << table.error() << "\n";
+        return 1;
+    }
+    std::ofstream output(argv[1], std::ios::binary | std::ios::trunc);
+    output.write(reinterpret_cast<const char*>(table->data()), static_cast<std::streamsize>(table->size()));
+    if (!output)
+    {
+        std::cerr << argv[1] << ": write failed\n";
+        return 1;
+    }
+    return 0;
+}
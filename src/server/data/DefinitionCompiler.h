@@ -0,0 +1,324 @@
+/**
+ * ************************************************************************
+ *
+ * @file DefinitionCompiler.h
+ * @author AnakinLiu (azrael2759@qq.com)
+ * @date 2026-10-16
+ * @version 0.1
+ * @brief JSON 定义 -> 二进制定义表
+    输入为合并后的 JSON 对象，包含 cards / deck / skills / characters 四个数组：
+    - cards: { key, name, description, type, subType, target: { needTarget, minTargets, maxTargets, range } }
+    - deck: { card, suit, points: [...] }，card 为 cards 中的 key
+    - skills: { name, description, target, triggers: [{ phase, moment }] }
+    - characters: { id, name, tag, faction, gender, maxHealth, skills: [技能名] }
+    枚举字段可写名称或底层整数值
+ *
+ * ************************************************************************
+ * @copyright Copyright (c) 2026 AnakinLiu
+ * For study and research only, no reprinting.
+ * ************************************************************************
+ */
+
+#pragma once
+#include <array>
+#include <cstring>
+#include <expected>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include <nlohmann/json.hpp>
+#include "src/server/data/DefinitionTable.h"
+
+namespace data
+{
+template <typename E>
+struct EnumName
+{
+    std::string_view name;
+    E value;
+};
+
+constexpr std::array CARD_TYPE_NAMES{EnumName<CardType>{"BASIC", CardType::BASIC},
+                                     EnumName<CardType>{"STRATEGY", CardType::STRATEGY}};
+
+constexpr std::array BASIC_CARD_NAMES{EnumName<BasicCardType>{"STRIKE", BasicCardType::STRIKE},
+                                      EnumName<BasicCardType>{"DODGE", BasicCardType::DODGE},
+                                      EnumName<BasicCardType>{"PEACH", BasicCardType::PEACH},
+                                      EnumName<BasicCardType>{"ALCOHOL", BasicCardType::ALCOHOL}};
+
+constexpr std::array STRATEGY_CARD_NAMES{EnumName<StrategyCardType>{"FIRE_ATTACK", StrategyCardType::FIRE_ATTACK},
+                                         EnumName<StrategyCardType>{"DUEL", StrategyCardType::DUEL}};
+
+constexpr std::array SUIT_NAMES{EnumName<SuitType>{"SPADE", SuitType::SPADE},
+                                EnumName<SuitType>{"HEART", SuitType::HEART},
+                                EnumName<SuitType>{"CLUB", SuitType::CLUB},
+                                EnumName<SuitType>{"DIAMOND", SuitType::DIAMOND},
+                                EnumName<SuitType>{"JOKER", SuitType::JOKER}};
+
+constexpr std::array PHASE_NAMES{EnumName<TurnPhase>{"GAME_START", TurnPhase::GAME_START},
+                                 EnumName<TurnPhase>{"START", TurnPhase::START},
+                                 EnumName<TurnPhase>{"JUDGE", TurnPhase::JUDGE},
+                                 EnumName<TurnPhase>{"DRAW", TurnPhase::DRAW},
+                                 EnumName<TurnPhase>{"PLAY", TurnPhase::PLAY},
+                                 EnumName<TurnPhase>{"DISCARD", TurnPhase::DISCARD},
+                                 EnumName<TurnPhase>{"END", TurnPhase::END},
+                                 EnumName<TurnPhase>{"GAME_OVER", TurnPhase::GAME_OVER}};
+
+constexpr std::array MOMENT_NAMES{EnumName<TriggerMoment>{"DURING", TriggerMoment::DURING}};
+
+/**
+ * @brief 定义表构建器：收集各段记录与去重后的字符串池，最后一次性排布成文件
+ */
+class DefinitionBuilder
+{
+public:
+    StringRef intern(std::string_view text)
+    {
+        auto [iter, inserted] = m_stringIndex.try_emplace(std::string(text), StringRef{});
+        if (inserted)
+        {
+            iter->second = StringRef{.offset = static_cast<uint32_t>(m_strings.size()),
+                                     .size = static_cast<uint32_t>(text.size())};
+            m_strings.insert(m_strings.end(), text.begin(), text.end());
+        }
+        return iter->second;
+    }
+
+    std::vector<CardDef> cards;
+    std::vector<DeckEntry> deck;
+    std::vector<SkillDef> skills;
+    std::vector<TriggerDef> triggers;
+    std::vector<CharacterDef> characters;
+    std::vector<uint16_t> characterSkills;
+
+    [[nodiscard]] std::vector<std::byte> build() const
+    {
+        std::vector<std::byte> bytes(sizeof(TableHeader));
+        TableHeader header;
+        header.cards = append(bytes, cards);
+        header.deck = append(bytes, deck);
+        header.skills = append(bytes, skills);
+        header.triggers = append(bytes, triggers);
+        header.characters = append(bytes, characters);
+        header.characterSkills = append(bytes, characterSkills);
+        header.strings = append(bytes, m_strings);
+        bytes.resize(alignUp(bytes.size()));
+        header.totalSize = static_cast<uint32_t>(bytes.size());
+        header.checksum = DefinitionChecksum(std::span(bytes).subspan(sizeof(TableHeader)));
+        std::memcpy(bytes.data(), &header, sizeof(TableHeader));
+        return bytes;
+    }
+
+private:
+    static std::size_t alignUp(std::size_t size)
+    {
+        return (size + DEFINITION_ALIGNMENT - 1) / DEFINITION_ALIGNMENT * DEFINITION_ALIGNMENT;
+    }
+
+    template <typename T>
+    static Section append(std::vector<std::byte>& bytes, const std::vector<T>& records)
+    {
+        const std::size_t offset = alignUp(bytes.size());
+        bytes.resize(offset + records.size() * sizeof(T));
+        if (!records.empty())
+        {
+            std::memcpy(bytes.data() + offset, records.data(), records.size() * sizeof(T));
+        }
+        return Section{.offset = static_cast<uint32_t>(offset), .count = static_cast<uint32_t>(records.size())};
+    }
+
+    std::vector<char> m_strings;
+    std::unordered_map<std::string, StringRef> m_stringIndex;
+};
+
+namespace detail
+{
+/**
+ * @brief 解析枚举字段：名称查表，整数按底层值
+ */
+template <typename E, std::size_t N>
+E ParseEnum(const nlohmann::json& value, const std::array<EnumName<E>, N>& names, std::string_view field)
+{
+    if (value.is_number_unsigned())
+    {
+        return static_cast<E>(value.get<std::underlying_type_t<E>>());
+    }
+    const auto text = value.get<std::string>();
+    for (const auto& entry : names)
+    {
+        if (entry.name == text)
+        {
+            return entry.value;
+        }
+    }
+    throw std::invalid_argument("unknown " + std::string(field) + " '" + text + "'");
+}
+
+inline uint8_t ParseSubType(CardType type, const nlohmann::json& value)
+{
+    if (value.is_number_unsigned())
+    {
+        return value.get<uint8_t>();
+    }
+    switch (type)
+    {
+        case CardType::BASIC: return static_cast<uint8_t>(ParseEnum(value, BASIC_CARD_NAMES, "basic card type"));
+        case CardType::STRATEGY:
+            return static_cast<uint8_t>(ParseEnum(value, STRATEGY_CARD_NAMES, "strategy card type"));
+        default: throw std::invalid_argument("subType of this card type must be numeric");
+    }
+}
+
+struct TargetFields
+{
+    uint8_t needTarget = 1;
+    uint8_t minTargets = 1;
+    uint8_t maxTargets = 1;
+    uint8_t range = 0;
+};
+
+inline TargetFields ParseTarget(const nlohmann::json& object)
+{
+    TargetFields target;
+    if (auto iter = object.find("target"); iter != object.end())
+    {
+        target.needTarget = iter->value("needTarget", true) ? 1 : 0;
+        target.minTargets = iter->value("minTargets", target.needTarget);
+        target.maxTargets = iter->value("maxTargets", target.needTarget);
+        target.range = iter->value("range", uint8_t{0});
+    }
+    return target;
+}
+} // namespace detail
+
+/**
+ * @brief 合并一个输入文件：同名数组按顺序拼接
+ */
+inline void MergeDefinitions(nlohmann::json& root, const nlohmann::json& document)
+{
+    for (const auto& [key, value] : document.items())
+    {
+        auto& merged = root[key];
+        if (merged.is_null())
+        {
+            merged = nlohmann::json::array();
+        }
+        merged.insert(merged.end(), value.begin(), value.end());
+    }
+}
+
+/**
+ * @brief 编译定义
+ * @return 成功返回定义表文件内容，失败返回带位置的错误描述
+ */
+inline std::expected<std::vector<std::byte>, std::string> CompileDefinitions(const nlohmann::json& root)
+{
+    DefinitionBuilder builder;
+    std::string where;
+    try
+    {
+        std::unordered_map<std::string, uint16_t> cardIndex;
+        for (const auto& card : root.value("cards", nlohmann::json::array()))
+        {
+            const auto key = card.at("key").get<std::string>();
+            where = "card '" + key + "'";
+            const CardType type = detail::ParseEnum(card.at("type"), CARD_TYPE_NAMES, "card type");
+            const auto target = detail::ParseTarget(card);
+            if (!cardIndex.try_emplace(key, static_cast<uint16_t>(builder.cards.size())).second)
+            {
+                throw std::invalid_argument("duplicate card key");
+            }
+            builder.cards.push_back(CardDef{.key = builder.intern(key),
+                                            .name = builder.intern(card.at("name").get<std::string>()),
+                                            .description = builder.intern(card.value("description", "")),
+                                            .type = type,
+                                            .subType = detail::ParseSubType(type, card.at("subType")),
+                                            .needTarget = target.needTarget,
+                                            .minTargets = target.minTargets,
+                                            .maxTargets = target.maxTargets,
+                                            .range = target.range});
+        }
+
+        for (const auto& group : root.value("deck", nlohmann::json::array()))
+        {
+            const auto key = group.at("card").get<std::string>();
+            where = "deck entry '" + key + "'";
+            auto iter = cardIndex.find(key);
+            if (iter == cardIndex.end())
+            {
+                throw std::invalid_argument("unknown card");
+            }
+            const SuitType suit = detail::ParseEnum(group.at("suit"), SUIT_NAMES, "suit");
+            for (const auto& point : group.at("points"))
+            {
+                builder.deck.push_back(DeckEntry{.card = iter->second, .point = point.get<uint8_t>(), .suit = suit});
+            }
+        }
+
+        std::unordered_map<std::string, uint16_t> skillIndex;
+        for (const auto& skill : root.value("skills", nlohmann::json::array()))
+        {
+            const auto name = skill.at("name").get<std::string>();
+            where = "skill '" + name + "'";
+            if (!skillIndex.try_emplace(name, static_cast<uint16_t>(builder.skills.size())).second)
+            {
+                throw std::invalid_argument("duplicate skill name");
+            }
+            const auto target = detail::ParseTarget(skill);
+            SkillDef def{.name = builder.intern(name),
+                         .description = builder.intern(skill.value("description", "")),
+                         .needTarget = target.needTarget,
+                         .minTargets = target.minTargets,
+                         .maxTargets = target.maxTargets,
+                         .firstTrigger = static_cast<uint32_t>(builder.triggers.size())};
+            for (const auto& trigger : skill.value("triggers", nlohmann::json::array()))
+            {
+                builder.triggers.push_back(
+                    TriggerDef{.phase = detail::ParseEnum(trigger.at("phase"), PHASE_NAMES, "phase"),
+                               .moment = detail::ParseEnum(trigger.at("moment"), MOMENT_NAMES, "trigger moment")});
+                ++def.triggerCount;
+            }
+            builder.skills.push_back(def);
+        }
+
+        for (const auto& character : root.value("characters", nlohmann::json::array()))
+        {
+            const auto name = character.at("name").get<std::string>();
+            where = "character '" + name + "'";
+            CharacterDef def{.name = builder.intern(name),
+                             .tag = builder.intern(character.value("tag", "")),
+                             .id = character.at("id").get<uint32_t>(),
+                             .faction = static_cast<FactionType>(character.value("faction", uint8_t{0})),
+                             .gender = static_cast<GenderType>(character.value("gender", uint8_t{0})),
+                             .maxHealth = character.value("maxHealth", uint8_t{4}),
+                             .firstSkill = static_cast<uint32_t>(builder.characterSkills.size())};
+            for (const auto& skillName : character.value("skills", nlohmann::json::array()))
+            {
+                auto iter = skillIndex.find(skillName.get<std::string>());
+                if (iter == skillIndex.end())
+                {
+                    throw std::invalid_argument("unknown skill '" + skillName.get<std::string>() + "'");
+                }
+                builder.characterSkills.push_back(iter->second);
+                ++def.skillCount;
+            }
+            builder.characters.push_back(def);
+        }
+    }
+    catch (const std::exception& error)
+    {
+        return std::unexpected(where.empty() ? std::string(error.what()) : where + ": " + error.what());
+    }
+    auto bytes = builder.build();
+    // 整数形式的枚举不经名称表，越界的取值在这里拦下，而不是留到服务端加载时
+    if (auto table = DefinitionTable::view(bytes); !table && table.error() == DefinitionError::InvalidValue)
+    {
+        return std::unexpected(std::string("enum value out of range"));
+    }
+    return bytes;
+}
+} // namespace data
@@ -0,0 +1,463 @@
+/**
+ * ************************************************************************
+ *
+ * @file DefinitionTable.h
+ * @author AnakinLiu (azrael2759@qq.com)
+ * @date 2026-10-16
+ * @version 0.1
+ * @brief 卡牌/技能/武将定义表（二进制格式与只读视图）
+    - 定义以 JSON 编写 (resource/Definitions)，构建时由 PestManKillDefc 编译为 definitions.pmkd
+    - 文件为定长 POD 数组 + 字符串池，按偏移访问，mmap 后无需解析即可使用
+    - 进程内只加载一份，所有房间共享只读视图；组件中的名称/描述直接引用映射内存
+ *
+ * ************************************************************************
+ * @copyright Copyright (c) 2026 AnakinLiu
+ * For study and research only, no reprinting.
+ * ************************************************************************
+ */
+
+#pragma once
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <expected>
+#include <filesystem>
+#include <memory>
+#include <span>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include "src/shared/common/Common.h"
+#include "src/utils/MappedFile.h"
+
+namespace data
+{
+static_assert(std::endian::native == std::endian::little, "definition table is stored little-endian");
+
+constexpr std::array<char, 4> DEFINITION_MAGIC{'P', 'M', 'K', 'D'};
+constexpr uint32_t DEFINITION_VERSION = 1; // 布局变化时递增，旧文件会被拒绝加载
+constexpr std::size_t DEFINITION_ALIGNMENT = 4;
+
+/**
+ * @brief 字符串池中的一段 UTF-8 文本
+ */
+struct StringRef
+{
+    uint32_t offset = 0;
+    uint32_t size = 0;
+};
+
+/**
+ * @brief 文件内的一个数组段
+ */
+struct Section
+{
+    uint32_t offset = 0; // 相对文件起始
+    uint32_t count = 0;  // 元素个数（字符串池为字节数）
+};
+
+struct TableHeader
+{
+    std::array<char, 4> magic = DEFINITION_MAGIC;
+    uint32_t version = DEFINITION_VERSION;
+    uint32_t totalSize = 0; // 文件总字节数
+    uint32_t checksum = 0;  // 头部之后全部字节的 FNV-1a
+    Section cards;
+    Section deck;
+    Section skills;
+    Section triggers;
+    Section characters;
+    Section characterSkills;
+    Section strings;
+};
+
+struct CardDef
+{
+    StringRef key;         // 稳定的英文标识，例如 "strike"
+    StringRef name;        // 显示名称
+    StringRef description; // 描述
+    CardType type = CardType::BASIC;
+    uint8_t subType = 0; // BasicCardType / StrategyCardType / EquipCardType 的底层值
+    uint8_t needTarget = 1;
+    uint8_t minTargets = 1;
+    uint8_t maxTargets = 1;
+    uint8_t range = 0; // 0 表示无限制
+    std::array<uint8_t, 2> reserved{};
+};
+
+/**
+ * @brief 牌堆中的一张牌
+ */
+struct DeckEntry
+{
+    uint16_t card = 0; // cards 段下标
+    uint8_t point = 0;
+    SuitType suit = SuitType::JOKER;
+};
+
+struct TriggerDef
+{
+    TurnPhase phase = TurnPhase::START;
+    TriggerMoment moment = TriggerMoment::DURING;
+};
+
+struct SkillDef
+{
+    StringRef name;
+    StringRef description;
+    uint8_t needTarget = 1;
+    uint8_t minTargets = 1;
+    uint8_t maxTargets = 1;
+    uint8_t triggerCount = 0;
+    uint32_t firstTrigger = 0; // triggers 段下标
+};
+
+struct CharacterDef
+{
+    StringRef name;
+    StringRef tag;
+    uint32_t id = 0;
+    FactionType faction{};
+    GenderType gender{};
+    uint8_t maxHealth = 4;
+    uint8_t skillCount = 0;
+    uint32_t firstSkill = 0; // characterSkills 段下标，元素为 skills 段下标 (uint16_t)
+};
+
+/**
+ * @brief 各枚举字段的取值个数，view() 据此拒绝越界的底层值
+ *
+ * 编译器也接受整数形式的枚举，上界因此按枚举定义而不是名称表；Common.h 中的枚举增加取值时同步修改
+ */
+constexpr uint8_t CARD_TYPE_COUNT = 3; // BASIC / STRATEGY / EQUIP
+constexpr uint8_t BASIC_CARD_COUNT = std::to_underlying(BasicCardType::ALCOHOL) + 1;
+constexpr uint8_t STRATEGY_CARD_COUNT = std::to_underlying(StrategyCardType::DUEL) + 1;
+constexpr uint8_t EQUIP_CARD_COUNT = 4; // 武器 / 防具 / 进攻马 / 防御马，与装备栏位一一对应
+constexpr uint8_t SUIT_COUNT = std::to_underlying(SuitType::JOKER) + 1;
+constexpr uint8_t PHASE_COUNT = std::to_underlying(TurnPhase::GAME_OVER) + 1;
+constexpr uint8_t MOMENT_COUNT = 3; // BEFORE / DURING / AFTER
+constexpr uint8_t FACTION_COUNT = 4;
+constexpr uint8_t GENDER_COUNT = 2;
+
+template <typename T>
+concept DefinitionRecord =
+    std::is_trivially_copyable_v<T> && std::is_standard_layout_v<T> && alignof(T) <= DEFINITION_ALIGNMENT;
+static_assert(DefinitionRecord<TableHeader> && DefinitionRecord<CardDef> && DefinitionRecord<DeckEntry> &&
+              DefinitionRecord<TriggerDef> && DefinitionRecord<SkillDef> && DefinitionRecord<CharacterDef>);
+
+enum class DefinitionError : uint8_t
+{
+    OpenFailed,       // 文件不存在或无法映射
+    Truncated,        // 文件比头部声明的短，或声明的大小装不下头部
+    BadMagic,         // 不是定义表文件
+    VersionMismatch,  // 由其他版本的编译器生成
+    ChecksumMismatch, // 内容损坏
+    InvalidSection,   // 段越界、未对齐或引用越界
+    InvalidValue      // 枚举字段超出取值范围
+};
+
+/**
+ * @brief FNV-1a 32 位校验
+ */
+inline uint32_t DefinitionChecksum(std::span<const std::byte> bytes)
+{
+    uint32_t hash = 2166136261U;
+    for (std::byte value : bytes)
+    {
+        hash = (hash ^ static_cast<uint8_t>(value)) * 16777619U;
+    }
+    return hash;
+}
+
+/**
+ * @brief 定义表只读视图
+ *
+ * 可以引用任意一段内存（编译器的输出缓冲、嵌入的数组），也可以通过 load() 持有映射文件
+ */
+class DefinitionTable
+{
+public:
+    /**
+     * @brief 校验并包装一段内存，不拷贝；内存须比视图活得久
+     */
+    static std::expected<DefinitionTable, DefinitionError> view(std::span<const std::byte> bytes)
+    {
+        if (bytes.size() < sizeof(TableHeader))
+        {
+            return std::unexpected(DefinitionError::Truncated);
+        }
+        TableHeader header;
+        std::memcpy(&header, bytes.data(), sizeof(TableHeader));
+        if (header.magic != DEFINITION_MAGIC)
+        {
+            return std::unexpected(DefinitionError::BadMagic);
+        }
+        if (header.version != DEFINITION_VERSION)
+        {
+            return std::unexpected(DefinitionError::VersionMismatch);
+        }
+        if (header.totalSize < sizeof(TableHeader) || header.totalSize > bytes.size())
+        {
+            return std::unexpected(DefinitionError::Truncated);
+        }
+        bytes = bytes.first(header.totalSize);
+        if (DefinitionChecksum(bytes.subspan(sizeof(TableHeader))) != header.checksum)
+        {
+            return std::unexpected(DefinitionError::ChecksumMismatch);
+        }
+        if (reinterpret_cast<std::uintptr_t>(bytes.data()) % DEFINITION_ALIGNMENT != 0 ||
+            !fits<CardDef>(header.cards, bytes) || !fits<DeckEntry>(header.deck, bytes) ||
+            !fits<SkillDef>(header.skills, bytes) || !fits<TriggerDef>(header.triggers, bytes) ||
+            !fits<CharacterDef>(header.characters, bytes) || !fits<uint16_t>(header.characterSkills, bytes) ||
+            !fits<char>(header.strings, bytes))
+        {
+            return std::unexpected(DefinitionError::InvalidSection);
+        }
+        DefinitionTable table;
+        table.m_bytes = bytes;
+        table.m_header = header;
+        if (!table.validateReferences())
+        {
+            return std::unexpected(DefinitionError::InvalidSection);
+        }
+        if (!table.validateValues())
+        {
+            return std::unexpected(DefinitionError::InvalidValue);
+        }
+        return table;
+    }
+
+    /**
+     * @brief 映射并校验定义表文件
+     */
+    static std::expected<std::shared_ptr<const DefinitionTable>, DefinitionError>
+        load(const std::filesystem::path& path)
+    {
+        auto file = std::make_shared<utils::MappedFile>(path);
+        if (!file->isOpen())
+        {
+            return std::unexpected(DefinitionError::OpenFailed);
+        }
+        auto table = view(file->bytes());
+        if (!table)
+        {
+            return std::unexpected(table.error());
+        }
+        table->m_file = std::move(file);
+        return std::make_shared<const DefinitionTable>(std::move(*table));
+    }
+
+    /**
+     * @brief 进程共享的定义表，首次调用时加载
+     *
+     * 路径依次取环境变量 PMK_DEFINITIONS、构建时注入的 PMK_DEFAULT_DEFINITIONS、工作目录下的 data/definitions.pmkd；
+     * 加载失败时返回空指针，调用方回退到内置数据
+     */
+    static std::shared_ptr<const DefinitionTable> shared()
+    {
+        static const std::shared_ptr<const DefinitionTable> table = []
+        {
+            auto loaded = load(defaultPath());
+            return loaded ? *loaded : nullptr;
+        }();
+        return table;
+    }
+
+    static std::filesystem::path defaultPath()
+    {
+        const char* path = std::getenv("PMK_DEFINITIONS"); // NOLINT(concurrency-mt-unsafe)
+        if (path != nullptr && *path != '\0')
+        {
+            return path;
+        }
+#ifdef PMK_DEFAULT_DEFINITIONS
+        return PMK_DEFAULT_DEFINITIONS;
+#else
+        return "data/definitions.pmkd";
+#endif
+    }
+
+    [[nodiscard]] std::span<const CardDef> cards() const { return section<CardDef>(m_header.cards); }
+    [[nodiscard]] std::span<const DeckEntry> deck() const { return section<DeckEntry>(m_header.deck); }
+    [[nodiscard]] std::span<const SkillDef> skills() const { return section<SkillDef>(m_header.skills); }
+    [[nodiscard]] std::span<const CharacterDef> characters() const
+    {
+        return section<CharacterDef>(m_header.characters);
+    }
+
+    [[nodiscard]] std::span<const TriggerDef> triggersOf(const SkillDef& skill) const
+    {
+        return section<TriggerDef>(m_header.triggers).subspan(skill.firstTrigger, skill.triggerCount);
+    }
+
+    /**
+     * @brief 武将的技能，元素为 skills() 下标
+     */
+    [[nodiscard]] std::span<const uint16_t> skillsOf(const CharacterDef& character) const
+    {
+        return section<uint16_t>(m_header.characterSkills).subspan(character.firstSkill, character.skillCount);
+    }
+
+    /**
+     * @brief 字符串视图直接指向表内存，与表同生命周期
+     */
+    [[nodiscard]] std::string_view text(StringRef ref) const
+    {
+        return {reinterpret_cast<const char*>(m_bytes.data()) + m_header.strings.offset + ref.offset, ref.size};
+    }
+
+    [[nodiscard]] const CardDef* findCard(std::string_view key) const
+    {
+        for (const auto& card : cards())
+        {
+            if (text(card.key) == key)
+            {
+                return &card;
+            }
+        }
+        return nullptr;
+    }
+
+    [[nodiscard]] const CharacterDef* findCharacter(uint32_t id) const
+    {
+        for (const auto& character : characters())
+        {
+            if (character.id == id)
+            {
+                return &character;
+            }
+        }
+        return nullptr;
+    }
+
+    [[nodiscard]] std::size_t sizeBytes() const { return m_bytes.size(); }
+
+private:
+    DefinitionTable() = default;
+
+    template <typename T>
+    static bool fits(const Section& section, std::span<const std::byte> bytes)
+    {
+        return section.offset % alignof(T) == 0 && section.offset <= bytes.size() &&
+               section.count <= (bytes.size() - section.offset) / sizeof(T);
+    }
+
+    template <typename T>
+    [[nodiscard]] std::span<const T> section(const Section& section) const
+    {
+        // 段已在 view() 中校验过边界与对齐，文件内容即这些 POD 的对象表示
+        return {reinterpret_cast<const T*>(m_bytes.data() + section.offset), section.count};
+    }
+
+    [[nodiscard]] bool validString(StringRef ref) const
+    {
+        return ref.offset <= m_header.strings.count && ref.size <= m_header.strings.count - ref.offset;
+    }
+
+    /**
+     * @brief 校验所有跨段引用，之后的访问无需再做边界检查
+     */
+    [[nodiscard]] bool validateReferences() const
+    {
+        for (const auto& card : cards())
+        {
+            if (!validString(card.key) || !validString(card.name) || !validString(card.description))
+            {
+                return false;
+            }
+        }
+        for (const auto& entry : deck())
+        {
+            if (entry.card >= m_header.cards.count)
+            {
+                return false;
+            }
+        }
+        for (const auto& skill : skills())
+        {
+            if (!validString(skill.name) || !validString(skill.description) ||
+                skill.firstTrigger > m_header.triggers.count ||
+                skill.triggerCount > m_header.triggers.count - skill.firstTrigger)
+            {
+                return false;
+            }
+        }
+        for (const auto& character : characters())
+        {
+            if (!validString(character.name) || !validString(character.tag) ||
+                character.firstSkill > m_header.characterSkills.count ||
+                character.skillCount > m_header.characterSkills.count - character.firstSkill)
+            {
+                return false;
+            }
+            for (uint16_t skill : skillsOf(character))
+            {
+                if (skill >= m_header.skills.count)
+                {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    template <typename E>
+    static bool inRange(E value, uint8_t count)
+    {
+        return std::to_underlying(value) < count;
+    }
+
+    [[nodiscard]] static bool validSubType(const CardDef& card)
+    {
+        switch (card.type)
+        {
+            case CardType::BASIC: return card.subType < BASIC_CARD_COUNT;
+            case CardType::STRATEGY: return card.subType < STRATEGY_CARD_COUNT;
+            default: return card.subType < EQUIP_CARD_COUNT;
+        }
+    }
+
+    /**
+     * @brief 校验枚举字段，组件构造时可以直接转换而不必再判断取值
+     */
+    [[nodiscard]] bool validateValues() const
+    {
+        for (const auto& card : cards())
+        {
+            if (!inRange(card.type, CARD_TYPE_COUNT) || !validSubType(card))
+            {
+                return false;
+            }
+        }
+        for (const auto& entry : deck())
+        {
+            if (!inRange(entry.suit, SUIT_COUNT))
+            {
+                return false;
+            }
+        }
+        for (const auto& trigger : section<TriggerDef>(m_header.triggers))
+        {
+            if (!inRange(trigger.phase, PHASE_COUNT) || !inRange(trigger.moment, MOMENT_COUNT))
+            {
+                return false;
+            }
+        }
+        for (const auto& character : characters())
+        {
+            if (!inRange(character.faction, FACTION_COUNT) || !inRange(character.gender, GENDER_COUNT))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    std::span<const std::byte> m_bytes;
+    TableHeader m_header;
+    std::shared_ptr<const utils::MappedFile> m_file; // 由 load() 创建时持有映射
+};
+} // namespace data
@@ -21,6 +21,7 @@
 #include <entt/entt.hpp>
 #include <string>
 #include <vector>
+#include "src/server/context/RoomMemory.h"
 
 namespace events
 {
@@ -61,7 +62,7 @@ struct CalculateDamage
 struct ChooseTarget
 {
     entt::entity player;
-    std::vector<entt::entity> availableTargets;
+    memory::Vector<entt::entity> availableTargets;
 };
 
 // 3. 动作事件（可能被取消）
@@ -123,7 +124,7 @@ struct CardDrawn // 获得牌事件
 struct CardDiscarded
 {
     entt::entity player;            // 弃牌角色
-    std::vector<entt::entity> card; // 弃掉的牌
+    memory::Vector<entt::entity> card; // 弃掉的牌
     uint8_t count;                  // 弃牌数量
 };
 
@@ -163,10 +164,17 @@ struct DamageRedirection
     int amount;                  // 重定向的伤害数值
 };
 
+/**
+ * @brief 结算步骤结束：DamageSystem 处理并一次性提交本步骤内缓冲的伤害、失去体力与回复
+ */
+struct SettleEffects
+{
+};
+
 struct DetailFinish
 {
     entt::entity player;             // 当前回合角色
-    std::vector<entt::entity> cards; // 结算的牌
+    memory::Vector<entt::entity> cards; // 结算的牌
 };
 
 struct AddResponseToSettleStack
@@ -35,6 +35,11 @@ struct NextTurn
 {
 };
 
+struct EndPlayPhase // 玩家主动结束出牌阶段
+{
+    entt::entity player; // 当前回合玩家
+};
+
 struct GotKilled
 {
     entt::entity player;     // 死亡的玩家实体
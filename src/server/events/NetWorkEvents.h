@@ -16,7 +16,10 @@
 
 #pragma once
 
+#include <cstdint>
+#include <vector>
 #include <entt/entt.hpp>
+#include "src/net/protocol/SharedFrame.h"
 
 namespace events
 {
@@ -27,6 +30,15 @@ struct NetworkMessageReceived
     uint32_t connectionId; // 标识发送者
 };
 
+/**
+ * @brief 发往某个连接的帧；房间在系统阶段产生，复制阶段统一交给网络层发送
+ */
+struct SendNetworkPacket
+{
+    uint32_t connectionId = 0;
+    SharedFrame frame;
+};
+
 struct Login
 {
 };
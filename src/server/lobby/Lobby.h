@@ -0,0 +1,640 @@
+/**
+ * ************************************************************************
+ *
+ * @file Lobby.h
+ * @author AnakinLiu (azrael2759@qq.com)
+ * @date 2026-10-16
+ * @version 0.1
+ * @brief 大厅：匹配与房间生命周期
+    - 网络线程只把请求压入无锁有界队列，队列满时立即回复 Busy，不阻塞收包
+    - 同一时刻只有一个匹配任务在共享调度器上运行，每次成批取出请求、入座、开局，
+      因此房间表与玩家表无需加锁
+    - 满员的房间交给自己的 strand，在工作线程上创建游戏上下文并回调 roomStarted
+    - 房间列表在变化时增量维护，每批最多重新编码一次；ROOM_LIST 请求直接发送
+      当前快照中预编码的共享帧，不遍历房间也不进入队列
+    - 会话挂起 (disconnect) 只标记离线、保留座位；恢复 (resume) 时立即回复所在房间与座位，
+      并在房间 strand 上回调 playerResumed 补发局面，玩家一个往返即可回到对局
+    - 对局中的房间及其玩家以快照 (RoomDirectory) 发布，tick 循环据此路由消息、驱动房间，无需访问大厅内部状态
+ *
+ * ************************************************************************
+ * @copyright Copyright (c) 2026 AnakinLiu
+ * For study and research only, no reprinting.
+ * ************************************************************************
+ */
+
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <absl/container/flat_hash_map.h>
+#include <asio/post.hpp>
+#include "Room.h"
+#include "src/net/protocol/SharedFrame.h"
+#include "src/shared/messages/MessageDispatcher.h"
+#include "src/shared/messages/request/CreateRoomRequest.h"
+#include "src/shared/messages/request/JoinRoomRequest.h"
+#include "src/shared/messages/request/LeaveRoomRequest.h"
+#include "src/shared/messages/response/CreateRoomResponse.h"
+#include "src/shared/messages/response/JoinRoomResponse.h"
+#include "src/shared/messages/response/RoomListResponse.h"
+#include "src/utils/MpmcQueue.h"
+#include "src/utils/TaskScheduler.h"
+
+namespace lobby
+{
+constexpr std::size_t LOBBY_QUEUE_CAPACITY = 16384; // 待处理请求上限，超出时回复 Busy
+constexpr std::size_t LOBBY_PUMP_BATCH = 1024;      // 单次匹配任务最多处理的请求数
+constexpr std::size_t ROOM_LIST_LIMIT = 1024;       // 房间列表最多返回的房间数
+constexpr std::size_t ROOM_NAME_LIMIT = 32;         // 房间名最大字节数（UTF-8）
+
+enum class LobbyError : uint8_t
+{
+    None = 0,
+    Busy,          // 请求队列已满
+    RoomNotFound,  // 房间不存在
+    RoomFull,      // 房间已满
+    RoomPlaying,   // 房间已开局
+    WrongPassword, // 密码错误
+    AlreadyInRoom  // 玩家已在其他房间
+};
+
+struct LobbyRequest
+{
+    enum class Action : uint8_t
+    {
+        Join,
+        Create,
+        Leave,
+        Disconnect,
+        Resume
+    };
+
+    Action action = Action::Join;
+    uint32_t player = 0; // 会话 conv
+    uint32_t roomId = 0; // Join: 0 为快速匹配
+    uint8_t maxPlayers = ROOM_CAPACITY;
+    std::string name;
+    std::string password;
+};
+
+/**
+ * @brief 房间列表快照，发布后不再修改，读者持有期间始终有效
+ */
+struct RoomListSnapshot
+{
+    uint64_t version = 0;
+    std::size_t roomCount = 0; // 等待中的房间总数（可能多于帧中列出的数量）
+    SharedFrame frame;         // 预编码的 ROOM_LIST_RESP
+};
+
+/**
+ * @brief 对局中的房间快照，与房间列表快照一样发布后不再修改
+ */
+struct RoomDirectory
+{
+    uint64_t version = 0;
+    std::vector<std::shared_ptr<Room>> rooms;                      // 对局中的房间
+    absl::flat_hash_map<uint32_t, std::shared_ptr<Room>> players; // 玩家 -> 所在的对局房间
+};
+
+struct LobbyCallbacks
+{
+    /**
+     * @brief 向玩家发送一帧；会在任意工作线程上调用，须线程安全（KcpSession::send 满足）
+     */
+    std::function<void(uint32_t player, const SharedFrame& frame)> send;
+
+    /**
+     * @brief 房间开局，在房间的 strand 上调用，此时 room.context 已创建
+     */
+    std::function<void(const std::shared_ptr<Room>& room)> roomStarted;
+
+    /**
+     * @brief 离线玩家恢复，在房间的 strand 上调用，应向该座位补发当前局面
+     */
+    std::function<void(const std::shared_ptr<Room>& room, uint8_t seat)> playerResumed;
+};
+
+class Lobby
+{
+public:
+    explicit Lobby(LobbyCallbacks callbacks,
+                   utils::TaskScheduler& scheduler = utils::TaskScheduler::global(),
+                   std::size_t queueCapacity = LOBBY_QUEUE_CAPACITY)
+        : m_callbacks(std::move(callbacks)), m_scheduler(scheduler), m_requests(queueCapacity), m_tasks(scheduler)
+    {
+        // 各房间并发开局时共用同一个日志器，先在这里注册，避免工作线程上重复注册
+        CreateRollingLogger();
+        publishRoomList();
+        publishDirectory();
+    }
+
+    Lobby(const Lobby&) = delete;
+    Lobby& operator=(const Lobby&) = delete;
+
+    /**
+     * @brief 加入指定房间，roomId 为 0 时快速匹配；可在任意线程调用
+     * @return 队列已满时返回 false（已回复 Busy）
+     */
+    bool join(uint32_t player, const JoinRoomRequest& request)
+    {
+        LobbyRequest entry;
+        entry.action = LobbyRequest::Action::Join;
+        entry.player = player;
+        entry.roomId = request.roomId;
+        entry.password = request.password;
+        return submit(std::move(entry));
+    }
+
+    /**
+     * @brief 创建房间，创建者坐 0 号位
+     */
+    bool create(uint32_t player, const CreateRoomRequest& request)
+    {
+        LobbyRequest entry;
+        entry.action = LobbyRequest::Action::Create;
+        entry.player = player;
+        entry.maxPlayers = request.maxPlayers;
+        entry.name = request.roomName;
+        entry.password = request.password;
+        return submit(std::move(entry));
+    }
+
+    /**
+     * @brief 离开当前房间（会话关闭、恢复窗口已过时也应调用）
+     */
+    bool leave(uint32_t player)
+    {
+        LobbyRequest entry;
+        entry.action = LobbyRequest::Action::Leave;
+        entry.player = player;
+        return submit(std::move(entry));
+    }
+
+    /**
+     * @brief 会话挂起：保留座位，标记为离线
+     */
+    bool disconnect(uint32_t player)
+    {
+        LobbyRequest entry;
+        entry.action = LobbyRequest::Action::Disconnect;
+        entry.player = player;
+        return submit(std::move(entry));
+    }
+
+    /**
+     * @brief 会话恢复：回复所在房间与座位，已开局的房间补发局面
+     */
+    bool resume(uint32_t player)
+    {
+        LobbyRequest entry;
+        entry.action = LobbyRequest::Action::Resume;
+        entry.player = player;
+        return submit(std::move(entry));
+    }
+
+    /**
+     * @brief 回复房间列表：直接发送当前快照，不进入队列
+     */
+    void sendRoomList(uint32_t player) const
+    {
+        auto snapshot = roomList();
+        send(player, snapshot->frame);
+    }
+
+    [[nodiscard]] std::shared_ptr<const RoomListSnapshot> roomList() const
+    {
+        return m_roomList.load(std::memory_order_acquire);
+    }
+
+    [[nodiscard]] std::shared_ptr<const RoomDirectory> directory() const
+    {
+        return m_directory.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief 等待已提交的请求处理完、已满员的房间完成开局
+     */
+    void flush() { m_tasks.wait(); }
+
+private:
+    bool submit(LobbyRequest&& request)
+    {
+        const uint32_t player = request.player;
+        const uint32_t roomId = request.roomId;
+        const auto action = request.action;
+        if (!m_requests.tryPush(std::move(request)))
+        {
+            if (action == LobbyRequest::Action::Create)
+            {
+                reply(player, CreateRoomResponse::createFailed(static_cast<uint8_t>(LobbyError::Busy)));
+            }
+            else if (action == LobbyRequest::Action::Join)
+            {
+                reply(player, JoinRoomResponse::createFailed(roomId, static_cast<uint8_t>(LobbyError::Busy)));
+            }
+            return false;
+        }
+        // 计数从 0 变 1 的提交者负责启动匹配任务；匹配任务处理完计数内的请求后若仍有剩余则自行续跑
+        if (m_pending.fetch_add(1, std::memory_order_acq_rel) == 0)
+        {
+            m_tasks.run([this] { pump(); });
+        }
+        return true;
+    }
+
+    /**
+     * @brief 匹配任务：处理一批请求，最后发布一次房间列表
+     */
+    void pump()
+    {
+        const std::size_t batch = std::min(m_pending.load(std::memory_order_acquire), LOBBY_PUMP_BATCH);
+        LobbyRequest request;
+        for (std::size_t index = 0; index < batch; ++index)
+        {
+            // 计数在入队之后增加，计数内的请求一定已在队列中；
+            // 队头槽位可能仍在被某个生产者写入，短暂自旋等待其完成
+            while (!m_requests.tryPop(request))
+            {
+                utils::CpuRelax();
+            }
+            switch (request.action)
+            {
+                case LobbyRequest::Action::Join: handleJoin(request); break;
+                case LobbyRequest::Action::Create: handleCreate(request); break;
+                case LobbyRequest::Action::Leave: handleLeave(request.player); break;
+                case LobbyRequest::Action::Disconnect: handlePresence(request.player, false); break;
+                case LobbyRequest::Action::Resume: handlePresence(request.player, true); break;
+            }
+        }
+        if (m_listDirty)
+        {
+            publishRoomList();
+        }
+        if (m_directoryDirty)
+        {
+            publishDirectory();
+        }
+        if (m_pending.fetch_sub(batch, std::memory_order_acq_rel) != batch)
+        {
+            m_tasks.run([this] { pump(); });
+        }
+    }
+
+    void handleJoin(const LobbyRequest& request)
+    {
+        if (m_playerRoom.contains(request.player))
+        {
+            reply(request.player,
+                  JoinRoomResponse::createFailed(request.roomId, static_cast<uint8_t>(LobbyError::AlreadyInRoom)));
+            return;
+        }
+        std::shared_ptr<Room> room;
+        if (request.roomId == 0)
+        {
+            room = quickMatchRoom();
+        }
+        else
+        {
+            auto iter = m_rooms.find(request.roomId);
+            LobbyError error = LobbyError::None;
+            if (iter == m_rooms.end())
+            {
+                error = LobbyError::RoomNotFound;
+            }
+            else if (iter->second->state != RoomState::Waiting)
+            {
+                error = LobbyError::RoomPlaying;
+            }
+            else if (iter->second->password != request.password)
+            {
+                error = LobbyError::WrongPassword;
+            }
+            else if (iter->second->full())
+            {
+                error = LobbyError::RoomFull;
+            }
+            if (error != LobbyError::None)
+            {
+                reply(request.player, JoinRoomResponse::createFailed(request.roomId, static_cast<uint8_t>(error)));
+                return;
+            }
+            room = iter->second;
+        }
+        const uint8_t seat = *room->takeSeat(request.player);
+        m_playerRoom.emplace(request.player, room->id);
+        reply(request.player, JoinRoomResponse::createSuccess(room->id, seat));
+        seatsChanged(*room);
+    }
+
+    void handleCreate(const LobbyRequest& request)
+    {
+        if (m_playerRoom.contains(request.player))
+        {
+            reply(request.player, CreateRoomResponse::createFailed(static_cast<uint8_t>(LobbyError::AlreadyInRoom)));
+            return;
+        }
+        const auto capacity = std::clamp<uint8_t>(request.maxPlayers, 2, ROOM_CAPACITY);
+        auto& room = openRoom(TruncateName(request.name), request.password, capacity);
+        room.takeSeat(request.player);
+        m_playerRoom.emplace(request.player, room.id);
+        reply(request.player, CreateRoomResponse::createSuccess(room.id));
+        seatsChanged(room);
+    }
+
+    void handleLeave(uint32_t player)
+    {
+        auto iter = m_playerRoom.find(player);
+        if (iter == m_playerRoom.end())
+        {
+            return;
+        }
+        auto roomIter = m_rooms.find(iter->second);
+        m_playerRoom.erase(iter);
+        if (roomIter == m_rooms.end())
+        {
+            return;
+        }
+        auto& room = *roomIter->second;
+        const bool playing = room.state == RoomState::Playing;
+        if (auto seat = room.leaveSeat(player))
+        {
+            // 对局中：玩家实体留在座位上按离线处理；等待中：座位可能立即被他人占用，
+            // 清除离线标记与 tick 同在 strand 上，先于新玩家的任何状态变化执行
+            m_tasks.add(1);
+            asio::post(room.strand,
+                       [this, room = roomIter->second, seat = *seat, playing]
+                       {
+                           if (playing)
+                           {
+                               room->seatLeft(seat);
+                           }
+                           else
+                           {
+                               room->offline.reset(seat);
+                           }
+                           m_tasks.done();
+                       });
+        }
+        m_directoryDirty |= playing;
+        if (room.occupied == 0)
+        {
+            // 最后一个玩家离开：回收房间；游戏上下文随最后一个引用（可能仍在 strand 上）一起释放
+            room.state = RoomState::Closed;
+            if (m_fillingRoom == room.id)
+            {
+                m_fillingRoom = 0;
+            }
+            unlist(room.id);
+            m_rooms.erase(roomIter);
+            return;
+        }
+        seatsChanged(room);
+    }
+
+    void handlePresence(uint32_t player, bool online)
+    {
+        auto iter = m_playerRoom.find(player);
+        auto roomIter = iter != m_playerRoom.end() ? m_rooms.find(iter->second) : m_rooms.end();
+        if (roomIter == m_rooms.end())
+        {
+            if (online)
+            {
+                // 不在任何房间：告知客户端回到大厅
+                reply(player, JoinRoomResponse::createFailed(0, static_cast<uint8_t>(LobbyError::RoomNotFound)));
+            }
+            return;
+        }
+        const auto& room = roomIter->second;
+        const auto seat = room->seatOf(player);
+        if (!seat)
+        {
+            // 玩家表与座位不一致（例如同一批请求中已离座），不再处理
+            return;
+        }
+        if (online)
+        {
+            reply(player, JoinRoomResponse::createSuccess(room->id, *seat));
+        }
+        // 离线标记属于房间状态，与 tick、开局任务一样只在房间 strand 上修改；
+        // 补发局面同在 strand 上，此时开局任务已执行，上下文必然已创建
+        const bool resumed = online && room->state == RoomState::Playing && m_callbacks.playerResumed;
+        m_tasks.add(1);
+        asio::post(room->strand,
+                   [this, room, seat = *seat, online, resumed]
+                   {
+                       room->offline.set(seat, !online);
+                       if (resumed)
+                       {
+                           m_callbacks.playerResumed(room, seat);
+                       }
+                       m_tasks.done();
+                   });
+    }
+
+    /**
+     * @brief 快速匹配：优先填满当前正在凑人的房间，满了再开新房间
+     */
+    std::shared_ptr<Room> quickMatchRoom()
+    {
+        if (m_fillingRoom != 0)
+        {
+            auto iter = m_rooms.find(m_fillingRoom);
+            if (iter != m_rooms.end() && iter->second->state == RoomState::Waiting && !iter->second->full())
+            {
+                return iter->second;
+            }
+        }
+        auto& room = openRoom({}, {}, ROOM_CAPACITY);
+        room.quickMatch = true;
+        m_fillingRoom = room.id;
+        return m_rooms.at(room.id);
+    }
+
+    Room& openRoom(std::string name, std::string password, uint8_t capacity)
+    {
+        const uint32_t id = m_nextRoomId++;
+        if (name.empty())
+        {
+            name = "房间 " + std::to_string(id);
+        }
+        auto room = std::make_shared<Room>(id, std::move(name), std::move(password), capacity, m_scheduler);
+        return *m_rooms.emplace(id, std::move(room)).first->second;
+    }
+
+    /**
+     * @brief 人数变化：满员则开局并移出列表，否则更新列表中的人数
+     */
+    void seatsChanged(Room& room)
+    {
+        if (room.state != RoomState::Waiting)
+        {
+            return;
+        }
+        if (room.full())
+        {
+            room.state = RoomState::Playing;
+            if (m_fillingRoom == room.id)
+            {
+                m_fillingRoom = 0;
+            }
+            startRoom(m_rooms.at(room.id));
+            unlist(room.id);
+            m_directoryDirty = true;
+            return;
+        }
+        auto [iter, inserted] = m_listIndex.try_emplace(room.id, m_listing.rooms.size());
+        if (inserted)
+        {
+            m_listing.rooms.push_back(RoomListResponse::RoomInfo{.roomId = room.id,
+                                                                 .name = room.name,
+                                                                 .maxPlayers = room.capacity,
+                                                                 .hasPassword = !room.password.empty()});
+        }
+        m_listing.rooms[iter->second].players = room.occupied;
+        m_listDirty = true;
+    }
+
+    void unlist(uint32_t roomId)
+    {
+        auto iter = m_listIndex.find(roomId);
+        if (iter == m_listIndex.end())
+        {
+            return;
+        }
+        const std::size_t index = iter->second;
+        m_listIndex.erase(iter);
+        if (index + 1 != m_listing.rooms.size())
+        {
+            m_listing.rooms[index] = std::move(m_listing.rooms.back());
+            m_listIndex[m_listing.rooms[index].roomId] = index;
+        }
+        m_listing.rooms.pop_back();
+        m_listDirty = true;
+    }
+
+    /**
+     * @brief 在房间的 strand 上创建游戏上下文并通知上层
+     *
+     * 座位表在投递时复制，开局任务不读取匹配任务之后可能修改的 seats
+     */
+    void startRoom(const std::shared_ptr<Room>& room)
+    {
+        m_tasks.add(1);
+        asio::post(room->strand,
+                   [this, room, seats = room->seats]
+                   {
+                       room->start(seats);
+                       if (m_callbacks.roomStarted)
+                       {
+                           m_callbacks.roomStarted(room);
+                       }
+                       m_tasks.done();
+                   });
+    }
+
+    void publishRoomList()
+    {
+        auto snapshot = std::make_shared<RoomListSnapshot>();
+        snapshot->version = ++m_listVersion;
+        snapshot->roomCount = m_listing.rooms.size();
+        if (m_listing.rooms.size() <= ROOM_LIST_LIMIT)
+        {
+            snapshot->frame = *encodeSharedMessage(m_listing);
+        }
+        else
+        {
+            RoomListResponse head;
+            head.rooms.assign(m_listing.rooms.begin(), m_listing.rooms.begin() + ROOM_LIST_LIMIT);
+            snapshot->frame = *encodeSharedMessage(head);
+        }
+        m_roomList.store(std::move(snapshot), std::memory_order_release);
+        m_listDirty = false;
+    }
+
+    void publishDirectory()
+    {
+        auto snapshot = std::make_shared<RoomDirectory>();
+        snapshot->version = ++m_directoryVersion;
+        for (const auto& [id, room] : m_rooms)
+        {
+            if (room->state != RoomState::Playing)
+            {
+                continue;
+            }
+            snapshot->rooms.push_back(room);
+            for (uint8_t seat = 0; seat < room->capacity; ++seat)
+            {
+                if (room->seats[seat] != EMPTY_SEAT)
+                {
+                    snapshot->players.emplace(room->seats[seat], room);
+                }
+            }
+        }
+        m_directory.store(std::move(snapshot), std::memory_order_release);
+        m_directoryDirty = false;
+    }
+
+    template <typename Response>
+    void reply(uint32_t player, const Response& response) const
+    {
+        if (auto frame = encodeSharedMessage(response))
+        {
+            send(player, *frame);
+        }
+    }
+
+    void send(uint32_t player, const SharedFrame& frame) const
+    {
+        if (m_callbacks.send)
+        {
+            m_callbacks.send(player, frame);
+        }
+    }
+
+    /**
+     * @brief 截断房间名，截断点回退到 UTF-8 字符边界
+     */
+    static std::string TruncateName(std::string_view name)
+    {
+        std::size_t size = std::min(name.size(), ROOM_NAME_LIMIT);
+        if (size < name.size())
+        {
+            while (size > 0 && (static_cast<unsigned char>(name[size]) & 0xC0U) == 0x80U)
+            {
+                --size;
+            }
+        }
+        return std::string(name.substr(0, size));
+    }
+
+    LobbyCallbacks m_callbacks;
+    utils::TaskScheduler& m_scheduler;
+
+    utils::MpmcQueue<LobbyRequest> m_requests;
+    std::atomic<std::size_t> m_pending{0}; // 已入队未处理的请求数
+
+    // 以下成员只由匹配任务访问
+    absl::flat_hash_map<uint32_t, std::shared_ptr<Room>> m_rooms;
+    absl::flat_hash_map<uint32_t, uint32_t> m_playerRoom; // 玩家 -> 房间
+    uint32_t m_nextRoomId = 1;
+    uint32_t m_fillingRoom = 0;                             // 快速匹配正在凑人的房间
+    RoomListResponse m_listing;                             // 等待中的房间，增量维护
+    absl::flat_hash_map<uint32_t, std::size_t> m_listIndex; // 房间 -> m_listing 下标
+    uint64_t m_listVersion = 0;
+    bool m_listDirty = false;
+    uint64_t m_directoryVersion = 0;
+    bool m_directoryDirty = false;
+
+    std::atomic<std::shared_ptr<const RoomListSnapshot>> m_roomList;
+    std::atomic<std::shared_ptr<const RoomDirectory>> m_directory;
+
+    utils::TaskGroup m_tasks; // 匹配任务与开局任务；最后声明，析构时先等待它们结束
+};
+} // namespace lobby
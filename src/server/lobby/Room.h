@@ -0,0 +1,332 @@
+/**
+ * ************************************************************************
+ *
+ * @file Room.h
+ * @author AnakinLiu (azrael2759@qq.com)
+ * @date 2026-10-16
+ * @version 0.1
+ * @brief 大厅中的房间
+    - 座位表 (seats/occupied) 与状态只由大厅的匹配任务读写（同一时刻只有一个匹配任务在运行）
+    - 开局任务带着座位表的副本进入 strand，对局中的座位 (lineup) 与离线标记只在房间 strand 上读写；
+      之后的离座、断线与恢复都由匹配任务投递到 strand 上生效
+    - 开局后游戏上下文只在房间自己的 strand 上访问，不同房间分散到共享调度器的各个工作线程
+    - 开局时由 SystemManager 创建并注册房间的系统，按座位创建玩家实体（武将取自共享定义表）并发出 GameStart
+    - 每个 tick：收包阶段在 tick 线程写入 inbox，系统阶段在 strand 上取走并驱动事件、推进阶段状态机，
+      最后结算本 tick 缓冲的效果；两个阶段之间有 fork-join，inbox 无需加锁
+    - 系统产生的 SendNetworkPacket 进入 outbox，复制阶段在 tick 线程统一取走；
+      补发局面等回调也会在 strand 上写 outbox，因此 outbox 用自旋锁保护
+    - 房间内的容器（组件、事件载荷）显式取注册表的分配器，从本房间的内存分配
+ *
+ * ************************************************************************
+ * @copyright Copyright (c) 2026 AnakinLiu
+ * For study and research only, no reprinting.
+ * ************************************************************************
+ */
+
+#pragma once
+#include <array>
+#include <bitset>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+#include <asio/strand.hpp>
+#include "src/server/components/Card.h"
+#include "src/server/components/Character.h"
+#include "src/server/components/GameData.h"
+#include "src/server/components/Player.h"
+#include "src/server/context/GameContext.h"
+#include "src/server/events/Events.h"
+#include "src/server/events/GameFlowEvents.h"
+#include "src/server/events/NetWorkEvents.h"
+#include "src/server/systems/DamageSystem.h"
+#include "src/server/systems/DeckSystem.h"
+#include "src/server/systems/GameFlowSystem.h"
+#include "src/server/systems/NetworkMessageSystem.h"
+#include "src/server/systems/SkillSystem.h"
+#include "src/server/systems/SystemManager.h"
+#include "src/shared/messages/MessageDispatcher.h"
+#include "src/shared/messages/response/RoomSnapshotResponse.h"
+#include "src/utils/TaskScheduler.h"
+
+namespace lobby
+{
+constexpr uint8_t ROOM_CAPACITY = 8; // 最大座位数
+constexpr uint32_t EMPTY_SEAT = 0;   // 座位上的玩家 ID（会话 conv）为 0 表示空座
+
+enum class RoomState : uint8_t
+{
+    Waiting, // 等待玩家
+    Playing, // 已开局
+    Closed   // 所有玩家离开，等待回收
+};
+
+struct Room
+{
+    using Strand = asio::strand<utils::TaskScheduler::Executor>;
+
+    Room(uint32_t id, std::string name, std::string password, uint8_t capacity, utils::TaskScheduler& scheduler)
+        : id(id), name(std::move(name)), password(std::move(password)), capacity(capacity),
+          strand(asio::make_strand(scheduler.executor()))
+    {
+    }
+
+    const uint32_t id;
+    const std::string name;
+    const std::string password;
+    const uint8_t capacity;
+    bool quickMatch = false; // 由快速匹配创建，满员即开局
+    RoomState state = RoomState::Waiting;
+    std::array<uint32_t, ROOM_CAPACITY> seats{}; // 大厅的座位表（仅匹配任务访问）
+    uint8_t occupied = 0;
+
+    std::array<uint32_t, ROOM_CAPACITY> lineup{}; // 开局时的座位表副本，对局中的座位（仅在 strand 上访问）
+    std::bitset<ROOM_CAPACITY> offline; // 会话挂起或已离开的座位，玩家实体与手牌保留（仅在 strand 上访问）
+
+    Strand strand;
+    std::unique_ptr<GameContext> context;  // 开局时在 strand 上创建
+    std::unique_ptr<SystemManager> systems; // 房间的系统，声明在 context 之后，先于其注销并析构
+    GameFlowSystem* flow = nullptr;         // 由 systems 持有，房间 tick 驱动其阶段状态机
+    std::array<entt::entity, ROOM_CAPACITY> players{}; // 座位 -> 玩家实体，开局时创建
+
+    std::vector<events::NetworkMessageReceived> inbox; // 本 tick 收到、尚未处理的消息
+
+    [[nodiscard]] bool full() const { return occupied >= capacity; }
+
+    /**
+     * @brief 开局：创建游戏上下文与系统，按座位创建玩家并发出 GameStart；系统发出的帧进入 outbox（在 strand 上调用）
+     * @param seatsAtStart 匹配任务在满员时复制的座位表
+     */
+    void start(const std::array<uint32_t, ROOM_CAPACITY>& seatsAtStart)
+    {
+        lineup = seatsAtStart;
+        context = std::make_unique<GameContext>();
+        context->dispatcher.sink<events::SendNetworkPacket>().connect<&Room::queueSend>(*this);
+        context->registry.ctx().emplace<GameData>();
+
+        systems = std::make_unique<SystemManager>(*context);
+        systems->emplace<NetworkMessageSystem>();
+        systems->emplace<DeckSystem>();
+        systems->emplace<DamageSystem>();
+        systems->emplace<SkillSystem>();
+        flow = &systems->emplace<GameFlowSystem>();
+        systems->registryAll();
+
+        // 第一个阶段在下一次 tick 中执行
+        events::GameStart gameStart;
+        for (uint8_t seat = 0; seat < capacity; ++seat)
+        {
+            players[seat] = createPlayer(lineup[seat]);
+            gameStart.players.push_back(players[seat]);
+        }
+        context->dispatcher.trigger(gameStart);
+    }
+
+    /**
+     * @brief 系统阶段：把 inbox 中的消息交给系统，处理本 tick 入队的事件，推进阶段状态机，
+     *        最后结算本 tick 中不属于任何阶段的效果（在 strand 上调用）
+     * @param deltaMs 距上次 tick 的时间（毫秒）
+     */
+    void tick(uint32_t deltaMs)
+    {
+        if (!context)
+        {
+            inbox.clear();
+            return;
+        }
+        PMK_DISPATCH_TICK_BEGIN(context->dispatcher);
+        for (auto& message : inbox)
+        {
+            context->dispatcher.trigger(std::move(message));
+        }
+        inbox.clear();
+        context->dispatcher.update();
+        flow->tick(deltaMs);
+        context->dispatcher.trigger(events::SettleEffects{});
+        PMK_DISPATCH_TICK_END(context->dispatcher);
+    }
+
+    /**
+     * @brief 距上次 tick 的毫秒数，首次调用为 0（在 strand 上调用）
+     * @note 空闲房间的 tick 在过载时可能被延后，按实际间隔推进响应计时
+     */
+    uint32_t elapsedSince(uint64_t nowMs)
+    {
+        const uint64_t last = std::exchange(m_lastTickMs, nowMs);
+        return last == 0 ? 0 : static_cast<uint32_t>(nowMs - last);
+    }
+
+    void queueSend(const events::SendNetworkPacket& packet)
+    {
+        std::lock_guard lock(m_outboxLock);
+        m_outbox.push_back(packet);
+    }
+
+    /**
+     * @brief 向座位补发当前局面（断线恢复后调用，在 strand 上调用）
+     *
+     * 快照进入 outbox，与系统产生的帧一起在复制阶段发出；只包含该座位自己的手牌
+     */
+    void sendSnapshot(uint8_t seat)
+    {
+        if (!context || seat >= capacity || lineup[seat] == EMPTY_SEAT)
+        {
+            return;
+        }
+        const auto& registry = context->registry;
+        const auto& gameData = registry.ctx().get<GameData>();
+        RoomSnapshotResponse snapshot;
+        snapshot.roomId = id;
+        snapshot.seat = seat;
+        snapshot.phase = static_cast<uint8_t>(gameData.currentPhase);
+        snapshot.round = gameData.round;
+        snapshot.responseTime = gameData.responseTime;
+        snapshot.seats.reserve(capacity);
+        for (uint8_t index = 0; index < capacity; ++index)
+        {
+            const entt::entity player = players[index];
+            if (player == gameData.currentPlayer)
+            {
+                snapshot.currentSeat = index;
+            }
+            const auto& combat = registry.get<CombatState>(player);
+            snapshot.seats.push_back(
+                RoomSnapshotResponse::SeatInfo{.playerId = lineup[index],
+                                               .health = combat.currentHealth,
+                                               .maxHealth = combat.maxHealth,
+                                               .handCount = static_cast<uint8_t>(
+                                                   registry.get<HandCards>(player).handCards.size()),
+                                               .offline = offline.test(index)});
+        }
+        for (entt::entity card : registry.get<HandCards>(players[seat]).handCards)
+        {
+            RoomSnapshotResponse::CardInfo info{.cardId = entt::to_integral(card)};
+            if (const auto* meta = registry.try_get<MetaCardInfo>(card))
+            {
+                info.name = meta->name;
+            }
+            if (const auto* face = registry.try_get<CardPointAndSuit>(card))
+            {
+                info.point = face->point;
+                info.suit = static_cast<uint8_t>(face->suit);
+            }
+            snapshot.hand.push_back(std::move(info));
+        }
+        if (auto frame = encodeSharedMessage(snapshot))
+        {
+            queueSend(events::SendNetworkPacket{.connectionId = lineup[seat], .frame = std::move(*frame)});
+        }
+    }
+
+    /**
+     * @brief 玩家在对局中离开房间（在 strand 上调用）
+     *
+     * 座位上的玩家实体留在对局中、按离线处理，回合照常轮转；离开的玩家不再经大厅路由，也不会恢复该座位
+     */
+    void seatLeft(uint8_t seat) { offline.set(seat); }
+
+    /**
+     * @brief 复制阶段：取走待发送的帧，追加到 out
+     */
+    void drainOutbox(std::vector<events::SendNetworkPacket>& out)
+    {
+        std::lock_guard lock(m_outboxLock);
+        out.insert(out.end(), std::make_move_iterator(m_outbox.begin()), std::make_move_iterator(m_outbox.end()));
+        m_outbox.clear();
+    }
+
+    /**
+     * @brief 占用第一个空座（匹配任务调用）
+     * @return 座位号，满员时返回空
+     */
+    std::optional<uint8_t> takeSeat(uint32_t player)
+    {
+        for (uint8_t seat = 0; seat < capacity; ++seat)
+        {
+            if (seats[seat] == EMPTY_SEAT)
+            {
+                seats[seat] = player;
+                ++occupied;
+                return seat;
+            }
+        }
+        return std::nullopt;
+    }
+
+    [[nodiscard]] std::optional<uint8_t> seatOf(uint32_t player) const
+    {
+        for (uint8_t seat = 0; seat < capacity; ++seat)
+        {
+            if (seats[seat] == player)
+            {
+                return seat;
+            }
+        }
+        return std::nullopt;
+    }
+
+    /**
+     * @brief 让出大厅中的座位（匹配任务调用）；对局中的座位由调用方经 strand 通知 seatLeft
+     * @return 让出的座位号，玩家不在房间内时返回空
+     */
+    std::optional<uint8_t> leaveSeat(uint32_t player)
+    {
+        auto seat = seatOf(player);
+        if (!seat)
+        {
+            return std::nullopt;
+        }
+        seats[*seat] = EMPTY_SEAT;
+        --occupied;
+        return seat;
+    }
+
+private:
+    /**
+     * @brief 座位上的玩家实体：玩家 ID 为会话 conv，体力与属性供伤害结算使用
+     */
+    entt::entity createPlayer(uint32_t playerId)
+    {
+        auto& registry = context->registry;
+        MetaPlayerInfo meta{.playerName = "玩家 " + std::to_string(playerId), .playerID = playerId};
+        CharacterInfo character;
+        HandCards hand{HandCards::Zone(registry.get_allocator())};
+        Equipments equipments;
+        LiveStatus live;
+        const data::CharacterDef* definition = pickCharacter(playerId);
+        if (definition != nullptr)
+        {
+            character.characterCard = CreateCharacterFromDefinition(registry, *context->definitions, *definition);
+        }
+        auto player = CreatePlayer(registry, meta, character, hand, equipments, live);
+        auto& combat = registry.emplace<CombatState>(player);
+        if (definition != nullptr)
+        {
+            combat.maxHealth = definition->maxHealth;
+            combat.currentHealth = definition->maxHealth;
+        }
+        registry.emplace<Attributes>(player);
+        return player;
+    }
+
+    /**
+     * @brief 按玩家 ID 在定义表中轮流分配武将；没有定义表或表中没有武将时返回空指针，玩家不带武将卡
+     */
+    [[nodiscard]] const data::CharacterDef* pickCharacter(uint32_t playerId) const
+    {
+        if (!context->definitions)
+        {
+            return nullptr;
+        }
+        const auto characters = context->definitions->characters();
+        return characters.empty() ? nullptr : &characters[playerId % characters.size()];
+    }
+
+    utils::SpinLock m_outboxLock;
+    std::vector<events::SendNetworkPacket> m_outbox;
+    uint64_t m_lastTickMs = 0; // 仅在 strand 上访问
+};
+} // namespace lobby
@@ -0,0 +1,251 @@
+/**
+ * ************************************************************************
+ *
+ * @file ServerLoop.h
+ * @author AnakinLiu (azrael2759@qq.com)
+ * @date 2026-10-16
+ * @version 0.1
+ * @brief 服务器主循环：把网络、大厅与房间挂到 TickLoop 的各个阶段
+    - 收包：在 tick 线程上执行传输层回调（UDP -> KCP），再执行会话的接收回调；
+      大厅请求交给 Lobby，其余消息按房间目录快照放入所在房间的 inbox。过载时每 tick 最多处理
+      INGRESS_OVERLOAD_BUDGET 个 UDP 包，其余留在 socket 缓冲区中延后到下一个 tick
+    - 系统：有消息的房间每个 tick 都在各自的 strand 上执行（关键）；没有消息的房间只处理定时与排队事件，
+      过载时降频执行（可延后）
+    - 复制：大厅回复与房间 outbox 中的帧交给对应会话
+    - 发包：驱动 KCP 刷新、重传与会话超时
+ *
+ * ************************************************************************
+ * @copyright Copyright (c) 2026 AnakinLiu
+ * For study and research only, no reprinting.
+ * ************************************************************************
+ */
+
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include <asio/io_context.hpp>
+#include <asio/post.hpp>
+#include <spdlog/spdlog.h>
+#include "TickLoop.h"
+#include "src/net/App/Server.h"
+#include "src/server/context/CreateLogger.h"
+#include "src/server/events/NetWorkEvents.h"
+#include "src/server/lobby/Lobby.h"
+#include "src/shared/messages/request/CreateRoomRequest.h"
+#include "src/shared/messages/request/JoinRoomRequest.h"
+#include "src/utils/MpmcQueue.h"
+#include "src/utils/TaskScheduler.h"
+
+namespace loop
+{
+constexpr std::size_t OUTBOUND_QUEUE_CAPACITY = 65536; // 大厅待发送帧上限，超出时丢弃并计数
+constexpr std::size_t INGRESS_OVERLOAD_BUDGET = 256;   // 过载时单个 tick 最多处理的 UDP 包
+
+class ServerLoop
+{
+public:
+    /**
+     * @param io 传输层所在的 io_context，只由 tick 线程驱动
+     */
+    ServerLoop(asio::io_context& io,
+               Server& server,
+               TickConfig config = {},
+               utils::TaskScheduler& scheduler = utils::TaskScheduler::global())
+        : m_io(io), m_server(server), m_outbound(OUTBOUND_QUEUE_CAPACITY), m_loop(config),
+          m_lobby(makeLobbyCallbacks(), scheduler), m_roomTasks(scheduler)
+    {
+        m_directory = m_lobby.directory();
+        m_server.setSessionHandlers(
+            {.opened = {},
+             .detached = [this](uint32_t conv) { m_lobby.disconnect(conv); },
+             .resumed = [this](uint32_t conv, const std::shared_ptr<KcpSession>&) { m_lobby.resume(conv); },
+             .closed = [this](uint32_t conv) { m_lobby.leave(conv); },
+             .received = [this](uint32_t conv, KcpSession::Packet packet) { route(conv, std::move(packet)); }});
+
+        m_loop.addTask(TickStage::NetIngress, "net.ingress", TickPriority::Critical,
+                       [this](const TickContext& context) { ingress(context); });
+        m_loop.addTask(TickStage::GameSystems, "rooms.active", TickPriority::Critical,
+                       [this](const TickContext& context) { tickActiveRooms(context); });
+        m_loop.addTask(TickStage::GameSystems, "rooms.idle", TickPriority::Deferrable,
+                       [this](const TickContext& context) { tickRooms(m_idleRooms, context); });
+        m_loop.addTask(TickStage::Replication, "replication", TickPriority::Critical,
+                       [this](const TickContext&) { replicate(); });
+        m_loop.addTask(TickStage::NetEgress, "net.egress", TickPriority::Critical,
+                       [this](const TickContext& context) { egress(context); });
+        m_loop.setReporter(
+            [this](const TickReport& report)
+            {
+                const uint64_t dropped = m_droppedFrames.load(std::memory_order_relaxed);
+                m_logger->info("{} | dropped frames={}", report.format(), dropped);
+            });
+    }
+
+    ~ServerLoop() { m_server.setSessionHandlers({}); }
+
+    ServerLoop(const ServerLoop&) = delete;
+    ServerLoop& operator=(const ServerLoop&) = delete;
+
+    /**
+     * @brief 以固定频率运行，直到 running 变为 false
+     */
+    void run(const std::atomic<bool>& running) { m_loop.run(running); }
+
+    [[nodiscard]] TickLoop& tickLoop() { return m_loop; }
+    [[nodiscard]] lobby::Lobby& lobby() { return m_lobby; }
+    [[nodiscard]] const std::shared_ptr<spdlog::logger>& logger() const { return m_logger; }
+
+private:
+    lobby::LobbyCallbacks makeLobbyCallbacks()
+    {
+        return {.send =
+                    [this](uint32_t player, const SharedFrame& frame)
+                {
+                    if (!m_outbound.tryPush(events::SendNetworkPacket{.connectionId = player, .frame = frame}))
+                    {
+                        m_droppedFrames.fetch_add(1, std::memory_order_relaxed);
+                    }
+                },
+                .roomStarted =
+                    [](const std::shared_ptr<lobby::Room>& room)
+                {
+                    // 房间的系统已在 Room::start 中创建并注册
+                    room->context->logger->info("房间 {} 开局，{} 名玩家", room->id, room->occupied);
+                },
+                .playerResumed =
+                    [](const std::shared_ptr<lobby::Room>& room, uint8_t seat)
+                {
+                    // 已在房间 strand 上：快照进入 outbox，由复制阶段发给重连的座位
+                    room->sendSnapshot(seat);
+                }};
+    }
+
+    void ingress(const TickContext& context)
+    {
+        m_directory = m_lobby.directory();
+        // 每个就绪的处理器对应一个 UDP 包：input() 送入 KCP，完整的包在下面的 poll() 中回调 route()
+        const std::size_t budget = context.overloaded ? INGRESS_OVERLOAD_BUDGET : SIZE_MAX;
+        for (std::size_t handled = 0; handled < budget && !context.expired(); ++handled)
+        {
+            if (m_io.poll_one() == 0)
+            {
+                break;
+            }
+        }
+        m_server.poll();
+    }
+
+    /**
+     * @brief 大厅请求交给 Lobby，其余消息进入玩家所在房间的 inbox
+     */
+    void route(uint32_t conv, KcpSession::Packet packet)
+    {
+        auto frame = decodeFrame(packet);
+        if (!frame)
+        {
+            return;
+        }
+        switch (frame->cmd)
+        {
+            case CommandID::JOIN_ROOM:
+                if (auto request = JoinRoomRequest::deserialize(frame->payload))
+                {
+                    m_lobby.join(conv, *request);
+                }
+                return;
+            case CommandID::CREATE_ROOM_REQ:
+                if (auto request = CreateRoomRequest::deserialize(frame->payload))
+                {
+                    m_lobby.create(conv, *request);
+                }
+                return;
+            case CommandID::LEAVE_ROOM: m_lobby.leave(conv); return;
+            case CommandID::ROOM_LIST: m_lobby.sendRoomList(conv); return;
+            default: break;
+        }
+        auto iter = m_directory->players.find(conv);
+        if (iter != m_directory->players.end())
+        {
+            iter->second->inbox.push_back(
+                events::NetworkMessageReceived{.payload = std::move(packet), .connectionId = conv});
+        }
+    }
+
+    /**
+     * @brief 按本 tick 是否收到消息划分房间，先执行有消息的房间；没有消息的房间由 rooms.idle 任务执行
+     */
+    void tickActiveRooms(const TickContext& context)
+    {
+        m_activeRooms.clear();
+        m_idleRooms.clear();
+        for (const auto& room : m_directory->rooms)
+        {
+            (room->inbox.empty() ? m_idleRooms : m_activeRooms).push_back(room.get());
+        }
+        tickRooms(m_activeRooms, context);
+    }
+
+    /**
+     * @brief 在各房间的 strand 上执行 tick 并等待全部完成
+     */
+    void tickRooms(const std::vector<lobby::Room*>& rooms, const TickContext& context)
+    {
+        const auto nowMs = static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::milliseconds>(context.start.time_since_epoch()).count());
+        m_roomTasks.add(rooms.size());
+        for (auto* room : rooms)
+        {
+            asio::post(room->strand,
+                       [this, room, nowMs]
+                       {
+                           room->tick(room->elapsedSince(nowMs));
+                           m_roomTasks.done();
+                       });
+        }
+        m_roomTasks.wait();
+    }
+
+    void replicate()
+    {
+        m_replicating.clear();
+        events::SendNetworkPacket packet;
+        while (m_outbound.tryPop(packet))
+        {
+            m_replicating.push_back(std::move(packet));
+        }
+        for (const auto& room : m_directory->rooms)
+        {
+            room->drainOutbox(m_replicating);
+        }
+        for (const auto& outgoing : m_replicating)
+        {
+            m_server.send(outgoing.connectionId, outgoing.frame);
+        }
+    }
+
+    void egress(const TickContext& context)
+    {
+        const auto nowMs = std::chrono::duration_cast<std::chrono::milliseconds>(context.start.time_since_epoch());
+        m_server.update(static_cast<uint32_t>(nowMs.count()));
+    }
+
+    asio::io_context& m_io;
+    Server& m_server;
+    std::shared_ptr<spdlog::logger> m_logger = CreateRollingLogger(); // 与房间共用的异步日志器，报告不阻塞 tick 线程
+    utils::MpmcQueue<events::SendNetworkPacket> m_outbound; // 大厅回复，任意工作线程写入，复制阶段取走
+    std::atomic<uint64_t> m_droppedFrames{0};
+    TickLoop m_loop;
+
+    // 以下成员只在 tick 线程访问
+    std::shared_ptr<const lobby::RoomDirectory> m_directory; // 本 tick 使用的房间目录
+    std::vector<lobby::Room*> m_activeRooms; // 由 m_directory 持有
+    std::vector<lobby::Room*> m_idleRooms;
+    std::vector<events::SendNetworkPacket> m_replicating;
+
+    lobby::Lobby m_lobby;         // 回调写入 m_outbound，须在其后声明、先于其析构
+    utils::TaskGroup m_roomTasks; // 最后声明，析构时先等待房间任务结束
+};
+} // namespace loop
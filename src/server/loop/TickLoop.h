@@ -0,0 +1,323 @@
+/**
+ * ************************************************************************
+ *
+ * @file TickLoop.h
+ * @author AnakinLiu (azrael2759@qq.com)
+ * @date 2026-10-16
+ * @version 0.1
+ * @brief 服务器主循环：固定频率 tick 调度
+    - 每个 tick 依次执行四个阶段：网络收包、游戏系统、状态复制、网络发包
+    - 各阶段耗时与整 tick 耗时写入滚动窗口，定期输出 p50/p99
+    - tick 超出周期即进入过载状态：可延后的任务降频执行（至少每 maxDeferTicks 个 tick 执行一次），
+      连续 overloadCooldown 个 tick 未超时后恢复；没有可整体丢弃的任务（空闲房间也带着响应计时），
+      收包阶段自行按预算把多余的包留到下一个 tick
+    - 落后超过 maxCatchUpTicks 个周期时放弃追赶，按当前时间重新对齐，避免雪崩
+    tick 循环只在一个线程上运行，统计数据不加锁
+ *
+ * ************************************************************************
+ * @copyright Copyright (c) 2026 AnakinLiu
+ * For study and research only, no reprinting.
+ * ************************************************************************
+ */
+
+#pragma once
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+#include <spdlog/fmt/fmt.h>
+
+namespace loop
+{
+using TickClock = std::chrono::steady_clock;
+
+enum class TickStage : uint8_t
+{
+    NetIngress,  // 收包、解码、投递到大厅/房间
+    GameSystems, // 各房间执行系统与事件
+    Replication, // 房间产生的帧投递到会话
+    NetEgress    // 驱动 KCP，写出 UDP
+};
+constexpr std::size_t TICK_STAGE_COUNT = 4;
+constexpr std::array<std::string_view, TICK_STAGE_COUNT> TICK_STAGE_NAMES{
+    "ingress", "systems", "replication", "egress"};
+
+enum class TickPriority : uint8_t
+{
+    Critical,  // 每个 tick 都执行
+    Deferrable // 过载时降频执行
+};
+
+constexpr std::size_t TICK_SAMPLE_WINDOW = 512; // 滚动统计窗口（tick 数）
+
+struct TickConfig
+{
+    uint32_t tickRate = 30;          // Hz
+    uint32_t maxDeferTicks = 8;      // 过载时可延后任务的最长间隔
+    uint32_t overloadCooldown = 30;  // 连续多少个 tick 未超时后退出过载
+    uint32_t maxCatchUpTicks = 3;    // 落后超过多少个周期时放弃追赶
+    std::chrono::seconds reportInterval{10};
+
+    [[nodiscard]] std::chrono::nanoseconds period() const
+    {
+        return std::chrono::nanoseconds(std::chrono::seconds(1)) / std::max<uint32_t>(tickRate, 1);
+    }
+};
+
+/**
+ * @brief 传给每个任务的 tick 信息；任务可据 deadline 自行限制本 tick 的工作量
+ */
+struct TickContext
+{
+    uint64_t tick = 0;
+    TickClock::time_point start;
+    TickClock::time_point deadline; // 本 tick 的截止时间
+    bool overloaded = false;
+
+    [[nodiscard]] bool expired() const { return TickClock::now() >= deadline; }
+};
+
+/**
+ * @brief 固定窗口的耗时样本（纳秒）
+ */
+class RollingSamples
+{
+public:
+    void push(uint64_t sample)
+    {
+        m_samples[m_next] = sample;
+        m_next = (m_next + 1) % TICK_SAMPLE_WINDOW;
+        m_size = std::min(m_size + 1, TICK_SAMPLE_WINDOW);
+    }
+
+    /**
+     * @param quantile 0~1
+     */
+    [[nodiscard]] uint64_t percentile(double quantile, std::vector<uint64_t>& scratch) const
+    {
+        if (m_size == 0)
+        {
+            return 0;
+        }
+        scratch.assign(m_samples.begin(), m_samples.begin() + static_cast<std::ptrdiff_t>(m_size));
+        const auto index = static_cast<std::size_t>(quantile * static_cast<double>(m_size - 1));
+        std::nth_element(scratch.begin(), scratch.begin() + static_cast<std::ptrdiff_t>(index), scratch.end());
+        return scratch[index];
+    }
+
+    [[nodiscard]] std::size_t size() const { return m_size; }
+
+private:
+    std::array<uint64_t, TICK_SAMPLE_WINDOW> m_samples{};
+    std::size_t m_next = 0;
+    std::size_t m_size = 0;
+};
+
+struct TimingReport
+{
+    double p50Us = 0;
+    double p99Us = 0;
+};
+
+struct TickReport
+{
+    std::array<TimingReport, TICK_STAGE_COUNT> stages;
+    TimingReport total;
+    double budgetUs = 0;    // tick 周期
+    uint64_t ticks = 0;     // 已执行的 tick 数
+    uint64_t overruns = 0;  // 超出周期的 tick 数
+    uint64_t skipped = 0;   // 因落后过多而放弃的 tick 数
+    uint64_t deferred = 0;  // 过载时被延后的任务次数
+    bool overloaded = false;
+
+    [[nodiscard]] std::string format() const
+    {
+        std::string text =
+            fmt::format("tick p50={:.0f}us p99={:.0f}us budget={:.0f}us", total.p50Us, total.p99Us, budgetUs);
+        for (std::size_t stage = 0; stage < TICK_STAGE_COUNT; ++stage)
+        {
+            const auto& timing = stages[stage];
+            text += fmt::format(" | {} {:.0f}/{:.0f}", TICK_STAGE_NAMES[stage], timing.p50Us, timing.p99Us);
+        }
+        text += fmt::format(" | ticks={} overruns={} skipped={} deferred={}{}",
+                            ticks,
+                            overruns,
+                            skipped,
+                            deferred,
+                            overloaded ? " OVERLOADED" : "");
+        return text;
+    }
+};
+
+class TickLoop
+{
+public:
+    using TaskFn = std::function<void(const TickContext&)>;
+
+    explicit TickLoop(TickConfig config = {}) : m_config(config) {}
+
+    /**
+     * @brief 注册任务；同一阶段内按注册顺序执行
+     */
+    void addTask(TickStage stage, std::string name, TickPriority priority, TaskFn task)
+    {
+        m_stages[static_cast<std::size_t>(stage)].push_back(
+            Task{.name = std::move(name), .priority = priority, .run = std::move(task)});
+    }
+
+    /**
+     * @brief 定期报告（在 tick 之间、计时之外调用）
+     */
+    void setReporter(std::function<void(const TickReport&)> reporter) { m_reporter = std::move(reporter); }
+
+    /**
+     * @brief 以固定频率运行，直到 running 变为 false
+     */
+    void run(const std::atomic<bool>& running)
+    {
+        const auto period = m_config.period();
+        auto next = TickClock::now();
+        auto nextReport = next + m_config.reportInterval;
+        while (running.load(std::memory_order_acquire))
+        {
+            std::this_thread::sleep_until(next);
+            tickOnce(next, next + period);
+            next += period;
+
+            const auto now = TickClock::now();
+            if (now - next > period * m_config.maxCatchUpTicks)
+            {
+                // 落后太多：丢弃积压的 tick，从现在重新对齐
+                m_skipped += static_cast<uint64_t>((now - next) / period);
+                next = now;
+            }
+            if (m_reporter && now >= nextReport)
+            {
+                m_reporter(report());
+                nextReport = now + m_config.reportInterval;
+            }
+        }
+    }
+
+    /**
+     * @brief 执行一个 tick（run() 内部使用，也可由测试/基准直接驱动）
+     */
+    void tickOnce(TickClock::time_point start, TickClock::time_point deadline)
+    {
+        const TickContext context{.tick = m_tick, .start = start, .deadline = deadline, .overloaded = overloaded()};
+        const auto tickBegin = TickClock::now();
+        auto stageBegin = tickBegin;
+        for (std::size_t stage = 0; stage < TICK_STAGE_COUNT; ++stage)
+        {
+            for (auto& task : m_stages[stage])
+            {
+                if (shouldRun(task, context))
+                {
+                    task.run(context);
+                }
+            }
+            const auto stageEnd = TickClock::now();
+            m_stageSamples[stage].push(toNs(stageEnd - stageBegin));
+            stageBegin = stageEnd;
+        }
+        const auto elapsed = stageBegin - tickBegin;
+        m_totalSamples.push(toNs(elapsed));
+        if (elapsed > m_config.period())
+        {
+            ++m_overruns;
+            m_overloadTicks = m_config.overloadCooldown;
+        }
+        else if (m_overloadTicks > 0)
+        {
+            --m_overloadTicks;
+        }
+        ++m_tick;
+    }
+
+    void tickOnce()
+    {
+        const auto now = TickClock::now();
+        tickOnce(now, now + m_config.period());
+    }
+
+    [[nodiscard]] bool overloaded() const { return m_overloadTicks > 0; }
+    [[nodiscard]] uint64_t tickCount() const { return m_tick; }
+    [[nodiscard]] const TickConfig& config() const { return m_config; }
+
+    [[nodiscard]] TickReport report() const
+    {
+        TickReport result;
+        for (std::size_t stage = 0; stage < TICK_STAGE_COUNT; ++stage)
+        {
+            result.stages[stage] = timing(m_stageSamples[stage]);
+        }
+        result.total = timing(m_totalSamples);
+        result.budgetUs = static_cast<double>(toNs(m_config.period())) / NS_PER_US;
+        result.ticks = m_tick;
+        result.overruns = m_overruns;
+        result.skipped = m_skipped;
+        result.deferred = m_deferred;
+        result.overloaded = overloaded();
+        return result;
+    }
+
+private:
+    static constexpr double NS_PER_US = 1000.0;
+    static constexpr double P50 = 0.50;
+    static constexpr double P99 = 0.99;
+
+    struct Task
+    {
+        std::string name;
+        TickPriority priority = TickPriority::Critical;
+        TaskFn run;
+        uint64_t lastRun = 0; // 最近一次执行的 tick
+    };
+
+    bool shouldRun(Task& task, const TickContext& context)
+    {
+        if (!context.overloaded || task.priority == TickPriority::Critical)
+        {
+            task.lastRun = context.tick;
+            return true;
+        }
+        if (context.tick - task.lastRun < m_config.maxDeferTicks)
+        {
+            ++m_deferred;
+            return false;
+        }
+        task.lastRun = context.tick;
+        return true;
+    }
+
+    [[nodiscard]] TimingReport timing(const RollingSamples& samples) const
+    {
+        return TimingReport{.p50Us = static_cast<double>(samples.percentile(P50, m_scratch)) / NS_PER_US,
+                            .p99Us = static_cast<double>(samples.percentile(P99, m_scratch)) / NS_PER_US};
+    }
+
+    static uint64_t toNs(TickClock::duration duration)
+    {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count());
+    }
+
+    TickConfig m_config;
+    std::array<std::vector<Task>, TICK_STAGE_COUNT> m_stages;
+    std::array<RollingSamples, TICK_STAGE_COUNT> m_stageSamples;
+    RollingSamples m_totalSamples;
+    mutable std::vector<uint64_t> m_scratch;
+    std::function<void(const TickReport&)> m_reporter;
+    uint64_t m_tick = 0;
+    uint64_t m_overruns = 0;
+    uint64_t m_skipped = 0;
+    uint64_t m_deferred = 0;
+    uint32_t m_overloadTicks = 0;
+};
+} // namespace loop
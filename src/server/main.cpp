@@ -5,7 +5,8 @@
  * @author AnakinLiu (azrael2759@qq.com)
  * @date 2025-12-01
  * @version 0.1
- * @brief 服务器主程序入口 - 心跳包通信测试
+ * @brief 服务器主程序入口
+    用法：PestManKillServer [--port 端口] [--tick-rate 每秒 tick 数]
  *
  * ************************************************************************
  * @copyright Copyright (c) 2025 AnakinLiu
@@ -14,34 +15,98 @@
  */
 
 #include <iostream>
-#include <memory>
-#include <thread>
-#include <chrono>
 #include <csignal>
 #include <atomic>
+#include <charconv>
+#include <cstdint>
+#include <string_view>
 #include <asio.hpp>
 #include <spdlog/spdlog.h>
-#include <spdlog/sinks/stdout_color_sinks.h>
-#include <spdlog/sinks/rotating_file_sink.h>
 
-#include <nlohmann/json.hpp>
-#include <entt/entt.hpp>
-#include <utils.h>
+#include "src/net/App/Server.h"
+#include "src/net/transport/AsioUdpTransport.h"
+#include "src/server/loop/ServerLoop.h"
+
 std::atomic<bool> g_running{true};
 
+namespace
+{
+constexpr uint16_t DEFAULT_PORT = 9527;
+
+struct Options
+{
+    uint16_t port = DEFAULT_PORT;
+    loop::TickConfig tick;
+};
+
+template <typename T>
+bool parseNumber(std::string_view text, T& value)
+{
+    const auto* end = text.data() + text.size();
+    auto [ptr, error] = std::from_chars(text.data(), end, value);
+    return error == std::errc{} && ptr == end;
+}
+
+bool parseOptions(int argc, char** argv, Options& options)
+{
+    for (int index = 1; index + 1 < argc; index += 2)
+    {
+        const std::string_view name = argv[index];
+        const std::string_view value = argv[index + 1];
+        bool parsed = false;
+        if (name == "--port")
+        {
+            parsed = parseNumber(value, options.port);
+        }
+        else if (name == "--tick-rate")
+        {
+            parsed = parseNumber(value, options.tick.tickRate) && options.tick.tickRate > 0;
+        }
+        if (!parsed)
+        {
+            std::cerr << "invalid option: " << name << " " << value << std::endl;
+            return false;
+        }
+    }
+    return argc % 2 == 1;
+}
+} // namespace
+
 void signalHandler(int signal)
 {
     if (signal == SIGINT || signal == SIGTERM)
     {
-        std::cout << "\nReceived stop signal, shutting down server..." << std::endl;
         g_running.store(false);
     }
 }
 
-int main()
+int main(int argc, char** argv)
 {
+    Options options;
+    if (!parseOptions(argc, argv, options))
+    {
+        std::cerr << "usage: " << argv[0] << " [--port PORT] [--tick-rate HZ]" << std::endl;
+        return 1;
+    }
+
     // 注册信号处理
     std::signal(SIGINT, signalHandler);
     std::signal(SIGTERM, signalHandler);
     //    utils::functions::setConsoleToUTF8();
+
+    // 传输层只由 tick 线程驱动（收包阶段 poll），不单独开网络线程
+    asio::io_context io;
+    AsioUdpTransport transport(io.get_executor(), options.port);
+    Server server(transport);
+    loop::ServerLoop serverLoop(io, server, options.tick);
+    transport.startRecvLoop([&server](const NetAddress& from, std::span<const uint8_t> data)
+                            { server.input(from, data); });
+
+    serverLoop.logger()->info("server listening on udp {} at {} Hz", transport.localPort(), options.tick.tickRate);
+    serverLoop.run(g_running);
+
+    serverLoop.logger()->info("shutting down server...");
+    transport.stop();
+    server.stop();
+    return 0;
 }
@@ -0,0 +1,97 @@
+/**
+ * ************************************************************************
+ *
+ * @file CardRules.h
+ * @author AnakinLiu (azrael2759@qq.com)
+ * @date 2026-10-16
+ * @version 0.1
+ * @brief 卡牌使用规则（纯函数）
+    与注册表/事件解耦，与 CombatRules 一样供房间内的系统与模拟器 (simulation::Simulator) 共用：
+    - 回合内的数量规则：摸牌数、出杀次数、手牌上限
+    - 杀、火攻、决斗、桃的结算方式（与 resource/Definitions/cards.json 的描述一致）
+    - 装备牌按子类型进入对应的装备栏
+ *
+ * ************************************************************************
+ * @copyright Copyright (c) 2026 AnakinLiu
+ * For study and research only, no reprinting.
+ * ************************************************************************
+ */
+
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include "src/server/components/Player.h"
+
+namespace rules
+{
+constexpr uint32_t DRAW_PER_TURN = 2; // 摸牌阶段摸牌数
+constexpr int PEACH_HEAL = 1;         // 桃回复的体力
+constexpr int DUEL_DAMAGE = 1;        // 决斗中未出杀一方受到的伤害
+
+/**
+ * @brief 攻击牌的结算方式：目标打出一张闪抵消，否则受到 damage 点伤害
+ */
+struct AttackRule
+{
+    int damage = 1;              // 未被抵消时造成的伤害
+    bool consumesStrike = false; // 是否占用本回合的出杀次数
+};
+
+constexpr AttackRule STRIKE_RULE{.damage = 1, .consumesStrike = true};
+constexpr AttackRule FIRE_ATTACK_RULE{.damage = 1, .consumesStrike = false}; // 火焰伤害，同样可以用闪抵消
+
+/**
+ * @brief 本回合还能否使用攻击牌
+ * @param rule 攻击牌的规则
+ * @param attackTimesLeft 本回合剩余出杀次数 (CombatState::attackTimes)
+ */
+constexpr bool CanAttack(const AttackRule& rule, uint8_t attackTimesLeft) noexcept
+{
+    return !rule.consumesStrike || attackTimesLeft > 0;
+}
+
+/**
+ * @brief 桃只能在体力未满时使用
+ */
+constexpr bool CanUsePeach(int32_t currentHealth, int32_t maxHealth) noexcept
+{
+    return currentHealth < maxHealth;
+}
+
+/**
+ * @brief 结算决斗：由目标开始，双方轮流打出一张杀，先不出的一方受到 DUEL_DAMAGE 点伤害
+ * @param playStrike playStrike(bool targetTurn) 让当前一方打出一张杀，返回是否打出
+ * @return 受到伤害的一方是否为目标
+ */
+template <typename PlayStrike>
+bool ResolveDuel(PlayStrike&& playStrike)
+{
+    bool targetTurn = true;
+    while (playStrike(targetTurn))
+    {
+        targetTurn = !targetTurn;
+    }
+    return targetTurn;
+}
+
+/**
+ * @brief 装备牌进入的装备栏
+ *
+ * EquipCardType 与 EquipSlot 按相同顺序定义（武器/防具/进攻马/防御马），定义表加载时已检查子类型的取值范围
+ */
+constexpr EquipSlot EquipSlotOf(EquipCardType type) noexcept
+{
+    return static_cast<EquipSlot>(std::to_underlying(type));
+}
+
+/**
+ * @brief 弃牌阶段需要弃置的张数：手牌数不得超过当前体力
+ */
+constexpr std::size_t DiscardCount(std::size_t handSize, int32_t currentHealth) noexcept
+{
+    const auto limit = static_cast<std::size_t>(std::max(0, currentHealth));
+    return handSize > limit ? handSize - limit : 0;
+}
+} // namespace rules
@@ -0,0 +1,76 @@
+/**
+ * ************************************************************************
+ *
+ * @file CombatRules.h
+ * @author AnakinLiu (azrael2759@qq.com)
+ * @date 2026-10-16
+ * @version 0.1
+ * @brief 战斗结算规则（纯函数）
+    与注册表/事件解耦的结算逻辑，供 DamageSystem、UseCardSystem
+    以及模拟器 (simulation::Simulator) 共用，保证两边规则一致
+ *
+ * ************************************************************************
+ * @copyright Copyright (c) 2026 AnakinLiu
+ * For study and research only, no reprinting.
+ * ************************************************************************
+ */
+
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+
+namespace rules
+{
+/**
+ * @brief 伤害结算结果
+ */
+struct DamageResult
+{
+    int32_t healthBefore;  // 结算前体力
+    int32_t healthAfter;   // 结算后体力
+    bool enteredNearDeath; // 是否由存活进入濒死
+};
+
+/**
+ * @brief 结算一次伤害
+ * @param currentHealth 当前体力
+ * @param amount 伤害值（负数视为 0）
+ */
+constexpr DamageResult ResolveDamage(int32_t currentHealth, int amount) noexcept
+{
+    amount = std::max(0, amount);
+    int32_t after = currentHealth - amount;
+    return {.healthBefore = currentHealth, .healthAfter = after, .enteredNearDeath = currentHealth > 0 && after <= 0};
+}
+
+/**
+ * @brief 结算一次回复，不超过体力上限
+ * @param currentHealth 当前体力
+ * @param maxHealth 体力上限
+ * @param amount 回复值（负数视为 0）
+ * @return 回复后的体力
+ */
+constexpr int32_t ResolveHeal(int32_t currentHealth, int32_t maxHealth, int amount) noexcept
+{
+    return std::min(maxHealth, currentHealth + std::max(0, amount));
+}
+
+/**
+ * @brief 从区域（手牌/装备等）中移除一张牌，保持其余牌的顺序
+ * @param zone 任意支持 begin/end 与 erase 的容器
+ * @param card 要移除的牌
+ * @return 是否找到并移除
+ */
+template <typename Zone, typename Card>
+bool RemoveCardFromZone(Zone& zone, const Card& card)
+{
+    auto iter = std::find(std::begin(zone), std::end(zone), card);
+    if (iter == std::end(zone))
+    {
+        return false;
+    }
+    zone.erase(iter);
+    return true;
+}
+} // namespace rules
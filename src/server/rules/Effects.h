@@ -0,0 +1,126 @@
+/**
+ * ************************************************************************
+ *
+ * @file Effects.h
+ * @author AnakinLiu (azrael2759@qq.com)
+ * @date 2026-10-16
+ * @version 0.1
+ * @brief 结算步骤中待生效的效果（伤害、失去体力、回复）及作用于整批效果的规则
+    - 一个结算步骤内产生的效果先写入扁平缓冲区，按阶段依次遍历整批：修正 -> 转移 -> 防止，最后一次性提交
+    - 群体效果只是缓冲区中的多条记录，每个阶段对它们做一次线性遍历，不再逐目标触发完整的事件链
+    - 数量被改为 0 的效果视为已取消，提交时跳过
+ *
+ * ************************************************************************
+ * @copyright Copyright (c) 2026 AnakinLiu
+ * For study and research only, no reprinting.
+ * ************************************************************************
+ */
+
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <entt/entity/entity.hpp>
+
+namespace rules
+{
+enum class EffectKind : uint8_t
+{
+    Damage,     // 伤害，可被修正、转移、防止
+    LoseHealth, // 失去体力，不视为伤害
+    Heal        // 回复体力，不超过上限
+};
+
+/**
+ * @brief 效果处理阶段，按枚举顺序执行
+ */
+enum class EffectPhase : uint8_t
+{
+    Modify,   // 修正数值（如酒、裸衣）
+    Redirect, // 转移目标（如天香）
+    Prevent   // 防止或减少（如藤甲、白银狮子）
+};
+constexpr std::size_t EFFECT_PHASE_COUNT = 3;
+
+constexpr uint8_t EFFECT_TAG_AREA = 1U << 0;    // 来自群体效果（南蛮入侵、万箭齐发）
+constexpr uint8_t EFFECT_TAG_CHAINED = 1U << 1; // 由其他效果连带产生（铁索连环）
+
+struct PendingEffect
+{
+    EffectKind kind = EffectKind::Damage;
+    uint8_t tags = 0;
+    int32_t amount = 0;
+    entt::entity source = entt::null; // 来源，可能为空（如闪电）
+    entt::entity target = entt::null;
+};
+
+/**
+ * @brief 转移伤害的结果
+ */
+struct RedirectResult
+{
+    bool matched = false;               // 是否找到匹配的伤害
+    std::optional<PendingEffect> split; // 部分转移时分出的效果，由调用方追加到缓冲区
+};
+
+/**
+ * @brief 把第一条匹配的伤害中的 amount 点转移给新目标
+ *
+ * 伤害不超过 amount 时整条改为新目标；超过时原目标承受剩余部分，转移的部分作为新效果返回（span 无法增长）
+ * @param source 伤害来源，为 entt::null 时匹配任意来源
+ */
+inline RedirectResult RedirectDamage(std::span<PendingEffect> effects,
+                                     entt::entity source,
+                                     entt::entity originalTarget,
+                                     entt::entity newTarget,
+                                     int32_t amount) noexcept
+{
+    for (auto& effect : effects)
+    {
+        if (effect.kind == EffectKind::Damage && effect.amount > 0 && effect.target == originalTarget &&
+            (source == entt::null || effect.source == source))
+        {
+            if (effect.amount <= amount)
+            {
+                effect.target = newTarget;
+                return RedirectResult{.matched = true};
+            }
+            effect.amount -= amount;
+            PendingEffect split = effect;
+            split.amount = amount;
+            split.target = newTarget;
+            return RedirectResult{.matched = true, .split = split};
+        }
+    }
+    return RedirectResult{};
+}
+
+/**
+ * @brief 按缓冲区顺序防止目标受到的伤害，直到用完 amount
+ * @param source 伤害来源，为 entt::null 时匹配任意来源
+ * @return 实际防止的伤害值
+ */
+inline int32_t PreventDamage(std::span<PendingEffect> effects,
+                             entt::entity source,
+                             entt::entity target,
+                             int32_t amount) noexcept
+{
+    int32_t prevented = 0;
+    for (auto& effect : effects)
+    {
+        if (prevented >= amount)
+        {
+            break;
+        }
+        if (effect.kind == EffectKind::Damage && effect.amount > 0 && effect.target == target &&
+            (source == entt::null || effect.source == source))
+        {
+            const int32_t reduced = std::min(effect.amount, amount - prevented);
+            effect.amount -= reduced;
+            prevented += reduced;
+        }
+    }
+    return prevented;
+}
+} // namespace rules
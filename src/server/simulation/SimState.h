@@ -0,0 +1,296 @@
+/**
+ * ************************************************************************
+ *
+ * @file SimState.h
+ * @author AnakinLiu (azrael2759@qq.com)
+ * @date 2026-10-16
+ * @version 0.1
+ * @brief 可分叉的紧凑游戏状态（用于 AI 与平衡性模拟）
+    SimState 只包含定长数组与标量，满足 trivially copyable：
+    - 分叉 (fork) 即一次值拷贝，无堆分配
+    - 卡牌以 CardId 索引只读的 SimCardTable，多条模拟共享同一张表
+    - 由 Capture() 从房间注册表派生
+ *
+ * ************************************************************************
+ * @copyright Copyright (c) 2026 AnakinLiu
+ * For study and research only, no reprinting.
+ * ************************************************************************
+ */
+
+#pragma once
+#include <array>
+#include <cstdint>
+#include <span>
+#include <type_traits>
+#include <vector>
+#include <entt/entt.hpp>
+#include <absl/container/flat_hash_map.h>
+#include "src/server/components/Card.h"
+#include "src/server/components/Character.h"
+#include "src/server/components/Deck.h"
+#include "src/server/components/Player.h"
+#include "src/server/rules/CardRules.h"
+
+namespace simulation
+{
+constexpr std::size_t MAX_SEATS = 8;      // 房间最大座位数
+constexpr std::size_t MAX_HAND = 32;      // 单人手牌上限
+constexpr std::size_t MAX_CARDS = 256;    // 整副牌上限
+constexpr std::size_t EQUIP_SLOTS = 4;    // 武器/防具/进攻马/防御马
+using CardId = uint16_t;
+constexpr CardId NO_CARD = 0xFFFF;
+static_assert(EQUIP_SLOTS == EQUIP_SLOT_COUNT, "simulated equipment slots mirror Equipments::slots");
+
+/**
+ * @brief 模拟器关心的卡牌种类
+ */
+enum class SimCardKind : uint8_t
+{
+    OTHER,
+    STRIKE,
+    DODGE,
+    PEACH,
+    ALCOHOL,
+    DUEL,
+    FIRE_ATTACK,
+    EQUIP
+};
+
+struct SimCard
+{
+    SimCardKind kind = SimCardKind::OTHER;
+    SuitType suit = SuitType::JOKER;
+    uint8_t point = 0;
+    EquipSlot slot = EquipSlot::Weapon; // 装备牌进入的装备栏，仅 kind 为 EQUIP 时有效
+};
+
+/**
+ * @brief 只读卡牌表：CardId -> 卡牌定义，以及实体到 CardId 的映射
+ */
+struct SimCardTable
+{
+    std::vector<SimCard> cards;
+    absl::flat_hash_map<entt::entity, CardId> ids;
+
+    /**
+     * @brief 取得（必要时登记）实体对应的 CardId
+     * @return 表已登记 MAX_CARDS 张牌时，新牌返回 NO_CARD，调用方应跳过该牌
+     */
+    CardId idOf(const RoomRegistry& registry, entt::entity card)
+    {
+        if (auto iter = ids.find(card); iter != ids.end())
+        {
+            return iter->second;
+        }
+        if (cards.size() >= MAX_CARDS)
+        {
+            return NO_CARD;
+        }
+        SimCard info{};
+        if (const auto* basic = registry.try_get<BasicCardTypeTag>(card))
+        {
+            switch (basic->type)
+            {
+                case BasicCardType::STRIKE: info.kind = SimCardKind::STRIKE; break;
+                case BasicCardType::DODGE: info.kind = SimCardKind::DODGE; break;
+                case BasicCardType::PEACH: info.kind = SimCardKind::PEACH; break;
+                case BasicCardType::ALCOHOL: info.kind = SimCardKind::ALCOHOL; break;
+                default: break;
+            }
+        }
+        else if (const auto* strategy = registry.try_get<StrategyCardTypeTag>(card))
+        {
+            switch (strategy->type)
+            {
+                case StrategyCardType::DUEL: info.kind = SimCardKind::DUEL; break;
+                case StrategyCardType::FIRE_ATTACK: info.kind = SimCardKind::FIRE_ATTACK; break;
+                default: break;
+            }
+        }
+        else if (const auto* equip = registry.try_get<EquipCardTypeTag>(card))
+        {
+            info.kind = SimCardKind::EQUIP;
+            info.slot = rules::EquipSlotOf(equip->type);
+        }
+        if (const auto* pointAndSuit = registry.try_get<CardPointAndSuit>(card))
+        {
+            info.suit = pointAndSuit->suit;
+            info.point = pointAndSuit->point;
+        }
+        auto id = static_cast<CardId>(cards.size());
+        cards.push_back(info);
+        ids.emplace(card, id);
+        return id;
+    }
+};
+
+/**
+ * @brief 定长牌区
+ */
+template <std::size_t Capacity>
+struct CardZone
+{
+    std::array<CardId, Capacity> cards{};
+    uint16_t count = 0;
+
+    [[nodiscard]] bool empty() const { return count == 0; }
+    [[nodiscard]] std::span<const CardId> view() const { return {cards.data(), count}; }
+    bool push(CardId card)
+    {
+        if (count >= Capacity)
+        {
+            return false;
+        }
+        cards[count++] = card;
+        return true;
+    }
+    CardId pop() { return count == 0 ? NO_CARD : cards[--count]; }
+    /**
+     * @brief 移除下标 index 处的牌，保持其余牌顺序
+     */
+    CardId take(std::size_t index)
+    {
+        CardId card = cards[index];
+        std::copy(cards.begin() + static_cast<std::ptrdiff_t>(index) + 1,
+                  cards.begin() + count,
+                  cards.begin() + static_cast<std::ptrdiff_t>(index));
+        --count;
+        return card;
+    }
+};
+
+struct SimPlayer
+{
+    CardZone<MAX_HAND> hand;
+    std::array<CardId, EQUIP_SLOTS> equipment{NO_CARD, NO_CARD, NO_CARD, NO_CARD};
+    int32_t health = 4;
+    int32_t maxHealth = 4;
+    uint32_t statusBits = 0; // 第 n 位表示存在 StatusType(n)
+    uint8_t attackTimes = 1;
+    bool alive = true;
+};
+
+struct SimState
+{
+    std::array<SimPlayer, MAX_SEATS> seats{};
+    CardZone<MAX_CARDS> drawPile;
+    CardZone<MAX_CARDS> discardPile;
+    uint8_t seatCount = 0;
+    uint8_t current = 0; // 当前回合座位
+    uint32_t turn = 0;
+
+    [[nodiscard]] uint8_t aliveCount() const
+    {
+        uint8_t alive = 0;
+        for (uint8_t seat = 0; seat < seatCount; ++seat)
+        {
+            alive += seats[seat].alive ? 1 : 0;
+        }
+        return alive;
+    }
+
+    /**
+     * @brief 分叉：返回独立副本（值拷贝，无堆分配）
+     */
+    [[nodiscard]] SimState fork() const { return *this; }
+};
+static_assert(std::is_trivially_copyable_v<SimState>, "SimState must stay POD-like for cheap forking");
+
+/**
+ * @brief 放入牌区，跳过卡牌表未登记的牌
+ */
+template <std::size_t Capacity>
+void pushMapped(CardZone<Capacity>& zone, CardId card)
+{
+    if (card != NO_CARD)
+    {
+        zone.push(card);
+    }
+}
+
+/**
+ * @brief 从注册表派生模拟状态
+ *
+ * 卡牌表登记不下的牌（超过 MAX_CARDS）不进入任何牌区，模拟中视为不存在
+ * @param registry 房间注册表
+ * @param deck 当前牌堆 (DeckSystem::deck())
+ * @param players 按座位顺序排列的玩家实体
+ * @param current 当前回合玩家
+ * @param table 卡牌表，按需登记新卡牌
+ */
+inline SimState Capture(const RoomRegistry& registry,
+                        const Deck& deck,
+                        std::span<const entt::entity> players,
+                        entt::entity current,
+                        SimCardTable& table)
+{
+    SimState state{};
+    state.seatCount = static_cast<uint8_t>(std::min(players.size(), MAX_SEATS));
+    for (uint8_t seat = 0; seat < state.seatCount; ++seat)
+    {
+        entt::entity player = players[seat];
+        auto& simPlayer = state.seats[seat];
+        if (player == current)
+        {
+            state.current = seat;
+        }
+        if (const auto* hand = registry.try_get<HandCards>(player))
+        {
+            for (auto card : hand->handCards)
+            {
+                pushMapped(simPlayer.hand, table.idOf(registry, card));
+            }
+        }
+        if (const auto* equipments = registry.try_get<Equipments>(player))
+        {
+            for (std::size_t slot = 0; slot < EQUIP_SLOTS; ++slot)
+            {
+                const entt::entity card = equipments->slots[slot];
+                simPlayer.equipment[slot] = card == entt::null ? NO_CARD : table.idOf(registry, card);
+            }
+        }
+        // 体力与状态可能挂在玩家实体上，也可能挂在其角色卡上
+        entt::entity character = player;
+        if (!registry.all_of<CombatState>(character))
+        {
+            if (const auto* info = registry.try_get<CharacterInfo>(player))
+            {
+                character = info->characterCard;
+            }
+        }
+        if (const auto* combat = registry.try_get<CombatState>(character))
+        {
+            simPlayer.health = combat->currentHealth;
+            simPlayer.maxHealth = static_cast<int32_t>(combat->maxHealth);
+            simPlayer.attackTimes = combat->attackTimes;
+            simPlayer.alive = combat->isAlive;
+        }
+        if (const auto* live = registry.try_get<LiveStatus>(player))
+        {
+            simPlayer.alive = simPlayer.alive && live->isAlive;
+        }
+        if (const auto* flags = registry.try_get<StatusFlags>(character))
+        {
+            for (const auto& status : flags->statusList)
+            {
+                simPlayer.statusBits |= 1U << (static_cast<uint32_t>(status.type) & 31U);
+            }
+        }
+    }
+    // 逆序存放，pop() 即取 DeckSystem 的牌堆顶 (drawPile.front())
+    for (auto iter = deck.drawPile.rbegin(); iter != deck.drawPile.rend(); ++iter)
+    {
+        pushMapped(state.drawPile, table.idOf(registry, *iter));
+    }
+    for (auto card : deck.discardPile)
+    {
+        pushMapped(state.discardPile, table.idOf(registry, card));
+    }
+    // 处理区的牌在结算后进入弃牌堆
+    for (auto card : deck.processingArea)
+    {
+        pushMapped(state.discardPile, table.idOf(registry, card));
+    }
+    return state;
+}
+} // namespace simulation
@@ -0,0 +1,371 @@
+/**
+ * ************************************************************************
+ *
+ * @file Simulator.h
+ * @author AnakinLiu (azrael2759@qq.com)
+ * @date 2026-10-16
+ * @version 0.1
+ * @brief 基于 SimState 的蒙特卡洛模拟器
+    - 规则结算复用 rules::ResolveDamage / ResolveHeal，与 DamageSystem 保持一致；
+      出牌规则（出杀次数、攻击牌、决斗、桃、装备栏、手牌上限）取自 rules/CardRules.h
+    - 单次模拟 (rollout) 只操作栈上的 SimState 副本，无堆分配
+    - runParallel() 将模拟按批投递到共享调度器 (utils::TaskScheduler)，并汇总胜率统计
+ *
+ * ************************************************************************
+ * @copyright Copyright (c) 2026 AnakinLiu
+ * For study and research only, no reprinting.
+ * ************************************************************************
+ */
+
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <vector>
+#include "src/server/rules/CardRules.h"
+#include "src/server/rules/CombatRules.h"
+#include "src/server/simulation/SimState.h"
+#include "src/utils/TaskScheduler.h"
+
+namespace simulation
+{
+constexpr uint8_t NO_WINNER = 0xFF;
+constexpr uint32_t DEFAULT_MAX_TURNS = 200; // 单局回合上限，超过判平局
+
+/**
+ * @brief 轻量随机数发生器 (SplitMix64)，满足 UniformRandomBitGenerator
+ */
+struct SplitMix64
+{
+    using result_type = uint64_t;
+    uint64_t state;
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+    result_type operator()()
+    {
+        uint64_t value = (state += 0x9E3779B97F4A7C15ULL);
+        value = (value ^ (value >> 30U)) * 0xBF58476D1CE4E5B9ULL;
+        value = (value ^ (value >> 27U)) * 0x94D049BB133111EBULL;
+        return value ^ (value >> 31U);
+    }
+
+    uint32_t below(uint32_t bound) { return static_cast<uint32_t>((*this)() % bound); }
+};
+
+struct RolloutResult
+{
+    uint8_t winner = NO_WINNER; // 获胜座位，NO_WINNER 表示平局/超时
+    uint32_t turns = 0;         // 实际进行的回合数
+};
+
+struct RolloutStats
+{
+    std::array<uint32_t, MAX_SEATS> wins{};
+    uint32_t draws = 0;
+    uint32_t games = 0;
+    uint64_t turns = 0;
+
+    void merge(const RolloutStats& other)
+    {
+        for (std::size_t seat = 0; seat < MAX_SEATS; ++seat)
+        {
+            wins[seat] += other.wins[seat];
+        }
+        draws += other.draws;
+        games += other.games;
+        turns += other.turns;
+    }
+};
+
+/**
+ * @brief 随机策略模拟器，持有只读卡牌表，可被多个线程同时使用
+ */
+class Simulator
+{
+public:
+    explicit Simulator(const SimCardTable& table) : m_table(&table) {}
+
+    /**
+     * @brief 从给定状态模拟一局直到结束
+     * @param state 起始状态（按值传入，即一次分叉）
+     * @param seed 随机种子
+     * @param maxTurns 回合上限
+     */
+    [[nodiscard]] RolloutResult rollout(SimState state, uint64_t seed, uint32_t maxTurns = DEFAULT_MAX_TURNS) const
+    {
+        SplitMix64 rng{seed};
+        uint32_t turns = 0;
+        while (state.aliveCount() > 1 && turns < maxTurns)
+        {
+            playTurn(state, rng);
+            advanceSeat(state);
+            ++turns;
+        }
+        RolloutResult result{.winner = NO_WINNER, .turns = turns};
+        if (state.aliveCount() == 1)
+        {
+            for (uint8_t seat = 0; seat < state.seatCount; ++seat)
+            {
+                if (state.seats[seat].alive)
+                {
+                    result.winner = seat;
+                }
+            }
+        }
+        return result;
+    }
+
+    /**
+     * @brief 单线程执行 count 局模拟
+     */
+    [[nodiscard]] RolloutStats runBatch(const SimState& root, uint32_t count, uint64_t seed) const
+    {
+        RolloutStats stats;
+        SplitMix64 seeds{seed};
+        for (uint32_t game = 0; game < count; ++game)
+        {
+            auto result = rollout(root, seeds());
+            if (result.winner == NO_WINNER)
+            {
+                ++stats.draws;
+            }
+            else
+            {
+                ++stats.wins[result.winner];
+            }
+            ++stats.games;
+            stats.turns += result.turns;
+        }
+        return stats;
+    }
+
+    /**
+     * @brief 将模拟按批分发到共享调度器并汇总
+     * @param root 根状态，所有模拟从此分叉
+     * @param count 模拟总局数
+     * @param seed 随机种子
+     * @param batches 批次数，默认与调度器线程数一致
+     */
+    [[nodiscard]] RolloutStats runParallel(const SimState& root,
+                                           uint32_t count,
+                                           uint64_t seed,
+                                           uint32_t batches = static_cast<uint32_t>(
+                                               utils::TaskScheduler::global().threadCount())) const
+    {
+        batches = std::max(1U, batches);
+        std::vector<RolloutStats> results(batches);
+        std::vector<uint64_t> seeds(batches);
+        SplitMix64 seedGenerator{seed};
+        std::ranges::generate(seeds, seedGenerator);
+        utils::TaskGroup group;
+        group.runBatch(batches,
+                       [this, &root, &results, &seeds, count, batches](std::size_t batch)
+                       {
+                           uint32_t share = count / batches + (batch < count % batches ? 1 : 0);
+                           if (share != 0)
+                           {
+                               results[batch] = runBatch(root, share, seeds[batch]);
+                           }
+                       });
+        group.wait();
+        RolloutStats total;
+        for (const auto& result : results)
+        {
+            total.merge(result);
+        }
+        return total;
+    }
+
+private:
+    [[nodiscard]] SimCardKind kindOf(CardId card) const
+    {
+        return card < m_table->cards.size() ? m_table->cards[card].kind : SimCardKind::OTHER;
+    }
+
+    static void advanceSeat(SimState& state)
+    {
+        for (uint8_t step = 0; step < state.seatCount; ++step)
+        {
+            state.current = static_cast<uint8_t>((state.current + 1) % state.seatCount);
+            if (state.seats[state.current].alive)
+            {
+                break;
+            }
+        }
+        ++state.turn;
+    }
+
+    /**
+     * @brief 摸牌，牌堆不足时洗入弃牌堆（对应 DeckSystem::onShuffleDeck）
+     */
+    static void drawCards(SimState& state, SimPlayer& player, uint32_t count, SplitMix64& rng)
+    {
+        for (uint32_t drawn = 0; drawn < count; ++drawn)
+        {
+            if (state.drawPile.empty())
+            {
+                if (state.discardPile.empty())
+                {
+                    return;
+                }
+                std::shuffle(state.discardPile.cards.begin(),
+                             state.discardPile.cards.begin() + state.discardPile.count,
+                             rng);
+                state.drawPile = state.discardPile;
+                state.discardPile.count = 0;
+            }
+            CardId card = state.drawPile.pop();
+            if (!player.hand.push(card))
+            {
+                state.discardPile.push(card);
+            }
+        }
+    }
+
+    /**
+     * @brief 打出手牌中第一张指定种类的牌
+     * @return 是否成功打出
+     */
+    bool playFirst(SimState& state, SimPlayer& player, SimCardKind kind) const
+    {
+        auto hand = player.hand.view();
+        for (std::size_t index = 0; index < hand.size(); ++index)
+        {
+            if (kindOf(hand[index]) == kind)
+            {
+                state.discardPile.push(player.hand.take(index));
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * @brief 结算伤害，进入濒死时尝试用桃自救（对应 DamageSystem -> NearDeath）
+     */
+    void dealDamage(SimState& state, SimPlayer& target, int amount) const
+    {
+        auto result = rules::ResolveDamage(target.health, amount);
+        target.health = result.healthAfter;
+        if (!result.enteredNearDeath)
+        {
+            return;
+        }
+        while (target.health <= 0 && playFirst(state, target, SimCardKind::PEACH))
+        {
+            target.health = rules::ResolveHeal(target.health, target.maxHealth, 1);
+        }
+        if (target.health <= 0)
+        {
+            target.alive = false;
+            // 阵亡角色的手牌与装备进入弃牌堆
+            for (auto card : target.hand.view())
+            {
+                state.discardPile.push(card);
+            }
+            target.hand.count = 0;
+            for (auto& card : target.equipment)
+            {
+                if (card != NO_CARD)
+                {
+                    state.discardPile.push(card);
+                    card = NO_CARD;
+                }
+            }
+        }
+    }
+
+    [[nodiscard]] static uint8_t randomOpponent(const SimState& state, uint8_t self, SplitMix64& rng)
+    {
+        std::array<uint8_t, MAX_SEATS> candidates{};
+        uint8_t count = 0;
+        for (uint8_t seat = 0; seat < state.seatCount; ++seat)
+        {
+            if (seat != self && state.seats[seat].alive)
+            {
+                candidates[count++] = seat;
+            }
+        }
+        return count == 0 ? self : candidates[rng.below(count)];
+    }
+
+    /**
+     * @brief 执行一个完整回合：摸牌 -> 出牌 -> 弃牌，各张牌的结算方式取自 rules/CardRules.h
+     */
+    void playTurn(SimState& state, SplitMix64& rng) const
+    {
+        auto& self = state.seats[state.current];
+        drawCards(state, self, rules::DRAW_PER_TURN, rng);
+
+        uint8_t attackTimesLeft = self.attackTimes;
+        std::size_t index = 0;
+        while (index < self.hand.count && self.alive && state.aliveCount() > 1)
+        {
+            CardId card = self.hand.cards[index];
+            switch (kindOf(card))
+            {
+                case SimCardKind::PEACH:
+                    if (!rules::CanUsePeach(self.health, self.maxHealth))
+                    {
+                        ++index;
+                        continue;
+                    }
+                    state.discardPile.push(self.hand.take(index));
+                    self.health = rules::ResolveHeal(self.health, self.maxHealth, rules::PEACH_HEAL);
+                    continue;
+                case SimCardKind::STRIKE:
+                case SimCardKind::FIRE_ATTACK:
+                {
+                    const auto& rule =
+                        kindOf(card) == SimCardKind::STRIKE ? rules::STRIKE_RULE : rules::FIRE_ATTACK_RULE;
+                    if (!rules::CanAttack(rule, attackTimesLeft))
+                    {
+                        ++index;
+                        continue;
+                    }
+                    attackTimesLeft -= rule.consumesStrike ? 1 : 0;
+                    state.discardPile.push(self.hand.take(index));
+                    auto& target = state.seats[randomOpponent(state, state.current, rng)];
+                    if (!playFirst(state, target, SimCardKind::DODGE))
+                    {
+                        dealDamage(state, target, rule.damage);
+                    }
+                    continue;
+                }
+                case SimCardKind::DUEL:
+                {
+                    state.discardPile.push(self.hand.take(index));
+                    auto& target = state.seats[randomOpponent(state, state.current, rng)];
+                    const bool targetLoses = rules::ResolveDuel(
+                        [&](bool targetTurn)
+                        { return playFirst(state, targetTurn ? target : self, SimCardKind::STRIKE); });
+                    dealDamage(state, targetLoses ? target : self, rules::DUEL_DAMAGE);
+                    continue;
+                }
+                case SimCardKind::EQUIP:
+                {
+                    // 装备栏已有装备时替换，旧装备进入弃牌堆
+                    auto& slot = self.equipment[static_cast<std::size_t>(m_table->cards[card].slot)];
+                    if (slot != NO_CARD)
+                    {
+                        state.discardPile.push(slot);
+                    }
+                    slot = self.hand.take(index);
+                    continue;
+                }
+                default: ++index; continue;
+            }
+        }
+
+        for (auto excess = rules::DiscardCount(self.alive ? self.hand.count : 0, self.health); excess > 0; --excess)
+        {
+            state.discardPile.push(self.hand.take(rng.below(self.hand.count)));
+        }
+    }
+
+    const SimCardTable* m_table;
+};
+} // namespace simulation
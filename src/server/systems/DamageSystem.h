@@ -6,6 +6,12 @@
  * @date 2025-11-25
  * @version 0.1
  * @brief 处理伤害相关的系统
+    - Damage / LostHealth 不再立即结算，而是写入本结算步骤的效果缓冲区；SettleEffects 时统一处理
+    - 处理顺序：修正 -> 转移 -> 防止，每个阶段先应用本步骤收到的 DamageRedirection / DamagePrevention，
+      再执行注册的处理函数，每个阶段都是对整批效果的一次线性遍历
+    - 转移只移走 DamageRedirection::amount 点，其余伤害仍由原目标承受，分出的部分追加到本轮并照常经过防止阶段
+    - 提交时顺序遍历一次，写入体力；进入濒死的角色在提交完成后依次触发 NearDeath，仍未脱离濒死则死亡
+    - 处理或濒死期间产生的新效果（连带伤害、求桃回复等）进入下一轮，最多展开 MAX_EFFECT_ROUNDS 轮
  *
  * ************************************************************************
  * @copyright Copyright (c) 2025 AnakinLiu
@@ -15,64 +21,290 @@
 
 #pragma once
 
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <span>
+#include <utility>
 #include <entt/entt.hpp>
 #include "src/server/context/GameContext.h"
 #include "src/server/events/Events.h"
-#include "src/server/components/Character.h"
+#include "src/server/components/Groups.h"
+#include "src/server/rules/CombatRules.h"
+#include "src/server/rules/Effects.h"
+
+constexpr uint32_t MAX_EFFECT_ROUNDS = 16; // 连带效果最多展开的轮数，防止技能互相触发形成死循环
+
 class DamageSystem
 {
 public:
-    explicit DamageSystem(GameContext& context) : m_context(&context) {};
+    /**
+     * @brief 效果处理函数：可修改数值（改为 0 即取消）与目标，新增的效果通过 enqueue() 进入下一轮
+     */
+    using EffectPass = std::function<void(std::span<rules::PendingEffect>)>;
+
+    explicit DamageSystem(GameContext& context)
+        : m_context(&context), m_combatants(groups::Combatants(context.registry)),
+          m_combat(&context.registry.storage<CombatState>()), m_pending(effectAllocator()),
+          m_resolving(effectAllocator()), m_redirections(effectAllocator()),
+          m_resolvingRedirections(effectAllocator()), m_preventions(effectAllocator()),
+          m_resolvingPreventions(effectAllocator()), m_dying(effectAllocator())
+    {
+    }
 
     void init() { registerEvents(); };
     void destroy() { unregisterEvents(); };
 
-private:
-    void registerEvents() { m_context->dispatcher.sink<events::Damage>().connect<&DamageSystem::onDamageEvent>(this); };
+    void registerEvents()
+    {
+        auto& dispatcher = m_context->dispatcher;
+        dispatcher.sink<events::Damage>().connect<&DamageSystem::onDamageEvent>(this);
+        dispatcher.sink<events::LostHealth>().connect<&DamageSystem::onLostHealthEvent>(this);
+        dispatcher.sink<events::DamagePrevention>().connect<&DamageSystem::onDamagePreventionEvent>(this);
+        dispatcher.sink<events::DamageRedirection>().connect<&DamageSystem::onDamageRedirectionEvent>(this);
+        dispatcher.sink<events::SettleEffects>().connect<&DamageSystem::onSettleEffectsEvent>(this);
+    };
     void unregisterEvents()
     {
-        m_context->dispatcher.sink<events::Damage>().disconnect<&DamageSystem::onDamageEvent>(this);
+        auto& dispatcher = m_context->dispatcher;
+        dispatcher.sink<events::Damage>().disconnect<&DamageSystem::onDamageEvent>(this);
+        dispatcher.sink<events::LostHealth>().disconnect<&DamageSystem::onLostHealthEvent>(this);
+        dispatcher.sink<events::DamagePrevention>().disconnect<&DamageSystem::onDamagePreventionEvent>(this);
+        dispatcher.sink<events::DamageRedirection>().disconnect<&DamageSystem::onDamageRedirectionEvent>(this);
+        dispatcher.sink<events::SettleEffects>().disconnect<&DamageSystem::onSettleEffectsEvent>(this);
     };
-    void onDamageEvent(const events::Damage& damageEvent) const
+
+    /**
+     * @brief 存活角色数（胜负判定在每次濒死结算后查询），顺序遍历 group 拥有的体力数组
+     */
+    [[nodiscard]] std::size_t aliveCount() const
+    {
+        std::size_t alive = 0;
+        m_combatants.each([&alive](const CombatState& combat, const Attributes&)
+                          { alive += static_cast<std::size_t>(combat.isAlive && combat.currentHealth > 0); });
+        return alive;
+    }
+
+    /**
+     * @brief 注册效果处理函数；同一阶段内按注册顺序执行
+     */
+    void addPass(rules::EffectPhase phase, EffectPass pass)
+    {
+        m_passes[static_cast<std::size_t>(phase)].push_back(std::move(pass));
+    }
+
+    void enqueue(const rules::PendingEffect& effect) { m_pending.push_back(effect); }
+
+    /**
+     * @brief 群体效果：每个目标一条记录，在同一批中处理
+     */
+    void enqueueArea(entt::entity source, std::span<const entt::entity> targets, int32_t amount)
+    {
+        for (auto target : targets)
+        {
+            m_pending.push_back(rules::PendingEffect{.kind = rules::EffectKind::Damage,
+                                                     .tags = rules::EFFECT_TAG_AREA,
+                                                     .amount = amount,
+                                                     .source = source,
+                                                     .target = target});
+        }
+    }
+
+    [[nodiscard]] std::size_t pendingCount() const { return m_pending.size(); }
+
+    /**
+     * @brief 处理并提交缓冲的效果，直到没有新效果产生
+     */
+    void settle()
     {
-        auto [source, target, amount] = damageEvent;
-        amount = std::max(0, amount);
-        // 目标没有生命组件则忽略
-        if (auto* attributes = m_context->registry.try_get<Attributes>(target))
+        uint32_t round = 0;
+        while (!m_pending.empty())
         {
-            int before = attributes->currentHealth;
-            attributes->currentHealth -= amount;
-            // 如果从存活变为死亡，触发濒死事件
-            if (before > 0 && attributes->currentHealth <= 0)
+            if (++round > MAX_EFFECT_ROUNDS)
             {
-                m_context->dispatcher.trigger(events::NearDeath{
-                    .killer = source, .character = target, .currentHealth = attributes->currentHealth});
+                m_context->logger->warn("连带效果超过 {} 轮，丢弃剩余 {} 条", MAX_EFFECT_ROUNDS, m_pending.size());
+                m_pending.clear();
+                m_redirections.clear();
+                m_preventions.clear();
+                break;
             }
+            // 本轮处理期间新增的效果写入 m_pending，留到下一轮
+            std::swap(m_pending, m_resolving);
+            std::swap(m_redirections, m_resolvingRedirections);
+            std::swap(m_preventions, m_resolvingPreventions);
+            applyPasses(m_resolving);
+            commit(m_resolving);
+            m_resolving.clear();
+            m_resolvingRedirections.clear();
+            m_resolvingPreventions.clear();
+            resolveDying();
         }
+    }
+
+private:
+    /**
+     * @brief 进入濒死的角色及使其濒死的来源
+     */
+    struct Dying
+    {
+        entt::entity killer;
+        entt::entity character;
     };
 
-    void onDamagePreventionEvent(const events::DamagePrevention& event) const
+    void onDamageEvent(const events::Damage& damageEvent)
     {
-        // 处理伤害预防逻辑
-        m_context->logger->info("伤害预防事件触发");
-        auto target = event.target;
-        int amount = event.amount;
-        if (amount <= 0)
+        m_pending.push_back(rules::PendingEffect{.kind = rules::EffectKind::Damage,
+                                                 .amount = damageEvent.amount,
+                                                 .source = damageEvent.from,
+                                                 .target = damageEvent.to});
+    };
+
+    void onLostHealthEvent(const events::LostHealth& event)
+    {
+        m_pending.push_back(rules::PendingEffect{
+            .kind = rules::EffectKind::LoseHealth, .amount = event.amount, .target = event.character});
+    }
+
+    void onDamagePreventionEvent(const events::DamagePrevention& event)
+    {
+        if (event.amount <= 0)
         {
             return;
         }
+        m_preventions.push_back(event);
     };
 
-    void onDamageRedirectionEvent(const events::DamageRedirection& event) const
+    void onDamageRedirectionEvent(const events::DamageRedirection& event)
     {
-        // 处理伤害重定向逻辑
-        m_context->logger->info("伤害重定向事件触发");
-        auto newTarget = event.newTarget;
-        int amount = event.amount;
-        if (amount <= 0)
+        if (event.amount <= 0)
         {
             return;
         }
+        m_redirections.push_back(event);
     };
+
+    void onSettleEffectsEvent(const events::SettleEffects&) { settle(); }
+
+    void applyPasses(memory::Vector<rules::PendingEffect>& effects)
+    {
+        for (auto& pass : m_passes[static_cast<std::size_t>(rules::EffectPhase::Modify)])
+        {
+            pass(effects);
+        }
+        for (const auto& redirection : m_resolvingRedirections)
+        {
+            auto result = rules::RedirectDamage(effects,
+                                                redirection.source,
+                                                redirection.originalTarget,
+                                                redirection.newTarget,
+                                                redirection.amount);
+            // 部分转移：分出的伤害追加到本轮末尾，之后的转移与防止都能看到它
+            if (result.split)
+            {
+                effects.push_back(*result.split);
+            }
+        }
+        for (auto& pass : m_passes[static_cast<std::size_t>(rules::EffectPhase::Redirect)])
+        {
+            pass(effects);
+        }
+        for (const auto& prevention : m_resolvingPreventions)
+        {
+            rules::PreventDamage(effects, prevention.source, prevention.target, prevention.amount);
+        }
+        for (auto& pass : m_passes[static_cast<std::size_t>(rules::EffectPhase::Prevent)])
+        {
+            pass(effects);
+        }
+    }
+
+    /**
+     * @brief 一次遍历写入体力；目标没有体力组件或已死亡则忽略，直接查体力存储，不经过注册表按类型查找存储
+     */
+    void commit(std::span<const rules::PendingEffect> effects)
+    {
+        for (const auto& effect : effects)
+        {
+            if (effect.amount <= 0 || !m_combat->contains(effect.target))
+            {
+                continue;
+            }
+            auto& combat = m_combat->get(effect.target);
+            if (!combat.isAlive)
+            {
+                continue;
+            }
+            if (effect.kind == rules::EffectKind::Heal)
+            {
+                combat.currentHealth =
+                    rules::ResolveHeal(combat.currentHealth, static_cast<int32_t>(combat.maxHealth), effect.amount);
+                continue;
+            }
+            auto result = rules::ResolveDamage(combat.currentHealth, effect.amount);
+            combat.currentHealth = result.healthAfter;
+            if (result.enteredNearDeath)
+            {
+                m_dying.push_back(Dying{.killer = effect.source, .character = effect.target});
+            }
+        }
+    }
+
+    /**
+     * @brief 全部效果提交后再依次处理濒死，濒死处理看到的是整批结算后的体力
+     */
+    void resolveDying()
+    {
+        if (m_dying.empty())
+        {
+            return;
+        }
+        // 濒死处理中可能再次进入本函数（如求桃时的连带结算），先取出本轮名单
+        auto dying = std::move(m_dying);
+        m_dying.clear();
+        for (const auto& [killer, character] : dying)
+        {
+            // 之前的濒死处理可能已销毁该角色或移除其体力组件
+            if (!m_combat->contains(character))
+            {
+                continue;
+            }
+            auto& combat = m_combat->get(character);
+            if (combat.currentHealth > 0 || !combat.isAlive)
+            {
+                continue;
+            }
+            m_context->dispatcher.trigger(
+                events::NearDeath{.killer = killer, .character = character, .currentHealth = combat.currentHealth});
+            // 濒死处理可能修改注册表，重新获取
+            if (!m_combat->contains(character))
+            {
+                continue;
+            }
+            auto& after = m_combat->get(character);
+            if (after.currentHealth <= 0 && after.isAlive)
+            {
+                after.isAlive = false;
+                m_context->dispatcher.trigger(events::CharacterDeath{.character = character});
+            }
+        }
+    }
+
+    memory::Allocator<rules::PendingEffect> effectAllocator() const
+    {
+        return memory::Allocator<rules::PendingEffect>{m_context->roomMemory.resource()};
+    }
+
     GameContext* m_context;
-};
\ No newline at end of file
+    groups::CombatantsGroup m_combatants;                  // 体力与属性同序存放
+    RoomRegistry::storage_for_type<CombatState>* m_combat; // 伤害结算的热数据
+
+    memory::Vector<rules::PendingEffect> m_pending;   // 本结算步骤产生、尚未处理的效果
+    memory::Vector<rules::PendingEffect> m_resolving; // 正在处理的一轮，与 m_pending 交换复用容量
+    memory::Vector<events::DamageRedirection> m_redirections;
+    memory::Vector<events::DamageRedirection> m_resolvingRedirections;
+    memory::Vector<events::DamagePrevention> m_preventions;
+    memory::Vector<events::DamagePrevention> m_resolvingPreventions;
+    memory::Vector<Dying> m_dying;
+    std::array<std::vector<EffectPass>, rules::EFFECT_PHASE_COUNT> m_passes;
+};
@@ -21,15 +21,22 @@
 #include "src/server/events/Events.h"
 #include "src/server/components/Player.h"
 #include "src/server/components/Card.h"
+#include "src/server/components/Groups.h"
 #include "src/server/events/DeckEvents.h"
 #include "src/server/events/GameFlowEvents.h"
 #include "src/server/Interface/ISystem.h"
-#include "absl/container/flat_hash_set.h"
 
 class DeckSystem : public EnableRegister<DeckSystem>
 {
 public:
-    explicit DeckSystem(GameContext& context) : m_context(&context) { m_context->logger->info("DeckSystem 初始化"); }
+    explicit DeckSystem(GameContext& context)
+        : m_context(&context), m_zones(groups::PlayerZones(context.registry)),
+          m_deck{.drawPile = memory::Vector<entt::entity>(context.registry.get_allocator()),
+                 .discardPile = memory::Vector<entt::entity>(context.registry.get_allocator()),
+                 .processingArea = memory::Vector<entt::entity>(context.registry.get_allocator())}
+    {
+        m_context->logger->info("DeckSystem 初始化");
+    }
 
     // Disable copy and move operations due to reference member
     DeckSystem(const DeckSystem&) = default;
@@ -38,10 +45,34 @@ public:
     DeckSystem& operator=(DeckSystem&& other) = delete;
     ~DeckSystem() = default;
 
+    /**
+     * @brief 获取当前牌堆（只读），用于状态快照
+     */
+    [[nodiscard]] const Deck& deck() const { return m_deck; }
+
 private:
-    void registerEventsImpl() { initDeck(); };
-    void unregisterEventsImpl() {
+    friend struct EnableRegister<DeckSystem>;
 
+    void registerEventsImpl()
+    {
+        initDeck();
+        auto& dispatcher = m_context->dispatcher;
+        dispatcher.sink<events::DealCards>().connect<&DeckSystem::onDealCards>(this);
+        dispatcher.sink<events::ShuffleDeck>().connect<&DeckSystem::onShuffleDeck>(this);
+        dispatcher.sink<events::CardDiscarded>().connect<&DeckSystem::onCardDiscarded>(this);
+        dispatcher.sink<events::DetailFinish>().connect<&DeckSystem::onProcessFinished>(this);
+        dispatcher.sink<events::FindCardInDrawPile>().connect<&DeckSystem::onFindCardInDrawPile>(this);
+        dispatcher.sink<events::FindCardInHandCardsArea>().connect<&DeckSystem::onFindCardInHandCards>(this);
+    };
+    void unregisterEventsImpl()
+    {
+        auto& dispatcher = m_context->dispatcher;
+        dispatcher.sink<events::DealCards>().disconnect<&DeckSystem::onDealCards>(this);
+        dispatcher.sink<events::ShuffleDeck>().disconnect<&DeckSystem::onShuffleDeck>(this);
+        dispatcher.sink<events::CardDiscarded>().disconnect<&DeckSystem::onCardDiscarded>(this);
+        dispatcher.sink<events::DetailFinish>().disconnect<&DeckSystem::onProcessFinished>(this);
+        dispatcher.sink<events::FindCardInDrawPile>().disconnect<&DeckSystem::onFindCardInDrawPile>(this);
+        dispatcher.sink<events::FindCardInHandCardsArea>().disconnect<&DeckSystem::onFindCardInHandCards>(this);
     };
 
     /**
@@ -59,32 +90,29 @@ private:
     {
         auto& [player, cards, count] = event;
 
-        auto& handCards = m_context->registry.try_get<HandCards>(player)->handCards;
-        auto* equipments = m_context->registry.try_get<Equipments>(player);
-        auto& [weapon, armor, attackhorse, defensehorse] = *equipments;
-        // 用 unordered_set 提升查找效率
-        absl::flat_hash_set<entt::entity> cardSet(cards.begin(), cards.end());
+        auto [hand, equipments] = m_zones.get<HandCards, Equipments>(player);
+        // 一次只弃几张牌，线性查找比建哈希集合更快且不分配
+        auto discarded = [&cards](entt::entity card) { return std::ranges::find(cards, card) != cards.end(); };
 
         // 移除手牌
-        auto newEnd = std::ranges::remove_if(handCards, [&](entt::entity card) { return cardSet.contains(card); });
-        handCards.erase(newEnd.begin(), newEnd.end());
+        auto newEnd = std::ranges::remove_if(hand.handCards, discarded);
+        hand.handCards.erase(newEnd.begin(), newEnd.end());
 
-        auto checkDiscarded = [](entt::entity& equipments, absl::flat_hash_set<entt::entity>& cardSet)
+        for (auto& slot : equipments.slots)
         {
-            if (equipments != entt::null && cardSet.contains(equipments))
+            if (slot != entt::null && discarded(slot))
             {
-                equipments = entt::null;
+                slot = entt::null;
             }
-        };
-        checkDiscarded(weapon, cardSet);
-        checkDiscarded(armor, cardSet);
-        checkDiscarded(attackhorse, cardSet);
-        checkDiscarded(defensehorse, cardSet);
+        }
 
         m_deck.processingArea.insert(m_deck.processingArea.end(), cards.begin(), cards.end());
     }
 
-    void onProcessFinished()
+    /**
+     * @brief 结算完成，处理区的牌进入弃牌堆
+     */
+    void onProcessFinished([[maybe_unused]] const events::DetailFinish& event)
     {
         m_deck.discardPile.insert(m_deck.discardPile.end(), m_deck.processingArea.begin(), m_deck.processingArea.end());
         m_deck.processingArea.clear();
@@ -111,7 +139,7 @@ private:
     void onDealCards(events::DealCards event)
     {
         auto& [player, count] = event;
-        auto& handCards = m_context->registry.get<HandCards>(player).handCards;
+        auto& handCards = m_zones.get<HandCards>(player).handCards;
 
         if (m_deck.drawPile.empty() or m_deck.drawPile.size() < count)
         {
@@ -161,10 +189,10 @@ private:
     {
         m_findCard = entt::null;
         auto& [cardName, suitType, rank] = event;
-        // 遍历所有玩家手牌区域
-        for (auto player : m_context->registry.view<HandCards>())
+        // 遍历所有玩家手牌区域：group 拥有的手牌数组顺序访问，不再逐个实体二次查找
+        for (auto [player, hand, equipments] : m_zones.each())
         {
-            auto& handCards = m_context->registry.get<HandCards>(player).handCards;
+            const auto& handCards = hand.handCards;
             {
                 auto it1 = std::ranges::find_if(handCards.begin(),
                                                 handCards.end(),
@@ -184,22 +212,32 @@ private:
 
     void initDeck()
     {
-        // 初始化牌堆，创建所有卡牌实体并加入摸牌堆
-        // 这里简化为只创建少量示例卡牌
+        // 初始化牌堆，按定义表创建所有卡牌实体并加入摸牌堆
         auto& registry = m_context->registry;
         m_deck.drawPile.clear();
         m_deck.discardPile.clear();
         m_deck.processingArea.clear();
-        // NOLINTNEXTLINE
-        for (int i = 0; i < 52; ++i)
+        if (m_context->definitions != nullptr)
+        {
+            CreateDeckFromDefinition(registry, *m_context->definitions, m_deck.drawPile);
+        }
+        else
         {
-            entt::entity card = registry.create();
-            registry.emplace<MetaCardInfo>(card, MetaCardInfo{.name = "Card" + std::to_string(i + 1)});
-            m_deck.drawPile.push_back(card);
+            // 未找到定义表时退化为占位牌，保证流程可以继续
+            m_context->logger->warn("未加载卡牌定义表 ({})，使用占位牌堆",
+                                    data::DefinitionTable::defaultPath().string());
+            // NOLINTNEXTLINE
+            for (int i = 0; i < 52; ++i)
+            {
+                entt::entity card = registry.create();
+                registry.emplace<MetaCardInfo>(card, MetaCardInfo{.name = "占位牌"});
+                m_deck.drawPile.push_back(card);
+            }
         }
         m_context->logger->info("牌堆初始化完成，包含 {} 张卡牌", m_deck.drawPile.size());
     }
     GameContext* m_context;
+    groups::PlayerZonesGroup m_zones;
     Deck m_deck;
     entt::entity m_findCard{entt::null};
 };
\ No newline at end of file
@@ -8,6 +8,13 @@
  * @brief 游戏流程系统定义
     处理游戏的整体流程控制
     包括游戏开始、回合切换、游戏结束等
+
+    阶段调度采用运行队列而非递归调用:
+    1. 切换: transitionToPhase() 只把目标阶段压入队列，不直接执行
+    2. 驱动: 房间每次 tick(deltaMs) 最多执行 MAX_PHASE_STEPS_PER_TICK 个阶段
+    3. 等待: 需要玩家响应的阶段打开响应窗口（非阻塞计时器），超时后自动入队下一阶段
+    开局时 GameStart 按座位顺序填充回合队列；每进入一个阶段广播一次 events::TurnPhase
+    因此空闲回合循环不会无限压栈，单个房间也无法独占共享的工作线程
  *
  * ************************************************************************
  * @copyright Copyright (c) 2025 AnakinLiu
@@ -16,20 +23,28 @@
  */
 
 #pragma once
+#include <cstdint>
+#include <deque>
+#include <optional>
 #include <entt/entt.hpp>
 #include "absl/container/flat_hash_map.h"
 #include "entt/signal/fwd.hpp"
+#include "src/server/Interface/ISystem.h"
 #include "src/server/context/GameContext.h"
 #include "src/server/events/GameFlowEvents.h"
 #include "src/server/events/DeckEvents.h"
+#include "src/server/events/Events.h"
 #include "src/shared/utils/RoundRobin.h"
 #include "src/shared/common/Common.h"
 #include "src/server/components/Player.h"
+#include "src/server/components/GameData.h"
+#include "src/server/rules/CardRules.h"
 
 class GameFlowSystem : public EnableRegister<GameFlowSystem>
 {
 public:
     static constexpr int MAX_PLAYERS = 8;
+    static constexpr std::size_t MAX_PHASE_STEPS_PER_TICK = 16; // 单次 tick 最多执行的阶段数
     explicit GameFlowSystem(GameContext& context) : m_context(&context)
     {
         m_phaseHandlers[TurnPhase::GAME_START] =
@@ -50,23 +65,92 @@ public:
             entt::delegate<void()>{entt::connect_arg<&GameFlowSystem::handleGameOver>, this};
     };
 
+    /**
+     * @brief 驱动阶段状态机，由房间 tick 在房间 strand 上调用（分发器的 tick 统计由房间 tick 标记）
+     * @param deltaMs 距上次调用的时间增量（毫秒）
+     * @return 本次 tick 实际执行的阶段数
+     */
+    std::size_t tick(uint32_t deltaMs)
+    {
+        updateResponseWindow(deltaMs);
+
+        std::size_t steps = 0;
+        while (steps < MAX_PHASE_STEPS_PER_TICK && !m_phaseQueue.empty())
+        {
+            TurnPhase nextPhase = m_phaseQueue.front();
+            m_phaseQueue.pop_front();
+            enterPhase(nextPhase);
+            ++steps;
+        }
+        return steps;
+    }
+
+    /**
+     * @brief 是否有待执行的阶段
+     */
+    [[nodiscard]] bool hasPendingPhases() const { return !m_phaseQueue.empty(); }
+
+    /**
+     * @brief 是否正在等待玩家响应
+     */
+    [[nodiscard]] bool isWaitingForResponse() const { return m_responseWindow.has_value(); }
+
+    /**
+     * @brief 当前所处阶段
+     */
+    [[nodiscard]] TurnPhase currentPhase() const { return m_currentPhase; }
+
 private:
+    friend struct EnableRegister<GameFlowSystem>;
+
+    /**
+     * @brief 响应窗口：等待玩家操作的非阻塞计时器
+     */
+    struct ResponseWindow
+    {
+        TurnPhase phase;        // 打开窗口的阶段
+        TurnPhase timeoutPhase; // 超时后进入的阶段
+        uint32_t remainingMs;   // 剩余时间（毫秒）
+    };
+
     void registerEventsImpl()
     {
         m_context->dispatcher.sink<events::GameStart>().connect<&GameFlowSystem::onGameStart>(this);
+        m_context->dispatcher.sink<events::EndPlayPhase>().connect<&GameFlowSystem::onEndPlayPhase>(this);
     };
     void unregisterEventsImpl()
     {
         m_context->dispatcher.sink<events::GameStart>().disconnect<&GameFlowSystem::onGameStart>(this);
+        m_context->dispatcher.sink<events::EndPlayPhase>().disconnect<&GameFlowSystem::onEndPlayPhase>(this);
     };
     void onGameStart(const events::GameStart& event)
     {
-        // 处理游戏开始事件的逻辑
-        for (auto player : m_playerQueue)
+        if (m_started || event.players.empty())
         {
+            return;
         }
+        // 按座位顺序排入回合队列
+        for (auto player : event.players)
+        {
+            m_playerQueue.push_back(player);
+        }
+        m_started = true;
+        transitionToPhase(TurnPhase::GAME_START);
     };
 
+    /**
+     * @brief 玩家主动结束出牌阶段
+     */
+    void onEndPlayPhase(const events::EndPlayPhase& event)
+    {
+        if (m_currentPhase != TurnPhase::PLAY || event.player != m_playerQueue.current())
+        {
+            return;
+        }
+        closeResponseWindow();
+        transitionToPhase(TurnPhase::DISCARD);
+    }
+
     void onGameEnd(const events::GameEnd& event) {
         // 处理游戏结束事件的逻辑
     };
@@ -99,13 +183,68 @@ private:
 
     /**
      * @brief 切换到下一个阶段
+     * @note 仅入队，由 tick() 统一执行，避免阶段处理函数之间互相递归
      * @param nextPhase 下一个阶段
      */
-    void transitionToPhase(TurnPhase nextPhase)
+    void transitionToPhase(TurnPhase nextPhase) { m_phaseQueue.push_back(nextPhase); }
+
+    /**
+     * @brief 进入指定阶段并执行其处理逻辑，随后广播 events::TurnPhase
+     * @note 广播在处理函数之后，监听者看到的是阶段已就绪的状态（如出牌阶段的响应窗口已打开）；
+     *       每个阶段是一个结算步骤，处理函数与监听者产生的伤害在阶段结束时统一结算
+     * @param nextPhase 目标阶段
+     */
+    void enterPhase(TurnPhase nextPhase)
     {
         m_context->logger->info("阶段切换: {} -> {}", static_cast<int>(m_currentPhase), static_cast<int>(nextPhase));
         m_currentPhase = nextPhase;
+        const entt::entity currentPlayer = m_playerQueue.current();
+        if (auto* gameData = m_context->registry.ctx().find<GameData>())
+        {
+            gameData->currentPhase = nextPhase;
+            gameData->currentPlayer = currentPlayer;
+        }
         executeCurrentPhase();
+        m_context->dispatcher.trigger(events::TurnPhase{.player = currentPlayer, .currentPhase = nextPhase});
+        m_context->dispatcher.trigger(events::SettleEffects{});
+    }
+
+    /**
+     * @brief 打开响应窗口，超时后自动进入 timeoutPhase
+     * @param timeoutPhase 超时后进入的阶段
+     */
+    void openResponseWindow(TurnPhase timeoutPhase)
+    {
+        uint32_t seconds = RESPONSE_TIME;
+        if (const auto* gameData = m_context->registry.ctx().find<GameData>())
+        {
+            seconds = gameData->responseTime;
+        }
+        m_responseWindow = ResponseWindow{
+            .phase = m_currentPhase, .timeoutPhase = timeoutPhase, .remainingMs = seconds * 1000U};
+    }
+
+    void closeResponseWindow() { m_responseWindow.reset(); }
+
+    /**
+     * @brief 推进响应窗口计时，超时则入队超时阶段
+     * @param deltaMs 时间增量（毫秒）
+     */
+    void updateResponseWindow(uint32_t deltaMs)
+    {
+        if (!m_responseWindow)
+        {
+            return;
+        }
+        if (m_responseWindow->remainingMs > deltaMs)
+        {
+            m_responseWindow->remainingMs -= deltaMs;
+            return;
+        }
+        m_context->logger->info("响应超时 - 阶段: {}", static_cast<int>(m_responseWindow->phase));
+        TurnPhase timeoutPhase = m_responseWindow->timeoutPhase;
+        closeResponseWindow();
+        transitionToPhase(timeoutPhase);
     }
 
     // ========== 各阶段处理函数 ==========
@@ -119,8 +258,6 @@ private:
         // 初始化玩家队列、发初始手牌等
         for (const auto& player : m_playerQueue)
         {
-            auto& handCards = m_context->registry.get<HandCards>(player).handCards;
-            m_context->dispatcher;
             m_context->dispatcher.trigger<events::DealCards>({.player = player, .count = 4});
         }
         transitionToPhase(TurnPhase::START);
@@ -153,7 +290,7 @@ private:
     {
         entt::entity currentPlayer = m_playerQueue.current();
         m_context->logger->info("摸牌阶段 - 玩家: {}", entt::to_integral(currentPlayer));
-        // 触发摸牌事件
+        m_context->dispatcher.trigger(events::DealCards{.player = currentPlayer, .count = rules::DRAW_PER_TURN});
         transitionToPhase(TurnPhase::PLAY);
     }
 
@@ -163,8 +300,9 @@ private:
     void handlePlayPhase()
     {
         m_context->logger->info("出牌阶段");
-        // 等待玩家操作，玩家主动结束出牌阶段
-        // 此阶段通常不自动切换，由玩家行动触发
+        // 等待玩家操作，玩家主动结束出牌阶段（EndPlayPhase）
+        // 超时未操作则视为结束出牌，进入弃牌阶段
+        openResponseWindow(TurnPhase::DISCARD);
     }
 
     /**
@@ -202,5 +340,8 @@ private:
     GameContext* m_context;
     utils::RoundRobin<entt::entity> m_playerQueue;
     TurnPhase m_currentPhase{TurnPhase::GAME_START};
+    bool m_started = false;                         // 已收到 GameStart，重复的开局事件被忽略
+    std::deque<TurnPhase> m_phaseQueue;             // 待执行阶段的运行队列
+    std::optional<ResponseWindow> m_responseWindow; // 当前响应窗口
     absl::flat_hash_map<TurnPhase, entt::delegate<void()>> m_phaseHandlers;
 };
\ No newline at end of file
@@ -53,12 +53,12 @@ private:
             {
                 m_context->logger->info("收到聊天消息 [频道{}]: {}", req.channelId, req.content);
 
-                // 构造响应 (回显)
+                // 构造响应 (回显)，返回完整帧，可直接发送
                 SendMessageToChatResponse resp;
                 resp.sender = 0; // System or User ID
                 resp.chatMessage = "Server Echo: " + req.content;
 
-                return resp.serialize();
+                return encodeMessage(resp);
             });
     }
 
@@ -80,13 +80,10 @@ private:
 
         if (result)
         {
-            // 这里的 result 是 Handler 返回的响应数据 (std::vector<uint8_t>)
-            // 实际应用中，我们需要通过 NetworkManager/Server 发送回客户端
-            // 由于 NetworkMessageSystem 目前没有直接持有 Server 实例，我们这里仅做逻辑处理
-            // 或者触发一个 "SendNetworkPacket" 事件
+            // result 是 Handler 返回的完整响应帧；系统不持有 Server，交给房间的发送队列，由复制阶段发出
             m_context->logger->info("消息处理成功，生成响应 {} 字节", result->size());
-
-            // TODO: m_context->dispatcher.trigger<events::SendNetworkPacket>({event.connectionId, *result});
+            m_context->dispatcher.trigger(events::SendNetworkPacket{.connectionId = event.connectionId,
+                                                                    .frame = SharedFrame(std::move(*result))});
         }
         else
         {
@@ -4,8 +4,11 @@
  * @file SkillSystem.h
  * @author AnakinLiu (azrael2759@qq.com)
  * @date 2025-12-03
- * @version 0.1
+ * @version 0.2
  * @brief 技能系统定义 负责技能的创建与管理 注册技能相关事件
+    维护 (触发时机, 阶段) -> 技能挂钩 的预计算索引:
+    - 角色的 Skills 组件创建/更新/销毁时，仅重建该角色的挂钩
+    - 每个触发点只遍历真正监听该时机的技能，无需广播
  *
  * ************************************************************************
  * @copyright Copyright (c) 2025 AnakinLiu
@@ -13,18 +16,189 @@
  * ************************************************************************
  */
 #pragma once
+#include <algorithm>
+#include <span>
+#include <string>
+#include <utility>
+#include <vector>
 #include <entt/entt.hpp>
 #include <absl/container/flat_hash_map.h>
+#include <absl/container/inlined_vector.h>
 #include "src/server/Interface/ISkill.h"
+#include "src/server/context/GameContext.h"
+#include "src/server/components/Character.h"
+#include "src/server/components/Skill.h"
+#include "src/server/events/Events.h"
+
+/**
+ * @brief 技能挂钩：某个角色持有的、监听某一触发点的技能
+ */
+struct SkillHook
+{
+    entt::entity owner = entt::null; // 技能持有者
+    entt::entity skill = entt::null; // 技能实体
+    uint32_t impl = 0;               // 技能实现在 SkillSystem 中的下标
+};
+
 class SkillSystem
 {
 public:
+    using HookKey = std::pair<TriggerMoment, TurnPhase>;
+
     explicit SkillSystem(GameContext& context) : m_context(&context) {};
 
-    void registerEvents() {}
-    void unregisterEvents() {}
+    void registerEvents()
+    {
+        auto& registry = m_context->registry;
+        registry.on_construct<Skills>().connect<&SkillSystem::onSkillsChanged>(this);
+        registry.on_update<Skills>().connect<&SkillSystem::onSkillsChanged>(this);
+        registry.on_destroy<Skills>().connect<&SkillSystem::onSkillsDestroyed>(this);
+        m_context->dispatcher.sink<events::TriggerMoment>().connect<&SkillSystem::onTriggerMoment>(this);
+        rebuildAll();
+    }
+    void unregisterEvents()
+    {
+        auto& registry = m_context->registry;
+        registry.on_construct<Skills>().disconnect<&SkillSystem::onSkillsChanged>(this);
+        registry.on_update<Skills>().disconnect<&SkillSystem::onSkillsChanged>(this);
+        registry.on_destroy<Skills>().disconnect<&SkillSystem::onSkillsDestroyed>(this);
+        m_context->dispatcher.sink<events::TriggerMoment>().disconnect<&SkillSystem::onTriggerMoment>(this);
+    }
+
+    /**
+     * @brief 注册技能实现
+     * @param name 技能名称，与技能实体的 MetaSkillInfo::name 对应
+     * @param skill 技能实现
+     * @note 新技能名会重建全部挂钩：先于实现创建的 Skills 组件此前忽略了该技能的触发点
+     */
+    template <typename Skill>
+    void registerSkill(std::string name, Skill&& skill)
+    {
+        if (auto iter = m_skillIndex.find(name); iter != m_skillIndex.end())
+        {
+            m_skills[iter->second] = std::forward<Skill>(skill);
+            return;
+        }
+        m_skillIndex.emplace(std::move(name), static_cast<uint32_t>(m_skills.size()));
+        m_skills.emplace_back(std::forward<Skill>(skill));
+        rebuildAll();
+    }
+
+    /**
+     * @brief 获取监听指定触发点的所有技能挂钩
+     * @param moment 触发时机
+     * @param phase 所处阶段
+     * @return 挂钩的连续视图，未监听时为空
+     */
+    [[nodiscard]] std::span<const SkillHook> hooksFor(TriggerMoment moment, TurnPhase phase) const
+    {
+        if (auto iter = m_hooks.find(HookKey{moment, phase}); iter != m_hooks.end())
+        {
+            return iter->second;
+        }
+        return {};
+    }
+
+    /**
+     * @brief 获取挂钩对应的技能实现
+     */
+    [[nodiscard]] const entt::poly<ISkill>& skillOf(const SkillHook& hook) const { return m_skills[hook.impl]; }
+
+    /**
+     * @brief 使用挂钩技能筛选目标
+     * @param hook 技能挂钩
+     * @param candidates 候选实体，只筛选前 MAX_SKILL_TARGETS 个
+     * @param out 调用方提供的输出位集
+     */
+    void filterTargets(const SkillHook& hook, std::span<const entt::entity> candidates, TargetMask& out) const
+    {
+        out.reset();
+        if (candidates.size() > MAX_SKILL_TARGETS)
+        {
+            m_context->logger->warn("技能目标候选 {} 个，超过上限 {}，多余的候选被忽略", candidates.size(),
+                                    MAX_SKILL_TARGETS);
+            candidates = candidates.first(MAX_SKILL_TARGETS);
+        }
+        m_skills[hook.impl]->filterTargets(hook.owner, candidates, out);
+    }
 
 private:
+    void onTriggerMoment(const events::TriggerMoment& event)
+    {
+        for (const auto& hook : hooksFor(event.moment, event.phase))
+        {
+            m_skills[hook.impl]->onUse(hook.owner, event);
+        }
+    }
+
+    void onSkillsChanged(RoomRegistry& registry, entt::entity owner)
+    {
+        removeHooks(owner);
+        addHooks(registry, owner);
+    }
+
+    void onSkillsDestroyed([[maybe_unused]] RoomRegistry& registry, entt::entity owner) { removeHooks(owner); }
+
+    void rebuildAll()
+    {
+        m_hooks.clear();
+        m_ownerKeys.clear();
+        auto& registry = m_context->registry;
+        for (auto owner : registry.view<Skills>())
+        {
+            addHooks(registry, owner);
+        }
+    }
+
+    void addHooks(RoomRegistry& registry, entt::entity owner)
+    {
+        auto& keys = m_ownerKeys[owner];
+        for (auto skill : registry.get<Skills>(owner).skillList)
+        {
+            const auto* triggers = registry.try_get<SkillTriggers>(skill);
+            const auto* meta = registry.try_get<MetaSkillInfo>(skill);
+            if (triggers == nullptr || meta == nullptr)
+            {
+                continue;
+            }
+            auto implIter = m_skillIndex.find(meta->name);
+            if (implIter == m_skillIndex.end())
+            {
+                m_context->logger->warn("技能 {} 未注册实现，忽略其触发点", meta->name);
+                continue;
+            }
+            for (const auto& trigger : triggers->triggers)
+            {
+                HookKey key{trigger.moment, trigger.phase};
+                m_hooks[key].push_back(SkillHook{.owner = owner, .skill = skill, .impl = implIter->second});
+                if (std::ranges::find(keys, key) == keys.end())
+                {
+                    keys.push_back(key);
+                }
+            }
+        }
+    }
+
+    void removeHooks(entt::entity owner)
+    {
+        auto ownerIter = m_ownerKeys.find(owner);
+        if (ownerIter == m_ownerKeys.end())
+        {
+            return;
+        }
+        for (const auto& key : ownerIter->second)
+        {
+            if (auto iter = m_hooks.find(key); iter != m_hooks.end())
+            {
+                std::erase_if(iter->second, [owner](const SkillHook& hook) { return hook.owner == owner; });
+            }
+        }
+        m_ownerKeys.erase(ownerIter);
+    }
+
     GameContext* m_context;
-    absl::flat_hash_map<std::string, entt::poly<ISkill>> m_skillMap;
-};
\ No newline at end of file
+    absl::flat_hash_map<std::string, uint32_t> m_skillIndex;                         // 技能名 -> 实现下标
+    std::vector<entt::poly<ISkill>> m_skills;                                        // 技能实现（稠密存储）
+    absl::flat_hash_map<HookKey, std::vector<SkillHook>> m_hooks;                    // 触发点 -> 挂钩数组
+    absl::flat_hash_map<entt::entity, absl::InlinedVector<HookKey, 4>> m_ownerKeys; // 角色 -> 其挂钩所在触发点
+};
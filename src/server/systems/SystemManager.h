@@ -6,6 +6,8 @@
  * @date 2025-12-05
  * @version 0.1
  * @brief 系统管理器 注册和注销所有系统的事件
+    emplace<System>() 创建的系统由管理器持有，地址在其生命周期内不变（事件连接保存的是 this），
+    接口中只保存指向它的句柄；析构时若已注册则先注销
  *
  * ************************************************************************
  * @copyright Copyright (c) 2025 AnakinLiu
@@ -15,14 +17,45 @@
 
 #pragma once
 
+#include <memory>
+#include <vector>
 #include <entt/entt.hpp>
 #include "src/server/context/GameContext.h"
-#include "src/server/systems/ISystem.h"
+#include "src/server/Interface/ISystem.h"
 
 class SystemManager
 {
 public:
     explicit SystemManager(GameContext& context) : m_context(&context) {}
+
+    SystemManager(const SystemManager&) = delete;
+    SystemManager& operator=(const SystemManager&) = delete;
+    SystemManager(SystemManager&&) = delete;
+    SystemManager& operator=(SystemManager&&) = delete;
+
+    ~SystemManager()
+    {
+        if (m_registered)
+        {
+            unregisterAll();
+        }
+    }
+
+    /**
+     * @brief 创建并持有一个以 GameContext 构造的系统
+     * @return 系统的引用，供需要直接驱动它的调用方使用（如 GameFlowSystem::tick）
+     */
+    template <typename System>
+    System& emplace()
+    {
+        auto system = std::make_shared<System>(*m_context);
+        auto& ref = *system;
+        m_owned.push_back(std::move(system));
+        m_systems.emplace_back(Handle<System>{&ref});
+        m_context->logger->info("系统添加，当前系统数量：{}", m_systems.size());
+        return ref;
+    }
+
     void addSystem(auto system)
     {
         m_context->logger->info("添加系统");
@@ -36,6 +69,7 @@ public:
         {
             system->registerEvents();
         }
+        m_registered = true;
     }
 
     void unregisterAll()
@@ -44,9 +78,24 @@ public:
         {
             system->unregisterEvents();
         }
+        m_registered = false;
     }
 
 private:
+    /**
+     * @brief 指向被持有系统的可拷贝句柄（系统本身可能不可拷贝）
+     */
+    template <typename System>
+    struct Handle
+    {
+        System* system;
+
+        void registerEvents() { system->registerEvents(); }
+        void unregisterEvents() { system->unregisterEvents(); }
+    };
+
+    std::vector<std::shared_ptr<void>> m_owned; // emplace() 创建的系统，先于 m_systems 声明、后于其析构
     std::vector<entt::poly<ISystem>> m_systems;
     GameContext* m_context;
+    bool m_registered = false;
 };
@@ -19,6 +19,7 @@
 #include "src/server/context/GameContext.h"
 #include "src/server/events/Events.h"
 #include "src/server/components/Card.h"
+#include "src/server/rules/CombatRules.h"
 
 class UseCardSystem
 {
@@ -42,7 +43,9 @@ private:
             cet.apply(user, target, m_context->registry); // 执行 delegate
         }
         auto& handCards = m_context->registry.get<HandCards>(user).handCards;
-        std::erase(handCards, card);
+        rules::RemoveCardFromZone(handCards, card);
+        // 一张牌的使用是一个结算步骤：效果产生的伤害在此统一结算
+        m_context->dispatcher.trigger(events::SettleEffects{});
     }
 
     void onCardShown(const events::CardShown& event)
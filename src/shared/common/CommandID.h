@@ -23,16 +23,22 @@
 namespace CommandID
 {
 // ==================== 连接与会话管理 (0x1000-0x10FF) ====================
-constexpr uint16_t CONNECTED = 0x1001;  // 客户端连接请求
-constexpr uint16_t HEARTBEAT = 0x1002;  // 心跳
-constexpr uint16_t DISCONNECT = 0x1003; // 断开连接
+constexpr uint16_t CONNECTED = 0x1001;     // 客户端连接请求
+constexpr uint16_t HEARTBEAT = 0x1002;     // 心跳
+constexpr uint16_t DISCONNECT = 0x1003;    // 断开连接
+
+// ==================== 连接与会话管理响应 (0x2000-0x20FF) ====================
+constexpr uint16_t SESSION_TOKEN = 0x2001; // 会话令牌（服务器下发，用于断线恢复）
 
 // ==================== 房间管理 (0x1100-0x11FF) ====================
 constexpr uint16_t CREATE_ROOM_REQ = 0x1100;  // 创建房间请求
 constexpr uint16_t CREATE_ROOM_RESP = 0x2100; // 创建房间响应
-constexpr uint16_t JOIN_ROOM = 0x1101;        // 加入房间
+constexpr uint16_t JOIN_ROOM = 0x1101;        // 加入房间（房间 ID 为 0 时快速匹配）
+constexpr uint16_t JOIN_ROOM_RESP = 0x2101;   // 加入房间响应
 constexpr uint16_t LEAVE_ROOM = 0x1102;       // 离开房间
 constexpr uint16_t ROOM_LIST = 0x1103;        // 房间列表
+constexpr uint16_t ROOM_LIST_RESP = 0x2103;   // 房间列表响应
+constexpr uint16_t ROOM_SNAPSHOT = 0x2104;    // 对局局面快照（断线恢复后补发）
 
 // ==================== 游戏逻辑 (0x1200-0x12FF) ====================
 constexpr uint16_t USE_CARD_REQ = 0x1200;      // 使用卡牌请求
@@ -25,6 +25,7 @@ enum class MessageError
 {
     BufferTooSmall,
     InvalidFormat,
+    SerializeFailed,
     DeserializeFailed
 };
 
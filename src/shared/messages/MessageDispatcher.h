@@ -16,11 +16,13 @@
 #pragma once
 #include "MessageBase.h"
 #include "src/net/protocol/FrameCodec.h"
+#include "src/net/protocol/SharedFrame.h"
 #include <unordered_map>
 #include <functional>
 #include <span>
 #include <expected>
 #include <memory>
+#include <cstring>
 
 /**
  * @brief 消息处理器基类
@@ -152,24 +154,42 @@ private:
 template <typename MessageType>
 std::expected<std::vector<uint8_t>, MessageError> encodeMessage(const MessageType& message)
 {
-    std::vector<uint8_t> payloadBuffer(1024);
-
     // 序列化消息
-    auto payloadResult = message.serialize(payloadBuffer);
-    if (!payloadResult)
-    {
-        return std::unexpected(payloadResult.error());
-    }
+    const auto payload = message.serialize();
 
     // 编码为帧
-    std::vector<uint8_t> frameBuffer(2048);
-    auto frameResult = encodeFrame(frameBuffer, MessageType::CMD_ID, *payloadResult);
-    if (!frameResult)
+    std::vector<uint8_t> frameBuffer(sizeof(FrameHeader) + payload.size());
+    if (!encodeFrame(frameBuffer, MessageType::CMD_ID, payload))
     {
         return std::unexpected(MessageError::SerializeFailed);
     }
+    return frameBuffer;
+}
+
+/**
+ * @brief 将消息编码为可广播的共享帧
+ *
+ * 载荷直接写在预留的帧头之后，整帧数据不再拷贝（SharedFrame 另有一次分配存放引用计数）；
+ * 返回的 SharedFrame 可投递给任意多个会话
+ * @tparam MessageType 消息类型
+ * @param message 消息对象
+ * @return 成功返回共享帧，载荷超过帧长度上限时返回 SerializeFailed
+ */
+template <typename MessageType>
+std::expected<SharedFrame, MessageError> encodeSharedMessage(const MessageType& message)
+{
+    shared::PacketWriter writer;
+    writer.buffer.resize(sizeof(FrameHeader));
+    message.writeTo(writer);
 
-    return std::vector<uint8_t>(frameResult->begin(), frameResult->end());
+    const size_t payloadSize = writer.buffer.size() - sizeof(FrameHeader);
+    if (payloadSize > UINT16_MAX)
+    {
+        return std::unexpected(MessageError::SerializeFailed);
+    }
+    const FrameHeader header{.cmd = MessageType::CMD_ID, .length = static_cast<uint16_t>(payloadSize)};
+    std::memcpy(writer.buffer.data(), &header, sizeof(FrameHeader));
+    return SharedFrame(std::move(writer.buffer));
 }
 
 /**
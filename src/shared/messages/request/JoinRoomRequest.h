@@ -0,0 +1,41 @@
+/**
+ * ************************************************************************
+ *
+ * @file JoinRoomRequest.h
+ * @author AnakinLiu (azrael2759@qq.com)
+ * @date 2026-10-16
+ * @version 0.1
+ * @brief 加入房间请求消息
+ *
+ * ************************************************************************
+ * @copyright Copyright (c) 2026 AnakinLiu
+ * For study and research only, no reprinting.
+ * ************************************************************************
+ */
+
+#pragma once
+#include "../MessageBase.h"
+#include "src/shared/common/CommandID.h"
+#include <string>
+
+struct JoinRoomRequest : public MessageBase<JoinRoomRequest>
+{
+    static constexpr uint16_t CMD_ID = CommandID::JOIN_ROOM;
+
+    uint32_t roomId = 0;  // 0: 快速匹配
+    std::string password; // 可为空
+
+    void writeTo(shared::PacketWriter& writer) const
+    {
+        writer.writeUint32(roomId);
+        writer.writeString(password);
+    }
+
+    void readFrom(shared::PacketReader& reader)
+    {
+        roomId = reader.readUint32();
+        password = reader.readString();
+    }
+
+    [[nodiscard]] nlohmann::json toJsonImpl() const { return {{"roomId", roomId}, {"password", password}}; }
+};
@@ -0,0 +1,31 @@
+/**
+ * ************************************************************************
+ *
+ * @file LeaveRoomRequest.h
+ * @author AnakinLiu (azrael2759@qq.com)
+ * @date 2026-10-16
+ * @version 0.1
+ * @brief 离开房间请求消息
+ *
+ * ************************************************************************
+ * @copyright Copyright (c) 2026 AnakinLiu
+ * For study and research only, no reprinting.
+ * ************************************************************************
+ */
+
+#pragma once
+#include "../MessageBase.h"
+#include "src/shared/common/CommandID.h"
+
+struct LeaveRoomRequest : public MessageBase<LeaveRoomRequest>
+{
+    static constexpr uint16_t CMD_ID = CommandID::LEAVE_ROOM;
+
+    uint32_t roomId = 0;
+
+    void writeTo(shared::PacketWriter& writer) const { writer.writeUint32(roomId); }
+
+    void readFrom(shared::PacketReader& reader) { roomId = reader.readUint32(); }
+
+    [[nodiscard]] nlohmann::json toJsonImpl() const { return {{"roomId", roomId}}; }
+};
@@ -0,0 +1,29 @@
+/**
+ * ************************************************************************
+ *
+ * @file RoomListRequest.h
+ * @author AnakinLiu (azrael2759@qq.com)
+ * @date 2026-10-16
+ * @version 0.1
+ * @brief 房间列表请求消息（无载荷）
+ *
+ * ************************************************************************
+ * @copyright Copyright (c) 2026 AnakinLiu
+ * For study and research only, no reprinting.
+ * ************************************************************************
+ */
+
+#pragma once
+#include "../MessageBase.h"
+#include "src/shared/common/CommandID.h"
+
+struct RoomListRequest : public MessageBase<RoomListRequest>
+{
+    static constexpr uint16_t CMD_ID = CommandID::ROOM_LIST;
+
+    void writeTo(shared::PacketWriter& /*writer*/) const {}
+
+    void readFrom(shared::PacketReader& /*reader*/) {}
+
+    [[nodiscard]] nlohmann::json toJsonImpl() const { return nlohmann::json::object(); }
+};
@@ -0,0 +1,66 @@
+/**
+ * ************************************************************************
+ *
+ * @file JoinRoomResponse.h
+ * @author AnakinLiu (azrael2759@qq.com)
+ * @date 2026-10-16
+ * @version 0.1
+ * @brief 加入房间响应消息
+ *
+ * ************************************************************************
+ * @copyright Copyright (c) 2026 AnakinLiu
+ * For study and research only, no reprinting.
+ * ************************************************************************
+ */
+
+#pragma once
+#include "../MessageBase.h"
+#include "src/shared/common/CommandID.h"
+
+struct JoinRoomResponse : public MessageBase<JoinRoomResponse>
+{
+    static constexpr uint16_t CMD_ID = CommandID::JOIN_ROOM_RESP;
+
+    uint32_t roomId = 0;   // 房间ID
+    uint8_t seat = 0;      // 座位号
+    bool success = false;  // 是否成功
+    uint8_t errorCode = 0; // 错误码
+
+    static JoinRoomResponse createSuccess(uint32_t roomId, uint8_t seat)
+    {
+        JoinRoomResponse resp;
+        resp.roomId = roomId;
+        resp.seat = seat;
+        resp.success = true;
+        return resp;
+    }
+
+    static JoinRoomResponse createFailed(uint32_t roomId, uint8_t errorCode)
+    {
+        JoinRoomResponse resp;
+        resp.roomId = roomId;
+        resp.errorCode = errorCode;
+        return resp;
+    }
+
+    void writeTo(shared::PacketWriter& writer) const
+    {
+        writer.writeUint32(roomId);
+        writer.writeUint8(seat);
+        writer.writeBool(success);
+        writer.writeUint8(errorCode);
+    }
+
+    void readFrom(shared::PacketReader& reader)
+    {
+        roomId = reader.readUint32();
+        seat = reader.readUint8();
+        success = reader.readBool();
+        errorCode = reader.readUint8();
+    }
+
+    [[nodiscard]] nlohmann::json toJsonImpl() const
+    {
+        return {{"roomId", roomId}, {"seat", seat}, {"success", success}, {"errorCode", errorCode}};
+    }
+};
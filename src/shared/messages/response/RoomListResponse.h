@@ -0,0 +1,76 @@
+/**
+ * ************************************************************************
+ *
+ * @file RoomListResponse.h
+ * @author AnakinLiu (azrael2759@qq.com)
+ * @date 2026-10-16
+ * @version 0.1
+ * @brief 房间列表响应消息（仅列出等待中的房间）
+ *
+ * ************************************************************************
+ * @copyright Copyright (c) 2026 AnakinLiu
+ * For study and research only, no reprinting.
+ * ************************************************************************
+ */
+
+#pragma once
+#include "../MessageBase.h"
+#include "src/shared/common/CommandID.h"
+#include <string>
+#include <vector>
+
+struct RoomListResponse : public MessageBase<RoomListResponse>
+{
+    static constexpr uint16_t CMD_ID = CommandID::ROOM_LIST_RESP;
+
+    struct RoomInfo
+    {
+        uint32_t roomId = 0;
+        std::string name;
+        uint8_t players = 0;    // 当前人数
+        uint8_t maxPlayers = 0; // 座位数
+        bool hasPassword = false;
+    };
+
+    std::vector<RoomInfo> rooms;
+
+    void writeTo(shared::PacketWriter& writer) const
+    {
+        writer.writeUint16(static_cast<uint16_t>(rooms.size()));
+        for (const auto& room : rooms)
+        {
+            writer.writeUint32(room.roomId);
+            writer.writeString(room.name);
+            writer.writeUint8(room.players);
+            writer.writeUint8(room.maxPlayers);
+            writer.writeBool(room.hasPassword);
+        }
+    }
+
+    void readFrom(shared::PacketReader& reader)
+    {
+        rooms.resize(reader.readUint16());
+        for (auto& room : rooms)
+        {
+            room.roomId = reader.readUint32();
+            room.name = reader.readString();
+            room.players = reader.readUint8();
+            room.maxPlayers = reader.readUint8();
+            room.hasPassword = reader.readBool();
+        }
+    }
+
+    [[nodiscard]] nlohmann::json toJsonImpl() const
+    {
+        nlohmann::json list = nlohmann::json::array();
+        for (const auto& room : rooms)
+        {
+            list.push_back({{"roomId", room.roomId},
+                            {"name", room.name},
+                            {"players", room.players},
+                            {"maxPlayers", room.maxPlayers},
+                            {"hasPassword", room.hasPassword}});
+        }
+        return {{"rooms", list}};
+    }
+};
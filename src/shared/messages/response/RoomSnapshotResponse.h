@@ -0,0 +1,135 @@
+/**
+ * ************************************************************************
+ *
+ * @file RoomSnapshotResponse.h
+ * @author AnakinLiu (azrael2759@qq.com)
+ * @date 2026-10-16
+ * @version 0.1
+ * @brief 对局局面快照（断线恢复后补发给重连的座位）
+    - 公开信息：当前阶段、当前行动座位、各座位的体力与手牌数
+    - 私有信息：只包含接收者自己的手牌
+ *
+ * ************************************************************************
+ * @copyright Copyright (c) 2026 AnakinLiu
+ * For study and research only, no reprinting.
+ * ************************************************************************
+ */
+
+#pragma once
+#include "../MessageBase.h"
+#include "src/shared/common/CommandID.h"
+#include <string>
+#include <vector>
+
+struct RoomSnapshotResponse : public MessageBase<RoomSnapshotResponse>
+{
+    static constexpr uint16_t CMD_ID = CommandID::ROOM_SNAPSHOT;
+    static constexpr uint8_t NO_SEAT = 0xFF; // 尚无行动座位（开局阶段未执行）
+
+    struct SeatInfo
+    {
+        uint32_t playerId = 0;
+        int32_t health = 0;
+        uint32_t maxHealth = 0;
+        uint8_t handCount = 0;
+        bool offline = false;
+    };
+
+    struct CardInfo
+    {
+        uint32_t cardId = 0; // 房间内的卡牌实体 ID，出牌请求按它引用
+        std::string name;
+        uint8_t point = 0;
+        uint8_t suit = 0; // SuitType 的底层值
+    };
+
+    uint32_t roomId = 0;
+    uint8_t seat = 0;              // 接收者的座位
+    uint8_t phase = 0;             // TurnPhase 的底层值
+    uint8_t currentSeat = NO_SEAT; // 当前行动的座位
+    uint32_t round = 0;
+    uint8_t responseTime = 0;    // 响应窗口（秒）
+    std::vector<SeatInfo> seats; // 按座位顺序
+    std::vector<CardInfo> hand;  // 接收者的手牌
+
+    void writeTo(shared::PacketWriter& writer) const
+    {
+        writer.writeUint32(roomId);
+        writer.writeUint8(seat);
+        writer.writeUint8(phase);
+        writer.writeUint8(currentSeat);
+        writer.writeUint32(round);
+        writer.writeUint8(responseTime);
+        writer.writeUint8(static_cast<uint8_t>(seats.size()));
+        for (const auto& info : seats)
+        {
+            writer.writeUint32(info.playerId);
+            writer.writeUint32(static_cast<uint32_t>(info.health));
+            writer.writeUint32(info.maxHealth);
+            writer.writeUint8(info.handCount);
+            writer.writeBool(info.offline);
+        }
+        writer.writeUint16(static_cast<uint16_t>(hand.size()));
+        for (const auto& card : hand)
+        {
+            writer.writeUint32(card.cardId);
+            writer.writeString(card.name);
+            writer.writeUint8(card.point);
+            writer.writeUint8(card.suit);
+        }
+    }
+
+    void readFrom(shared::PacketReader& reader)
+    {
+        roomId = reader.readUint32();
+        seat = reader.readUint8();
+        phase = reader.readUint8();
+        currentSeat = reader.readUint8();
+        round = reader.readUint32();
+        responseTime = reader.readUint8();
+        seats.resize(reader.readUint8());
+        for (auto& info : seats)
+        {
+            info.playerId = reader.readUint32();
+            info.health = static_cast<int32_t>(reader.readUint32());
+            info.maxHealth = reader.readUint32();
+            info.handCount = reader.readUint8();
+            info.offline = reader.readBool();
+        }
+        hand.resize(reader.readUint16());
+        for (auto& card : hand)
+        {
+            card.cardId = reader.readUint32();
+            card.name = reader.readString();
+            card.point = reader.readUint8();
+            card.suit = reader.readUint8();
+        }
+    }
+
+    [[nodiscard]] nlohmann::json toJsonImpl() const
+    {
+        nlohmann::json seatList = nlohmann::json::array();
+        for (const auto& info : seats)
+        {
+            seatList.push_back({{"playerId", info.playerId},
+                                {"health", info.health},
+                                {"maxHealth", info.maxHealth},
+                                {"handCount", info.handCount},
+                                {"offline", info.offline}});
+        }
+        nlohmann::json cardList = nlohmann::json::array();
+        for (const auto& card : hand)
+        {
+            cardList.push_back(
+                {{"cardId", card.cardId}, {"name", card.name}, {"point", card.point}, {"suit", card.suit}});
+        }
+        return {{"roomId", roomId},
+                {"seat", seat},
+                {"phase", phase},
+                {"currentSeat", currentSeat},
+                {"round", round},
+                {"responseTime", responseTime},
+                {"seats", seatList},
+                {"hand", cardList}};
+    }
+};
@@ -1,37 +1,33 @@
 // =========================================================================
 // SDL3 GPU 着色器公共定义
-// 支持：圆角矩形 UI、外发光阴影、抗锯齿裁切、整体透明度
+// 支持：圆角矩形 UI、外发光阴影、抗锯齿裁切、整体透明度（均为逐实例参数）
 // 兼容 Vulkan 和 DX12 后端
 // =========================================================================
 
 // --- 0. Uniform Buffer (必须与 C++ 结构体 16 字节对齐) ---
-// D3D12 后端的 Root Signature 使用不同的 register space：
-// VS: space1, PS: space3。Vulkan 下也保持一致即可。
+// 只剩整帧不变的屏幕尺寸，只有顶点着色器使用；
+// 矩形尺寸、圆角、阴影与透明度随实例传入，参数不同的矩形可以在同一次绘制中完成。
+// D3D12 后端的 Root Signature 使用不同的 register space：VS: space1。Vulkan 下也保持一致即可。
 #if defined(UI_STAGE_VERTEX)
 cbuffer UiConstants : register(b0, space1)
-#elif defined(UI_STAGE_PIXEL)
-cbuffer UiConstants : register(b0, space3)
-#else
-cbuffer UiConstants : register(b0)
-#endif
 {
-    float2 screen_size;    // 屏幕尺寸 (用于坐标转换)
-    float2 rect_size;      // 矩形实际像素尺寸 (用于 SDF 计算)
-    float4 radius;         // 四个角的半径 (x:左上, y:右上, z:右下, w:左下)
-    float shadow_soft;     // 阴影柔和度 (像素单位，0则无阴影)
-    float shadow_offset_x; // 阴影偏移 X
-    float shadow_offset_y; // 阴影偏移 Y
-    float opacity;         // 整体透明度 (0.0 - 1.0)
-    float _padding;        // 填充位，保证结构体对齐
+    float2 screen_size; // 屏幕尺寸 (用于坐标转换)
+    float2 _padding;    // 填充位，保证结构体对齐
 };
+#endif
 
 // --- 1. 输入输出结构 ---
+// 每个矩形一个实例（与 C++ 的 render::QuadInstance 对应），4 个角由 SV_VertexID 展开
 struct VSInput
 {
-    // D3D12 后端使用统一的语义名（默认 TEXCOORD），此处用 TEXCOORD0/1/2 对齐
-    float2 position : TEXCOORD0;
-    float2 texcoord : TEXCOORD1;
+    uint vertex_id : SV_VertexID;
+    // D3D12 后端使用统一的语义名（默认 TEXCOORD），此处用 TEXCOORD0~5 对齐
+    float4 rect : TEXCOORD0;    // 屏幕矩形 (x, y, 宽, 高)
+    float4 uv_rect : TEXCOORD1; // UV 矩形 (u0, v0, u1, v1)
     float4 color : TEXCOORD2;
+    float4 radius : TEXCOORD3;  // 四个角的半径 (x:左上, y:右上, z:右下, w:左下)
+    float4 shadow : TEXCOORD4;  // x:阴影柔和度, 0则无阴影; yz:偏移; w:整体透明度 (0.0 - 1.0)
+    uint flags : TEXCOORD5;     // bit0: 纹理为预乘 Alpha
 };
 
 struct PSInput
@@ -39,6 +35,12 @@ struct PSInput
     float4 sv_position : SV_POSITION;
     float2 texcoord : TEXCOORD0;
     float4 color : TEXCOORD1;
+    // 同一矩形的 4 个顶点参数相同，不做插值
+    nointerpolation float2 rect_size : TEXCOORD2;
+    nointerpolation float4 radius : TEXCOORD3;
+    nointerpolation float3 shadow : TEXCOORD4;
+    nointerpolation float2 style : TEXCOORD5; // x:整体透明度; y:>0.5 表示纹理为预乘 Alpha
+    float2 local : TEXCOORD6;                 // 矩形内的归一化坐标 [0, 1]（用于 SDF，与图集 UV 无关）
 };
 
 // --- 2. 纹理定义 ---
@@ -2,6 +2,7 @@
 chcp 65001 >nul
 REM 编译 HLSL 着色器到 SPIR-V 和 DXIL
 REM 需要安装 DirectXShaderCompiler (dxc)
+REM 仅用于手动检查 HLSL 能否编译；构建时由 CMake 编译到构建目录并嵌入资源，这里的输出不入库
 
 echo Compiling shaders...
 
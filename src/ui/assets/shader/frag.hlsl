@@ -24,13 +24,13 @@ float4 main_ps(PSInput input) : SV_Target
     // ------------------------------------------------------------
     // 1. 像素坐标（以矩形中心为原点）
     // ------------------------------------------------------------
-    float2 p = (input.texcoord - 0.5) * rect_size;
-    float2 half_size = rect_size * 0.5;
+    float2 p = (input.local - 0.5) * input.rect_size;
+    float2 half_size = input.rect_size * 0.5;
 
     // ------------------------------------------------------------
     // 2. 主体 SDF
     // ------------------------------------------------------------
-    float dist = sdRoundedBox(p, half_size, radius);
+    float dist = sdRoundedBox(p, half_size, input.radius);
 
     float edge = fwidth(dist);
     float body_mask = 1.0 - smoothstep(-edge, edge, dist);
@@ -39,11 +39,12 @@ float4 main_ps(PSInput input) : SV_Target
     // 3. 阴影 SDF（只影响主体外部）
     // ------------------------------------------------------------
     float shadow_alpha = 0.0;
+    float shadow_soft = input.shadow.x;
 
     if (shadow_soft > 0.0)
     {
-        float2 shadow_p = p - float2(shadow_offset_x, shadow_offset_y);
-        float dist_shadow = sdRoundedBox(shadow_p, half_size, radius);
+        float2 shadow_p = p - input.shadow.yz;
+        float dist_shadow = sdRoundedBox(shadow_p, half_size, input.radius);
 
         shadow_alpha =
             1.0 - smoothstep(-shadow_soft, shadow_soft, dist_shadow);
@@ -64,9 +65,9 @@ float4 main_ps(PSInput input) : SV_Target
     // 主体 alpha
     float body_alpha = color.a * body_mask;
 
-    // _padding > 0.5 表示纹理已经是预乘 Alpha（如文本位图），
+    // style.y > 0.5 表示纹理已经是预乘 Alpha（如文本位图），
     // 此时 color.rgb 已包含 alpha 信息，只需乘以 body_mask 即可
-    float3 body_rgb = (_padding > 0.5)
+    float3 body_rgb = (input.style.y > 0.5)
         ? color.rgb * body_mask   // 预乘纹理：避免二次预乘
         : color.rgb * body_alpha; // 直通纹理：手动预乘
 
@@ -83,8 +84,8 @@ float4 main_ps(PSInput input) : SV_Target
     float3 out_rgb = body_rgb + shadow_rgb;
 
     // 全局透明度（UI 树 Alpha）
-    out_alpha *= opacity;
-    out_rgb *= opacity;
+    out_alpha *= input.style.x;
+    out_rgb *= input.style.x;
 
     // 剔除无效像素
     if (out_alpha < 0.001)
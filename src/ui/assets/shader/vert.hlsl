@@ -3,17 +3,31 @@
 
 // =========================================================================
 // 顶点着色器 (Vertex Shader)
+// 静态单位矩形：两个三角形 (0,1,2) (0,2,3)，角的顺序为左上、右上、右下、左下
 // =========================================================================
+static const float2 UNIT_QUAD[6] = {
+    float2(0.0f, 0.0f), float2(1.0f, 0.0f), float2(1.0f, 1.0f),
+    float2(0.0f, 0.0f), float2(1.0f, 1.0f), float2(0.0f, 1.0f)
+};
+
 PSInput main_vs(VSInput input)
 {
     PSInput output;
 
+    float2 corner = UNIT_QUAD[input.vertex_id % 6];
+    float2 position = input.rect.xy + corner * input.rect.zw;
+
     // 将像素坐标转为 NDC [-1, 1], 原点设在左上角, Y轴向下
-    float2 ndc = float2((input.position.x / screen_size.x) * 2.0f - 1.0f,
-                        1.0f - (input.position.y / screen_size.y) * 2.0f);
+    float2 ndc = float2((position.x / screen_size.x) * 2.0f - 1.0f,
+                        1.0f - (position.y / screen_size.y) * 2.0f);
 
     output.sv_position = float4(ndc, 0.0f, 1.0f);
-    output.texcoord = input.texcoord;
+    output.texcoord = lerp(input.uv_rect.xy, input.uv_rect.zw, corner);
     output.color = input.color;
+    output.rect_size = input.rect.zw;
+    output.radius = input.radius;
+    output.shadow = input.shadow.xyz;
+    output.style = float2(input.shadow.w, (input.flags & 1u) != 0u ? 1.0f : 0.0f);
+    output.local = corner;
     return output;
 }
\ No newline at end of file
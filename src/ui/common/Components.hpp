@@ -21,6 +21,7 @@
 #include <vector>
 #include <functional>
 #include <cfloat>
+#include <cstdint>
 #include <entt/entt.hpp>
 #include "Policies.hpp"
 
@@ -239,6 +240,45 @@ struct Text
     policies::TextFlag flags = policies::TextFlag::Default;    // 其他文本属性
 };
 
+/**
+ * @brief 排版后的字形：码点与相对行首的笔位置
+ */
+struct TextLayoutGlyph
+{
+    uint32_t codepoint = 0; // 0 表示非法字节，不绘制
+    float x = 0.0F;
+};
+
+/**
+ * @brief 排版后的一行：content 中的字节区间与 glyphs 中的字形区间
+ */
+struct TextLayoutLine
+{
+    uint32_t begin = 0;
+    uint32_t end = 0;
+    uint32_t firstGlyph = 0;
+    uint32_t glyphCount = 0;
+    float width = 0.0F;
+};
+
+/**
+ * @brief 文本排版缓存（由 TextRenderer 维护，见 utils::UpdateTextLayout）
+ *
+ * 内容、字体、字号或换行宽度不变时直接复用，渲染只遍历已排版的字形
+ */
+struct TextLayout
+{
+    using is_component_tag = void;
+    std::string content; // 排版时的文本副本，用于检测变化
+    float fontSize = 0.0F;
+    float maxWidth = 0.0F; // 0 表示不换行
+    policies::TextWrap wrapMode = policies::TextWrap::NONE;
+    uint32_t fontGeneration = 0; // 0 表示尚未排版
+    float lineHeight = 0.0F;
+    std::vector<TextLayoutLine> lines;
+    std::vector<TextLayoutGlyph> glyphs;
+};
+
 /**
  * @brief 文本编辑框数据组件
  */
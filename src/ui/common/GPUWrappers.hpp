@@ -116,6 +116,7 @@ using UniqueGPUShader = std::unique_ptr<SDL_GPUShader, GPUResourceDeleter<SDL_Re
 using UniqueGPUSampler = std::unique_ptr<SDL_GPUSampler, GPUResourceDeleter<SDL_ReleaseGPUSampler>>;
 using UniqueGPUGraphicsPipeline =
     std::unique_ptr<SDL_GPUGraphicsPipeline, GPUResourceDeleter<SDL_ReleaseGPUGraphicsPipeline>>;
+using UniqueGPUFence = std::unique_ptr<SDL_GPUFence, GPUResourceDeleter<SDL_ReleaseGPUFence>>;
 
 /**
  * @brief Helper to create a GPU resource unique_ptr
@@ -1,8 +1,11 @@
 #pragma once
+#include <algorithm>
+#include <bit>
+#include <cmath>
 #include <cstdint>
+#include <limits>
 #include <vector>
 #include <optional>
-#include <memory_resource>
 #include <SDL3/SDL_gpu.h>
 #include <SDL3/SDL_rect.h>
 
@@ -10,58 +13,193 @@ namespace ui::render
 {
 /**
  * @brief UI 着色器推送常量结构
+ *
+ * 只保留整帧不变的屏幕尺寸；矩形尺寸、圆角、阴影与透明度随实例传入，
+ * 参数不同的矩形可以合并到同一批次
  */
 struct alignas(16) UiPushConstants
 {
-    float screen_size[2];  // 屏幕尺寸 (float2)
-    float rect_size[2];    // 矩形尺寸 (float2)
-    float radius[4];       // 四角圆角 (float4: 左上, 右上, 右下, 左下)
-    float shadow_soft;     // 阴影柔和度
-    float shadow_offset_x; // 阴影 X 偏移
-    float shadow_offset_y; // 阴影 Y 偏移
-    float opacity;         // 整体透明度
-    float padding;         // 标志位：>0.5 表示纹理为预乘 Alpha（用于文本/图标）
+    float screen_size[2]; // 屏幕尺寸 (float2)
+    float padding[2];     // 填充位，保证 16 字节对齐
 };
+
+/**
+ * @brief 单个矩形的 SDF 参数，由 BatchManager::addRect 打包进该矩形的实例
+ */
+struct ShapeParams
+{
+    float radius[4] = {};       // 四角圆角 (左上, 右上, 右下, 左下)
+    float shadowSoft = 0.0F;    // 阴影柔和度，0 表示无阴影
+    float shadowOffset[2] = {}; // 阴影偏移
+    float opacity = 1.0F;       // 整体透明度
+    bool premultiplied = false; // 纹理为预乘 Alpha（文本/图标）
+};
+
+/**
+ * @brief 矩形实例（48 字节）
+ *
+ * 每个矩形一条记录，顶点着色器按 SV_VertexID 把静态单位矩形的 4 个角展开到 rect 上。
+ * 颜色为 RGBA8，UV 为 unorm16，圆角、阴影与透明度为半精度浮点
+ */
+struct QuadInstance
+{
+    static constexpr uint32_t FLAG_PREMULTIPLIED = 1U; // 纹理为预乘 Alpha（文本/图标）
+
+    float rect[4];      // TEXCOORD0 屏幕矩形 (x, y, 宽, 高)
+    uint16_t uvRect[4]; // TEXCOORD1 UV 矩形 (u0, v0, u1, v1)
+    uint8_t color[4];   // TEXCOORD2 颜色 (R, G, B, A)
+    uint16_t radius[4]; // TEXCOORD3 四角圆角 (左上, 右上, 右下, 左下)
+    uint16_t shadow[4]; // TEXCOORD4 (阴影柔和度, 阴影偏移 X, 阴影偏移 Y, 整体透明度)
+    uint32_t flags;     // TEXCOORD5 FLAG_*
+};
+static_assert(sizeof(QuadInstance) == 48, "QuadInstance must match the vertex input layout");
+
+/**
+ * @brief float 转半精度（就近舍入，超出范围时饱和到最大有限值）
+ */
+inline uint16_t packHalf(float value)
+{
+    const auto bits = std::bit_cast<uint32_t>(value);
+    const auto sign = static_cast<uint16_t>((bits >> 16) & 0x8000U);
+    const uint32_t magnitude = bits & 0x7FFFFFFFU;
+    if (magnitude >= 0x477FF000U) // >= 65520（含无穷大与 NaN）
+    {
+        return static_cast<uint16_t>(sign | 0x7BFFU);
+    }
+    if (magnitude < 0x38800000U) // 小于 2^-14：非规格化数
+    {
+        if (magnitude < 0x33000000U) return sign;
+        const uint32_t mantissa = (magnitude & 0x7FFFFFU) | 0x800000U;
+        const uint32_t shift = 126U - (magnitude >> 23);
+        uint32_t half = mantissa >> shift;
+        const uint32_t rest = mantissa & ((1U << shift) - 1U);
+        const uint32_t halfway = 1U << (shift - 1U);
+        if (rest > halfway || (rest == halfway && (half & 1U) != 0U)) ++half;
+        return static_cast<uint16_t>(sign | half);
+    }
+    const uint32_t rebased = magnitude - 0x38000000U; // 指数偏置 127 -> 15
+    const uint32_t half = (rebased + 0xFFFU + ((rebased >> 13) & 1U)) >> 13;
+    return static_cast<uint16_t>(sign | half);
+}
+
+/**
+ * @brief 半精度转 float
+ */
+inline float unpackHalf(uint16_t half)
+{
+    const uint32_t sign = static_cast<uint32_t>(half & 0x8000U) << 16;
+    const uint32_t exponent = (half >> 10) & 0x1FU;
+    const uint32_t mantissa = half & 0x3FFU;
+    if (exponent == 0)
+    {
+        const float value = std::ldexp(static_cast<float>(mantissa), -24);
+        return sign != 0 ? -value : value;
+    }
+    const uint32_t rebased = exponent == 0x1FU ? 0xFFU : exponent + 112U;
+    return std::bit_cast<float>(sign | (rebased << 23) | (mantissa << 13));
+}
+
+/**
+ * @brief [0, 1] 映射到 unorm8 / unorm16（超出范围时截断）
+ */
+inline uint8_t packUnorm8(float value)
+{
+    return static_cast<uint8_t>(std::lround(std::clamp(value, 0.0F, 1.0F) * 255.0F));
+}
+
+inline uint16_t packUnorm16(float value)
+{
+    return static_cast<uint16_t>(std::lround(std::clamp(value, 0.0F, 1.0F) * 65535.0F));
+}
+
+/**
+ * @brief 批次覆盖的屏幕区域（像素），BatchManager::optimize 据此判断两个批次能否交换绘制顺序
+ */
+struct BatchBounds
+{
+    float minX = std::numeric_limits<float>::max();
+    float minY = std::numeric_limits<float>::max();
+    float maxX = std::numeric_limits<float>::lowest();
+    float maxY = std::numeric_limits<float>::lowest();
+
+    void expand(float x, float y)
+    {
+        minX = std::min(minX, x);
+        minY = std::min(minY, y);
+        maxX = std::max(maxX, x);
+        maxY = std::max(maxY, y);
+    }
+
+    void merge(const BatchBounds& other)
+    {
+        minX = std::min(minX, other.minX);
+        minY = std::min(minY, other.minY);
+        maxX = std::max(maxX, other.maxX);
+        maxY = std::max(maxY, other.maxY);
+    }
+
+    /**
+     * @brief 是否相交（仅接触边缘不算）
+     */
+    [[nodiscard]] bool overlaps(const BatchBounds& other) const
+    {
+        return minX < other.maxX && other.minX < maxX && minY < other.maxY && other.minY < maxY;
+    }
+};
+
 /**
- * @brief 顶点结构
+ * @brief 整帧实例流中的一段连续实例
  */
-struct Vertex
+struct InstanceRange
 {
-    float position[2]; // POSITION
-    float texCoord[2]; // TEXCOORD0
-    float color[4];    // COLOR0
+    uint32_t firstInstance = 0;
+    uint32_t instanceCount = 0;
 };
 
 /**
  * @brief 渲染批次结构
+ *
+ * 实例写在 BatchManager 的整帧实例流中，批次只记录位置。收集时一个批次是一段连续实例；
+ * optimize 合并后可以由多段组成（BatchManager::getRanges），上传时按批次顺序把各段复制到 GPU 缓冲区
  */
 struct RenderBatch
 {
-    using allocator_type = std::pmr::polymorphic_allocator<std::byte>;
-
-    std::pmr::vector<Vertex> vertices;
-    std::pmr::vector<uint16_t> indices;
     UiPushConstants pushConstants{};
     SDL_GPUTexture* texture = nullptr;
     std::optional<SDL_Rect> scissorRect;
+    BatchBounds bounds;         // 矩形包围盒
+    uint32_t layer = 0;         // Z 层（最后写入的内容所在层），只在同层内重排
+    uint32_t instanceCount = 0; // 矩形数（合并后为各段之和）
+    uint32_t firstInstance = 0; // 收集时为在整帧实例流中的起始位置，optimize 后为在 GPU 实例缓冲区中的位置
+    uint32_t firstRange = 0;    // 在 BatchManager::getRanges() 中的第一段（optimize 后有效）
+    uint32_t rangeCount = 0;    // 段数（optimize 后有效）
+};
 
-    // PMR 兼容构造函数
-    RenderBatch(allocator_type alloc = {}) : vertices(alloc), indices(alloc) {}
+/**
+ * @brief 一段录制下来的几何：同一纹理与裁剪区域下连续写入的矩形
+ */
+struct RecordedBatch
+{
+    SDL_GPUTexture* texture = nullptr;
+    std::optional<SDL_Rect> scissorRect;
+    uint32_t firstInstance = 0; // 在 RecordedGeometry::instances 中的起始位置
+    uint32_t instanceCount = 0;
+    BatchBounds bounds;
+};
 
-    RenderBatch(const RenderBatch& other, allocator_type alloc = {})
-        : vertices(other.vertices, alloc), indices(other.indices, alloc), pushConstants(other.pushConstants),
-          texture(other.texture), scissorRect(other.scissorRect)
-    {
-    }
+/**
+ * @brief 一个渲染记录生成的全部几何，内容未变化时由 BatchManager::replay 原样写回批次
+ */
+struct RecordedGeometry
+{
+    std::vector<RecordedBatch> batches;
+    std::vector<QuadInstance> instances;
 
-    RenderBatch(RenderBatch&& other, allocator_type alloc = {})
-        : vertices(std::move(other.vertices), alloc), indices(std::move(other.indices), alloc),
-          pushConstants(other.pushConstants), texture(other.texture), scissorRect(other.scissorRect)
+    void clear()
     {
+        batches.clear();
+        instances.clear();
     }
-
-    RenderBatch& operator=(const RenderBatch&) = default;
-    RenderBatch& operator=(RenderBatch&&) = default;
 };
 
 // 纹理缓存条目（用于文本）
@@ -0,0 +1,249 @@
+/**
+ * ************************************************************************
+ *
+ * @file RenderCache.hpp
+ * @author AnakinLiu (azrael2759@qq.com)
+ * @date 2026-10-16
+ * @version 0.1
+ * @brief 保留模式渲染缓存 - 跨帧保留渲染队列与每条记录生成的几何
+ *
+ * 每个窗口一份。每帧：
+ * - 结构变化（增删节点、显隐、Z 序）时整体重建队列，否则只对标记的子树调用 RenderQueue::refresh
+ * - 标记为脏的实体，以及位置、大小、透明度或裁剪区域变化的记录，重新调用渲染器并录制几何
+ * - 其余记录直接回放上一次录制的几何（整段复制实例），不调用渲染器
+ * 悬停一个按钮只重新遍历该按钮的子树、重新生成该按钮的几何
+ *
+ * 渲染器的输出必须只取决于实体自身的组件与记录中的位置、大小、透明度和裁剪区域；
+ * 纹理或 UV 失效（图集重建、字体重新加载等）时由调用方 invalidate()
+ *
+ * ************************************************************************
+ * @copyright Copyright (c) 2026 AnakinLiu
+ * For study and research only, no reprinting.
+ * ************************************************************************
+ */
+
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <span>
+#include <unordered_map>
+#include <vector>
+#include <Eigen/Dense>
+#include <SDL3/SDL_rect.h>
+#include <entt/entt.hpp>
+#include "../common/RenderTypes.hpp"
+#include "../managers/BatchManager.hpp"
+#include "../interface/IRenderer.hpp"
+#include "RenderContext.hpp"
+#include "RenderQueue.hpp"
+
+namespace ui::core
+{
+
+class RenderCache
+{
+public:
+    /**
+     * @brief 最近一次 collect 的统计
+     */
+    struct Stats
+    {
+        uint32_t regeneratedItems = 0; // 调用渲染器重新生成几何的记录数
+        uint32_t reusedItems = 0;      // 直接回放的记录数
+        bool queueRebuilt = false;     // 是否整体重建了渲染队列
+    };
+
+    /**
+     * @brief 丢弃全部几何并在下一帧重建队列
+     */
+    void invalidate()
+    {
+        m_rebuildQueue = true;
+        for (auto& cached : m_cached)
+        {
+            cached.valid = false;
+        }
+    }
+
+    /**
+     * @brief 树结构变化（节点增删、显隐、Z 序），下一帧重建队列；未变化的记录仍可复用几何
+     */
+    void markStructureChanged() { m_rebuildQueue = true; }
+
+    /**
+     * @brief 实体的组件变化：重新遍历它的子树，并重新生成它自己的几何
+     */
+    void markDirty(entt::entity entity) { m_dirtySubtrees.push_back(entity); }
+
+    /**
+     * @brief 只重新生成实体自己的几何（位置与子树不受影响）
+     */
+    void markGeometryDirty(entt::entity entity) { m_dirtyGeometry.push_back(entity); }
+
+    /**
+     * @brief 把 root 的可见子树写入 context.batchManager
+     * @param context 资源管理器等字段由调用方填好，位置、大小、透明度与裁剪区域逐条填入
+     */
+    void collect(entt::entity root,
+                 const Eigen::Vector2f& rootOffset,
+                 std::span<const std::unique_ptr<IRenderer>> renderers,
+                 RenderContext& context)
+    {
+        m_stats = {};
+        managers::BatchManager& batchManager = *context.batchManager;
+
+        // 屏幕尺寸变化时渲染器可能按新尺寸生成几何
+        if (context.screenWidth != m_screenWidth || context.screenHeight != m_screenHeight)
+        {
+            m_screenWidth = context.screenWidth;
+            m_screenHeight = context.screenHeight;
+            invalidate();
+        }
+
+        if (m_rebuildQueue || root != m_root || rootOffset != m_rootOffset)
+        {
+            rebuild(root, rootOffset, renderers);
+        }
+        else
+        {
+            for (entt::entity entity : m_dirtySubtrees)
+            {
+                if (!m_queue.refresh(entity, renderers))
+                {
+                    rebuild(root, rootOffset, renderers);
+                    break;
+                }
+            }
+        }
+
+        invalidateItems(m_dirtySubtrees);
+        invalidateItems(m_dirtyGeometry);
+        m_dirtySubtrees.clear();
+        m_dirtyGeometry.clear();
+
+        const auto& items = m_queue.items();
+        for (const uint32_t index : m_queue.order())
+        {
+            const RenderItem& item = items[index];
+            CachedItem& cached = m_cached[index];
+            const std::optional<SDL_Rect> scissor = m_queue.scissor(item.scissorIndex);
+
+            batchManager.setLayer(static_cast<uint32_t>(item.sortKey >> 32));
+            if (cached.valid && cached.matches(item, scissor))
+            {
+                batchManager.replay(cached.geometry);
+                ++m_stats.reusedItems;
+                continue;
+            }
+
+            m_queue.apply(item, context);
+            batchManager.beginRecording(cached.geometry);
+            item.renderer->collect(item.entity, context);
+            batchManager.endRecording();
+
+            cached.position = item.position;
+            cached.size = item.size;
+            cached.alpha = item.alpha;
+            cached.scissor = scissor;
+            cached.valid = true;
+            ++m_stats.regeneratedItems;
+        }
+    }
+
+    [[nodiscard]] const RenderQueue& queue() const { return m_queue; }
+    [[nodiscard]] const Stats& stats() const { return m_stats; }
+
+private:
+    /**
+     * @brief 一条记录上次生成几何时的输入与录制结果
+     */
+    struct CachedItem
+    {
+        Eigen::Vector2f position{0.0F, 0.0F};
+        Eigen::Vector2f size{0.0F, 0.0F};
+        float alpha = 1.0F;
+        std::optional<SDL_Rect> scissor;
+        render::RecordedGeometry geometry;
+        bool valid = false;
+
+        [[nodiscard]] bool matches(const RenderItem& item, const std::optional<SDL_Rect>& rect) const
+        {
+            if (position != item.position || size != item.size || alpha != item.alpha) return false;
+            if (scissor.has_value() != rect.has_value()) return false;
+            return !rect.has_value() || (scissor->x == rect->x && scissor->y == rect->y && scissor->w == rect->w &&
+                                         scissor->h == rect->h);
+        }
+    };
+
+    static uint64_t itemKey(const RenderItem& item)
+    {
+        return (static_cast<uint64_t>(entt::to_integral(item.entity)) << 32) | item.rendererIndex;
+    }
+
+    /**
+     * @brief 整体重建队列，按 (实体, 渲染器) 把已有的几何移交给新队列中的同一记录
+     */
+    void rebuild(entt::entity root,
+                 const Eigen::Vector2f& rootOffset,
+                 std::span<const std::unique_ptr<IRenderer>> renderers)
+    {
+        std::unordered_map<uint64_t, CachedItem> previous;
+        const auto& oldItems = m_queue.items();
+        for (size_t index = 0; index < m_cached.size() && index < oldItems.size(); ++index)
+        {
+            if (m_cached[index].valid)
+            {
+                previous.emplace(itemKey(oldItems[index]), std::move(m_cached[index]));
+            }
+        }
+
+        m_queue.clear();
+        m_queue.build(root, rootOffset, renderers);
+        m_queue.sort();
+
+        const auto& items = m_queue.items();
+        m_cached.clear();
+        m_cached.resize(items.size());
+        if (!previous.empty())
+        {
+            for (size_t index = 0; index < items.size(); ++index)
+            {
+                if (auto iter = previous.find(itemKey(items[index])); iter != previous.end())
+                {
+                    m_cached[index] = std::move(iter->second);
+                }
+            }
+        }
+
+        m_root = root;
+        m_rootOffset = rootOffset;
+        m_rebuildQueue = false;
+        m_stats.queueRebuilt = true;
+    }
+
+    void invalidateItems(const std::vector<entt::entity>& entities)
+    {
+        for (entt::entity entity : entities)
+        {
+            const auto [first, count] = m_queue.itemRange(entity);
+            for (uint32_t index = first; index < first + count; ++index)
+            {
+                m_cached[index].valid = false;
+            }
+        }
+    }
+
+    RenderQueue m_queue;
+    std::vector<CachedItem> m_cached; // 与 m_queue.items() 一一对应
+    std::vector<entt::entity> m_dirtySubtrees;
+    std::vector<entt::entity> m_dirtyGeometry;
+    entt::entity m_root = entt::null;
+    Eigen::Vector2f m_rootOffset{0.0F, 0.0F};
+    float m_screenWidth = 0.0F;
+    float m_screenHeight = 0.0F;
+    bool m_rebuildQueue = true;
+    Stats m_stats;
+};
+
+} // namespace ui::core
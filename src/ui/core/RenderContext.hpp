@@ -17,7 +17,8 @@
 #include <Eigen/Dense>
 #include <SDL3/SDL_rect.h>
 #include <SDL3/SDL_gpu.h>
-#include <vector>
+#include <array>
+#include <cstddef>
 #include <optional>
 
 namespace ui::managers
@@ -26,6 +27,7 @@ class DeviceManager;
 class FontManager;
 class IconManager;
 class TextTextureCache;
+class FontAtlasManager;
 class BatchManager;
 } // namespace ui::managers
 
@@ -35,12 +37,14 @@ namespace ui::core
 /**
  * @brief 渲染上下文 - 封装渲染过程中需要的共享状态
  *
- * 这个上下文对象在渲染树遍历时传递，包含：
+ * 传给渲染器的 collect，包含：
  * - 位置和大小信息
  * - 透明度和变换
- * - 裁剪区域栈
+ * - 当前裁剪区域
  * - 屏幕尺寸
  * - 资源管理器引用
+ *
+ * 树的遍历本身不复制上下文（见 RenderQueue），每帧只有一个上下文，逐条记录填入位置、大小、透明度与裁剪区域
  */
 struct RenderContext
 {
@@ -56,16 +60,19 @@ struct RenderContext
     // 屏幕尺寸
     float screenWidth = 0.0F;
     float screenHeight = 0.0F;
-    // 裁剪区域栈
-    std::vector<SDL_Rect> scissorStack;
-
     // 当前有效的裁剪区域
     std::optional<SDL_Rect> currentScissor;
 
+    // 渲染器内部 pushScissor 时保存的上一层裁剪区域（定长，复制上下文不分配内存）
+    static constexpr size_t MAX_SCISSOR_DEPTH = 4;
+    std::array<std::optional<SDL_Rect>, MAX_SCISSOR_DEPTH> savedScissors{};
+    size_t scissorDepth = 0;
+
     // 资源管理器引用
     managers::DeviceManager* deviceManager = nullptr;
     managers::FontManager* fontManager = nullptr;
-    managers::TextTextureCache* textTextureCache = nullptr;
+    managers::TextTextureCache* textTextureCache = nullptr; // 图集不可用时的整串纹理回退路径
+    managers::FontAtlasManager* fontAtlas = nullptr;        // 字形图集（默认文本路径）
     managers::BatchManager* batchManager = nullptr;
 
     // SDL窗口指针（用于IME等）
@@ -75,7 +82,7 @@ struct RenderContext
     SDL_GPUTexture* whiteTexture = nullptr;
 
     /**
-     * @brief 推入新的裁剪区域
+     * @brief 推入新的裁剪区域（与当前裁剪区域求交集）
      */
     void pushScissor(const SDL_Rect& rect)
     {
@@ -83,9 +90,9 @@ struct RenderContext
         SDL_Rect newScissor = rect;
 
         // 与父级裁剪区域求交集
-        if (!scissorStack.empty())
+        if (currentScissor.has_value())
         {
-            const SDL_Rect& parent = scissorStack.back();
+            const SDL_Rect& parent = *currentScissor;
             if (!SDL_GetRectIntersection(&newScissor, &parent, &newScissor))
             {
                 // 不可见，设置为空区域
@@ -94,27 +101,26 @@ struct RenderContext
             }
         }
 
-        scissorStack.push_back(newScissor);
+        // 超过最大深度时不再保存，弹出时保留当前区域
+        if (scissorDepth < MAX_SCISSOR_DEPTH)
+        {
+            savedScissors[scissorDepth] = currentScissor;
+        }
+        ++scissorDepth;
         currentScissor = newScissor;
     }
 
     /**
-     * @brief 弹出裁剪区域
+     * @brief 弹出裁剪区域，恢复 pushScissor 之前的区域
      */
     void popScissor()
     {
-        if (!scissorStack.empty())
-        {
-            scissorStack.pop_back();
+        if (scissorDepth == 0) return;
 
-            if (!scissorStack.empty())
-            {
-                currentScissor = scissorStack.back();
-            }
-            else
-            {
-                currentScissor.reset();
-            }
+        --scissorDepth;
+        if (scissorDepth < MAX_SCISSOR_DEPTH)
+        {
+            currentScissor = savedScissors[scissorDepth];
         }
     }
 
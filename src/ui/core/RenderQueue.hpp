@@ -0,0 +1,391 @@
+/**
+ * ************************************************************************
+ *
+ * @file RenderQueue.hpp
+ * @author AnakinLiu (azrael2759@qq.com)
+ * @date 2026-10-16
+ * @version 0.1
+ * @brief 渲染队列 - 遍历 UI 树生成按 Z 序排序的渲染记录
+ *
+ * 遍历时只向下传递位置、透明度与裁剪索引（栈上的小结构），不再逐节点复制 RenderContext：
+ * - 每条记录只保存实体、渲染器、排序键、位置、大小、透明度与裁剪索引
+ * - ScrollArea 的裁剪区域（已与祖先求交）写入按帧的裁剪表，记录通过索引引用
+ * - 记录与裁剪表在帧之间保留容量，稳定状态下遍历不分配内存
+ * 收集阶段由 apply() 把一条记录填入同一个 RenderContext 再交给渲染器
+ *
+ * 队列可以跨帧保留：记录按遍历（提交）顺序存放，每个节点记下自己的记录与子树范围，
+ * refresh() 只重新遍历一个子树并原地更新记录；子树结构变化时返回 false，由调用方整体重建
+ *
+ * ************************************************************************
+ * @copyright Copyright (c) 2026 AnakinLiu
+ * For study and research only, no reprinting.
+ * ************************************************************************
+ */
+
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <numeric>
+#include <optional>
+#include <span>
+#include <unordered_map>
+#include <vector>
+#include <Eigen/Dense>
+#include <SDL3/SDL_rect.h>
+#include <entt/entt.hpp>
+#include "../singleton/Registry.hpp"
+#include "../common/Components.hpp"
+#include "../common/Tags.hpp"
+#include "../interface/IRenderer.hpp"
+#include "RenderContext.hpp"
+
+namespace ui::core
+{
+
+/**
+ * @brief 一条渲染记录（实体 × 可处理它的渲染器）
+ */
+struct RenderItem
+{
+    static constexpr uint32_t NO_SCISSOR = std::numeric_limits<uint32_t>::max();
+
+    uint64_t sortKey = 0; // 高 32 位：Z 序，低 32 位：提交顺序（即在 items() 中的下标）
+    entt::entity entity = entt::null;
+    uint32_t rendererIndex = 0; // 渲染器在 build 传入的列表中的下标
+    IRenderer* renderer = nullptr;
+    Eigen::Vector2f position{0.0F, 0.0F};
+    Eigen::Vector2f size{0.0F, 0.0F};
+    float alpha = 1.0F;
+    uint32_t scissorIndex = NO_SCISSOR; // 裁剪表索引
+
+    bool operator<(const RenderItem& other) const { return sortKey < other.sortKey; }
+};
+
+class RenderQueue
+{
+public:
+    /**
+     * @brief 清空记录与裁剪表（保留容量）
+     */
+    void clear()
+    {
+        m_items.clear();
+        m_scissors.clear();
+        m_nodes.clear();
+        m_nodeIndex.clear();
+        m_order.clear();
+    }
+
+    /**
+     * @brief 从 root 开始遍历可见子树，追加渲染记录
+     * @param rootOffset root 的父级位置（窗口实体为其位置取反）
+     * @param renderers 按优先级排列的渲染器
+     */
+    void build(entt::entity root,
+               const Eigen::Vector2f& rootOffset,
+               std::span<const std::unique_ptr<IRenderer>> renderers)
+    {
+        m_renderers = renderers;
+        m_refreshing = false;
+        m_mismatch = false;
+        m_nextNode = static_cast<uint32_t>(m_nodes.size());
+        m_nextItem = static_cast<uint32_t>(m_items.size());
+        visit(root, NodeState{.position = rootOffset, .alpha = 1.0F, .scissorIndex = RenderItem::NO_SCISSOR});
+        m_renderers = {};
+    }
+
+    /**
+     * @brief 重新遍历 entity 的子树，原地更新其中记录的位置、大小、透明度与裁剪区域
+     *
+     * renderers 必须与 build 时相同。entity 不在队列中时不做任何事
+     * @return 子树的节点、记录或裁剪区域数量与上次不同（显隐、增删子节点、Z 序等变化）时返回 false，
+     *         此时队列已部分改写，需要 clear() 后重新 build()
+     */
+    bool refresh(entt::entity entity, std::span<const std::unique_ptr<IRenderer>> renderers)
+    {
+        const auto iter = m_nodeIndex.find(entity);
+        if (iter == m_nodeIndex.end()) return true;
+
+        const Node node = m_nodes[iter->second];
+        m_renderers = renderers;
+        m_refreshing = true;
+        m_mismatch = false;
+        m_nextNode = iter->second;
+        m_nextItem = node.firstItem;
+        m_refreshNodeEnd = node.endNode;
+        m_refreshItemEnd = node.endItem;
+        visit(entity, node.parent);
+
+        const bool matched = !m_mismatch && m_nextNode == node.endNode && m_nextItem == node.endItem;
+        m_refreshing = false;
+        m_renderers = {};
+        return matched;
+    }
+
+    /**
+     * @brief 按 Z 序排序（同一 Z 序内保持提交顺序，排序键唯一）
+     *
+     * 只排序下标，记录本身保持提交顺序，refresh() 之后排序结果仍然有效
+     */
+    void sort()
+    {
+        m_order.resize(m_items.size());
+        std::iota(m_order.begin(), m_order.end(), 0U);
+        std::sort(m_order.begin(),
+                  m_order.end(),
+                  [this](uint32_t lhs, uint32_t rhs) { return m_items[lhs] < m_items[rhs]; });
+    }
+
+    /**
+     * @brief 提交顺序的记录
+     */
+    [[nodiscard]] const std::vector<RenderItem>& items() const { return m_items; }
+
+    /**
+     * @brief 排序后的记录下标（sort() 之后有效）
+     */
+    [[nodiscard]] std::span<const uint32_t> order() const { return m_order; }
+
+    /**
+     * @brief entity 自身的记录在 items() 中的下标范围 [first, first + count)，不在队列中时 count 为 0
+     */
+    [[nodiscard]] std::pair<uint32_t, uint32_t> itemRange(entt::entity entity) const
+    {
+        const auto iter = m_nodeIndex.find(entity);
+        if (iter == m_nodeIndex.end()) return {0, 0};
+        const Node& node = m_nodes[iter->second];
+        return {node.firstItem, node.itemCount};
+    }
+
+    [[nodiscard]] size_t scissorCount() const { return m_scissors.size(); }
+
+    /**
+     * @brief 裁剪表中的区域
+     */
+    [[nodiscard]] std::optional<SDL_Rect> scissor(uint32_t index) const
+    {
+        if (index >= m_scissors.size()) return std::nullopt;
+        return m_scissors[index];
+    }
+
+    /**
+     * @brief 把一条记录填入渲染上下文（资源管理器等字段保持不变）
+     */
+    void apply(const RenderItem& item, RenderContext& context) const
+    {
+        context.position = item.position;
+        context.size = item.size;
+        context.alpha = item.alpha;
+        context.currentScissor = scissor(item.scissorIndex);
+        context.scissorDepth = 0;
+    }
+
+private:
+    /**
+     * @brief 从父节点传给子节点的状态
+     */
+    struct NodeState
+    {
+        Eigen::Vector2f position; // 子节点坐标原点（已含父节点的滚动偏移）
+        float alpha;
+        uint32_t scissorIndex;
+    };
+
+    /**
+     * @brief 一个可见节点：refresh() 从这里恢复遍历
+     */
+    struct Node
+    {
+        entt::entity entity = entt::null;
+        NodeState parent{};
+        uint32_t firstItem = 0;                       // 自身的第一条记录
+        uint32_t itemCount = 0;                       // 自身的记录数
+        uint32_t endItem = 0;                         // 子树记录的结尾
+        uint32_t endNode = 0;                         // 子树节点的结尾
+        uint32_t scissorSlot = RenderItem::NO_SCISSOR; // ScrollArea 在裁剪表中的位置
+    };
+
+    void visit(entt::entity entity, const NodeState& parent)
+    {
+        if (m_mismatch) return;
+        if (!Registry::AnyOf<components::VisibleTag>(entity)) return;
+        if (Registry::AnyOf<components::SpacerTag>(entity)) return;
+
+        const uint32_t nodeIndex = m_nextNode++;
+        if (m_refreshing)
+        {
+            if (nodeIndex >= m_refreshNodeEnd || m_nodes[nodeIndex].entity != entity)
+            {
+                m_mismatch = true;
+                return;
+            }
+        }
+        else
+        {
+            m_nodes.push_back({.entity = entity});
+            m_nodeIndex.insert_or_assign(entity, nodeIndex);
+        }
+
+        const auto& pos = Registry::Get<components::Position>(entity);
+        const auto& size = Registry::Get<components::Size>(entity);
+        const auto* alphaComp = Registry::TryGet<components::Alpha>(entity);
+        const auto* scaleComp = Registry::TryGet<components::Scale>(entity);
+        const auto* offsetComp = Registry::TryGet<components::RenderOffset>(entity);
+
+        const float globalAlpha = parent.alpha * (alphaComp != nullptr ? alphaComp->value : 1.0F);
+        Eigen::Vector2f absolutePos = parent.position + pos.value;
+        Eigen::Vector2f finalSize = size.size;
+
+        // 应用渲染偏移
+        if (offsetComp != nullptr)
+        {
+            absolutePos += offsetComp->value;
+        }
+
+        // 应用缩放（基于中心点）
+        if (scaleComp != nullptr)
+        {
+            Eigen::Vector2f scaleDiff = size.size.cwiseProduct(Eigen::Vector2f::Ones() - scaleComp->value);
+            absolutePos += scaleDiff * 0.5F;
+            finalSize = size.size.cwiseProduct(scaleComp->value);
+        }
+
+        NodeState child{.position = absolutePos, .alpha = globalAlpha, .scissorIndex = parent.scissorIndex};
+
+        // 处理 ScrollArea：裁剪区域与祖先求交后写入裁剪表
+        uint32_t scissorSlot = RenderItem::NO_SCISSOR;
+        if (const auto* scrollArea = Registry::TryGet<components::ScrollArea>(entity))
+        {
+            SDL_Rect scissorRect;
+            scissorRect.x = static_cast<int>(absolutePos.x());
+            scissorRect.y = static_cast<int>(absolutePos.y());
+            scissorRect.w = static_cast<int>(size.size.x());
+            scissorRect.h = static_cast<int>(size.size.y());
+            if (parent.scissorIndex != RenderItem::NO_SCISSOR)
+            {
+                const SDL_Rect parentRect = m_scissors[parent.scissorIndex];
+                if (!SDL_GetRectIntersection(&scissorRect, &parentRect, &scissorRect))
+                {
+                    // 不可见，设置为空区域
+                    scissorRect.w = 0;
+                    scissorRect.h = 0;
+                }
+            }
+
+            if (m_refreshing)
+            {
+                scissorSlot = m_nodes[nodeIndex].scissorSlot;
+                if (scissorSlot == RenderItem::NO_SCISSOR)
+                {
+                    m_mismatch = true;
+                    return;
+                }
+                m_scissors[scissorSlot] = scissorRect;
+            }
+            else
+            {
+                scissorSlot = static_cast<uint32_t>(m_scissors.size());
+                m_scissors.push_back(scissorRect);
+            }
+            child.scissorIndex = scissorSlot;
+            child.position += -scrollArea->scrollOffset;
+        }
+        else if (m_refreshing && m_nodes[nodeIndex].scissorSlot != RenderItem::NO_SCISSOR)
+        {
+            m_mismatch = true;
+            return;
+        }
+
+        // Z 序偏移到无符号范围（int32_min -> 0）
+        int32_t zOrder = 0;
+        if (const auto* zOrderComp = Registry::TryGet<components::ZOrderIndex>(entity))
+        {
+            zOrder = zOrderComp->value;
+        }
+        const auto encodedZ = static_cast<uint64_t>(static_cast<int64_t>(zOrder) + 2147483648LL);
+
+        // 实体自身使用包含自己裁剪区域的索引（与子节点相同）
+        const uint32_t firstItem = m_nextItem;
+        for (uint32_t rendererIndex = 0; rendererIndex < m_renderers.size(); ++rendererIndex)
+        {
+            IRenderer* renderer = m_renderers[rendererIndex].get();
+            if (!renderer->canHandle(entity)) continue;
+
+            const RenderItem item{.sortKey = (encodedZ << 32) | m_nextItem,
+                                  .entity = entity,
+                                  .rendererIndex = rendererIndex,
+                                  .renderer = renderer,
+                                  .position = absolutePos,
+                                  .size = finalSize,
+                                  .alpha = globalAlpha,
+                                  .scissorIndex = child.scissorIndex};
+            if (m_refreshing)
+            {
+                if (m_nextItem >= m_refreshItemEnd || m_items[m_nextItem].sortKey != item.sortKey ||
+                    m_items[m_nextItem].renderer != renderer)
+                {
+                    m_mismatch = true;
+                    return;
+                }
+                m_items[m_nextItem] = item;
+            }
+            else
+            {
+                m_items.push_back(item);
+            }
+            ++m_nextItem;
+        }
+
+        {
+            Node& node = m_nodes[nodeIndex];
+            if (m_refreshing && node.itemCount != m_nextItem - firstItem)
+            {
+                m_mismatch = true;
+                return;
+            }
+            node.parent = parent;
+            node.firstItem = firstItem;
+            node.itemCount = m_nextItem - firstItem;
+            node.scissorSlot = scissorSlot;
+        }
+
+        // 递归处理子元素
+        const auto* hierarchy = Registry::TryGet<components::Hierarchy>(entity);
+        if (hierarchy != nullptr)
+        {
+            for (entt::entity childEntity : hierarchy->children)
+            {
+                visit(childEntity, child);
+            }
+        }
+        if (m_mismatch) return;
+
+        Node& node = m_nodes[nodeIndex];
+        if (m_refreshing && (node.endItem != m_nextItem || node.endNode != m_nextNode))
+        {
+            m_mismatch = true;
+            return;
+        }
+        node.endItem = m_nextItem;
+        node.endNode = m_nextNode;
+    }
+
+    std::span<const std::unique_ptr<IRenderer>> m_renderers;
+    std::vector<RenderItem> m_items;        // 提交顺序
+    std::vector<SDL_Rect> m_scissors;       // 裁剪表
+    std::vector<Node> m_nodes;              // 先序遍历顺序
+    std::vector<uint32_t> m_order;          // 按排序键排列的记录下标
+    std::unordered_map<entt::entity, uint32_t> m_nodeIndex;
+
+    // 遍历状态
+    uint32_t m_nextNode = 0;
+    uint32_t m_nextItem = 0;
+    uint32_t m_refreshNodeEnd = 0;
+    uint32_t m_refreshItemEnd = 0;
+    bool m_refreshing = false;
+    bool m_mismatch = false;
+};
+
+} // namespace ui::core
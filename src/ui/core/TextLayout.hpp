@@ -0,0 +1,201 @@
+/**
+ * ************************************************************************
+ *
+ * @file TextLayout.hpp
+ * @author AnakinLiu (azrael2759@qq.com)
+ * @date 2026-10-16
+ * @version 0.1
+ * @brief 文本排版缓存的更新与访问
+ *
+ * components::TextLayout 保存一段文本排版后的行（content 中的字节区间）与字形（码点 + 笔位置）。
+ * UpdateTextLayout 只在内容、字体、字号、换行宽度变化时重新排版：
+ * - 参数变化：整段重新排版
+ * - 只有内容变化（如 TextEdit 输入）：从第一个被修改的段落开始重新排版，之前的段落原样保留
+ * 换行规则与 WrapTextLines 一致（共用 BreakParagraph），渲染时直接遍历缓存的字形，不生成字符串
+ *
+ * ************************************************************************
+ * @copyright Copyright (c) 2026 AnakinLiu
+ * For study and research only, no reprinting.
+ * ************************************************************************
+ */
+
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <string_view>
+#include "../common/Components.hpp"
+#include "TextUtils.hpp"
+
+namespace ui::utils
+{
+
+/**
+ * @brief 排版参数，任一项变化都会整段重新排版
+ */
+struct TextLayoutParams
+{
+    float fontSize = 0.0F;
+    float maxWidth = 0.0F; // 0 表示不换行
+    policies::TextWrap wrapMode = policies::TextWrap::NONE;
+    uint32_t fontGeneration = 0;
+    float lineHeight = 0.0F;
+};
+
+namespace detail
+{
+/**
+ * @brief 把 BreakParagraph 的输出追加到排版缓存
+ */
+struct TextLayoutSink
+{
+    components::TextLayout& layout;
+    size_t offset = 0; // 当前段落在 content 中的起始字节
+    uint32_t lineBegin = 0;
+    uint32_t lineEnd = 0;
+    uint32_t firstGlyph = 0;
+    bool lineEmpty = true;
+
+    void glyph(size_t begin, size_t end, uint32_t codepoint, float x)
+    {
+        if (lineEmpty)
+        {
+            lineBegin = static_cast<uint32_t>(offset + begin);
+            firstGlyph = static_cast<uint32_t>(layout.glyphs.size());
+            lineEmpty = false;
+        }
+        lineEnd = static_cast<uint32_t>(offset + end);
+        layout.glyphs.push_back({.codepoint = codepoint, .x = x});
+    }
+
+    void endLine(float width)
+    {
+        if (lineEmpty)
+        {
+            lineBegin = lineEnd = static_cast<uint32_t>(offset);
+            firstGlyph = static_cast<uint32_t>(layout.glyphs.size());
+        }
+        layout.lines.push_back({.begin = lineBegin,
+                                .end = lineEnd,
+                                .firstGlyph = firstGlyph,
+                                .glyphCount = static_cast<uint32_t>(layout.glyphs.size()) - firstGlyph,
+                                .width = width});
+        lineEmpty = true;
+    }
+};
+} // namespace detail
+
+/**
+ * @brief 按需更新排版缓存
+ * @param advanceFunc float(uint32_t codepoint, uint32_t previous)，见 LineWidthAccumulator
+ * @return 重新排版的起始字节；缓存仍然有效时返回 std::string_view::npos
+ */
+template <typename AdvanceFunc>
+inline size_t UpdateTextLayout(components::TextLayout& layout,
+                               std::string_view content,
+                               const TextLayoutParams& params,
+                               AdvanceFunc&& advanceFunc)
+{
+    const bool sameParams = layout.fontGeneration != 0 && layout.fontGeneration == params.fontGeneration &&
+                            layout.fontSize == params.fontSize && layout.maxWidth == params.maxWidth &&
+                            layout.wrapMode == params.wrapMode && layout.lineHeight == params.lineHeight;
+    if (sameParams && layout.content == content)
+    {
+        return std::string_view::npos;
+    }
+
+    const bool wrapping = params.wrapMode != policies::TextWrap::NONE && params.maxWidth > 0.0F;
+
+    // 参数不变时从第一个被修改的段落开始，之前的行与字形保留
+    size_t from = 0;
+    if (sameParams && wrapping)
+    {
+        const auto [changed, _] = std::ranges::mismatch(content, layout.content);
+        const auto common = static_cast<size_t>(changed - content.begin());
+        const size_t newline = common == 0 ? std::string_view::npos : content.rfind('\n', common - 1);
+        from = newline == std::string_view::npos ? 0 : newline + 1;
+    }
+
+    const auto stale =
+        std::ranges::lower_bound(layout.lines, static_cast<uint32_t>(from), {}, &components::TextLayoutLine::begin);
+    if (stale != layout.lines.end())
+    {
+        layout.glyphs.resize(stale->firstGlyph);
+        layout.lines.erase(stale, layout.lines.end());
+    }
+
+    layout.content.assign(content);
+    layout.fontSize = params.fontSize;
+    layout.maxWidth = params.maxWidth;
+    layout.wrapMode = params.wrapMode;
+    layout.fontGeneration = params.fontGeneration;
+    layout.lineHeight = params.lineHeight;
+
+    detail::TextLayoutSink sink{.layout = layout};
+    if (!wrapping)
+    {
+        // 不换行：整段一行（与 WrapTextLines 相同，换行符也留在行内）
+        BreakParagraph(content, std::numeric_limits<float>::infinity(), policies::TextWrap::Char, advanceFunc, sink);
+        return from;
+    }
+
+    // 按换行符分段；每个换行符之后追加一个空行，与 WrapTextLines 一致
+    size_t paragraphStart = from;
+    while (paragraphStart <= content.size())
+    {
+        size_t paragraphEnd = content.find('\n', paragraphStart);
+        const bool lastParagraph = paragraphEnd == std::string_view::npos;
+        if (lastParagraph)
+        {
+            paragraphEnd = content.size();
+        }
+
+        if (paragraphEnd > paragraphStart)
+        {
+            sink.offset = paragraphStart;
+            BreakParagraph(content.substr(paragraphStart, paragraphEnd - paragraphStart),
+                           params.maxWidth,
+                           params.wrapMode,
+                           advanceFunc,
+                           sink);
+        }
+        if (lastParagraph) break;
+
+        const auto newline = static_cast<uint32_t>(paragraphEnd);
+        layout.lines.push_back({.begin = newline,
+                                .end = newline,
+                                .firstGlyph = static_cast<uint32_t>(layout.glyphs.size()),
+                                .glyphCount = 0,
+                                .width = 0.0F});
+        paragraphStart = paragraphEnd + 1;
+    }
+    return from;
+}
+
+/**
+ * @brief 一行的字形
+ */
+inline std::span<const components::TextLayoutGlyph> LineGlyphs(const components::TextLayout& layout,
+                                                               const components::TextLayoutLine& line)
+{
+    return std::span<const components::TextLayoutGlyph>(layout.glyphs).subspan(line.firstGlyph, line.glyphCount);
+}
+
+/**
+ * @brief 一行在 content 中的原文（Word 模式下单词间的连续空白保持原样）
+ */
+inline std::string_view LineText(const components::TextLayout& layout, const components::TextLayoutLine& line)
+{
+    return std::string_view(layout.content).substr(line.begin, line.end - line.begin);
+}
+
+/**
+ * @brief 排版后的总高度
+ */
+inline float LayoutHeight(const components::TextLayout& layout)
+{
+    return static_cast<float>(layout.lines.size()) * layout.lineHeight;
+}
+
+} // namespace ui::utils
@@ -7,6 +7,9 @@
  * @version 0.1
  * @brief 文本处理工具函数
  *
+ * 换行与截断只通过 advanceFunc(codepoint, previous) 查询单个字符的宽度，行宽在遍历时累加，
+ * 整段文本只遍历一次；配合 GlyphAdvanceCache 使用时每个码点只向字体查询一次
+ *
  * ************************************************************************
  * @copyright Copyright (c) 2026 AnakinLiu
  * For study and research only, no reprinting.
@@ -14,11 +17,13 @@
  */
 
 #pragma once
+#include <cstdint>
+#include <iterator>
 #include <string>
+#include <string_view>
+#include <type_traits>
 #include <vector>
-#include <functional>
-#include <algorithm>
-#include "../common/Components.hpp"
+#include "../common/Policies.hpp"
 
 namespace ui::utils
 {
@@ -60,134 +65,288 @@ inline size_t NextCharPos(const std::string& text, size_t pos)
     }
     return newPos;
 }
+
 /**
- * @brief 换行处理单个段落
+ * @brief 解码一个 UTF-8 字符
+ * @param text UTF-8 字符串视图
+ * @param outCodepoint 输出码点
+ * @return 字符占用的字节数，失败返回 0
  */
-template <typename MeasureFunc>
-inline std::vector<std::string>
-    WrapParagraph(const std::string& paragraph, int maxWidth, policies::TextWrap wrapMode, MeasureFunc&& measureFunc)
+inline size_t DecodeUtf8(std::string_view text, uint32_t& outCodepoint)
 {
-    std::vector<std::string> lines;
+    if (text.empty()) return 0;
+
+    const auto byte0 = static_cast<uint8_t>(text[0]);
+
+    // 单字节 ASCII
+    if (byte0 < 0x80)
+    {
+        outCodepoint = byte0;
+        return 1;
+    }
+
+    // 2 字节
+    if ((byte0 & 0xE0U) == 0xC0)
+    {
+        if (text.size() < 2) return 0;
+        outCodepoint = ((byte0 & 0x1FU) << 6U) | (static_cast<uint8_t>(text[1]) & 0x3FU);
+        return 2;
+    }
+
+    // 3 字节
+    if ((byte0 & 0xF0U) == 0xE0)
+    {
+        if (text.size() < 3) return 0;
+        outCodepoint = ((byte0 & 0x0FU) << 12U) | ((static_cast<uint8_t>(text[1]) & 0x3FU) << 6U) |
+                       (static_cast<uint8_t>(text[2]) & 0x3FU);
+        return 3;
+    }
+
+    // 4 字节
+    if ((byte0 & 0xF8U) == 0xF0)
+    {
+        if (text.size() < 4) return 0;
+        outCodepoint = ((byte0 & 0x07U) << 18U) | ((static_cast<uint8_t>(text[1]) & 0x3FU) << 12U) |
+                       ((static_cast<uint8_t>(text[2]) & 0x3FU) << 6U) | (static_cast<uint8_t>(text[3]) & 0x3FU);
+        return 4;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief 单行的宽度累加器
+ *
+ * advanceFunc(codepoint, previous) 返回 codepoint 紧跟在 previous 之后占用的宽度（前进量 + 字距），
+ * previous 为 0 表示行首。每个字符只查询一次，行宽在追加时累加，不再重复测量整行前缀
+ */
+template <typename AdvanceFunc>
+class LineWidthAccumulator
+{
+public:
+    explicit LineWidthAccumulator(AdvanceFunc& advanceFunc) : m_advanceFunc(advanceFunc) {}
+
+    /**
+     * @brief 单独测量一段文本（不影响当前行）
+     * @param outFirst 输出第一个字符的码点
+     * @param outLast 输出最后一个字符的码点
+     */
+    float measure(std::string_view text, uint32_t& outFirst, uint32_t& outLast)
+    {
+        float width = 0.0F;
+        outFirst = 0;
+        outLast = 0;
+        for (size_t pos = 0; pos < text.size();)
+        {
+            uint32_t codepoint = 0;
+            const size_t length = DecodeUtf8(text.substr(pos), codepoint);
+            if (length == 0) break;
+
+            width += m_advanceFunc(codepoint, outLast);
+            if (outFirst == 0) outFirst = codepoint;
+            outLast = codepoint;
+            pos += length;
+        }
+        return width;
+    }
+
+    /**
+     * @brief 当前行与 previous 之间插入 codepoint 后、再接上以 next 开头的文本时增加的宽度
+     */
+    float joinWidth(uint32_t codepoint, uint32_t previous, uint32_t next)
+    {
+        float width = m_advanceFunc(codepoint, previous);
+        if (next != 0)
+        {
+            width += m_advanceFunc(next, codepoint) - m_advanceFunc(next, 0);
+        }
+        return width;
+    }
+
+private:
+    AdvanceFunc& m_advanceFunc;
+};
 
+/**
+ * @brief 单个段落的断行（单次遍历，行宽增量累加）
+ *
+ * 结果以回调形式输出，不生成字符串，供 WrapParagraph 与 TextLayout 共用：
+ * - sink.glyph(begin, end, codepoint, x)：行内一个字符，[begin, end) 为其在 paragraph 中的字节区间，
+ *   x 为相对行首的笔位置；Word 模式下单词之间的连接空格以 ' ' 输出，区间指向原文中的分隔符；
+ *   非法 UTF-8 字节以码点 0 输出，不占宽度
+ * - sink.endLine(width)：当前行结束
+ * @param advanceFunc float(uint32_t codepoint, uint32_t previous)，见 LineWidthAccumulator
+ */
+template <typename AdvanceFunc, typename LineSink>
+inline void BreakParagraph(std::string_view paragraph,
+                           float maxWidth,
+                           policies::TextWrap wrapMode,
+                           AdvanceFunc& advanceFunc,
+                           LineSink& sink)
+{
     if (paragraph.empty())
     {
-        lines.push_back("");
-        return lines;
+        sink.endLine(0.0F);
+        return;
     }
 
-    if (wrapMode == policies::TextWrap::Char)
+    LineWidthAccumulator<AdvanceFunc> accumulator(advanceFunc);
+
+    float lineWidth = 0.0F;
+    uint32_t lastCodepoint = 0; // 当前行最后一个字符，0 表示行首
+    bool lineEmpty = true;
+
+    auto endLine = [&]()
     {
-        std::string currentLine;
-        for (size_t i = 0; i < paragraph.size();)
+        sink.endLine(lineWidth);
+        lineWidth = 0.0F;
+        lastCodepoint = 0;
+        lineEmpty = true;
+    };
+
+    // 把一个字符放到当前行末尾，advance 为相对 lastCodepoint 的宽度（含字距）
+    auto place = [&](size_t pos, size_t length, uint32_t codepoint, float advance)
+    {
+        const float kerning = lastCodepoint != 0 ? advance - advanceFunc(codepoint, 0) : 0.0F;
+        sink.glyph(pos, pos + length, codepoint, lineWidth + kerning);
+        lineWidth += advance;
+        lastCodepoint = codepoint;
+        lineEmpty = false;
+    };
+
+    // 逐字符追加；wrap 为 true 时超出宽度换行（每行至少一个字符）
+    auto appendChars = [&](size_t begin, size_t end, bool wrap)
+    {
+        for (size_t pos = begin; pos < end;)
         {
-            size_t next = NextCharPos(paragraph, i);
-            std::string ch = paragraph.substr(i, next - i);
-            float width = measureFunc(currentLine + ch);
-            if (width > maxWidth && !currentLine.empty())
+            uint32_t codepoint = 0;
+            const size_t length = DecodeUtf8(paragraph.substr(pos, end - pos), codepoint);
+            if (length == 0)
             {
-                lines.push_back(currentLine);
-                currentLine = ch;
+                // 非法字节原样保留，不占宽度
+                sink.glyph(pos, pos + 1, 0, lineWidth);
+                lineEmpty = false;
+                ++pos;
+                continue;
             }
-            else
+
+            float advance = advanceFunc(codepoint, lastCodepoint);
+            if (wrap && lineWidth + advance > maxWidth && !lineEmpty)
             {
-                currentLine += ch;
+                endLine();
+                advance = advanceFunc(codepoint, 0);
             }
-            i = next;
+            place(pos, length, codepoint, advance);
+            pos += length;
         }
-        if (!currentLine.empty()) lines.push_back(currentLine);
-        return lines;
-    }
+    };
 
-    // Word 模式或默认
-    std::string currentLine;
-    std::string word;
+    if (wrapMode == policies::TextWrap::Char)
+    {
+        appendChars(0, paragraph.size(), true);
+        if (!lineEmpty) endLine();
+        return;
+    }
 
-    auto pushWord = [&](const std::string& w)
+    // Word 模式或默认：单词之间以一个空格连接
+    auto pushWord = [&](size_t begin, size_t end)
     {
-        if (w.empty()) return;
+        if (begin == end) return;
+
+        uint32_t first = 0;
+        uint32_t last = 0;
+        const float wordWidth = accumulator.measure(paragraph.substr(begin, end - begin), first, last);
 
         // 如果单个单词就超过了最大宽度，强制对其进行字符级换行
-        if (measureFunc(w) > maxWidth)
+        if (wordWidth > maxWidth)
         {
-            // 先把当前行推入
-            if (!currentLine.empty())
-            {
-                lines.push_back(currentLine);
-                currentLine.clear();
-            }
-
-            // 对这个超长单词进行字符换行
-            std::string tempWord;
-            for (size_t i = 0; i < w.size();)
+            if (!lineEmpty)
             {
-                size_t next = NextCharPos(w, i);
-                std::string ch = w.substr(i, next - i);
-                if (measureFunc(tempWord + ch) > maxWidth && !tempWord.empty())
-                {
-                    lines.push_back(tempWord);
-                    tempWord = ch;
-                }
-                else
-                {
-                    tempWord += ch;
-                }
-                i = next;
+                endLine();
             }
-            currentLine = tempWord;
+            appendChars(begin, end, true);
             return;
         }
 
-        std::string testLine = currentLine.empty() ? w : currentLine + " " + w;
-        if (measureFunc(testLine) > maxWidth && !currentLine.empty())
-        {
-            lines.push_back(currentLine);
-            currentLine = w;
-        }
-        else
+        if (!lineEmpty)
         {
-            currentLine = testLine;
+            const float joined = lineWidth + accumulator.joinWidth(' ', lastCodepoint, first) + wordWidth;
+            if (joined > maxWidth)
+            {
+                endLine();
+            }
+            else
+            {
+                // begin 前一个字节就是分隔符
+                place(begin - 1, 1, ' ', advanceFunc(' ', lastCodepoint));
+            }
         }
+        appendChars(begin, end, false);
     };
 
-    for (size_t i = 0; i < paragraph.size();)
+    size_t wordStart = 0;
+    for (size_t i = 0; i < paragraph.size(); ++i)
     {
-        unsigned char c = static_cast<unsigned char>(paragraph[i]);
+        const char c = paragraph[i];
         if (c == ' ' || c == '\t')
         {
-            pushWord(word);
-            word.clear();
-            // 在 Word 模式下保留必要的间距（如果不是行首）
-            if (!currentLine.empty())
-            {
-                // 注意：由于 pushWord 可能会推入多行，这里简单处理
-                // 实际复杂的渲染可能需要更好的处理
-            }
-            i++;
-        }
-        else
-        {
-            size_t next = NextCharPos(paragraph, i);
-            word += paragraph.substr(i, next - i);
-            i = next;
+            pushWord(wordStart, i);
+            wordStart = i + 1;
         }
     }
+    pushWord(wordStart, paragraph.size());
 
-    pushWord(word);
-
-    if (!currentLine.empty())
+    if (!lineEmpty)
     {
-        lines.push_back(currentLine);
+        endLine();
     }
+}
 
-    return lines;
+/**
+ * @brief 换行处理单个段落
+ * @param advanceFunc float(uint32_t codepoint, uint32_t previous)，见 LineWidthAccumulator
+ */
+template <typename AdvanceFunc>
+inline std::vector<std::string>
+    WrapParagraph(std::string_view paragraph, int maxWidth, policies::TextWrap wrapMode, AdvanceFunc&& advanceFunc)
+{
+    struct StringSink
+    {
+        std::string_view paragraph;
+        std::vector<std::string> lines;
+        std::string currentLine;
+
+        void glyph(size_t begin, size_t end, uint32_t codepoint, float /*x*/)
+        {
+            if (codepoint == ' ')
+            {
+                currentLine += ' ';
+            }
+            else
+            {
+                currentLine.append(paragraph.substr(begin, end - begin));
+            }
+        }
+
+        void endLine(float /*width*/)
+        {
+            lines.push_back(std::move(currentLine));
+            currentLine.clear();
+        }
+    };
+
+    StringSink sink{.paragraph = paragraph, .lines = {}, .currentLine = {}};
+    BreakParagraph(paragraph, static_cast<float>(maxWidth), wrapMode, advanceFunc, sink);
+    return std::move(sink.lines);
 }
 
 /**
  * @brief 文本换行处理
+ * @param advanceFunc float(uint32_t codepoint, uint32_t previous)，见 LineWidthAccumulator
  */
-template <typename MeasureFunc>
+template <typename AdvanceFunc>
 inline std::vector<std::string>
-    WrapTextLines(const std::string& text, int maxWidth, policies::TextWrap wrapMode, MeasureFunc&& measureFunc)
+    WrapTextLines(const std::string& text, int maxWidth, policies::TextWrap wrapMode, AdvanceFunc&& advanceFunc)
 {
     std::vector<std::string> lines;
 
@@ -198,41 +357,42 @@ inline std::vector<std::string>
     }
 
     // 按换行符分割
-    std::string currentParagraph;
-    for (char c : text)
+    const std::string_view view(text);
+    size_t paragraphStart = 0;
+    auto wrapParagraph = [&](size_t end)
     {
-        if (c == '\n')
+        if (end > paragraphStart)
         {
-            if (!currentParagraph.empty())
-            {
-                // 处理当前段落
-                auto wrappedLines = WrapParagraph(currentParagraph, maxWidth, wrapMode, measureFunc);
-                lines.insert(lines.end(), wrappedLines.begin(), wrappedLines.end());
-                currentParagraph.clear();
-            }
-            lines.push_back(""); // 空行
+            auto wrappedLines = WrapParagraph(view.substr(paragraphStart, end - paragraphStart), maxWidth, wrapMode,
+                                              advanceFunc);
+            lines.insert(lines.end(),
+                         std::make_move_iterator(wrappedLines.begin()),
+                         std::make_move_iterator(wrappedLines.end()));
         }
-        else
+    };
+
+    for (size_t i = 0; i < view.size(); ++i)
+    {
+        if (view[i] == '\n')
         {
-            currentParagraph += c;
+            wrapParagraph(i);
+            lines.emplace_back(); // 空行
+            paragraphStart = i + 1;
         }
     }
 
     // 处理最后一段
-    if (!currentParagraph.empty())
-    {
-        auto wrappedLines = WrapParagraph(currentParagraph, maxWidth, wrapMode, measureFunc);
-        lines.insert(lines.end(), wrappedLines.begin(), wrappedLines.end());
-    }
+    wrapParagraph(view.size());
 
     return lines;
 }
 
 /**
- * @brief 获取能够显示在指定宽度内的文本尾部
+ * @brief 获取能够显示在指定宽度内的文本尾部（从尾部逐字符累加宽度）
+ * @param advanceFunc float(uint32_t codepoint, uint32_t previous)，见 LineWidthAccumulator
  */
-template <typename MeasureFunc>
-inline std::string GetTailThatFits(const std::string& text, int maxWidth, MeasureFunc&& measureFunc, float& outWidth)
+template <typename AdvanceFunc>
+inline std::string GetTailThatFits(const std::string& text, int maxWidth, AdvanceFunc&& advanceFunc, float& outWidth)
 {
     outWidth = 0.0f;
 
@@ -241,33 +401,29 @@ inline std::string GetTailThatFits(const std::string& text, int maxWidth, Measur
         return "";
     }
 
-    // 从尾部开始截取
-    for (size_t i = 0; i < text.size(); ++i)
+    const auto limit = static_cast<float>(maxWidth);
+    const std::string_view view(text);
+    LineWidthAccumulator<std::remove_reference_t<AdvanceFunc>> accumulator(advanceFunc);
+
+    float width = 0.0F;
+    uint32_t first = 0; // 已接受部分的第一个字符
+    size_t start = text.size();
+    while (start > 0)
     {
-        std::string substr = text.substr(text.size() - i - 1);
-        float width = measureFunc(substr);
+        const size_t prev = PrevCharPos(text, start);
+        uint32_t codepoint = 0;
+        if (DecodeUtf8(view.substr(prev, start - prev), codepoint) == 0) break;
 
-        if (width <= maxWidth)
-        {
-            outWidth = width;
-            if (i == text.size() - 1)
-            {
-                return substr; // 全部都能显示
-            }
-        }
-        else
-        {
-            // 超出宽度，返回上一次的结果
-            if (i > 0)
-            {
-                return text.substr(text.size() - i);
-            }
-            return "";
-        }
+        const float extended = width + accumulator.joinWidth(codepoint, 0, first);
+        if (extended > limit) break;
+
+        width = extended;
+        first = codepoint;
+        start = prev;
     }
 
-    outWidth = measureFunc(text);
-    return text;
+    outWidth = width;
+    return text.substr(start);
 }
 
 } // namespace ui::utils
@@ -16,8 +16,9 @@
 #pragma once
 #include <vector>
 #include <optional>
-#include <array>
-#include <memory_resource>
+#include <algorithm>
+#include <memory>
+#include <span>
 #include <SDL3/SDL_gpu.h>
 #include <SDL3/SDL_rect.h>
 #include <Eigen/Dense>
@@ -26,44 +27,100 @@
 namespace ui::managers
 {
 
-static constexpr size_t MAX_BATCH_COUNT = 256ULL * 1024ULL;
+static constexpr size_t MAX_REORDER_LOOKBACK = 64ULL;      // optimize 向前查找可合并批次的最大距离
+static constexpr size_t MIN_INSTANCE_CAPACITY = 4096ULL;   // 实例流首次扩容的最小容量
+
+/**
+ * @brief 实例流的存储
+ *
+ * BatchManager 把整帧的矩形实例连续写入这块内存。CommandBuffer 提供映射后的上传缓冲区，
+ * 渲染器写入的实例就是上传给 GPU 的数据，不再经过中间缓冲
+ */
+class IInstanceStorage
+{
+public:
+    IInstanceStorage() = default;
+    virtual ~IInstanceStorage() = default;
+    IInstanceStorage(const IInstanceStorage&) = delete;
+    IInstanceStorage& operator=(const IInstanceStorage&) = delete;
+    IInstanceStorage(IInstanceStorage&&) = delete;
+    IInstanceStorage& operator=(IInstanceStorage&&) = delete;
+
+    /**
+     * @brief 把容量扩大到至少 capacity 个实例，前 used 个实例保持不变
+     * @return 全部可写空间（可能已移动）；扩容失败时返回原来的空间
+     */
+    virtual std::span<render::QuadInstance> growInstances(size_t capacity, size_t used) = 0;
+};
+
 /**
  * @brief 批次管理器
  *
  * 负责：
  * 1. 收集渲染命令并组装成批次
- * 2. 批次合并优化（相同纹理、相同裁剪区域）
- * 3. 状态排序减少状态切换
+ * 2. 批次合并优化（相同纹理、相同裁剪区域；形状参数在实例中，不影响合并）
+ * 3. 同一 Z 层内互不重叠的批次按纹理与裁剪区域重排并合并，减少状态切换
+ * 4. 录制一个渲染记录写入的矩形（beginRecording / endRecording），内容未变化时整段回放（replay）
+ *
+ * 每个矩形打包成一条 QuadInstance，按提交顺序写入整帧实例流（IInstanceStorage），由顶点着色器展开成
+ * 4 个角；批次只记录所在的区间。合并批次不移动实例，只把区间串起来，上传时按合并后的顺序复制各段
  */
 class BatchManager
 {
 public:
-    BatchManager()
-        : m_bufferResource(MAX_BATCH_COUNT), // 预分配 256KB
-          m_batches(&m_bufferResource)
-    {
-    }
+    BatchManager() = default;
 
     /**
-     * @brief 清空所有批次
+     * @brief 清空所有批次（保留实例存储与各容器的容量）
      */
     void clear()
     {
         m_currentBatch.reset();
-        // 否则 m_batches 会保留指向已释放内存的指针（capacity），导致内存重叠
-        m_batches = std::pmr::vector<render::RenderBatch>(&m_bufferResource);
-        m_bufferResource.release();
+        m_recording = nullptr;
+        m_layer = 0;
+        m_collectedBatchCount = 0;
+        m_instanceCount = 0;
+        m_batches.clear();
+        m_ranges.clear();
+    }
+
+    /**
+     * @brief 设置实例流的存储，为空时使用内部内存
+     *
+     * 只能在 clear() 之后、写入实例之前调用
+     */
+    void setInstanceStorage(IInstanceStorage* storage)
+    {
+        m_storage = storage;
+        m_instances = m_storage != nullptr
+                          ? m_storage->growInstances(0, 0)
+                          : std::span<render::QuadInstance>(m_ownedInstances.get(), m_ownedCapacity);
     }
 
+    [[nodiscard]] IInstanceStorage* getInstanceStorage() const { return m_storage; }
+
+    /**
+     * @brief 设置屏幕尺寸（整帧不变，写入每个批次的推送常量）
+     */
+    void setScreenSize(float width, float height)
+    {
+        m_pushConstants.screen_size[0] = width;
+        m_pushConstants.screen_size[1] = height;
+    }
+
+    /**
+     * @brief 设置之后写入的内容所在的 Z 层（RenderKey 的高 32 位，按升序提交）
+     */
+    void setLayer(uint32_t layer) { m_layer = layer; }
+
     /**
      * @brief 开始新的批次
+     *
+     * 形状参数随实例传入，只有纹理或裁剪区域变化时才需要新的批次（即一次新的绘制调用）
      * @param texture 纹理指针
      * @param scissor 裁剪区域
-     * @param pushConstants 推送常量
      */
-    void beginBatch(SDL_GPUTexture* texture,
-                    const std::optional<SDL_Rect>& scissor,
-                    const render::UiPushConstants& pushConstants)
+    void beginBatch(SDL_GPUTexture* texture, const std::optional<SDL_Rect>& scissor)
     {
         // 检查是否可以与当前批次合并
         if (m_currentBatch.has_value())
@@ -85,41 +142,6 @@ public:
                 }
             }
 
-            // 检查推送常量是否相同
-            // 注意：PushConstants 控制着 Shader 中的 SDF 计算参数，必须完全一致才能合并
-            if (canMerge)
-            {
-                const auto& curr = m_currentBatch->pushConstants;
-                const auto& next = pushConstants;
-                constexpr float EPSILON = 0.001F;
-
-                bool paramsMatch = true;
-
-                // 屏幕尺寸
-                paramsMatch &= (std::abs(curr.screen_size[0] - next.screen_size[0]) < EPSILON);
-                paramsMatch &= (std::abs(curr.screen_size[1] - next.screen_size[1]) < EPSILON);
-
-                // 矩形尺寸 (关键：不一样会导致 SDF 计算错误)
-                paramsMatch &= (std::abs(curr.rect_size[0] - next.rect_size[0]) < EPSILON);
-                paramsMatch &= (std::abs(curr.rect_size[1] - next.rect_size[1]) < EPSILON);
-
-                // 圆角半径
-                paramsMatch &= (std::abs(curr.radius[0] - next.radius[0]) < EPSILON);
-                paramsMatch &= (std::abs(curr.radius[1] - next.radius[1]) < EPSILON);
-                paramsMatch &= (std::abs(curr.radius[2] - next.radius[2]) < EPSILON);
-                paramsMatch &= (std::abs(curr.radius[3] - next.radius[3]) < EPSILON);
-
-                // 阴影参数
-                paramsMatch &= (std::abs(curr.shadow_offset_x - next.shadow_offset_x) < EPSILON);
-                paramsMatch &= (std::abs(curr.shadow_offset_y - next.shadow_offset_y) < EPSILON);
-                paramsMatch &= (std::abs(curr.shadow_soft - next.shadow_soft) < EPSILON);
-
-                // 透明度
-                paramsMatch &= (std::abs(curr.opacity - next.opacity) < EPSILON);
-
-                canMerge = paramsMatch;
-            }
-
             if (!canMerge)
             {
                 flushBatch();
@@ -128,112 +150,129 @@ public:
 
         if (!m_currentBatch.has_value())
         {
-            m_currentBatch.emplace(&m_bufferResource);
+            m_currentBatch.emplace();
             m_currentBatch->texture = texture;
             m_currentBatch->scissorRect = scissor;
-            m_currentBatch->pushConstants = pushConstants;
+            m_currentBatch->pushConstants = m_pushConstants;
+            m_currentBatch->firstInstance = static_cast<uint32_t>(m_instanceCount);
+        }
+        m_currentBatch->layer = m_layer;
+
+        if (m_recording != nullptr)
+        {
+            recordBatch(texture, scissor);
         }
     }
 
     /**
-     * @brief 添加顶点到当前批次
+     * @brief 添加矩形（一条实例）
+     * @param shape 圆角、阴影与透明度；矩形尺寸取 size
      */
-    void addVertex(const render::Vertex& vertex)
+    void addRect(const Eigen::Vector2f& pos,
+                 const Eigen::Vector2f& size,
+                 const Eigen::Vector4f& color,
+                 const render::ShapeParams& shape = {},
+                 const Eigen::Vector2f& uvMin = {0.0F, 0.0F},
+                 const Eigen::Vector2f& uvMax = {1.0F, 1.0F})
     {
         if (!m_currentBatch.has_value())
         {
             return;
         }
-        m_currentBatch->vertices.push_back(vertex);
-    }
 
-    /**
-     * @brief 添加索引到当前批次
-     */
-    void addIndex(uint16_t index)
-    {
-        if (!m_currentBatch.has_value())
+        render::QuadInstance* out = allocateInstances(1);
+        if (out == nullptr)
         {
             return;
         }
-        m_currentBatch->indices.push_back(index);
+
+        // 先在栈上打包，目标可能是只写的映射内存
+        const render::QuadInstance instance = packInstance(pos, size, color, shape, uvMin, uvMax);
+        *out = instance;
+        ++m_currentBatch->instanceCount;
+        m_currentBatch->bounds.expand(pos.x(), pos.y());
+        m_currentBatch->bounds.expand(pos.x() + size.x(), pos.y() + size.y());
+
+        if (m_recording != nullptr)
+        {
+            if (m_recording->batches.empty())
+            {
+                // 记录开始前已打开的批次：按它的纹理与裁剪区域录制
+                recordBatch(m_currentBatch->texture, m_currentBatch->scissorRect);
+            }
+            auto& recorded = m_recording->batches.back();
+            m_recording->instances.push_back(instance);
+            ++recorded.instanceCount;
+            recorded.bounds.expand(pos.x(), pos.y());
+            recorded.bounds.expand(pos.x() + size.x(), pos.y() + size.y());
+        }
     }
 
     /**
-     * @brief 添加矩形（4个顶点 + 6个索引）
+     * @brief 把一个矩形打包成实例（颜色与 UV 截断到 [0, 1]）
      */
-    void addRect(const Eigen::Vector2f& pos,
-                 const Eigen::Vector2f& size,
-                 const Eigen::Vector4f& color,
-                 const Eigen::Vector2f& uvMin = {0.0F, 0.0F},
-                 const Eigen::Vector2f& uvMax = {1.0F, 1.0F})
+    static render::QuadInstance packInstance(const Eigen::Vector2f& pos,
+                                             const Eigen::Vector2f& size,
+                                             const Eigen::Vector4f& color,
+                                             const render::ShapeParams& shape = {},
+                                             const Eigen::Vector2f& uvMin = {0.0F, 0.0F},
+                                             const Eigen::Vector2f& uvMax = {1.0F, 1.0F})
     {
-        if (!m_currentBatch.has_value())
+        render::QuadInstance instance{};
+        instance.rect[0] = pos.x();
+        instance.rect[1] = pos.y();
+        instance.rect[2] = size.x();
+        instance.rect[3] = size.y();
+        instance.uvRect[0] = render::packUnorm16(uvMin.x());
+        instance.uvRect[1] = render::packUnorm16(uvMin.y());
+        instance.uvRect[2] = render::packUnorm16(uvMax.x());
+        instance.uvRect[3] = render::packUnorm16(uvMax.y());
+        for (int channel = 0; channel < 4; ++channel)
         {
-            return;
+            instance.color[channel] = render::packUnorm8(color[channel]);
+            instance.radius[channel] = render::packHalf(shape.radius[channel]);
         }
+        instance.shadow[0] = render::packHalf(shape.shadowSoft);
+        instance.shadow[1] = render::packHalf(shape.shadowOffset[0]);
+        instance.shadow[2] = render::packHalf(shape.shadowOffset[1]);
+        instance.shadow[3] = render::packHalf(shape.opacity);
+        instance.flags = shape.premultiplied ? render::QuadInstance::FLAG_PREMULTIPLIED : 0U;
+        return instance;
+    }
 
-        auto baseIndex = static_cast<uint16_t>(m_currentBatch->vertices.size());
-
-        // 添加4个顶点
-        std::array<render::Vertex, 4> vertices{};
-
-        // 左上
-        vertices[0].position[0] = pos.x();
-        vertices[0].position[1] = pos.y();
-        vertices[0].texCoord[0] = uvMin.x();
-        vertices[0].texCoord[1] = uvMin.y();
-        vertices[0].color[0] = color.x();
-        vertices[0].color[1] = color.y();
-        vertices[0].color[2] = color.z();
-        vertices[0].color[3] = color.w();
-
-        // 右上
-        vertices[1].position[0] = pos.x() + size.x();
-        vertices[1].position[1] = pos.y();
-        vertices[1].texCoord[0] = uvMax.x();
-        vertices[1].texCoord[1] = uvMin.y();
-        vertices[1].color[0] = color.x();
-        vertices[1].color[1] = color.y();
-        vertices[1].color[2] = color.z();
-        vertices[1].color[3] = color.w();
-
-        // 右下
-        vertices[2].position[0] = pos.x() + size.x();
-        vertices[2].position[1] = pos.y() + size.y();
-        vertices[2].texCoord[0] = uvMax.x();
-        vertices[2].texCoord[1] = uvMax.y();
-        vertices[2].color[0] = color.x();
-        vertices[2].color[1] = color.y();
-        vertices[2].color[2] = color.z();
-        vertices[2].color[3] = color.w();
-
-        // 左下
-        vertices[3].position[0] = pos.x();
-        vertices[3].position[1] = pos.y() + size.y();
-        vertices[3].texCoord[0] = uvMin.x();
-        vertices[3].texCoord[1] = uvMax.y();
-        vertices[3].color[0] = color.x();
-        vertices[3].color[1] = color.y();
-        vertices[3].color[2] = color.z();
-        vertices[3].color[3] = color.w();
-
-        for (const auto& val : vertices)
-        {
-            m_currentBatch->vertices.push_back(val);
-        }
+    /**
+     * @brief 开始录制：之后 beginBatch / addRect 写入的内容同时追加到 geometry（先清空）
+     */
+    void beginRecording(render::RecordedGeometry& geometry)
+    {
+        geometry.clear();
+        m_recording = &geometry;
+    }
 
-        // 添加6个索引（2个三角形）
-        std::array<uint16_t, 6> indices = {baseIndex,
-                                           static_cast<uint16_t>(baseIndex + 1),
-                                           static_cast<uint16_t>(baseIndex + 2),
-                                           baseIndex,
-                                           static_cast<uint16_t>(baseIndex + 2),
-                                           static_cast<uint16_t>(baseIndex + 3)};
+    /**
+     * @brief 结束录制
+     */
+    void endRecording() { m_recording = nullptr; }
 
-        for (const auto& idx : indices)
+    /**
+     * @brief 回放录制的几何：按录制时的纹理与裁剪区域打开批次，实例整段复制
+     *
+     * 与录制时逐个调用 addRect 的结果相同
+     */
+    void replay(const render::RecordedGeometry& geometry)
+    {
+        for (const auto& recorded : geometry.batches)
         {
-            m_currentBatch->indices.push_back(idx);
+            beginBatch(recorded.texture, recorded.scissorRect);
+
+            render::QuadInstance* out = allocateInstances(recorded.instanceCount);
+            if (out == nullptr)
+            {
+                return;
+            }
+            std::copy_n(geometry.instances.data() + recorded.firstInstance, recorded.instanceCount, out);
+            m_currentBatch->instanceCount += recorded.instanceCount;
+            m_currentBatch->bounds.merge(recorded.bounds);
         }
     }
 
@@ -242,30 +281,108 @@ public:
      */
     void flushBatch()
     {
-        if (m_currentBatch.has_value() && !m_currentBatch->vertices.empty() && !m_currentBatch->indices.empty())
+        if (m_currentBatch.has_value() && m_currentBatch->instanceCount != 0)
         {
-            m_batches.push_back(std::move(m_currentBatch.value()));
+            m_batches.push_back(*m_currentBatch);
         }
         m_currentBatch.reset();
     }
 
     /**
-     * @brief 优化批次（当前简单实现，未来可以添加更多优化）
+     * @brief 优化批次：同层重排合并，并计算各批次在 GPU 实例缓冲区中的位置
+     *
+     * 按提交顺序处理每个批次，向前查找纹理与裁剪区域相同的批次并合并进去（只串接实例区间，不移动实例）。
+     * 查找只在同一 Z 层内进行，且跨过的每个批次都必须与它互不重叠，否则重叠处的混合顺序会改变；
+     * 与紧邻的前一个批次合并不改变顺序，总是允许
      */
     void optimize()
     {
         flushBatch(); // 确保当前批次已刷新
+        m_collectedBatchCount = m_batches.size();
+
+        // 合并后的批次由若干收集时的批次串成：firstRange 暂存链表头，m_nextSource 为链表的下一个
+        m_merged.clear();
+        m_mergedTail.clear();
+        m_nextSource.assign(m_batches.size(), NO_SOURCE);
+        for (uint32_t source = 0; source < m_batches.size(); ++source)
+        {
+            const render::RenderBatch& batch = m_batches[source];
+            const size_t target = findMergeTarget(batch);
+            if (target != NO_TARGET)
+            {
+                auto& merged = m_merged[target];
+                merged.instanceCount += batch.instanceCount;
+                merged.bounds.merge(batch.bounds);
+                merged.layer = batch.layer;
+                m_nextSource[m_mergedTail[target]] = source;
+                m_mergedTail[target] = source;
+            }
+            else
+            {
+                m_merged.push_back(batch);
+                m_merged.back().firstRange = source;
+                m_mergedTail.push_back(source);
+            }
+        }
 
-        // TODO:
-        // 1. 按纹理排序减少纹理切换
-        // 2. 合并相邻的相同纹理批次
-        // 3. Z-order排序处理透明度
+        // 按合并后的顺序展开实例区间（相邻的区间连成一段），上传后各批次在 GPU 缓冲区中首尾相接
+        m_ranges.clear();
+        uint32_t firstInstance = 0;
+        for (auto& merged : m_merged)
+        {
+            const uint32_t head = merged.firstRange;
+            merged.firstRange = static_cast<uint32_t>(m_ranges.size());
+            for (uint32_t source = head; source != NO_SOURCE; source = m_nextSource[source])
+            {
+                const uint32_t first = m_batches[source].firstInstance;
+                const uint32_t count = m_batches[source].instanceCount;
+                if (m_ranges.size() > merged.firstRange &&
+                    m_ranges.back().firstInstance + m_ranges.back().instanceCount == first)
+                {
+                    m_ranges.back().instanceCount += count;
+                }
+                else
+                {
+                    m_ranges.push_back({.firstInstance = first, .instanceCount = count});
+                }
+            }
+            merged.rangeCount = static_cast<uint32_t>(m_ranges.size()) - merged.firstRange;
+            merged.firstInstance = firstInstance;
+            firstInstance += merged.instanceCount;
+        }
+        std::swap(m_batches, m_merged);
     }
 
+    /**
+     * @brief 最近一次 optimize 之前收集到的批次数
+     */
+    [[nodiscard]] size_t getCollectedBatchCount() const { return m_collectedBatchCount; }
+
     /**
      * @brief 获取所有批次
      */
-    [[nodiscard]] const std::pmr::vector<render::RenderBatch>& getBatches() const { return m_batches; }
+    [[nodiscard]] const std::vector<render::RenderBatch>& getBatches() const { return m_batches; }
+
+    /**
+     * @brief 批次在整帧实例流中的区间（optimize 之后有效）
+     */
+    [[nodiscard]] std::span<const render::InstanceRange> getRanges(const render::RenderBatch& batch) const
+    {
+        return getRanges().subspan(batch.firstRange, batch.rangeCount);
+    }
+
+    /**
+     * @brief 所有批次的区间，按绘制顺序排列（optimize 之后有效），依次复制即得到 GPU 实例缓冲区的内容
+     */
+    [[nodiscard]] std::span<const render::InstanceRange> getRanges() const { return m_ranges; }
+
+    /**
+     * @brief 整帧实例流（提交顺序）
+     */
+    [[nodiscard]] std::span<const render::QuadInstance> getInstances() const
+    {
+        return m_instances.first(m_instanceCount);
+    }
 
     /**
      * @brief 获取批次数量
@@ -273,22 +390,124 @@ public:
     [[nodiscard]] size_t getBatchCount() const { return m_batches.size(); }
 
     /**
-     * @brief 获取总顶点数
+     * @brief 获取矩形实例总数
+     */
+    [[nodiscard]] size_t getInstanceCount() const { return m_instanceCount; }
+
+private:
+    static constexpr uint32_t NO_SOURCE = UINT32_MAX;
+    static constexpr size_t NO_TARGET = SIZE_MAX;
+
+    /**
+     * @brief 在实例流末尾分配 count 个实例，容量不足时扩容
+     * @return 扩容失败时返回 nullptr
      */
-    [[nodiscard]] size_t getTotalVertexCount() const
+    render::QuadInstance* allocateInstances(size_t count)
     {
-        size_t count = 0;
-        for (const auto& batch : m_batches)
+        const size_t required = m_instanceCount + count;
+        if (required > m_instances.size())
         {
-            count += batch.vertices.size();
+            const size_t capacity = std::max({required, m_instances.size() * 2, MIN_INSTANCE_CAPACITY});
+            if (m_storage != nullptr)
+            {
+                m_instances = m_storage->growInstances(capacity, m_instanceCount);
+            }
+            else
+            {
+                auto grown = std::make_unique_for_overwrite<render::QuadInstance[]>(capacity);
+                std::copy_n(m_ownedInstances.get(), m_instanceCount, grown.get());
+                m_ownedInstances = std::move(grown);
+                m_ownedCapacity = capacity;
+                m_instances = std::span<render::QuadInstance>(m_ownedInstances.get(), m_ownedCapacity);
+            }
+            if (required > m_instances.size())
+            {
+                return nullptr;
+            }
         }
-        return count;
+
+        render::QuadInstance* out = m_instances.data() + m_instanceCount;
+        m_instanceCount = required;
+        return out;
     }
 
-private:
-    std::pmr::monotonic_buffer_resource m_bufferResource; // 帧内内存池资源
-    std::pmr::vector<render::RenderBatch> m_batches;      // 存储所有渲染批次
-    std::optional<render::RenderBatch> m_currentBatch;    // 当前正在构建的批次
+    /**
+     * @brief 录制中打开新的一段；上一段为空时直接替换
+     */
+    void recordBatch(SDL_GPUTexture* texture, const std::optional<SDL_Rect>& scissor)
+    {
+        if (m_recording->batches.empty() || m_recording->batches.back().instanceCount != 0)
+        {
+            m_recording->batches.emplace_back();
+        }
+        auto& recorded = m_recording->batches.back();
+        recorded.texture = texture;
+        recorded.scissorRect = scissor;
+        recorded.firstInstance = static_cast<uint32_t>(m_recording->instances.size());
+    }
+
+    /**
+     * @brief 纹理与裁剪区域相同
+     */
+    static bool isCompatible(const render::RenderBatch& target, const render::RenderBatch& batch)
+    {
+        if (target.texture != batch.texture || target.scissorRect.has_value() != batch.scissorRect.has_value())
+        {
+            return false;
+        }
+        if (target.scissorRect.has_value())
+        {
+            const SDL_Rect& x = target.scissorRect.value();
+            const SDL_Rect& y = batch.scissorRect.value();
+            return x.x == y.x && x.y == y.y && x.w == y.w && x.h == y.h;
+        }
+        return true;
+    }
+
+    /**
+     * @brief 从后向前查找可以接收 batch 的批次
+     * @return 找不到时返回 NO_TARGET
+     */
+    size_t findMergeTarget(const render::RenderBatch& batch) const
+    {
+        const size_t lookback = std::min(m_merged.size(), MAX_REORDER_LOOKBACK);
+        for (size_t step = 1; step <= lookback; ++step)
+        {
+            const size_t index = m_merged.size() - step;
+            const auto& candidate = m_merged[index];
+            if (step > 1 && candidate.layer != batch.layer)
+            {
+                return NO_TARGET;
+            }
+            if (isCompatible(candidate, batch))
+            {
+                return index;
+            }
+            if (candidate.bounds.overlaps(batch.bounds))
+            {
+                return NO_TARGET; // 不能越过与之重叠的批次
+            }
+        }
+        return NO_TARGET;
+    }
+
+    std::vector<render::RenderBatch> m_batches;        // 收集时为各段批次，optimize 后为合并后的批次
+    std::vector<render::RenderBatch> m_merged;         // optimize 的工作区
+    std::vector<uint32_t> m_mergedTail;                // optimize：每个合并批次链表的最后一个
+    std::vector<uint32_t> m_nextSource;                // optimize：链表中的下一个收集时批次
+    std::vector<render::InstanceRange> m_ranges;       // 合并后各批次的实例区间
+    std::optional<render::RenderBatch> m_currentBatch; // 当前正在构建的批次
+    render::UiPushConstants m_pushConstants{};         // 整帧共享的推送常量
+    uint32_t m_layer = 0;                              // 当前写入的 Z 层
+    size_t m_collectedBatchCount = 0;                  // optimize 之前的批次数
+    render::RecordedGeometry* m_recording = nullptr;   // 正在录制的几何（未录制时为空）
+
+    // 整帧实例流
+    IInstanceStorage* m_storage = nullptr;                    // 外部存储（为空时使用 m_ownedInstances）
+    std::span<render::QuadInstance> m_instances;              // 可写空间
+    size_t m_instanceCount = 0;                               // 已写入的实例数
+    std::unique_ptr<render::QuadInstance[]> m_ownedInstances; // 内部存储，容量跨帧保留
+    size_t m_ownedCapacity = 0;
 };
 
 } // namespace ui::managers
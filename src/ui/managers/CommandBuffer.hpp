@@ -6,7 +6,9 @@
  * @date 2026-01-30
  * @version 0.1
  * @brief 命令缓冲区包装器 - 封装SDL GPU命令和资源管理
-    池化
+ *
+ * 矩形实例经 UploadRing 上传：beginFrame 返回映射后的实例存储交给 BatchManager，
+ * execute 按批次顺序把实例复制到 GPU 缓冲区，每个批次一次实例化绘制（静态单位矩形 × 实例数）
  *
  * ************************************************************************
  * @copyright Copyright (c) 2026 AnakinLiu
@@ -15,14 +17,14 @@
  */
 
 #pragma once
-#include <array>
 #include <cstdint>
-#include <vector>
+#include <cstring>
 #include <SDL3/SDL_gpu.h>
 #include "../managers/DeviceManager.hpp"
 #include "../managers/PipelineCache.hpp"
+#include "../managers/BatchManager.hpp"
+#include "../managers/UploadRing.hpp"
 #include "../common/RenderTypes.hpp"
-#include "../common/GPUWrappers.hpp"
 #include "../singleton/Logger.hpp"
 
 namespace ui::managers
@@ -33,13 +35,15 @@ namespace ui::managers
  *
  * 负责：
  * 1. 封装SDL GPU命令的提交、渲染通道等操作
- * 2. 管理顶点/索引缓冲区的生命周期和池化
+ * 2. 通过 UploadRing 管理实例缓冲区的生命周期（多帧在途，跨帧复用）
  */
 class CommandBuffer
 {
 public:
+    static constexpr uint32_t QUAD_VERTEX_COUNT = 6; // 单位矩形的两个三角形，见 vert.hlsl
+
     CommandBuffer(DeviceManager& deviceManager, PipelineCache& pipelineCache)
-        : m_deviceManager(deviceManager), m_pipelineCache(pipelineCache)
+        : m_deviceManager(deviceManager), m_pipelineCache(pipelineCache), m_uploadRing(deviceManager)
     {
     }
 
@@ -50,35 +54,33 @@ public:
     CommandBuffer& operator=(CommandBuffer&&) = delete;
 
     /**
-     * @brief 执行渲染批次
-     * @param batches 渲染批次列表
+     * @brief 开始收集一个窗口：返回本次提交的实例存储（映射后的上传缓冲区），交给 BatchManager::setInstanceStorage
+     * @return 映射失败时返回 nullptr，BatchManager 使用内部内存，execute 时再复制
+     */
+    IInstanceStorage* beginFrame() { return m_uploadRing.beginFrame(); }
+
+    /**
+     * @brief 执行渲染批次（batchManager 已 optimize）
      */
-    void execute(SDL_Window* window, int width, int height, const std::pmr::vector<render::RenderBatch>& batches)
+    void execute(SDL_Window* window, int width, int height, const BatchManager& batchManager)
     {
         SDL_GPUDevice* device = m_deviceManager.getDevice();
         if (device == nullptr) return;
 
-        auto [totalVertexCount, totalIndexCount] = calculateBatchTotals(batches);
-        if (totalVertexCount == 0 || totalIndexCount == 0) return;
-
-        uint32_t totalVertexSize = totalVertexCount * sizeof(render::Vertex);
-        uint32_t totalIndexSize = totalIndexCount * sizeof(uint16_t);
-
-        // 获取当前帧资源
-        FrameResource& currentFrame = m_frameResources[m_frameIndex % MAX_FRAMES_IN_FLIGHT];
-
-        // 确保缓冲区足够大
-        if (!resizeBuffers(device, currentFrame, totalVertexSize, totalIndexSize))
+        const auto instanceCount = static_cast<uint32_t>(batchManager.getInstanceCount());
+        if (instanceCount == 0)
         {
-            Logger::error("Failed to resize buffers.");
+            m_uploadRing.unmap();
             return;
         }
 
-        if (!uploadToTransferBuffer(device, batches, totalVertexSize))
+        if (!writeUploadData(batchManager, instanceCount))
         {
+            m_uploadRing.unmap();
             Logger::error("Failed to map transfer buffer.");
             return;
         }
+        m_uploadRing.unmap();
 
         SDL_GPUCommandBuffer* cmdBuf = SDL_AcquireGPUCommandBuffer(device);
         if (cmdBuf == nullptr) return;
@@ -97,120 +99,54 @@ public:
             return;
         }
 
-        recordCopyPass(cmdBuf, currentFrame, totalVertexSize, totalIndexSize);
-        recordRenderPass(cmdBuf, swapchainTexture, width, height, currentFrame, batches);
+        SDL_GPUCopyPass* copyPass = SDL_BeginGPUCopyPass(cmdBuf);
+        const bool uploaded = m_uploadRing.upload(copyPass, batchManager.getRanges(), instanceCount);
+        SDL_EndGPUCopyPass(copyPass);
+        if (!uploaded)
+        {
+            Logger::error("Failed to resize buffers.");
+            SDL_CancelGPUCommandBuffer(cmdBuf);
+            return;
+        }
 
-        // 提交命令缓冲区
-        SDL_SubmitGPUCommandBuffer(cmdBuf);
+        recordRenderPass(cmdBuf, swapchainTexture, width, height, batchManager);
 
-        // 切换到下一帧
-        m_frameIndex++;
+        // 提交命令缓冲区，切换到下一个帧槽
+        m_uploadRing.submit(cmdBuf);
     }
 
+    /**
+     * @brief 最近一帧的上传统计
+     */
+    [[nodiscard]] const UploadRing::Stats& getUploadStats() const { return m_uploadRing.getStats(); }
+    void resetUploadStats() { m_uploadRing.resetStats(); }
+
     /**
      * @brief 清理资源
      */
-    void cleanup()
-    {
-        // RAII handles destruction
-        for (auto& frame : m_frameResources)
-        {
-            frame.vertexBuffer.reset();
-            frame.indexBuffer.reset();
-            frame.vertexBufferSize = 0;
-            frame.indexBufferSize = 0;
-        }
-        m_transferBuffer.reset();
-        m_transferBufferSize = 0;
-    }
+    void cleanup() { m_uploadRing.cleanup(); }
 
 private:
-    static constexpr uint32_t MAX_FRAMES_IN_FLIGHT = 2;
-
-    struct FrameResource
-    {
-        wrappers::UniqueGPUBuffer vertexBuffer;
-        wrappers::UniqueGPUBuffer indexBuffer;
-        uint32_t vertexBufferSize = 0;
-        uint32_t indexBufferSize = 0;
-    };
-
-    [[nodiscard]] std::pair<uint32_t, uint32_t>
-        calculateBatchTotals(const std::pmr::vector<render::RenderBatch>& batches) const
-    {
-        uint32_t vertices = 0;
-        uint32_t indices = 0;
-        for (const auto& batch : batches)
-        {
-            vertices += static_cast<uint32_t>(batch.vertices.size());
-            indices += static_cast<uint32_t>(batch.indices.size());
-        }
-        return {vertices, indices};
-    }
-
-    bool uploadToTransferBuffer(SDL_GPUDevice* device,
-                                const std::pmr::vector<render::RenderBatch>& batches,
-                                uint32_t totalVertexSize)
+    /**
+     * @brief 实例不在上传缓冲区中时（映射失败后的内部内存）按原顺序复制过去
+     */
+    bool writeUploadData(const BatchManager& batchManager, uint32_t instanceCount)
     {
-        void* mapData = SDL_MapGPUTransferBuffer(device, m_transferBuffer.get(), true);
-        if (mapData == nullptr) return false;
-
-        auto* ptr = static_cast<uint8_t*>(mapData);
-        uint32_t vertexOffset = 0;
-        uint32_t indexOffset = totalVertexSize;
-
-        for (const auto& batch : batches)
-        {
-            if (batch.vertices.empty()) continue;
-            auto vSize = static_cast<uint32_t>(batch.vertices.size() * sizeof(render::Vertex));
-            SDL_memcpy(ptr + vertexOffset, batch.vertices.data(), vSize); // NOLINT
-            vertexOffset += vSize;
-        }
+        if (batchManager.getInstanceStorage() == &m_uploadRing) return true;
 
-        for (const auto& batch : batches)
-        {
-            if (batch.indices.empty()) continue;
-            auto iSize = static_cast<uint32_t>(batch.indices.size() * sizeof(uint16_t));
-            SDL_memcpy(ptr + indexOffset, batch.indices.data(), iSize);
-            indexOffset += iSize;
-        }
-
-        SDL_UnmapGPUTransferBuffer(device, m_transferBuffer.get());
+        if (m_uploadRing.beginFrame() == nullptr) return false;
+        const auto instances = m_uploadRing.growInstances(instanceCount, 0);
+        if (instances.size() < instanceCount) return false;
+        std::memcpy(
+            instances.data(), batchManager.getInstances().data(), instanceCount * sizeof(render::QuadInstance));
         return true;
     }
 
-    void recordCopyPass(SDL_GPUCommandBuffer* cmdBuf,
-                        const FrameResource& currentFrame,
-                        uint32_t totalVertexSize,
-                        uint32_t totalIndexSize)
-    {
-        SDL_GPUCopyPass* copyPass = SDL_BeginGPUCopyPass(cmdBuf);
-
-        SDL_GPUTransferBufferLocation srcLoc = {};
-        srcLoc.transfer_buffer = m_transferBuffer.get();
-        srcLoc.offset = 0;
-
-        SDL_GPUBufferRegion dstReg = {};
-        dstReg.buffer = currentFrame.vertexBuffer.get();
-        dstReg.offset = 0;
-        dstReg.size = totalVertexSize;
-
-        SDL_UploadToGPUBuffer(copyPass, &srcLoc, &dstReg, false);
-
-        srcLoc.offset = totalVertexSize;
-        dstReg.buffer = currentFrame.indexBuffer.get();
-        dstReg.size = totalIndexSize;
-        SDL_UploadToGPUBuffer(copyPass, &srcLoc, &dstReg, false);
-
-        SDL_EndGPUCopyPass(copyPass);
-    }
-
     void recordRenderPass(SDL_GPUCommandBuffer* cmdBuf,
                           SDL_GPUTexture* swapchainTexture,
                           int width,
                           int height,
-                          const FrameResource& currentFrame,
-                          const std::pmr::vector<render::RenderBatch>& batches)
+                          const BatchManager& batchManager)
     {
         SDL_GPUColorTargetInfo colorTarget = {};
         colorTarget.texture = swapchainTexture;
@@ -232,22 +168,16 @@ private:
         viewport.max_depth = 1.0F;
         SDL_SetGPUViewport(renderPass, &viewport);
 
-        SDL_GPUBufferBinding vertexBinding = {};
-        vertexBinding.buffer = currentFrame.vertexBuffer.get();
-        vertexBinding.offset = 0;
-        SDL_BindGPUVertexBuffers(renderPass, 0, &vertexBinding, 1);
-
-        SDL_GPUBufferBinding indexBinding = {};
-        indexBinding.buffer = currentFrame.indexBuffer.get();
-        indexBinding.offset = 0;
-        SDL_BindGPUIndexBuffer(renderPass, &indexBinding, SDL_GPU_INDEXELEMENTSIZE_16BIT);
+        // 单位矩形的角由顶点着色器按 SV_VertexID 生成，只绑定逐实例的缓冲区
+        SDL_GPUBufferBinding instanceBinding = {};
+        instanceBinding.buffer = m_uploadRing.instanceBuffer();
+        instanceBinding.offset = 0;
+        SDL_BindGPUVertexBuffers(renderPass, 0, &instanceBinding, 1);
 
-        uint32_t currentVertexOffset = 0;
-        uint32_t currentIndexOffset = 0;
-
-        for (const auto& batch : batches)
+        const render::UiPushConstants* pushed = nullptr;
+        for (const auto& batch : batchManager.getBatches())
         {
-            if (batch.vertices.empty() || batch.indices.empty()) continue;
+            if (batch.instanceCount == 0) continue;
 
             if (batch.scissorRect.has_value())
             {
@@ -268,80 +198,23 @@ private:
                 SDL_BindGPUFragmentSamplers(renderPass, 0, &texSamplerBinding, 1);
             }
 
-            SDL_PushGPUVertexUniformData(cmdBuf, 0, &batch.pushConstants, sizeof(render::UiPushConstants));
-            SDL_PushGPUFragmentUniformData(cmdBuf, 0, &batch.pushConstants, sizeof(render::UiPushConstants));
-
-            SDL_DrawGPUIndexedPrimitives(renderPass,
-                                         static_cast<uint32_t>(batch.indices.size()),
-                                         1,
-                                         currentIndexOffset,
-                                         static_cast<int32_t>(currentVertexOffset),
-                                         0);
+            // 只剩屏幕尺寸，整帧相同；只在变化时推送
+            if (pushed == nullptr || std::memcmp(pushed, &batch.pushConstants, sizeof(render::UiPushConstants)) != 0)
+            {
+                SDL_PushGPUVertexUniformData(cmdBuf, 0, &batch.pushConstants, sizeof(render::UiPushConstants));
+                pushed = &batch.pushConstants;
+            }
 
-            currentVertexOffset += static_cast<uint32_t>(batch.vertices.size());
-            currentIndexOffset += static_cast<uint32_t>(batch.indices.size());
+            // 实例按批次顺序上传，firstInstance 由 BatchManager::optimize 计算；每个矩形两个三角形
+            SDL_DrawGPUPrimitives(renderPass, QUAD_VERTEX_COUNT, batch.instanceCount, 0, batch.firstInstance);
         }
 
         SDL_EndGPURenderPass(renderPass);
     }
 
-    bool resizeBuffers(SDL_GPUDevice* device, FrameResource& frame, uint32_t vSize, uint32_t iSize)
-    {
-        // 传输缓冲区 (Shared across frames, handled by cycle=true)
-        uint32_t neededTransfer = vSize + iSize;
-
-        if (m_transferBufferSize < neededTransfer)
-        {
-            m_transferBufferSize =
-                neededTransfer > m_transferBufferSize * 2 ? neededTransfer : m_transferBufferSize * 2;
-            if (m_transferBufferSize < neededTransfer) m_transferBufferSize = neededTransfer;
-
-            SDL_GPUTransferBufferCreateInfo tInfo = {};
-            tInfo.usage = SDL_GPU_TRANSFERBUFFERUSAGE_UPLOAD;
-            tInfo.size = m_transferBufferSize;
-
-            m_transferBuffer = wrappers::MakeGpuResource<wrappers::UniqueGPUTransferBuffer>(
-                device, SDL_CreateGPUTransferBuffer, &tInfo);
-            if (!m_transferBuffer) return false;
-        }
-
-        // 顶点缓冲区 (Per Frame)
-        if (frame.vertexBufferSize < vSize)
-        {
-            frame.vertexBufferSize = vSize > frame.vertexBufferSize * 2 ? vSize : frame.vertexBufferSize * 2;
-
-            SDL_GPUBufferCreateInfo bInfo = {};
-            bInfo.usage = SDL_GPU_BUFFERUSAGE_VERTEX;
-            bInfo.size = frame.vertexBufferSize;
-            frame.vertexBuffer =
-                wrappers::MakeGpuResource<wrappers::UniqueGPUBuffer>(device, SDL_CreateGPUBuffer, &bInfo);
-            if (!frame.vertexBuffer) return false;
-        }
-
-        // 索引缓冲区 (Per Frame)
-        if (frame.indexBufferSize < iSize)
-        {
-            frame.indexBufferSize = iSize > frame.indexBufferSize * 2 ? iSize : frame.indexBufferSize * 2;
-
-            SDL_GPUBufferCreateInfo bInfo = {};
-            bInfo.usage = SDL_GPU_BUFFERUSAGE_INDEX;
-            bInfo.size = frame.indexBufferSize;
-            frame.indexBuffer =
-                wrappers::MakeGpuResource<wrappers::UniqueGPUBuffer>(device, SDL_CreateGPUBuffer, &bInfo);
-            if (!frame.indexBuffer) return false;
-        }
-        return true;
-    }
-
     DeviceManager& m_deviceManager;
     PipelineCache& m_pipelineCache;
-
-    // 帧资源池
-    std::array<FrameResource, MAX_FRAMES_IN_FLIGHT> m_frameResources;
-    uint32_t m_frameIndex = 0;
-
-    wrappers::UniqueGPUTransferBuffer m_transferBuffer;
-    uint32_t m_transferBufferSize = 0;
+    UploadRing m_uploadRing;
 };
 
 } // namespace ui::managers
@@ -4,13 +4,13 @@
  * @file FontAtlasManager.hpp
  * @author AnakinLiu (azrael2759@qq.com)
  * @date 2026-02-10
- * @version 0.1
+ * @version 0.2
  * @brief 字体图集管理器（FreeType + TextureAtlas）
  *
  * 集成 FreeType 字体管理和纹理图集，实现高效的字形缓存：
- * - 使用 FreeType2 渲染高质量字形
- * - 字形位图统一缓存到 GPU 纹理图集
- * - 提供字形 UV 坐标用于文本渲染
+ * - 使用 FontManager（与测量共用同一字体）渲染单个字形
+ * - 所有字号的字形统一缓存到一张 GPU 纹理图集，键为 (字号, 码点)
+ * - 提供字形 UV 坐标用于文本渲染，新字形在 uploadPending() 时批量上传
  *
  * ************************************************************************
  * @copyright Copyright (c) 2026 AnakinLiu
@@ -24,7 +24,6 @@
 #include "TextureAtlas.hpp"
 #include "DeviceManager.hpp"
 #include <memory>
-#include <optional>
 
 namespace ui::managers
 {
@@ -35,8 +34,8 @@ namespace ui::managers
 class FontAtlasManager
 {
 public:
-    explicit FontAtlasManager(DeviceManager& deviceManager)
-        : m_deviceManager(deviceManager), m_fontManager(std::make_unique<FontManager>())
+    FontAtlasManager(DeviceManager& deviceManager, FontManager& fontManager)
+        : m_deviceManager(deviceManager), m_fontManager(fontManager)
     {
         Logger::info("[FontAtlasManager] Initialized");
     }
@@ -50,89 +49,68 @@ public:
     FontAtlasManager& operator=(FontAtlasManager&&) = delete;
 
     /**
-     * @brief 从内存加载字体
-     * @param fontData 字体数据指针
-     * @param dataSize 字体数据大小
-     * @param fontSize 字体大小（像素）
-     * @return 加载成功返回 true
+     * @brief 字体已加载且图集可用（首次调用时创建图集）
      */
-    bool loadFromMemory(const uint8_t* fontData, size_t dataSize, float fontSize)
+    [[nodiscard]] bool isLoaded()
     {
-        if (!m_fontManager->loadFromMemory(fontData, dataSize, fontSize))
+        if (!m_fontManager.isLoaded())
         {
             return false;
         }
-
-        // 创建纹理图集
-        SDL_GPUDevice* device = m_deviceManager.getDevice();
-        if (device == nullptr)
+        if (m_atlas == nullptr)
         {
-            Logger::error("[FontAtlasManager] No GPU device available");
-            return false;
+            SDL_GPUDevice* device = m_deviceManager.getDevice();
+            if (device == nullptr)
+            {
+                return false;
+            }
+            m_atlas = std::make_unique<TextureAtlas>(device);
         }
-
-        m_atlas = std::make_unique<TextureAtlas>(device, 2048, 2);
-        Logger::info("[FontAtlasManager] Font loaded and atlas created");
-        return true;
+        return m_atlas->getTexture() != nullptr;
     }
 
     /**
-     * @brief 检查字体是否已加载
-     */
-    [[nodiscard]] bool isLoaded() const { return m_fontManager && m_fontManager->isLoaded() && m_atlas; }
-
-    /**
-     * @brief 获取字体高度（行高）
-     */
-    [[nodiscard]] int getFontHeight() const { return m_fontManager ? m_fontManager->getFontHeight() : 0; }
-
-    /**
-     * @brief 获取基线位置
+     * @brief 获取指定字号的基线与行高（FontManager 按字号缓存）
      */
-    [[nodiscard]] int getBaseline() const { return m_fontManager ? m_fontManager->getBaseline() : 0; }
-
-    /**
-     * @brief 测量文本宽度
-     */
-    int measureTextWidth(const std::string& text) { return m_fontManager ? m_fontManager->measureTextWidth(text) : 0; }
-
-    /**
-     * @brief 测量文本（带最大宽度限制）
-     */
-    int measureString(const char* text, size_t textLen, int maxWidth, size_t* outMeasuredLength)
-    {
-        return m_fontManager ? m_fontManager->measureString(text, textLen, maxWidth, outMeasuredLength) : 0;
-    }
+    const FontManager::SizeMetrics& getSizeMetrics(float fontSize) { return m_fontManager.getSizeMetrics(fontSize); }
 
     /**
      * @brief 获取字形（自动添加到图集）
      * @param codepoint Unicode 码点
-     * @return 图集中的字形信息，失败返回 nullopt
+     * @param fontSize 字体大小（像素），0 表示使用默认大小
+     * @return 图集中的字形信息，失败返回 nullptr
      */
-    std::optional<AtlasGlyph> getOrAddGlyph(uint32_t codepoint)
+    const AtlasGlyph* getOrAddGlyph(uint32_t codepoint, float fontSize)
     {
-        if (!isLoaded()) return std::nullopt;
+        if (!isLoaded()) return nullptr;
 
-        // 检查图集中是否已存在
-        auto existing = m_atlas->getGlyph(codepoint);
-        if (existing.has_value())
+        const uint64_t key = (static_cast<uint64_t>(makeSizeKey(fontSize)) << 32U) | codepoint;
+        if (const auto* existing = m_atlas->findGlyph(key))
         {
             return existing;
         }
 
-        // 渲染字形位图
-        GlyphInfo glyph = m_fontManager->renderGlyph(static_cast<int>(codepoint));
-        if (glyph.bitmap.empty())
-        {
-            Logger::warn("[FontAtlasManager] Empty bitmap for codepoint {}", codepoint);
-            return std::nullopt;
-        }
-
-        // 添加到图集
-        return m_atlas->addGlyph(
-            codepoint, glyph.bitmap.data(), glyph.width, glyph.height, glyph.bearingX, glyph.bearingY, glyph.advanceX);
+        // 渲染字形位图（空白字符没有位图，只记录前进量）
+        GlyphInfo glyph = m_fontManager.renderGlyph(static_cast<int>(codepoint), fontSize);
+        return m_atlas->addGlyph(key,
+                                 glyph.bitmap.empty() ? nullptr : glyph.bitmap.data(),
+                                 glyph.width,
+                                 glyph.height,
+                                 glyph.bearingX,
+                                 glyph.bearingY,
+                                 glyph.advanceX);
     }
 
+    /**
+     * @brief 上传本帧新增的字形，在提交绘制之前调用
+     */
+    bool uploadPending() { return m_atlas == nullptr || m_atlas->uploadPending(); }
+
+    /**
+     * @brief 图集扩展或清空的次数，变化说明之前生成的字形顶点已失效
+     */
+    [[nodiscard]] uint32_t getGeneration() const { return m_atlas ? m_atlas->getGeneration() : 0; }
+
     /**
      * @brief 获取图集纹理
      */
@@ -151,10 +129,6 @@ public:
      */
     void clear()
     {
-        if (m_fontManager)
-        {
-            m_fontManager->clearCache();
-        }
         if (m_atlas)
         {
             m_atlas->clear();
@@ -171,8 +145,17 @@ public:
     }
 
 private:
+    /**
+     * @brief 字号键（精度 0.1px，0 表示默认字号）
+     */
+    [[nodiscard]] uint32_t makeSizeKey(float fontSize) const
+    {
+        const float targetSize = (fontSize > 0.0F) ? fontSize : m_fontManager.getFontSize();
+        return static_cast<uint32_t>(targetSize * 10.0F);
+    }
+
     DeviceManager& m_deviceManager;
-    std::unique_ptr<FontManager> m_fontManager;
+    FontManager& m_fontManager;
     std::unique_ptr<TextureAtlas> m_atlas;
 };
 
@@ -37,6 +37,8 @@
 #include <cstdint>
 #include <cmath>
 #include "../singleton/Logger.hpp"
+#include "../core/TextUtils.hpp"
+#include "GlyphAdvanceCache.hpp"
 
 namespace ui::managers
 {
@@ -152,6 +154,9 @@ public:
 
         m_fontSize = fontSize;
         m_loaded = true;
+        m_advanceCaches.clear();
+        m_sizeMetrics.clear();
+        ++m_fontGeneration;
 
         // 创建 HarfBuzz font
         createHarfBuzzFont();
@@ -188,6 +193,41 @@ public:
         return static_cast<int>(m_ftFace->size->metrics.ascender >> 6);
     }
 
+    /**
+     * @brief 指定字号下的基线与行高（像素）
+     */
+    struct SizeMetrics
+    {
+        int baseline = 0;
+        int height = 0;
+    };
+
+    /**
+     * @brief 获取指定字号的基线与行高（按字号缓存）
+     * @param fontSize 字体大小（像素），0 表示使用默认大小
+     */
+    const SizeMetrics& getSizeMetrics(float fontSize = 0.0F)
+    {
+        const float targetSize = (fontSize > 0.0F) ? fontSize : m_fontSize;
+        const auto sizeKey = static_cast<uint32_t>(targetSize * 10.0F);
+        auto iter = m_sizeMetrics.find(sizeKey);
+        if (iter == m_sizeMetrics.end())
+        {
+            SizeMetrics metrics{};
+            withPixelSize(targetSize,
+                          [&]() { metrics = SizeMetrics{.baseline = getBaseline(), .height = getFontHeight()}; });
+            iter = m_sizeMetrics.emplace(sizeKey, metrics).first;
+        }
+        return iter->second;
+    }
+
+    /**
+     * @brief 字体版本号，每次成功加载字体后递增（0 表示尚未加载）
+     *
+     * 按字体缓存的排版结果用它判断是否失效
+     */
+    [[nodiscard]] uint32_t getFontGeneration() const { return m_fontGeneration; }
+
     /**
      * @brief 测量 UTF-8 文本的宽度
      * @param text UTF-8 编码的文本
@@ -203,42 +243,27 @@ public:
             return 0;
         }
 
+        GlyphAdvanceCache& advances = getAdvanceCache();
         float totalWidth = 0.0F;
         size_t bytePos = 0;
         std::string_view view(text, textLen);
-        FT_UInt prevGlyphIndex = 0;
-        bool useKerning = FT_HAS_KERNING(m_ftFace);
+        uint32_t previous = 0;
 
         while (bytePos < textLen)
         {
-            int codepoint = 0;
-            size_t charLen = decodeUTF8(view.substr(bytePos), codepoint);
+            uint32_t codepoint = 0;
+            size_t charLen = utils::DecodeUtf8(view.substr(bytePos), codepoint);
             if (charLen == 0) break;
 
-            FT_UInt glyphIndex = FT_Get_Char_Index(m_ftFace, static_cast<FT_ULong>(codepoint));
-
-            // 应用字距调整（kerning）
-            if (useKerning && prevGlyphIndex != 0 && glyphIndex != 0)
-            {
-                FT_Vector delta;
-                FT_Get_Kerning(m_ftFace, prevGlyphIndex, glyphIndex, FT_KERNING_DEFAULT, &delta);
-                totalWidth += static_cast<float>(delta.x >> 6);
-            }
-
-            // 加载字形获取 advance
-            if (FT_Load_Glyph(m_ftFace, glyphIndex, FT_LOAD_DEFAULT) == 0)
+            // 前进量与字距均来自缓存
+            const float advance = advances.advance(codepoint, previous);
+            if (maxWidth > 0 && totalWidth + advance > static_cast<float>(maxWidth))
             {
-                float advance = static_cast<float>(m_ftFace->glyph->advance.x >> 6);
-
-                if (maxWidth > 0 && totalWidth + advance > static_cast<float>(maxWidth))
-                {
-                    break;
-                }
-
-                totalWidth += advance;
+                break;
             }
 
-            prevGlyphIndex = glyphIndex;
+            totalWidth += advance;
+            previous = codepoint;
             bytePos += charLen;
         }
 
@@ -250,6 +275,54 @@ public:
         return static_cast<int>(std::ceil(totalWidth));
     }
 
+    /**
+     * @brief 获取指定字号的前进量/字距缓存（首次使用时创建）
+     * @param fontSize 字体大小（像素），0 表示使用默认大小
+     *
+     * 缓存只在未命中时切换字号向 FreeType 查询，换行与测量的热路径不再调用 FT_Load_Glyph
+     */
+    GlyphAdvanceCache& getAdvanceCache(float fontSize = 0.0F)
+    {
+        const float targetSize = (fontSize > 0.0F) ? fontSize : m_fontSize;
+        const auto sizeKey = static_cast<uint32_t>(targetSize * 10.0F);
+        auto iter = m_advanceCaches.find(sizeKey);
+        if (iter != m_advanceCaches.end())
+        {
+            return *iter->second;
+        }
+
+        GlyphAdvanceCache::KerningLoader kerning;
+        if (m_ftFace && FT_HAS_KERNING(m_ftFace))
+        {
+            kerning = [this, targetSize](uint32_t leftGlyph, uint32_t rightGlyph)
+            {
+                FT_Vector delta{};
+                withPixelSize(targetSize,
+                              [&]() { FT_Get_Kerning(m_ftFace, leftGlyph, rightGlyph, FT_KERNING_DEFAULT, &delta); });
+                return static_cast<float>(delta.x >> 6);
+            };
+        }
+
+        auto cache = std::make_unique<GlyphAdvanceCache>(
+            [this, targetSize](uint32_t codepoint)
+            {
+                GlyphAdvance result{};
+                if (!m_ftFace) return result;
+                withPixelSize(targetSize,
+                              [&]()
+                              {
+                                  result.glyphIndex = FT_Get_Char_Index(m_ftFace, static_cast<FT_ULong>(codepoint));
+                                  if (FT_Load_Glyph(m_ftFace, result.glyphIndex, FT_LOAD_DEFAULT) == 0)
+                                  {
+                                      result.advance = static_cast<float>(m_ftFace->glyph->advance.x >> 6);
+                                  }
+                              });
+                return result;
+            },
+            std::move(kerning));
+        return *m_advanceCaches.emplace(sizeKey, std::move(cache)).first->second;
+    }
+
     /**
      * @brief 测量文本宽度（简化版本）
      */
@@ -633,45 +706,13 @@ public:
      */
     static size_t decodeUTF8(std::string_view text, int& outCodepoint)
     {
-        if (text.empty()) return 0;
-
-        const auto byte0 = static_cast<uint8_t>(text[0]);
-
-        // 单字节 ASCII
-        if (byte0 < 0x80)
-        {
-            outCodepoint = byte0;
-            return 1;
-        }
-
-        // 2 字节
-        if ((byte0 & 0xE0U) == 0xC0)
-        {
-            if (text.size() < 2) return 0;
-            outCodepoint = static_cast<int>(((byte0 & 0x1FU) << 6U) | (static_cast<uint8_t>(text[1]) & 0x3FU));
-            return 2;
-        }
-
-        // 3 字节
-        if ((byte0 & 0xF0U) == 0xE0)
-        {
-            if (text.size() < 3) return 0;
-            outCodepoint = static_cast<int>(((byte0 & 0x0FU) << 12U) | ((static_cast<uint8_t>(text[1]) & 0x3FU) << 6U) |
-                                            (static_cast<uint8_t>(text[2]) & 0x3FU));
-            return 3;
-        }
-
-        // 4 字节
-        if ((byte0 & 0xF8U) == 0xF0)
+        uint32_t codepoint = 0;
+        const size_t length = utils::DecodeUtf8(text, codepoint);
+        if (length != 0)
         {
-            if (text.size() < 4) return 0;
-            outCodepoint = static_cast<int>(
-                ((byte0 & 0x07U) << 18U) | ((static_cast<uint8_t>(text[1]) & 0x3FU) << 12U) |
-                ((static_cast<uint8_t>(text[2]) & 0x3FU) << 6U) | (static_cast<uint8_t>(text[3]) & 0x3FU));
-            return 4;
+            outCodepoint = static_cast<int>(codepoint);
         }
-
-        return 0;
+        return length;
     }
 
 private:
@@ -721,6 +762,25 @@ private:
         }
     }
 
+    /**
+     * @brief 在指定字号下执行 func，结束后恢复当前字号
+     */
+    template <typename Func>
+    void withPixelSize(float size, Func&& func)
+    {
+        const bool needRestore = (std::abs(size - m_fontSize) > 0.1F);
+        const float oldSize = m_fontSize;
+        if (needRestore)
+        {
+            setPixelSize(size);
+        }
+        func();
+        if (needRestore)
+        {
+            setPixelSize(oldSize);
+        }
+    }
+
     /**
      * @brief 生成字形缓存键（包含字体大小）
      */
@@ -744,6 +804,11 @@ private:
 
     // 字形缓存（key = (fontSize << 32) | codepoint）
     std::unordered_map<uint64_t, GlyphInfo> m_glyphCache;
+
+    // 前进量/字距缓存与行高缓存（key = 字号 * 10）
+    std::unordered_map<uint32_t, std::unique_ptr<GlyphAdvanceCache>> m_advanceCaches;
+    std::unordered_map<uint32_t, SizeMetrics> m_sizeMetrics;
+    uint32_t m_fontGeneration = 0;
 };
 
 } // namespace ui::managers
@@ -0,0 +1,147 @@
+/**
+ * ************************************************************************
+ *
+ * @file GlyphAdvanceCache.hpp
+ * @author AnakinLiu (azrael2759@qq.com)
+ * @date 2026-10-16
+ * @version 0.1
+ * @brief 单个字号的字形前进量与字距缓存
+ *
+ * 文本测量与换行只需要前进量，不需要位图。每个码点只向字体查询一次：
+ * - BMP（含 ASCII 与 CJK）按 256 个码点一页的稠密数组存放，页在首次访问时分配
+ * - BMP 以外的码点放在哈希表中
+ * - 字体带 kern 表时，字距按 (左字形, 右字形) 缓存
+ * 不依赖 FreeType，字形数据由构造时传入的加载函数提供
+ *
+ * ************************************************************************
+ * @copyright Copyright (c) 2026 AnakinLiu
+ * For study and research only, no reprinting.
+ * ************************************************************************
+ */
+
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+
+namespace ui::managers
+{
+
+/**
+ * @brief 单个字形的度量
+ */
+struct GlyphAdvance
+{
+    float advance = 0.0F;    // 水平前进量（像素）
+    uint32_t glyphIndex = 0; // 字体中的字形索引，0 表示缺字
+};
+
+class GlyphAdvanceCache
+{
+public:
+    using GlyphLoader = std::function<GlyphAdvance(uint32_t codepoint)>;
+    using KerningLoader = std::function<float(uint32_t leftGlyph, uint32_t rightGlyph)>;
+
+    /**
+     * @param loader 缓存未命中时查询字形度量
+     * @param kerning 查询字距，为空表示字体没有字距信息
+     */
+    explicit GlyphAdvanceCache(GlyphLoader loader, KerningLoader kerning = {})
+        : m_loader(std::move(loader)), m_kerning(std::move(kerning))
+    {
+    }
+
+    /**
+     * @brief 码点的字形度量（首次访问时加载）
+     */
+    const GlyphAdvance& glyph(uint32_t codepoint)
+    {
+        if (codepoint < BMP_SIZE)
+        {
+            auto& page = m_pages[codepoint >> PAGE_BITS];
+            if (page == nullptr)
+            {
+                page = std::make_unique<Page>();
+            }
+            auto& entry = (*page)[codepoint & (PAGE_SIZE - 1)];
+            if (entry.advance < 0.0F)
+            {
+                entry = load(codepoint);
+            }
+            return entry;
+        }
+
+        auto iter = m_supplementary.find(codepoint);
+        if (iter == m_supplementary.end())
+        {
+            iter = m_supplementary.emplace(codepoint, load(codepoint)).first;
+        }
+        return iter->second;
+    }
+
+    /**
+     * @brief 紧跟在 previous 之后的 codepoint 占用的宽度（前进量 + 字距）
+     * @param previous 前一个码点，0 表示行首
+     */
+    float advance(uint32_t codepoint, uint32_t previous)
+    {
+        const GlyphAdvance& current = glyph(codepoint);
+        if (!m_kerning || previous == 0 || current.glyphIndex == 0)
+        {
+            return current.advance;
+        }
+        const uint32_t left = glyph(previous).glyphIndex;
+        if (left == 0)
+        {
+            return current.advance;
+        }
+
+        const uint64_t key = (static_cast<uint64_t>(left) << 32U) | current.glyphIndex;
+        auto iter = m_kerningPairs.find(key);
+        if (iter == m_kerningPairs.end())
+        {
+            iter = m_kerningPairs.emplace(key, m_kerning(left, current.glyphIndex)).first;
+        }
+        return current.advance + iter->second;
+    }
+
+    /**
+     * @brief 向字体查询的次数（即缓存未命中次数）
+     */
+    [[nodiscard]] size_t loadCount() const { return m_loadCount; }
+
+private:
+    static constexpr uint32_t BMP_SIZE = 0x10000;
+    static constexpr uint32_t PAGE_BITS = 8;
+    static constexpr uint32_t PAGE_SIZE = 1U << PAGE_BITS;
+
+    // 前进量为负表示尚未加载
+    struct Page : std::array<GlyphAdvance, PAGE_SIZE>
+    {
+        Page() { fill(GlyphAdvance{.advance = -1.0F, .glyphIndex = 0}); }
+    };
+
+    GlyphAdvance load(uint32_t codepoint)
+    {
+        ++m_loadCount;
+        GlyphAdvance result = m_loader(codepoint);
+        if (result.advance < 0.0F)
+        {
+            result.advance = 0.0F;
+        }
+        return result;
+    }
+
+    GlyphLoader m_loader;
+    KerningLoader m_kerning;
+    std::array<std::unique_ptr<Page>, (BMP_SIZE >> PAGE_BITS)> m_pages;
+    std::unordered_map<uint32_t, GlyphAdvance> m_supplementary;
+    std::unordered_map<uint64_t, float> m_kerningPairs;
+    size_t m_loadCount = 0;
+};
+
+} // namespace ui::managers
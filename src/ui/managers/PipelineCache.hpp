@@ -83,38 +83,56 @@ public:
             return;
         }
 
-        // 顶点属性描述
-        SDL_GPUVertexAttribute vertexAttributes[3] = {};
+        // 逐实例属性描述（矩形的 4 个角由顶点着色器按 SV_VertexID 生成，没有逐顶点缓冲区）
+        SDL_GPUVertexAttribute vertexAttributes[6] = {};
 
-        // 位置 (vec2)
+        // 屏幕矩形 (vec4)
         vertexAttributes[0].location = 0;
-        vertexAttributes[0].format = SDL_GPU_VERTEXELEMENTFORMAT_FLOAT2;
+        vertexAttributes[0].format = SDL_GPU_VERTEXELEMENTFORMAT_FLOAT4;
         vertexAttributes[0].buffer_slot = 0;
-        vertexAttributes[0].offset = static_cast<uint32_t>(offsetof(ui::render::Vertex, position));
+        vertexAttributes[0].offset = static_cast<uint32_t>(offsetof(ui::render::QuadInstance, rect));
 
-        // 纹理坐标 (vec2)
+        // UV 矩形 (unorm16 x4)
         vertexAttributes[1].location = 1;
-        vertexAttributes[1].format = SDL_GPU_VERTEXELEMENTFORMAT_FLOAT2;
+        vertexAttributes[1].format = SDL_GPU_VERTEXELEMENTFORMAT_USHORT4_NORM;
         vertexAttributes[1].buffer_slot = 0;
-        vertexAttributes[1].offset = static_cast<uint32_t>(offsetof(ui::render::Vertex, texCoord));
+        vertexAttributes[1].offset = static_cast<uint32_t>(offsetof(ui::render::QuadInstance, uvRect));
 
-        // 颜色 (vec4)
+        // 颜色 (unorm8 x4)
         vertexAttributes[2].location = 2;
-        vertexAttributes[2].format = SDL_GPU_VERTEXELEMENTFORMAT_FLOAT4;
+        vertexAttributes[2].format = SDL_GPU_VERTEXELEMENTFORMAT_UBYTE4_NORM;
         vertexAttributes[2].buffer_slot = 0;
-        vertexAttributes[2].offset = static_cast<uint32_t>(offsetof(ui::render::Vertex, color));
+        vertexAttributes[2].offset = static_cast<uint32_t>(offsetof(ui::render::QuadInstance, color));
+
+        // 四角圆角 (half4)
+        vertexAttributes[3].location = 3;
+        vertexAttributes[3].format = SDL_GPU_VERTEXELEMENTFORMAT_HALF4;
+        vertexAttributes[3].buffer_slot = 0;
+        vertexAttributes[3].offset = static_cast<uint32_t>(offsetof(ui::render::QuadInstance, radius));
+
+        // 阴影与整体透明度 (half4)
+        vertexAttributes[4].location = 4;
+        vertexAttributes[4].format = SDL_GPU_VERTEXELEMENTFORMAT_HALF4;
+        vertexAttributes[4].buffer_slot = 0;
+        vertexAttributes[4].offset = static_cast<uint32_t>(offsetof(ui::render::QuadInstance, shadow));
+
+        // 标志位 (uint)
+        vertexAttributes[5].location = 5;
+        vertexAttributes[5].format = SDL_GPU_VERTEXELEMENTFORMAT_UINT;
+        vertexAttributes[5].buffer_slot = 0;
+        vertexAttributes[5].offset = static_cast<uint32_t>(offsetof(ui::render::QuadInstance, flags));
 
         SDL_GPUVertexBufferDescription vertexBufferDesc = {};
         vertexBufferDesc.slot = 0;
-        vertexBufferDesc.pitch = sizeof(ui::render::Vertex);
-        vertexBufferDesc.input_rate = SDL_GPU_VERTEXINPUTRATE_VERTEX;
+        vertexBufferDesc.pitch = sizeof(ui::render::QuadInstance);
+        vertexBufferDesc.input_rate = SDL_GPU_VERTEXINPUTRATE_INSTANCE;
         vertexBufferDesc.instance_step_rate = 0;
 
         SDL_GPUVertexInputState vertexInputState = {};
         vertexInputState.vertex_buffer_descriptions = &vertexBufferDesc;
         vertexInputState.num_vertex_buffers = 1;
         vertexInputState.vertex_attributes = vertexAttributes;
-        vertexInputState.num_vertex_attributes = 3;
+        vertexInputState.num_vertex_attributes = 6;
 
         // 颜色附件描述
         SDL_GPUColorTargetBlendState blendState = {};
@@ -214,7 +232,8 @@ private:
         shaderInfo.format = format;
         shaderInfo.stage = stage;
         shaderInfo.num_samplers = (stage == SDL_GPU_SHADERSTAGE_FRAGMENT) ? 1u : 0u;
-        shaderInfo.num_uniform_buffers = 1u;
+        // 只有顶点着色器使用推送常量（屏幕尺寸）
+        shaderInfo.num_uniform_buffers = (stage == SDL_GPU_SHADERSTAGE_VERTEX) ? 1u : 0u;
 
         return wrappers::MakeGpuResource<wrappers::UniqueGPUShader>(
             m_deviceManager->getDevice(), SDL_CreateGPUShader, &shaderInfo);
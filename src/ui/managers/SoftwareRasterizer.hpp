@@ -0,0 +1,540 @@
+/**
+ * ************************************************************************
+ *
+ * @file SoftwareRasterizer.hpp
+ * @author AnakinLiu (azrael2759@qq.com)
+ * @date 2026-10-16
+ * @version 0.1
+ * @brief CPU 光栅化后端 - 不需要 GPU 设备，把批次渲染到内存中的 RGBA 缓冲区
+ *
+ * 输入与 CommandBuffer 相同（optimize 之后的 BatchManager），按 frag.hlsl 逐像素计算：
+ * 圆角矩形 SDF 与抗锯齿边缘、阴影、预乘 / 直通 Alpha 的纹理采样，以及 (ONE, ONE_MINUS_SRC_ALPHA) 混合。
+ * - 先把实例解码并按 64x64 的图块分箱（保持绘制顺序），各图块在 TaskScheduler 上并行光栅化
+ * - 每行按 8 个像素一组用 Eigen 数组计算（SIMD），纹理为双线性采样、边缘截断
+ * 用于没有 GPU 的环境下的画面测试（对比像素或参考图）与帧率基准
+ *
+ * ************************************************************************
+ * @copyright Copyright (c) 2026 AnakinLiu
+ * For study and research only, no reprinting.
+ * ************************************************************************
+ */
+
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <span>
+#include <unordered_map>
+#include <vector>
+#include <SDL3/SDL_gpu.h>
+#include <SDL3/SDL_rect.h>
+#include <Eigen/Dense>
+#include "src/utils/TaskScheduler.h"
+#include "../common/RenderTypes.hpp"
+#include "BatchManager.hpp"
+
+namespace ui::managers
+{
+
+class SoftwareRasterizer
+{
+public:
+    static constexpr int32_t TILE_SIZE = 64; // 图块边长（像素），每个图块是一个任务
+    static constexpr int32_t SPAN = 8;       // 一次计算的像素数
+
+    /**
+     * @param scheduler 为空时在调用线程上依次光栅化各图块
+     */
+    explicit SoftwareRasterizer(utils::TaskScheduler* scheduler = &utils::TaskScheduler::global())
+        : m_scheduler(scheduler)
+    {
+    }
+
+    /**
+     * @brief 设置渲染目标尺寸（内容在下一次 execute 时重新生成）
+     */
+    void resize(uint32_t width, uint32_t height)
+    {
+        m_width = static_cast<int32_t>(width);
+        m_height = static_cast<int32_t>(height);
+        const size_t pixels = static_cast<size_t>(width) * height;
+        for (auto& plane : m_planes)
+        {
+            plane.assign(pixels, 0.0F);
+        }
+        m_pixels.assign(pixels * 4, 0);
+        m_tilesX = (m_width + TILE_SIZE - 1) / TILE_SIZE;
+        m_tilesY = (m_height + TILE_SIZE - 1) / TILE_SIZE;
+        m_bins.resize(static_cast<size_t>(m_tilesX) * m_tilesY);
+    }
+
+    /**
+     * @brief 清屏颜色，默认与 CommandBuffer 相同
+     */
+    void setClearColor(float red, float green, float blue, float alpha) { m_clearColor = {red, green, blue, alpha}; }
+
+    /**
+     * @brief 登记批次引用的纹理的像素（RGBA8，按行紧密排列），内容被复制
+     *
+     * 未登记的纹理与空纹理按白色采样
+     */
+    void setTexture(SDL_GPUTexture* handle, uint32_t width, uint32_t height, std::span<const uint8_t> rgba)
+    {
+        Texture& texture = m_textures[handle];
+        texture.width = static_cast<int32_t>(width);
+        texture.height = static_cast<int32_t>(height);
+        texture.texels.assign(rgba.begin(), rgba.end());
+    }
+
+    void removeTexture(SDL_GPUTexture* handle) { m_textures.erase(handle); }
+
+    /**
+     * @brief 清屏并按顺序绘制全部批次（batchManager 已 optimize），结果见 pixels()
+     */
+    void execute(const BatchManager& batchManager)
+    {
+        if (m_width <= 0 || m_height <= 0) return;
+
+        binQuads(batchManager);
+
+        const auto tileCount = static_cast<size_t>(m_tilesX) * m_tilesY;
+        if (m_scheduler == nullptr)
+        {
+            for (size_t tile = 0; tile < tileCount; ++tile)
+            {
+                renderTile(tile);
+            }
+            return;
+        }
+        utils::TaskGroup group(*m_scheduler);
+        group.runBatch(tileCount, [this](size_t tile) { renderTile(tile); });
+        group.wait();
+    }
+
+    /**
+     * @brief 渲染结果（RGBA8，按行紧密排列，与交换链相同的非 sRGB 数值）
+     */
+    [[nodiscard]] std::span<const uint8_t> pixels() const { return m_pixels; }
+
+    [[nodiscard]] std::array<uint8_t, 4> pixel(int32_t x, int32_t y) const
+    {
+        const size_t offset = ((static_cast<size_t>(y) * m_width) + x) * 4;
+        return {m_pixels[offset], m_pixels[offset + 1], m_pixels[offset + 2], m_pixels[offset + 3]};
+    }
+
+    [[nodiscard]] uint32_t width() const { return static_cast<uint32_t>(m_width); }
+    [[nodiscard]] uint32_t height() const { return static_cast<uint32_t>(m_height); }
+
+private:
+    using Span = Eigen::Array<float, SPAN, 1>;
+
+    struct Texture
+    {
+        int32_t width = 0;
+        int32_t height = 0;
+        std::vector<uint8_t> texels;
+    };
+
+    /**
+     * @brief 解码后的实例与它覆盖的像素范围 [x0, x1) x [y0, y1)（已与裁剪区域和渲染目标求交）
+     */
+    struct Quad
+    {
+        float rect[4];
+        float uv[4];
+        float color[4];
+        float radius[4];
+        float shadow[3];
+        float opacity;
+        bool premultiplied;
+        const Texture* texture; // 为空时按白色采样
+        int32_t x0, y0, x1, y1;
+    };
+
+    /**
+     * @brief 按绘制顺序解码实例，并把每个实例的下标放入它覆盖的图块
+     */
+    void binQuads(const BatchManager& batchManager)
+    {
+        m_quads.clear();
+        for (auto& bin : m_bins)
+        {
+            bin.clear();
+        }
+
+        const auto instances = batchManager.getInstances();
+        for (const auto& batch : batchManager.getBatches())
+        {
+            SDL_Rect clip{0, 0, m_width, m_height};
+            if (batch.scissorRect.has_value() && !SDL_GetRectIntersection(&clip, &batch.scissorRect.value(), &clip))
+            {
+                continue;
+            }
+            const auto textureIter = m_textures.find(batch.texture);
+            const Texture* texture = textureIter != m_textures.end() ? &textureIter->second : nullptr;
+
+            for (const auto& range : batchManager.getRanges(batch))
+            {
+                for (const auto& instance : instances.subspan(range.firstInstance, range.instanceCount))
+                {
+                    addQuad(instance, texture, clip);
+                }
+            }
+        }
+    }
+
+    void addQuad(const render::QuadInstance& instance, const Texture* texture, const SDL_Rect& clip)
+    {
+        // 与 GPU 相同：像素中心落在矩形内才会被着色
+        const float* rect = instance.rect;
+        const auto x0 = std::max(clip.x, static_cast<int32_t>(std::ceil(rect[0] - 0.5F)));
+        const auto y0 = std::max(clip.y, static_cast<int32_t>(std::ceil(rect[1] - 0.5F)));
+        const auto x1 = std::min(clip.x + clip.w, static_cast<int32_t>(std::ceil(rect[0] + rect[2] - 0.5F)));
+        const auto y1 = std::min(clip.y + clip.h, static_cast<int32_t>(std::ceil(rect[1] + rect[3] - 0.5F)));
+        if (x0 >= x1 || y0 >= y1) return;
+
+        Quad quad{};
+        std::copy_n(rect, 4, quad.rect);
+        for (int index = 0; index < 4; ++index)
+        {
+            quad.uv[index] = static_cast<float>(instance.uvRect[index]) / 65535.0F;
+            quad.color[index] = static_cast<float>(instance.color[index]) / 255.0F;
+            quad.radius[index] = render::unpackHalf(instance.radius[index]);
+        }
+        for (int index = 0; index < 3; ++index)
+        {
+            quad.shadow[index] = render::unpackHalf(instance.shadow[index]);
+        }
+        quad.opacity = render::unpackHalf(instance.shadow[3]);
+        quad.premultiplied = (instance.flags & render::QuadInstance::FLAG_PREMULTIPLIED) != 0U;
+        quad.texture = texture;
+        quad.x0 = x0;
+        quad.y0 = y0;
+        quad.x1 = x1;
+        quad.y1 = y1;
+
+        const auto index = static_cast<uint32_t>(m_quads.size());
+        m_quads.push_back(quad);
+        for (int32_t tileY = y0 / TILE_SIZE; tileY <= (y1 - 1) / TILE_SIZE; ++tileY)
+        {
+            for (int32_t tileX = x0 / TILE_SIZE; tileX <= (x1 - 1) / TILE_SIZE; ++tileX)
+            {
+                m_bins[(static_cast<size_t>(tileY) * m_tilesX) + tileX].push_back(index);
+            }
+        }
+    }
+
+    /**
+     * @brief 清屏、依次绘制图块内的实例，再转换为 RGBA8
+     */
+    void renderTile(size_t tile)
+    {
+        const int32_t tileX0 = static_cast<int32_t>(tile % m_tilesX) * TILE_SIZE;
+        const int32_t tileY0 = static_cast<int32_t>(tile / m_tilesX) * TILE_SIZE;
+        const int32_t tileX1 = std::min(tileX0 + TILE_SIZE, m_width);
+        const int32_t tileY1 = std::min(tileY0 + TILE_SIZE, m_height);
+
+        for (int32_t y = tileY0; y < tileY1; ++y)
+        {
+            const size_t row = static_cast<size_t>(y) * m_width;
+            for (int channel = 0; channel < 4; ++channel)
+            {
+                std::fill_n(m_planes[channel].data() + row + tileX0, tileX1 - tileX0, m_clearColor[channel]);
+            }
+        }
+
+        for (const uint32_t index : m_bins[tile])
+        {
+            const Quad& quad = m_quads[index];
+            const int32_t x0 = std::max(quad.x0, tileX0);
+            const int32_t x1 = std::min(quad.x1, tileX1);
+            for (int32_t y = std::max(quad.y0, tileY0); y < std::min(quad.y1, tileY1); ++y)
+            {
+                shadeRow(quad, x0, x1, y);
+            }
+        }
+
+        // 转换为 RGBA8：逐通道量化一行（向量化），再交错写出
+        const int32_t width = tileX1 - tileX0;
+        std::array<int32_t, TILE_SIZE> quantized;
+        Eigen::Map<Eigen::Array<int32_t, Eigen::Dynamic, 1>> quantizedRow(quantized.data(), width);
+        for (int32_t y = tileY0; y < tileY1; ++y)
+        {
+            const size_t row = (static_cast<size_t>(y) * m_width) + tileX0;
+            uint8_t* out = m_pixels.data() + (row * 4);
+            for (int channel = 0; channel < 4; ++channel)
+            {
+                const Eigen::Map<const Eigen::ArrayXf> values(m_planes[channel].data() + row, width);
+                quantizedRow = ((values.max(0.0F).min(1.0F) * 255.0F) + 0.5F).cast<int32_t>();
+                for (int32_t x = 0; x < width; ++x)
+                {
+                    out[(x * 4) + channel] = static_cast<uint8_t>(quantized[x]);
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief frag.hlsl 的 sdRoundedBox；同时返回 fwidth(dist) 的解析值（圆角区域为 |n.x| + |n.y|，其余为 1）
+     * @param dx 像素相对矩形中心的 X 坐标；dy 为 Y 坐标（整行相同）
+     * @param radiusLeft / radiusRight 本行左半部分与右半部分使用的圆角
+     */
+    static Span roundedBoxDistance(const Span& dx,
+                                   float dy,
+                                   float halfWidth,
+                                   float halfHeight,
+                                   float radiusLeft,
+                                   float radiusRight,
+                                   Span& edge)
+    {
+        const Span radius = (dx > 0.0F).select(Span::Constant(radiusRight), Span::Constant(radiusLeft));
+        const Span qx = dx.abs() - halfWidth + radius;
+        const Span qy = (std::abs(dy) - halfHeight) + radius;
+        const Span outsideX = qx.max(0.0F);
+        const Span outsideY = qy.max(0.0F);
+        const Span length = (outsideX.square() + outsideY.square()).sqrt();
+        edge = (outsideX > 0.0F && outsideY > 0.0F).select((outsideX + outsideY) / length.max(1e-6F), 1.0F);
+        return qx.max(qy).min(0.0F) + length - radius;
+    }
+
+    static Span smoothstep(float edge0, float edge1, const Span& value)
+    {
+        const Span t = ((value - edge0) / (edge1 - edge0)).max(0.0F).min(1.0F);
+        return t.square() * (3.0F - (2.0F * t));
+    }
+
+    static Span smoothstep(const Span& edge0, const Span& edge1, const Span& value)
+    {
+        const Span t = ((value - edge0) / (edge1 - edge0)).max(0.0F).min(1.0F);
+        return t.square() * (3.0F - (2.0F * t));
+    }
+
+    /**
+     * @brief 一个实例在某一行上不变的量
+     */
+    struct RowSetup
+    {
+        const Quad* quad;
+        float halfWidth, halfHeight, centerX;
+        float dy, radiusLeft, radiusRight;             // 主体 SDF
+        float shadowDy, shadowLeft, shadowRight;       // 阴影 SDF
+        float v;                                       // 整行相同的纹理坐标
+        size_t offset;                                 // 行首在颜色平面中的下标
+    };
+
+    /**
+     * @brief 对一行 [x0, x1) 着色并混合
+     *
+     * 像素中心满足 |dx| <= halfWidth - max(1, r) 且 |dy| <= halfHeight - 1 时 dist <= -1 = -fwidth，
+     * 主体遮罩恰为 1、阴影恰为 0，这段内部区域跳过 SDF 计算；只有两端的边缘部分逐像素求 SDF
+     */
+    void shadeRow(const Quad& quad, int32_t x0, int32_t x1, int32_t y)
+    {
+        RowSetup row{};
+        row.quad = &quad;
+        row.halfWidth = quad.rect[2] * 0.5F;
+        row.halfHeight = quad.rect[3] * 0.5F;
+        row.centerX = quad.rect[0] + row.halfWidth;
+        row.dy = (static_cast<float>(y) + 0.5F) - (quad.rect[1] + row.halfHeight);
+
+        // radius 布局 (左上, 右上, 右下, 左下)；屏幕坐标 Y 轴向下，dy > 0 为下半部分
+        row.radiusLeft = row.dy > 0.0F ? quad.radius[3] : quad.radius[0];
+        row.radiusRight = row.dy > 0.0F ? quad.radius[2] : quad.radius[1];
+        row.shadowDy = row.dy - quad.shadow[2];
+        row.shadowLeft = row.shadowDy > 0.0F ? quad.radius[3] : quad.radius[0];
+        row.shadowRight = row.shadowDy > 0.0F ? quad.radius[2] : quad.radius[1];
+
+        // 纹理坐标：单位矩形坐标映射到 UV 矩形
+        const float localY = (static_cast<float>(y) + 0.5F - quad.rect[1]) / quad.rect[3];
+        row.v = quad.uv[1] + ((quad.uv[3] - quad.uv[1]) * localY);
+        row.offset = static_cast<size_t>(y) * m_width;
+
+        int32_t innerX0 = x1;
+        int32_t innerX1 = x1;
+        if (std::abs(row.dy) <= row.halfHeight - 1.0F)
+        {
+            const float left = row.centerX - row.halfWidth + std::max(1.0F, row.radiusLeft) - 0.5F;
+            const float right = row.centerX + row.halfWidth - std::max(1.0F, row.radiusRight) - 0.5F;
+            innerX0 = std::clamp(static_cast<int32_t>(std::ceil(left)), x0, x1);
+            innerX1 = std::clamp(static_cast<int32_t>(std::floor(right)) + 1, innerX0, x1);
+        }
+
+        for (int32_t x = x0; x < innerX0; x += SPAN)
+        {
+            shadeEdgeSpan(row, x, std::min(SPAN, innerX0 - x));
+        }
+        for (int32_t x = innerX0; x < innerX1; x += SPAN)
+        {
+            shadeInteriorSpan(row, x, std::min(SPAN, innerX1 - x));
+        }
+        for (int32_t x = innerX1; x < x1; x += SPAN)
+        {
+            shadeEdgeSpan(row, x, std::min(SPAN, x1 - x));
+        }
+    }
+
+    /**
+     * @brief 完整的 frag.hlsl：主体 SDF、阴影与纹理
+     */
+    void shadeEdgeSpan(const RowSetup& row, int32_t x, int32_t count)
+    {
+        const Quad& quad = *row.quad;
+        const Span pixelX = lanes() + (static_cast<float>(x) + 0.5F);
+        const Span dx = pixelX - row.centerX;
+
+        // 主体 SDF
+        Span edge;
+        const Span dist =
+            roundedBoxDistance(dx, row.dy, row.halfWidth, row.halfHeight, row.radiusLeft, row.radiusRight, edge);
+        const Span bodyMask = 1.0F - smoothstep(-edge, edge, dist);
+
+        // 阴影 SDF（只影响主体外部）
+        Span shadowAlpha = Span::Zero();
+        if (quad.shadow[0] > 0.0F)
+        {
+            Span shadowEdge;
+            const Span shadowDist = roundedBoxDistance(dx - quad.shadow[1],
+                                                       row.shadowDy,
+                                                       row.halfWidth,
+                                                       row.halfHeight,
+                                                       row.shadowLeft,
+                                                       row.shadowRight,
+                                                       shadowEdge);
+            shadowAlpha = (1.0F - smoothstep(-quad.shadow[0], quad.shadow[0], shadowDist)) * (1.0F - bodyMask) * 0.5F;
+        }
+
+        // 主体颜色（预乘 Alpha）
+        std::array<Span, 4> color;
+        sampleColor(row, pixelX, color);
+        const Span bodyAlpha = color[3] * bodyMask;
+        const Span bodyScale = (quad.premultiplied ? bodyMask : bodyAlpha) * quad.opacity;
+        for (int channel = 0; channel < 3; ++channel)
+        {
+            color[channel] *= bodyScale;
+        }
+        color[3] = (bodyAlpha + shadowAlpha) * quad.opacity;
+        blend(row.offset + x, count, color);
+    }
+
+    /**
+     * @brief 内部区域：遮罩为 1、没有阴影，只采样纹理
+     */
+    void shadeInteriorSpan(const RowSetup& row, int32_t x, int32_t count)
+    {
+        const Quad& quad = *row.quad;
+        std::array<Span, 4> color;
+        sampleColor(row, lanes() + (static_cast<float>(x) + 0.5F), color);
+        const Span bodyScale = (quad.premultiplied ? Span::Ones() : color[3]) * quad.opacity;
+        for (int channel = 0; channel < 3; ++channel)
+        {
+            color[channel] *= bodyScale;
+        }
+        color[3] *= quad.opacity;
+        blend(row.offset + x, count, color);
+    }
+
+    /**
+     * @brief 纹理颜色乘实例颜色
+     */
+    static void sampleColor(const RowSetup& row, const Span& pixelX, std::array<Span, 4>& color)
+    {
+        const Quad& quad = *row.quad;
+        const Span localX = (pixelX - quad.rect[0]) / quad.rect[2];
+        sample(quad.texture, quad.uv[0] + ((quad.uv[2] - quad.uv[0]) * localX), row.v, color);
+        for (int channel = 0; channel < 4; ++channel)
+        {
+            color[channel] *= quad.color[channel];
+        }
+    }
+
+    /**
+     * @brief (ONE, ONE_MINUS_SRC_ALPHA) 混合前 count 个像素；与着色器一样丢弃 alpha < 0.001 的像素
+     * @param source 预乘颜色
+     */
+    void blend(size_t offset, int32_t count, std::array<Span, 4>& source)
+    {
+        const Span keep = (source[3] >= 0.001F).select(Span::Ones(), Span::Zero());
+        for (auto& channel : source)
+        {
+            channel *= keep;
+        }
+        const Span inverseAlpha = 1.0F - source[3];
+        for (int channel = 0; channel < 4; ++channel)
+        {
+            float* target = m_planes[channel].data() + offset;
+            if (count == SPAN)
+            {
+                Eigen::Map<Span> mapped(target);
+                mapped = source[channel] + (mapped * inverseAlpha);
+            }
+            else
+            {
+                Span destination = Span::Zero();
+                std::copy_n(target, count, destination.data());
+                destination = source[channel] + (destination * inverseAlpha);
+                std::copy_n(destination.data(), count, target);
+            }
+        }
+    }
+
+    static const Span& lanes()
+    {
+        static const Span value = Span::LinSpaced(0.0F, static_cast<float>(SPAN - 1));
+        return value;
+    }
+
+    /**
+     * @brief 双线性采样（边缘截断），texture 为空时返回白色
+     */
+    static void sample(const Texture* texture, const Span& u, float v, std::array<Span, 4>& out)
+    {
+        if (texture == nullptr || texture->texels.empty())
+        {
+            out.fill(Span::Ones());
+            return;
+        }
+
+        const float texelY = (v * static_cast<float>(texture->height)) - 0.5F;
+        const float floorY = std::floor(texelY);
+        const float weightY = texelY - floorY;
+        const int32_t row0 = std::clamp(static_cast<int32_t>(floorY), 0, texture->height - 1);
+        const int32_t row1 = std::clamp(static_cast<int32_t>(floorY) + 1, 0, texture->height - 1);
+        const uint8_t* top = texture->texels.data() + (static_cast<size_t>(row0) * texture->width * 4);
+        const uint8_t* bottom = texture->texels.data() + (static_cast<size_t>(row1) * texture->width * 4);
+
+        const Span texelX = (u * static_cast<float>(texture->width)) - 0.5F;
+        const Span floorX = texelX.floor();
+        const Span weightX = texelX - floorX;
+        for (int lane = 0; lane < SPAN; ++lane)
+        {
+            const auto column = static_cast<int32_t>(floorX[lane]);
+            const size_t left = static_cast<size_t>(std::clamp(column, 0, texture->width - 1)) * 4;
+            const size_t right = static_cast<size_t>(std::clamp(column + 1, 0, texture->width - 1)) * 4;
+            for (int channel = 0; channel < 4; ++channel)
+            {
+                const float upper = std::lerp(static_cast<float>(top[left + channel]),
+                                              static_cast<float>(top[right + channel]),
+                                              weightX[lane]);
+                const float lower = std::lerp(static_cast<float>(bottom[left + channel]),
+                                              static_cast<float>(bottom[right + channel]),
+                                              weightX[lane]);
+                out[channel][lane] = std::lerp(upper, lower, weightY) / 255.0F;
+            }
+        }
+    }
+
+    utils::TaskScheduler* m_scheduler;
+    int32_t m_width = 0;
+    int32_t m_height = 0;
+    int32_t m_tilesX = 0;
+    int32_t m_tilesY = 0;
+    std::array<float, 4> m_clearColor = {0.15F, 0.15F, 0.15F, 1.0F};
+    std::array<std::vector<float>, 4> m_planes; // 预乘颜色，按通道分平面存放
+    std::vector<uint8_t> m_pixels;              // RGBA8 结果
+    std::vector<Quad> m_quads;                  // 按绘制顺序解码的实例
+    std::vector<std::vector<uint32_t>> m_bins;  // 每个图块覆盖它的实例下标（绘制顺序）
+    std::unordered_map<SDL_GPUTexture*, Texture> m_textures;
+};
+
+} // namespace ui::managers
@@ -4,18 +4,22 @@
  * @file TextRenderHelper.hpp
  * @author AnakinLiu (azrael2759@qq.com)
  * @date 2026-02-10
- * @version 0.1
+ * @version 0.2
  * @brief 文本渲染辅助类（基于纹理图集）
  *
  * 提供基于纹理图集的文本渲染功能：
  * - 从 FontAtlasManager 获取字形
- * - 生成文本渲染所需的顶点数据（位置 + UV）
- * - 支持逐字符拼接，无需为每个字符串生成独立纹理
+ * - 每个字形生成一个四边形写入 BatchManager，颜色为实例属性
+ * - 所有文本共用图集纹理，同一裁剪区域内的文本合并为一个批次，不再为每个字符串生成独立纹理
+ *
+ * 排版与 FontManager::renderTextBitmap 一致：字形 x = floor(游标) + bearingX，y = 基线 - bearingY，
+ * 行盒高度为字号对应的行高。
  *
  * 使用示例：
  *   TextRenderHelper helper(fontAtlasManager);
- *   auto renderData = helper.prepareTextRender("Hello", x, y, color);
- *   // 使用 renderData.vertices 和 atlasTexture 进行批量渲染
+ *   float width = helper.measureLine("Hello", fontSize);
+ *   helper.addLine(batchManager, "Hello", topLeft, color, opacity, fontSize, scissor);
+ *   helper.addGlyphs(batchManager, utils::LineGlyphs(layout, line), topLeft, color, opacity, fontSize, scissor);
  *
  * ************************************************************************
  * @copyright Copyright (c) 2026 AnakinLiu
@@ -26,38 +30,16 @@
 #pragma once
 
 #include "FontAtlasManager.hpp"
+#include "BatchManager.hpp"
 #include <Eigen/Dense>
-#include <vector>
-#include <string>
+#include <cmath>
+#include <optional>
+#include <ranges>
+#include <string_view>
 
 namespace ui::managers
 {
 
-/**
- * @brief 文本渲染顶点（位置 + UV + 颜色）
- */
-struct TextVertex
-{
-    float x = 0.0F;
-    float y = 0.0F;
-    float u = 0.0F;
-    float v = 0.0F;
-    float r = 1.0F;
-    float g = 1.0F;
-    float b = 1.0F;
-    float a = 1.0F;
-};
-
-/**
- * @brief 文本渲染数据
- */
-struct TextRenderData
-{
-    std::vector<TextVertex> vertices; // 顶点数据（6个顶点/字符，两个三角形）
-    int width = 0;                    // 文本总宽度
-    int height = 0;                   // 文本总高度
-};
-
 /**
  * @brief 文本渲染辅助类
  */
@@ -67,88 +49,128 @@ public:
     explicit TextRenderHelper(FontAtlasManager& fontAtlasManager) : m_fontAtlasManager(fontAtlasManager) {}
 
     /**
-     * @brief 准备文本渲染数据
-     * @param text UTF-8 文本
-     * @param x 起始 X 坐标
-     * @param y 起始 Y 坐标（基线）
-     * @param color RGBA 颜色
-     * @return 文本渲染数据
+     * @brief 测量单行文本宽度（与 addLine 的排版一致）
      */
-    TextRenderData prepareTextRender(const std::string& text, float x, float y, const Eigen::Vector4f& color)
+    float measureLine(std::string_view text, float fontSize)
     {
-        TextRenderData data;
+        float cursorX = 0.0F;
+        forEachGlyph(text, fontSize, [&cursorX](const AtlasGlyph& glyph) { cursorX += glyph.advanceX; });
+        return std::ceil(cursorX);
+    }
 
-        if (!m_fontAtlasManager.isLoaded() || text.empty())
+    /**
+     * @brief 行高（像素）
+     */
+    float lineHeight(float fontSize)
+    {
+        return static_cast<float>(m_fontAtlasManager.getSizeMetrics(fontSize).height);
+    }
+
+    /**
+     * @brief 把单行文本的字形四边形写入批次
+     * @param origin 行盒左上角（应已对齐到整数像素）
+     * @param color 文本颜色（直通 Alpha）
+     * @param opacity UI 树累积透明度
+     */
+    void addLine(BatchManager& batchManager,
+                 std::string_view text,
+                 const Eigen::Vector2f& origin,
+                 const Eigen::Vector4f& color,
+                 float opacity,
+                 float fontSize,
+                 const std::optional<SDL_Rect>& scissor)
+    {
+        SDL_GPUTexture* atlasTexture = m_fontAtlasManager.getAtlasTexture();
+        if (atlasTexture == nullptr || text.empty()) return;
+
+        const auto baseline = static_cast<float>(m_fontAtlasManager.getSizeMetrics(fontSize).baseline);
+
+        render::ShapeParams shape{};
+        shape.opacity = opacity;
+
+        batchManager.beginBatch(atlasTexture, scissor);
+
+        float cursorX = 0.0F;
+        forEachGlyph(text,
+                     fontSize,
+                     [&](const AtlasGlyph& glyph)
+                     {
+                         if (glyph.width > 0 && glyph.height > 0)
+                         {
+                             const float glyphX = origin.x() + std::floor(cursorX) + static_cast<float>(glyph.bearingX);
+                             const float glyphY = origin.y() + baseline - static_cast<float>(glyph.bearingY);
+                             batchManager.addRect({glyphX, glyphY},
+                                                  {static_cast<float>(glyph.width), static_cast<float>(glyph.height)},
+                                                  color,
+                                                  shape,
+                                                  {glyph.u0, glyph.v0},
+                                                  {glyph.u1, glyph.v1});
+                         }
+                         cursorX += glyph.advanceX;
+                     });
+    }
+
+    /**
+     * @brief 把已排版的字形写入批次（字形位置来自排版缓存，不再解码与测量文本）
+     * @param glyphs 元素需提供 codepoint 与相对行首的笔位置 x，如 components::TextLayoutGlyph；码点 0 跳过
+     * @param origin 行盒左上角（应已对齐到整数像素）
+     */
+    template <typename GlyphRange>
+    void addGlyphs(BatchManager& batchManager,
+                   const GlyphRange& glyphs,
+                   const Eigen::Vector2f& origin,
+                   const Eigen::Vector4f& color,
+                   float opacity,
+                   float fontSize,
+                   const std::optional<SDL_Rect>& scissor)
+    {
+        SDL_GPUTexture* atlasTexture = m_fontAtlasManager.getAtlasTexture();
+        if (atlasTexture == nullptr || std::ranges::empty(glyphs)) return;
+
+        const auto baseline = static_cast<float>(m_fontAtlasManager.getSizeMetrics(fontSize).baseline);
+
+        render::ShapeParams shape{};
+        shape.opacity = opacity;
+
+        batchManager.beginBatch(atlasTexture, scissor);
+        for (const auto& placed : glyphs)
         {
-            return data;
+            if (placed.codepoint == 0) continue;
+
+            const AtlasGlyph* glyph = m_fontAtlasManager.getOrAddGlyph(placed.codepoint, fontSize);
+            if (glyph == nullptr || glyph->width <= 0 || glyph->height <= 0) continue;
+
+            const float glyphX = origin.x() + std::floor(placed.x) + static_cast<float>(glyph->bearingX);
+            const float glyphY = origin.y() + baseline - static_cast<float>(glyph->bearingY);
+            batchManager.addRect({glyphX, glyphY},
+                                 {static_cast<float>(glyph->width), static_cast<float>(glyph->height)},
+                                 color,
+                                 shape,
+                                 {glyph->u0, glyph->v0},
+                                 {glyph->u1, glyph->v1});
         }
+    }
 
-        float cursorX = x;
-        float cursorY = y;
-        int maxHeight = m_fontAtlasManager.getFontHeight();
-
+private:
+    template <typename Func>
+    void forEachGlyph(std::string_view text, float fontSize, Func&& func)
+    {
         size_t bytePos = 0;
-        std::string_view view(text);
-
         while (bytePos < text.size())
         {
             int codepoint = 0;
-            size_t charLen = FontAtlasManager::decodeUTF8(view.substr(bytePos), codepoint);
+            size_t charLen = FontAtlasManager::decodeUTF8(text.substr(bytePos), codepoint);
             if (charLen == 0) break;
 
             // 获取字形（自动添加到图集）
-            auto glyphOpt = m_fontAtlasManager.getOrAddGlyph(static_cast<uint32_t>(codepoint));
-            if (!glyphOpt.has_value())
-            {
-                bytePos += charLen;
-                continue;
-            }
-
-            const AtlasGlyph& glyph = *glyphOpt;
-
-            // 计算字形渲染位置
-            float glyphX = cursorX + static_cast<float>(glyph.bearingX);
-            float glyphY = cursorY - static_cast<float>(glyph.bearingY);
-            float glyphW = static_cast<float>(glyph.width);
-            float glyphH = static_cast<float>(glyph.height);
-
-            // 生成两个三角形（6个顶点）
-            if (glyphW > 0.0F && glyphH > 0.0F)
+            if (const auto* glyph = m_fontAtlasManager.getOrAddGlyph(static_cast<uint32_t>(codepoint), fontSize))
             {
-                // 三角形 1: 左上, 左下, 右下
-                data.vertices.push_back(
-                    {glyphX, glyphY, glyph.u0, glyph.v0, color.x(), color.y(), color.z(), color.w()});
-                data.vertices.push_back(
-                    {glyphX, glyphY + glyphH, glyph.u0, glyph.v1, color.x(), color.y(), color.z(), color.w()});
-                data.vertices.push_back(
-                    {glyphX + glyphW, glyphY + glyphH, glyph.u1, glyph.v1, color.x(), color.y(), color.z(), color.w()});
-
-                // 三角形 2: 左上, 右下, 右上
-                data.vertices.push_back(
-                    {glyphX, glyphY, glyph.u0, glyph.v0, color.x(), color.y(), color.z(), color.w()});
-                data.vertices.push_back(
-                    {glyphX + glyphW, glyphY + glyphH, glyph.u1, glyph.v1, color.x(), color.y(), color.z(), color.w()});
-                data.vertices.push_back(
-                    {glyphX + glyphW, glyphY, glyph.u1, glyph.v0, color.x(), color.y(), color.z(), color.w()});
+                func(*glyph);
             }
-
-            // 前进游标
-            cursorX += glyph.advanceX;
             bytePos += charLen;
         }
-
-        data.width = static_cast<int>(cursorX - x);
-        data.height = maxHeight;
-
-        return data;
     }
 
-    /**
-     * @brief 测量文本宽度
-     */
-    int measureTextWidth(const std::string& text) { return m_fontAtlasManager.measureTextWidth(text); }
-
-private:
     FontAtlasManager& m_fontAtlasManager;
 };
 
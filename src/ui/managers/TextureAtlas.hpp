@@ -4,14 +4,18 @@
  * @file TextureAtlas.hpp
  * @author AnakinLiu (azrael2759@qq.com)
  * @date 2026-02-10
- * @version 0.1
+ * @version 0.2
  * @brief GPU 纹理图集管理器，用于字形缓存
  *
  * 采用 Shelf Bin Packing 算法管理纹理图集：
  * - 每次分配从当前 shelf（行）尝试，不够则开新行
- * - 支持自动扩展图集尺寸（2048x2048 -> 4096x4096）
+ * - 支持自动扩展图集尺寸（1024 -> 2048 -> 4096），已有字形的像素位置不变
  * - 每个字形记录其 UV 坐标和偏移量
  *
+ * 纹理为 RGBA8，像素为白色 + 覆盖率 Alpha（直通 Alpha），颜色由实例提供，
+ * 同一图集可以绘制任意颜色的文本。CPU 端保留一份覆盖率副本，新字形先写入副本，
+ * 每帧绘制前由 uploadPending() 在一次 CopyPass 中上传；扩展后整张重新上传。
+ *
  * ************************************************************************
  * @copyright Copyright (c) 2026 AnakinLiu
  * For study and research only, no reprinting.
@@ -22,6 +26,7 @@
 
 #include <SDL3/SDL_gpu.h>
 #include <cstdint>
+#include <cstring>
 #include <optional>
 #include <unordered_map>
 #include <vector>
@@ -29,16 +34,13 @@
 #include "../common/GPUWrappers.hpp"
 #include "../singleton/Logger.hpp"
 
-namespace ui::wrappers
-{
-using GPUTexturePtr = UniqueGPUTexture;
-}
-
 namespace ui::managers
 {
 
 /**
  * @brief 字形在图集中的位置信息
+ *
+ * 区域包含位图四周各 1 像素的透明边，按该区域绘制四边形时，SDF 边缘抗锯齿只会落在透明像素上
  */
 struct AtlasGlyph
 {
@@ -48,15 +50,15 @@ struct AtlasGlyph
     float u1 = 0.0F;
     float v1 = 0.0F;
 
-    // 像素坐标（在图集中的位置）
+    // 像素坐标（在图集中的位置，含透明边）
     int32_t x = 0;
     int32_t y = 0;
-    int32_t width = 0;
+    int32_t width = 0; // 为 0 表示没有位图（如空格），只有前进量
     int32_t height = 0;
 
-    // 渲染偏移量
+    // 渲染偏移量（相对含透明边的区域）
     int32_t bearingX = 0;  // 水平偏移
-    int32_t bearingY = 0;  // 垂直偏移（基线到字形顶部）
+    int32_t bearingY = 0;  // 垂直偏移（基线到区域顶部）
     float advanceX = 0.0F; // 水平前进量
 };
 
@@ -66,28 +68,26 @@ struct AtlasGlyph
 class TextureAtlas
 {
 public:
+    static constexpr uint32_t MAX_SIZE = 4096;
+    static constexpr int32_t GLYPH_BORDER = 1; // 位图四周的透明边（像素）
+
     /**
      * @brief 构造纹理图集
      * @param device GPU 设备
      * @param initialSize 初始尺寸（宽高相同）
      * @param padding 字形之间的内边距（像素）
      */
-    explicit TextureAtlas(SDL_GPUDevice* device, uint32_t initialSize = 2048, uint32_t padding = 2)
+    explicit TextureAtlas(SDL_GPUDevice* device, uint32_t initialSize = 1024, uint32_t padding = 1)
         : m_device(device), m_size(initialSize), m_padding(padding)
     {
+        m_coverage.assign(static_cast<size_t>(m_size) * m_size, 0);
         if (!createTexture())
         {
             Logger::error("[TextureAtlas] Failed to create initial texture");
         }
     }
 
-    ~TextureAtlas()
-    {
-        if (m_texture)
-        {
-            SDL_ReleaseGPUTexture(m_device, m_texture.get());
-        }
-    }
+    ~TextureAtlas() = default;
 
     // 禁止拷贝和移动
     TextureAtlas(const TextureAtlas&) = delete;
@@ -105,92 +105,202 @@ public:
      */
     [[nodiscard]] uint32_t getSize() const { return m_size; }
 
+    /**
+     * @brief 图集扩展次数；扩展后所有字形的 UV 都会改变，之前生成的顶点需要重新生成
+     */
+    [[nodiscard]] uint32_t getGeneration() const { return m_generation; }
+
     /**
      * @brief 添加字形到图集
-     * @param codepoint Unicode 码点（作为 key）
-     * @param bitmap 字形位图数据（灰度，单通道）
+     * @param key 字形键（由调用方组合码点与字号）
+     * @param bitmap 字形位图数据（灰度，单通道），可为空
      * @param width 位图宽度
      * @param height 位图高度
      * @param bearingX 水平偏移
      * @param bearingY 垂直偏移
      * @param advanceX 水平前进量
-     * @return 字形信息，失败返回 nullopt
+     * @return 字形信息，失败返回 nullptr；指针在 clear 之前有效
      */
-    std::optional<AtlasGlyph> addGlyph(uint32_t codepoint,
-                                       const uint8_t* bitmap,
-                                       int32_t width,
-                                       int32_t height,
-                                       int32_t bearingX,
-                                       int32_t bearingY,
-                                       float advanceX)
+    const AtlasGlyph* addGlyph(uint64_t key,
+                               const uint8_t* bitmap,
+                               int32_t width,
+                               int32_t height,
+                               int32_t bearingX,
+                               int32_t bearingY,
+                               float advanceX)
     {
         // 检查是否已缓存
-        auto iter = m_glyphMap.find(codepoint);
+        auto iter = m_glyphMap.find(key);
         if (iter != m_glyphMap.end())
         {
-            return iter->second;
+            return &iter->second;
         }
 
-        // 尝试分配空间
-        auto pos = allocate(width, height);
-        if (!pos.has_value())
+        AtlasGlyph glyph;
+        glyph.advanceX = advanceX;
+
+        if (bitmap != nullptr && width > 0 && height > 0)
         {
-            // 尝试扩展图集
-            if (!expand())
+            const int32_t regionWidth = width + (GLYPH_BORDER * 2);
+            const int32_t regionHeight = height + (GLYPH_BORDER * 2);
+
+            // 尝试分配空间，不够时扩展图集
+            auto pos = allocate(regionWidth, regionHeight);
+            while (!pos.has_value())
+            {
+                if (!expand())
+                {
+                    Logger::error("[TextureAtlas] Atlas is full, dropping glyph {:#x}", key);
+                    return nullptr;
+                }
+                pos = allocate(regionWidth, regionHeight);
+            }
+
+            auto [xPos, yPos] = *pos;
+            glyph.x = static_cast<int32_t>(xPos);
+            glyph.y = static_cast<int32_t>(yPos);
+            glyph.width = regionWidth;
+            glyph.height = regionHeight;
+            glyph.bearingX = bearingX - GLYPH_BORDER;
+            glyph.bearingY = bearingY + GLYPH_BORDER;
+            updateUV(glyph);
+
+            // 写入 CPU 副本（透明边保持为 0），等待 uploadPending
+            for (int32_t row = 0; row < height; ++row)
             {
-                Logger::error("[TextureAtlas] Failed to expand atlas for codepoint {}", codepoint);
-                return std::nullopt;
+                const size_t dst = (static_cast<size_t>(yPos + GLYPH_BORDER + row) * m_size) + xPos + GLYPH_BORDER;
+                std::memcpy(m_coverage.data() + dst,
+                            bitmap + (static_cast<size_t>(row) * static_cast<size_t>(width)),
+                            static_cast<size_t>(width));
             }
-            pos = allocate(width, height);
-            if (!pos.has_value())
+            if (!m_fullUploadPending)
             {
-                Logger::error("[TextureAtlas] Still cannot allocate after expansion");
-                return std::nullopt;
+                m_pendingRegions.push_back(Region{xPos, yPos, static_cast<uint32_t>(regionWidth),
+                                                  static_cast<uint32_t>(regionHeight)});
             }
         }
 
-        auto [xPos, yPos] = *pos;
+        return &m_glyphMap.emplace(key, glyph).first->second;
+    }
+
+    /**
+     * @brief 查询字形是否已缓存
+     */
+    [[nodiscard]] const AtlasGlyph* findGlyph(uint64_t key) const
+    {
+        auto iter = m_glyphMap.find(key);
+        return iter != m_glyphMap.end() ? &iter->second : nullptr;
+    }
+
+    /**
+     * @brief 是否有尚未上传的字形
+     */
+    [[nodiscard]] bool hasPendingUploads() const { return m_fullUploadPending || !m_pendingRegions.empty(); }
 
-        // 上传位图到 GPU
-        if (!uploadBitmap(bitmap, xPos, yPos, width, height))
+    /**
+     * @brief 把新增字形上传到 GPU（一次 CopyPass），在提交本帧绘制之前调用
+     */
+    bool uploadPending()
+    {
+        if (!hasPendingUploads() || m_texture == nullptr)
         {
-            Logger::error("[TextureAtlas] Failed to upload bitmap for codepoint {}", codepoint);
-            return std::nullopt;
+            return true;
         }
 
-        // 构造字形信息
-        AtlasGlyph glyph;
-        glyph.x = static_cast<int32_t>(xPos);
-        glyph.y = static_cast<int32_t>(yPos);
-        glyph.width = width;
-        glyph.height = height;
-        glyph.bearingX = bearingX;
-        glyph.bearingY = bearingY;
-        glyph.advanceX = advanceX;
+        if (m_fullUploadPending)
+        {
+            // 扩展后整张上传已用的行
+            m_pendingRegions.clear();
+            if (m_currentShelfY > 0)
+            {
+                m_pendingRegions.push_back(Region{0, 0, m_size, m_currentShelfY});
+            }
+        }
 
-        // 计算 UV 坐标（归一化）
-        auto fSize = static_cast<float>(m_size);
-        glyph.u0 = static_cast<float>(xPos) / fSize;
-        glyph.v0 = static_cast<float>(yPos) / fSize;
-        glyph.u1 = static_cast<float>(xPos + static_cast<uint32_t>(width)) / fSize;
-        glyph.v1 = static_cast<float>(yPos + static_cast<uint32_t>(height)) / fSize;
+        size_t totalBytes = 0;
+        for (const auto& region : m_pendingRegions)
+        {
+            totalBytes += static_cast<size_t>(region.width) * region.height * 4;
+        }
+        if (totalBytes == 0)
+        {
+            m_pendingRegions.clear();
+            m_fullUploadPending = false;
+            return true;
+        }
 
-        // 缓存
-        m_glyphMap[codepoint] = glyph;
-        return glyph;
-    }
+        SDL_GPUTransferBufferCreateInfo transferInfo = {};
+        transferInfo.usage = SDL_GPU_TRANSFERBUFFERUSAGE_UPLOAD;
+        transferInfo.size = static_cast<uint32_t>(totalBytes);
+        auto transferBuffer = wrappers::MakeGpuResource<wrappers::UniqueGPUTransferBuffer>(
+            m_device, SDL_CreateGPUTransferBuffer, &transferInfo);
+        if (!transferBuffer)
+        {
+            Logger::error("[TextureAtlas] Failed to create transfer buffer: {}", SDL_GetError());
+            return false;
+        }
 
-    /**
-     * @brief 查询字形是否已缓存
-     */
-    [[nodiscard]] std::optional<AtlasGlyph> getGlyph(uint32_t codepoint) const
-    {
-        auto iter = m_glyphMap.find(codepoint);
-        if (iter != m_glyphMap.end())
+        auto* mapped = static_cast<uint8_t*>(SDL_MapGPUTransferBuffer(m_device, transferBuffer.get(), false));
+        if (mapped == nullptr)
         {
-            return iter->second;
+            Logger::error("[TextureAtlas] Failed to map transfer buffer: {}", SDL_GetError());
+            return false;
         }
-        return std::nullopt;
+
+        // 覆盖率展开为白色 + Alpha
+        uint8_t* out = mapped;
+        for (const auto& region : m_pendingRegions)
+        {
+            for (uint32_t row = 0; row < region.height; ++row)
+            {
+                const uint8_t* src = m_coverage.data() + (static_cast<size_t>(region.y + row) * m_size) + region.x;
+                for (uint32_t col = 0; col < region.width; ++col)
+                {
+                    out[0] = 0xFF;
+                    out[1] = 0xFF;
+                    out[2] = 0xFF;
+                    out[3] = src[col];
+                    out += 4;
+                }
+            }
+        }
+        SDL_UnmapGPUTransferBuffer(m_device, transferBuffer.get());
+
+        SDL_GPUCommandBuffer* cmd = SDL_AcquireGPUCommandBuffer(m_device);
+        if (cmd == nullptr)
+        {
+            Logger::error("[TextureAtlas] Failed to acquire command buffer: {}", SDL_GetError());
+            return false;
+        }
+        SDL_GPUCopyPass* copyPass = SDL_BeginGPUCopyPass(cmd);
+
+        uint32_t offset = 0;
+        for (const auto& region : m_pendingRegions)
+        {
+            SDL_GPUTextureTransferInfo srcInfo = {};
+            srcInfo.transfer_buffer = transferBuffer.get();
+            srcInfo.offset = offset;
+            srcInfo.pixels_per_row = region.width;
+            srcInfo.rows_per_layer = region.height;
+
+            SDL_GPUTextureRegion dstRegion = {};
+            dstRegion.texture = m_texture.get();
+            dstRegion.x = region.x;
+            dstRegion.y = region.y;
+            dstRegion.w = region.width;
+            dstRegion.h = region.height;
+            dstRegion.d = 1;
+
+            SDL_UploadToGPUTexture(copyPass, &srcInfo, &dstRegion, false);
+            offset += region.width * region.height * 4;
+        }
+
+        SDL_EndGPUCopyPass(copyPass);
+        SDL_SubmitGPUCommandBuffer(cmd);
+
+        m_pendingRegions.clear();
+        m_fullUploadPending = false;
+        return true;
     }
 
     /**
@@ -200,7 +310,11 @@ public:
     {
         m_glyphMap.clear();
         m_shelves.clear();
+        m_pendingRegions.clear();
         m_currentShelfY = 0;
+        std::fill(m_coverage.begin(), m_coverage.end(), uint8_t{0});
+        m_fullUploadPending = false;
+        ++m_generation;
         Logger::info("[TextureAtlas] Cleared all glyphs");
     }
 
@@ -224,7 +338,7 @@ public:
         stats.shelfCount = static_cast<uint32_t>(m_shelves.size());
 
         uint32_t usedPixels = 0;
-        for (const auto& [codepoint, glyph] : m_glyphMap)
+        for (const auto& [key, glyph] : m_glyphMap)
         {
             usedPixels += static_cast<uint32_t>(glyph.width * glyph.height);
         }
@@ -247,6 +361,17 @@ private:
         uint32_t x = 0;      // 当前行的 X 游标
     };
 
+    /**
+     * @brief 待上传的像素区域
+     */
+    struct Region
+    {
+        uint32_t x = 0;
+        uint32_t y = 0;
+        uint32_t width = 0;
+        uint32_t height = 0;
+    };
+
     /**
      * @brief 创建 GPU 纹理
      */
@@ -254,7 +379,7 @@ private:
     {
         SDL_GPUTextureCreateInfo textureInfo{};
         textureInfo.type = SDL_GPU_TEXTURETYPE_2D;
-        textureInfo.format = SDL_GPU_TEXTUREFORMAT_R8_UNORM; // 单通道灰度
+        textureInfo.format = SDL_GPU_TEXTUREFORMAT_R8G8B8A8_UNORM;
         textureInfo.width = m_size;
         textureInfo.height = m_size;
         textureInfo.layer_count_or_depth = 1;
@@ -262,14 +387,15 @@ private:
         textureInfo.sample_count = SDL_GPU_SAMPLECOUNT_1;
         textureInfo.usage = SDL_GPU_TEXTUREUSAGE_SAMPLER;
 
-        SDL_GPUTexture* texture = SDL_CreateGPUTexture(m_device, &textureInfo);
-        if (texture == nullptr)
+        auto texture =
+            wrappers::MakeGpuResource<wrappers::UniqueGPUTexture>(m_device, SDL_CreateGPUTexture, &textureInfo);
+        if (!texture)
         {
             Logger::error("[TextureAtlas] Failed to create texture: {}", SDL_GetError());
             return false;
         }
 
-        m_texture.reset(texture);
+        m_texture = std::move(texture);
         Logger::info("[TextureAtlas] Created texture atlas {}x{}", m_size, m_size);
         return true;
     }
@@ -296,7 +422,7 @@ private:
         }
 
         // 创建新 shelf
-        if (m_currentShelfY + glyphHeight <= m_size)
+        if (m_currentShelfY + glyphHeight <= m_size && glyphWidth <= m_size)
         {
             Shelf newShelf;
             newShelf.y = m_currentShelfY;
@@ -314,84 +440,73 @@ private:
 
     /**
      * @brief 扩展图集尺寸（2x）
+     *
+     * 已有 shelf 与字形的像素位置不变（每行变长，可以继续放入字形），只重新计算 UV；
+     * CPU 副本按新宽度重排，新纹理在下一次 uploadPending 时整张上传
      */
     bool expand()
     {
-        if (m_size >= 4096)
+        if (m_size >= MAX_SIZE)
         {
-            Logger::warn("[TextureAtlas] Cannot expand beyond 4096x4096");
+            Logger::warn("[TextureAtlas] Cannot expand beyond {}x{}", MAX_SIZE, MAX_SIZE);
             return false;
         }
 
-        uint32_t newSize = m_size * 2;
-        Logger::info("[TextureAtlas] Expanding atlas from {}x{} to {}x{}", m_size, m_size, newSize, newSize);
-
-        // 创建新纹理
-        SDL_GPUTextureCreateInfo textureInfo{};
-        textureInfo.type = SDL_GPU_TEXTURETYPE_2D;
-        textureInfo.format = SDL_GPU_TEXTUREFORMAT_R8_UNORM;
-        textureInfo.width = newSize;
-        textureInfo.height = newSize;
-        textureInfo.layer_count_or_depth = 1;
-        textureInfo.num_levels = 1;
-        textureInfo.sample_count = SDL_GPU_SAMPLECOUNT_1;
-        textureInfo.usage = SDL_GPU_TEXTUREUSAGE_SAMPLER;
+        const uint32_t oldSize = m_size;
+        const uint32_t newSize = m_size * 2;
+        Logger::info("[TextureAtlas] Expanding atlas from {}x{} to {}x{}", oldSize, oldSize, newSize, newSize);
 
-        SDL_GPUTexture* newTexture = SDL_CreateGPUTexture(m_device, &textureInfo);
-        if (!newTexture)
+        m_size = newSize;
+        if (!createTexture())
         {
-            Logger::error("[TextureAtlas] Failed to create expanded texture");
+            m_size = oldSize;
             return false;
         }
 
-        // TODO: 理想情况下应该复制旧纹理内容到新纹理
-        // SDL3 GPU API 需要通过 blit 或重新上传实现
-        // 这里简化实现：仅释放旧纹理，字形需要重新上传
-
-        if (m_texture)
+        std::vector<uint8_t> coverage(static_cast<size_t>(newSize) * newSize, 0);
+        for (uint32_t row = 0; row < oldSize; ++row)
         {
-            SDL_ReleaseGPUTexture(m_device, m_texture.get());
+            std::memcpy(coverage.data() + (static_cast<size_t>(row) * newSize),
+                        m_coverage.data() + (static_cast<size_t>(row) * oldSize),
+                        oldSize);
         }
+        m_coverage = std::move(coverage);
 
-        m_texture.reset(newTexture);
-        m_size = newSize;
-
-        // 重置布局状态（字形映射保留，但需重新上传）
-        // 简化处理：清空所有，让调用方重新添加
-        m_glyphMap.clear();
-        m_shelves.clear();
-        m_currentShelfY = 0;
+        for (auto& [key, glyph] : m_glyphMap)
+        {
+            updateUV(glyph);
+        }
 
-        Logger::warn("[TextureAtlas] Expansion requires re-uploading all glyphs");
+        m_pendingRegions.clear();
+        m_fullUploadPending = true;
+        ++m_generation;
         return true;
     }
 
-    /**
-     * @brief 上传位图到纹理（灰度转 R8）
-     */
-    bool uploadBitmap(const uint8_t* bitmap, uint32_t xPos, uint32_t yPos, int32_t width, int32_t height)
+    void updateUV(AtlasGlyph& glyph) const
     {
-        if (bitmap == nullptr || width <= 0 || height <= 0) return false;
-
-        // 注意：SDL3 GPU API 需要通过 CopyPass 上传纹理
-        // 这里简化实现，实际应该创建 TransferBuffer 并使用 CopyPass
-        // 由于 SDL_UploadToGPUTexture 签名在不同版本可能不同，这里提供占位实现
-        // TODO: 完整实现需要 CommandBuffer + CopyPass + TransferBuffer
-
-        Logger::warn("[TextureAtlas] uploadBitmap not fully implemented, atlas updates may not work");
-        return true;
+        const auto fSize = static_cast<float>(m_size);
+        glyph.u0 = static_cast<float>(glyph.x) / fSize;
+        glyph.v0 = static_cast<float>(glyph.y) / fSize;
+        glyph.u1 = static_cast<float>(glyph.x + glyph.width) / fSize;
+        glyph.v1 = static_cast<float>(glyph.y + glyph.height) / fSize;
     }
 
     SDL_GPUDevice* m_device = nullptr;
-    wrappers::GPUTexturePtr m_texture;
+    wrappers::UniqueGPUTexture m_texture;
 
-    uint32_t m_size = 2048;
-    uint32_t m_padding = 2;
+    uint32_t m_size = 1024;
+    uint32_t m_padding = 1;
+    uint32_t m_generation = 0;
 
     std::vector<Shelf> m_shelves;
     uint32_t m_currentShelfY = 0;
 
-    std::unordered_map<uint32_t, AtlasGlyph> m_glyphMap;
+    std::vector<uint8_t> m_coverage; // CPU 端覆盖率副本（m_size * m_size）
+    std::vector<Region> m_pendingRegions;
+    bool m_fullUploadPending = false;
+
+    std::unordered_map<uint64_t, AtlasGlyph> m_glyphMap;
 };
 
 } // namespace ui::managers
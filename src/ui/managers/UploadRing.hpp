@@ -0,0 +1,279 @@
+/**
+ * ************************************************************************
+ *
+ * @file UploadRing.hpp
+ * @author AnakinLiu (azrael2759@qq.com)
+ * @date 2026-10-16
+ * @version 0.1
+ * @brief GPU 上传环 - 多帧在途的持久上传缓冲区
+ *
+ * 每个帧槽持有一个传输缓冲区和对应的实例 GPU 缓冲区，跨帧保留，容量不足时按 2 倍扩容：
+ * - beginFrame 等待该槽上一次提交的栅栏，再映射传输缓冲区（不需要 cycle），渲染器经 BatchManager 直接写入
+ * - 收集中途容量不足时换一个更大的传输缓冲区，已写入的实例复制过去（growInstances）
+ * - upload 解除映射，按批次顺序把各段实例复制到 GPU 缓冲区；submit 提交并保存栅栏，轮到下一个槽
+ * 每帧统计上传字节数与缓冲区（重新）分配次数
+ *
+ * ************************************************************************
+ * @copyright Copyright (c) 2026 AnakinLiu
+ * For study and research only, no reprinting.
+ * ************************************************************************
+ */
+
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <span>
+#include <SDL3/SDL_gpu.h>
+#include "../common/GPUWrappers.hpp"
+#include "../common/RenderTypes.hpp"
+#include "../singleton/Logger.hpp"
+#include "BatchManager.hpp"
+#include "DeviceManager.hpp"
+
+namespace ui::managers
+{
+
+class UploadRing : public IInstanceStorage
+{
+public:
+    static constexpr uint32_t FRAMES_IN_FLIGHT = 3;               // 多个窗口各占一个槽，留出余量
+    static constexpr uint32_t INITIAL_TRANSFER_SIZE = 1024U * 1024U; // 首次映射时的传输缓冲区大小
+
+    /**
+     * @brief 最近一帧的上传统计（resetStats 清零）
+     */
+    struct Stats
+    {
+        uint64_t uploadedBytes = 0;     // 复制到 GPU 缓冲区的字节数
+        uint32_t bufferAllocations = 0; // 创建或扩容的传输 / 实例缓冲区个数
+    };
+
+    explicit UploadRing(DeviceManager& deviceManager) : m_deviceManager(deviceManager) {}
+
+    ~UploadRing() override { cleanup(); }
+    UploadRing(const UploadRing&) = delete;
+    UploadRing& operator=(const UploadRing&) = delete;
+    UploadRing(UploadRing&&) = delete;
+    UploadRing& operator=(UploadRing&&) = delete;
+
+    /**
+     * @brief 映射当前槽的传输缓冲区；已映射时直接返回
+     * @return 失败时返回 nullptr
+     */
+    IInstanceStorage* beginFrame()
+    {
+        FrameSlot& slot = currentSlot();
+        if (slot.mapped != nullptr) return this;
+
+        SDL_GPUDevice* device = m_deviceManager.getDevice();
+        if (device == nullptr) return nullptr;
+
+        // 该槽上一次提交的数据 GPU 已用完之后才能覆盖
+        if (slot.fence)
+        {
+            SDL_GPUFence* fence = slot.fence.get();
+            SDL_WaitForGPUFences(device, true, &fence, 1);
+            slot.fence.reset();
+        }
+
+        if (!slot.transferBuffer)
+        {
+            return replaceTransferBuffer(slot, INITIAL_TRANSFER_SIZE, 0) ? this : nullptr;
+        }
+
+        slot.mapped = static_cast<uint8_t*>(SDL_MapGPUTransferBuffer(device, slot.transferBuffer.get(), false));
+        if (slot.mapped == nullptr)
+        {
+            Logger::error("[UploadRing] Failed to map transfer buffer: {}", SDL_GetError());
+            return nullptr;
+        }
+        return this;
+    }
+
+    std::span<render::QuadInstance> growInstances(size_t capacity, size_t used) override
+    {
+        FrameSlot& slot = currentSlot();
+        const size_t required = capacity * sizeof(render::QuadInstance);
+        if (slot.mapped != nullptr && required > slot.transferSize)
+        {
+            replaceTransferBuffer(slot, required, used * sizeof(render::QuadInstance));
+        }
+        if (slot.mapped == nullptr) return {};
+        return {reinterpret_cast<render::QuadInstance*>(slot.mapped), slot.transferSize / sizeof(render::QuadInstance)};
+    }
+
+    /**
+     * @brief 解除映射（未提交时下一次 beginFrame 重新映射同一个槽）
+     */
+    void unmap()
+    {
+        FrameSlot& slot = currentSlot();
+        if (slot.mapped == nullptr) return;
+        SDL_UnmapGPUTransferBuffer(m_deviceManager.getDevice(), slot.transferBuffer.get());
+        slot.mapped = nullptr;
+    }
+
+    /**
+     * @brief 解除映射，并在 copyPass 中把 ranges 依次复制到当前槽的实例缓冲区（首尾相接）
+     * @param ranges 传输缓冲区中的实例区间，按绘制顺序排列（BatchManager::getRanges()）
+     */
+    bool upload(SDL_GPUCopyPass* copyPass, std::span<const render::InstanceRange> ranges, uint32_t instanceCount)
+    {
+        unmap();
+
+        FrameSlot& slot = currentSlot();
+        const auto bufferBytes = static_cast<uint32_t>(instanceCount * sizeof(render::QuadInstance));
+        if (!ensureBuffer(slot.instanceBuffer, slot.instanceBufferSize, bufferBytes, SDL_GPU_BUFFERUSAGE_VERTEX))
+        {
+            return false;
+        }
+
+        SDL_GPUTransferBufferLocation source = {};
+        source.transfer_buffer = slot.transferBuffer.get();
+        SDL_GPUBufferRegion destination = {};
+        destination.buffer = slot.instanceBuffer.get();
+
+        // 源与目标都连续的相邻区间合成一次复制；未重排时整帧只有一次
+        uint32_t written = 0;
+        for (size_t index = 0; index < ranges.size();)
+        {
+            const uint32_t first = ranges[index].firstInstance;
+            uint32_t count = ranges[index].instanceCount;
+            for (++index; index < ranges.size() && ranges[index].firstInstance == first + count; ++index)
+            {
+                count += ranges[index].instanceCount;
+            }
+
+            source.offset = static_cast<uint32_t>(first * sizeof(render::QuadInstance));
+            destination.offset = static_cast<uint32_t>(written * sizeof(render::QuadInstance));
+            destination.size = static_cast<uint32_t>(count * sizeof(render::QuadInstance));
+            SDL_UploadToGPUBuffer(copyPass, &source, &destination, false);
+            written += count;
+        }
+
+        m_stats.uploadedBytes += static_cast<uint64_t>(written) * sizeof(render::QuadInstance);
+        return true;
+    }
+
+    [[nodiscard]] SDL_GPUBuffer* instanceBuffer() { return currentSlot().instanceBuffer.get(); }
+
+    /**
+     * @brief 提交命令缓冲区，保存栅栏并切换到下一个槽
+     */
+    void submit(SDL_GPUCommandBuffer* cmdBuf)
+    {
+        SDL_GPUFence* fence = SDL_SubmitGPUCommandBufferAndAcquireFence(cmdBuf);
+        currentSlot().fence = wrappers::UniqueGPUFence(fence, wrappers::GPUResourceDeleter<SDL_ReleaseGPUFence>(
+                                                                   m_deviceManager.getDevice()));
+        m_frameIndex = (m_frameIndex + 1) % FRAMES_IN_FLIGHT;
+    }
+
+    [[nodiscard]] const Stats& getStats() const { return m_stats; }
+    void resetStats() { m_stats = {}; }
+
+    /**
+     * @brief 等待所有在途的帧并释放缓冲区
+     */
+    void cleanup()
+    {
+        SDL_GPUDevice* device = m_deviceManager.getDevice();
+        for (auto& slot : m_slots)
+        {
+            if (slot.mapped != nullptr && device != nullptr)
+            {
+                SDL_UnmapGPUTransferBuffer(device, slot.transferBuffer.get());
+            }
+            if (slot.fence && device != nullptr)
+            {
+                SDL_GPUFence* fence = slot.fence.get();
+                SDL_WaitForGPUFences(device, true, &fence, 1);
+            }
+            slot = FrameSlot{};
+        }
+    }
+
+private:
+    struct FrameSlot
+    {
+        wrappers::UniqueGPUTransferBuffer transferBuffer;
+        size_t transferSize = 0;
+        uint8_t* mapped = nullptr; // 映射期间有效
+        wrappers::UniqueGPUBuffer instanceBuffer;
+        uint32_t instanceBufferSize = 0;
+        wrappers::UniqueGPUFence fence; // 最近一次使用该槽的提交
+    };
+
+    FrameSlot& currentSlot() { return m_slots[m_frameIndex]; }
+
+    /**
+     * @brief 换成至少 size 字节的传输缓冲区并映射，保留旧缓冲区映射内容的前 keepBytes 字节
+     *
+     * 旧缓冲区由 SDL 延迟到不再使用时释放；失败时保持原状
+     */
+    bool replaceTransferBuffer(FrameSlot& slot, size_t size, size_t keepBytes)
+    {
+        SDL_GPUDevice* device = m_deviceManager.getDevice();
+        const size_t newSize = std::max(size, slot.transferSize * 2);
+
+        SDL_GPUTransferBufferCreateInfo info = {};
+        info.usage = SDL_GPU_TRANSFERBUFFERUSAGE_UPLOAD;
+        info.size = static_cast<uint32_t>(newSize);
+        auto buffer =
+            wrappers::MakeGpuResource<wrappers::UniqueGPUTransferBuffer>(device, SDL_CreateGPUTransferBuffer, &info);
+        if (!buffer)
+        {
+            Logger::error("[UploadRing] Failed to create transfer buffer: {}", SDL_GetError());
+            return false;
+        }
+
+        auto* mapped = static_cast<uint8_t*>(SDL_MapGPUTransferBuffer(device, buffer.get(), false));
+        if (mapped == nullptr)
+        {
+            Logger::error("[UploadRing] Failed to map transfer buffer: {}", SDL_GetError());
+            return false;
+        }
+
+        if (slot.mapped != nullptr)
+        {
+            SDL_memcpy(mapped, slot.mapped, keepBytes);
+            SDL_UnmapGPUTransferBuffer(device, slot.transferBuffer.get());
+        }
+        slot.transferBuffer = std::move(buffer);
+        slot.transferSize = newSize;
+        slot.mapped = mapped;
+        ++m_stats.bufferAllocations;
+        return true;
+    }
+
+    bool ensureBuffer(wrappers::UniqueGPUBuffer& buffer,
+                      uint32_t& bufferSize,
+                      uint32_t size,
+                      SDL_GPUBufferUsageFlags usage)
+    {
+        if (buffer && bufferSize >= size) return true;
+
+        const uint32_t newSize = std::max(size, bufferSize * 2);
+        SDL_GPUBufferCreateInfo info = {};
+        info.usage = usage;
+        info.size = newSize;
+        buffer = wrappers::MakeGpuResource<wrappers::UniqueGPUBuffer>(
+            m_deviceManager.getDevice(), SDL_CreateGPUBuffer, &info);
+        if (!buffer)
+        {
+            bufferSize = 0;
+            Logger::error("[UploadRing] Failed to create GPU buffer: {}", SDL_GetError());
+            return false;
+        }
+        bufferSize = newSize;
+        ++m_stats.bufferAllocations;
+        return true;
+    }
+
+    DeviceManager& m_deviceManager;
+    std::array<FrameSlot, FRAMES_IN_FLIGHT> m_slots;
+    uint32_t m_frameIndex = 0;
+    Stats m_stats;
+};
+
+} // namespace ui::managers
@@ -141,16 +141,12 @@ public:
             drawPos.x() = std::round(drawPos.x());
             drawPos.y() = std::round(drawPos.y());
 
-            render::UiPushConstants pushConstants{};
-            pushConstants.screen_size[0] = context.screenWidth;
-            pushConstants.screen_size[1] = context.screenHeight;
-            pushConstants.rect_size[0] = actualIconSize.x();
-            pushConstants.rect_size[1] = actualIconSize.y();
-            pushConstants.opacity = context.alpha;
-            pushConstants.padding = 1.0F; // 标记纹理为预乘 Alpha
-
-            context.batchManager->beginBatch(iconTexture, context.currentScissor, pushConstants);
-            context.batchManager->addRect(drawPos, actualIconSize, tint, uvMin, uvMax);
+            render::ShapeParams shape{};
+            shape.opacity = context.alpha;
+            shape.premultiplied = true; // 标记纹理为预乘 Alpha
+
+            context.batchManager->beginBatch(iconTexture, context.currentScissor);
+            context.batchManager->addRect(drawPos, actualIconSize, tint, shape, uvMin, uvMax);
         }
     }
     /**
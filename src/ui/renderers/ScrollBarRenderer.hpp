@@ -106,22 +106,15 @@ private:
             }
 
             // 绘制轨道背景
-            render::UiPushConstants trackPushConstants{};
-            trackPushConstants.screen_size[0] = context.screenWidth;
-            trackPushConstants.screen_size[1] = context.screenHeight;
-            trackPushConstants.rect_size[0] = trackSize.x();
-            trackPushConstants.rect_size[1] = trackSize.y();
-            trackPushConstants.radius[0] = 6.0F; // 圆角轨道
-            trackPushConstants.radius[1] = 6.0F;
-            trackPushConstants.radius[2] = 6.0F;
-            trackPushConstants.radius[3] = 6.0F;
-            trackPushConstants.opacity = alpha;
-            trackPushConstants.shadow_soft = 0.0F;
-            trackPushConstants.shadow_offset_x = 0.0F;
-            trackPushConstants.shadow_offset_y = 0.0F;
-
-            context.batchManager->beginBatch(context.whiteTexture, context.currentScissor, trackPushConstants);
-            context.batchManager->addRect(trackPos, trackSize, trackColor);
+            render::ShapeParams trackShape{};
+            trackShape.radius[0] = 6.0F; // 圆角轨道
+            trackShape.radius[1] = 6.0F;
+            trackShape.radius[2] = 6.0F;
+            trackShape.radius[3] = 6.0F;
+            trackShape.opacity = alpha;
+
+            context.batchManager->beginBatch(context.whiteTexture, context.currentScissor);
+            context.batchManager->addRect(trackPos, trackSize, trackColor, trackShape);
 
             // 滑块位置和大小
             Eigen::Vector2f barPos(pos.x() + size.x() - barWidth - trackPadding - 1.0F, pos.y() + thumbPos + 2.0F);
@@ -139,22 +132,15 @@ private:
             }
 
             // 绘制滑块
-            render::UiPushConstants pushConstants{};
-            pushConstants.screen_size[0] = context.screenWidth;
-            pushConstants.screen_size[1] = context.screenHeight;
-            pushConstants.rect_size[0] = barSize.x();
-            pushConstants.rect_size[1] = barSize.y();
-            pushConstants.radius[0] = 5.0F;
-            pushConstants.radius[1] = 5.0F;
-            pushConstants.radius[2] = 5.0F;
-            pushConstants.radius[3] = 5.0F;
-            pushConstants.opacity = alpha;
-            pushConstants.shadow_soft = 0.0F;
-            pushConstants.shadow_offset_x = 0.0F;
-            pushConstants.shadow_offset_y = 0.0F;
-
-            context.batchManager->beginBatch(context.whiteTexture, context.currentScissor, pushConstants);
-            context.batchManager->addRect(barPos, barSize, thumbColor);
+            render::ShapeParams thumbShape{};
+            thumbShape.radius[0] = 5.0F;
+            thumbShape.radius[1] = 5.0F;
+            thumbShape.radius[2] = 5.0F;
+            thumbShape.radius[3] = 5.0F;
+            thumbShape.opacity = alpha;
+
+            context.batchManager->beginBatch(context.whiteTexture, context.currentScissor);
+            context.batchManager->addRect(barPos, barSize, thumbColor, thumbShape);
         }
     }
 };
@@ -74,28 +74,18 @@ private:
     // 边框粗细半值系数
     static constexpr float HALF_THICKNESS_MULTIPLIER = 0.5F;
     /**
-     * @brief 初始化基础推送常量
+     * @brief 基础形状参数
      *
-     * 设置所有推送常量的默认值，包括屏幕尺寸、矩形尺寸、不透明度和阴影默认值。
-     * 阴影参数默认设置为0，调用者可以根据需要在之后覆盖这些值。
+     * 透明度取自渲染上下文，圆角与阴影默认为 0，调用者可以根据需要在之后覆盖。
+     * 这些参数随实例传入，不同参数的形状仍可合并到同一批次
      *
-     * @param pushConstants 要初始化的推送常量
      * @param context 渲染上下文
-     * @param rectSize 矩形尺寸
      */
-    void initBasicPushConstants(render::UiPushConstants& pushConstants,
-                                const core::RenderContext& context,
-                                const Eigen::Vector2f& rectSize) const
+    [[nodiscard]] render::ShapeParams basicShape(const core::RenderContext& context) const
     {
-        pushConstants.screen_size[0] = context.screenWidth;
-        pushConstants.screen_size[1] = context.screenHeight;
-        pushConstants.rect_size[0] = rectSize.x();
-        pushConstants.rect_size[1] = rectSize.y();
-        pushConstants.opacity = context.alpha;
-        // 默认无阴影，调用者可以覆盖
-        pushConstants.shadow_soft = 0.0F;
-        pushConstants.shadow_offset_x = 0.0F;
-        pushConstants.shadow_offset_y = 0.0F;
+        render::ShapeParams shape;
+        shape.opacity = context.alpha;
+        return shape;
     }
 
     void renderBackground(entt::entity entity, core::RenderContext& context)
@@ -106,14 +96,12 @@ private:
             return;
         }
 
-        // 准备推送常量
-        render::UiPushConstants pushConstants{};
-        initBasicPushConstants(pushConstants, context, context.size);
-
-        pushConstants.radius[0] = bg->borderRadius.x();
-        pushConstants.radius[1] = bg->borderRadius.y();
-        pushConstants.radius[2] = bg->borderRadius.z();
-        pushConstants.radius[3] = bg->borderRadius.w();
+        // 准备形状参数
+        render::ShapeParams shape = basicShape(context);
+        shape.radius[0] = bg->borderRadius.x();
+        shape.radius[1] = bg->borderRadius.y();
+        shape.radius[2] = bg->borderRadius.z();
+        shape.radius[3] = bg->borderRadius.w();
 
         // Debug log
         if (auto* baseInfo = Registry::TryGet<components::BaseInfo>(entity))
@@ -134,17 +122,17 @@ private:
         const auto* shadow = Registry::TryGet<components::Shadow>(entity);
         if (shadow && shadow->enabled == policies::Feature::Enabled)
         {
-            pushConstants.shadow_soft = shadow->softness;
-            pushConstants.shadow_offset_x = shadow->offset.x();
-            pushConstants.shadow_offset_y = shadow->offset.y();
+            shape.shadowSoft = shadow->softness;
+            shape.shadowOffset[0] = shadow->offset.x();
+            shape.shadowOffset[1] = shadow->offset.y();
         }
 
         // 开始批次
-        context.batchManager->beginBatch(context.whiteTexture, context.currentScissor, pushConstants);
+        context.batchManager->beginBatch(context.whiteTexture, context.currentScissor);
 
         // 添加矩形
         Eigen::Vector4f color(bg->color.red, bg->color.green, bg->color.blue, bg->color.alpha);
-        context.batchManager->addRect(context.position, context.size, color);
+        context.batchManager->addRect(context.position, context.size, color, shape);
     }
 
     void renderBorder(entt::entity entity, core::RenderContext& context)
@@ -199,26 +187,27 @@ private:
      */
     void renderBorderLines(core::RenderContext& context, const Eigen::Vector4f& color, float thickness)
     {
-        render::UiPushConstants pushConstants{};
-        initBasicPushConstants(pushConstants, context, context.size);
+        const render::ShapeParams shape = basicShape(context);
 
-        context.batchManager->beginBatch(context.whiteTexture, context.currentScissor, pushConstants);
+        context.batchManager->beginBatch(context.whiteTexture, context.currentScissor);
 
         const Eigen::Vector2f& pos = context.position;
         const Eigen::Vector2f& size = context.size;
         const float halfThickness = thickness * HALF_THICKNESS_MULTIPLIER;
 
         // 顶边
-        context.batchManager->addRect({pos.x(), pos.y() - halfThickness}, {size.x(), thickness}, color);
+        context.batchManager->addRect({pos.x(), pos.y() - halfThickness}, {size.x(), thickness}, color, shape);
 
         // 右边
-        context.batchManager->addRect({pos.x() + size.x() - halfThickness, pos.y()}, {thickness, size.y()}, color);
+        context.batchManager->addRect(
+            {pos.x() + size.x() - halfThickness, pos.y()}, {thickness, size.y()}, color, shape);
 
         // 底边
-        context.batchManager->addRect({pos.x(), pos.y() + size.y() - halfThickness}, {size.x(), thickness}, color);
+        context.batchManager->addRect(
+            {pos.x(), pos.y() + size.y() - halfThickness}, {size.x(), thickness}, color, shape);
 
         // 左边
-        context.batchManager->addRect({pos.x() - halfThickness, pos.y()}, {thickness, size.y()}, color);
+        context.batchManager->addRect({pos.x() - halfThickness, pos.y()}, {thickness, size.y()}, color, shape);
     }
 };
 
@@ -42,19 +42,15 @@ public:
             trackSize.y() = std::max(8.0F, trackSize.y());
         }
 
-        render::UiPushConstants pc{};
-        pc.screen_size[0] = context.screenWidth;
-        pc.screen_size[1] = context.screenHeight;
-        pc.rect_size[0] = trackSize.x();
-        pc.rect_size[1] = trackSize.y();
-        pc.radius[0] = 6.0F;
-        pc.radius[1] = 6.0F;
-        pc.radius[2] = 6.0F;
-        pc.radius[3] = 6.0F;
-        pc.opacity = context.alpha;
+        render::ShapeParams shape{};
+        shape.radius[0] = 6.0F;
+        shape.radius[1] = 6.0F;
+        shape.radius[2] = 6.0F;
+        shape.radius[3] = 6.0F;
+        shape.opacity = context.alpha;
 
-        context.batchManager->beginBatch(context.whiteTexture, context.currentScissor, pc);
-        context.batchManager->addRect(trackPos, trackSize, trackColor);
+        context.batchManager->beginBatch(context.whiteTexture, context.currentScissor);
+        context.batchManager->addRect(trackPos, trackSize, trackColor, shape);
 
         // draw fill/thumb
         float progress = 0.0F;
@@ -68,20 +64,14 @@ public:
             float fillH = trackSize.y() * progress;
             Eigen::Vector2f fillPos(trackPos.x(), trackPos.y() + trackSize.y() - fillH);
             Eigen::Vector2f fillSize(trackSize.x(), fillH);
-            pc.rect_size[0] = fillSize.x();
-            pc.rect_size[1] = fillSize.y();
-            context.batchManager->beginBatch(context.whiteTexture, context.currentScissor, pc);
-            context.batchManager->addRect(fillPos, fillSize, thumbColor);
+            context.batchManager->addRect(fillPos, fillSize, thumbColor, shape);
         }
         else
         {
             float fillW = trackSize.x() * progress;
             Eigen::Vector2f fillPos(trackPos.x(), trackPos.y());
             Eigen::Vector2f fillSize(fillW, trackSize.y());
-            pc.rect_size[0] = fillSize.x();
-            pc.rect_size[1] = fillSize.y();
-            context.batchManager->beginBatch(context.whiteTexture, context.currentScissor, pc);
-            context.batchManager->addRect(fillPos, fillSize, thumbColor);
+            context.batchManager->addRect(fillPos, fillSize, thumbColor, shape);
         }
     }
 
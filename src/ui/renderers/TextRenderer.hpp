@@ -20,10 +20,14 @@
 #include "../common/Tags.hpp"
 #include "../managers/TextTextureCache.hpp"
 #include "../managers/FontManager.hpp"
+#include "../managers/TextRenderHelper.hpp"
 #include "../managers/BatchManager.hpp"
+#include "../core/TextLayout.hpp"
 #include "../core/TextUtils.hpp"
 #include "../api/Utils.hpp"
 #include <functional>
+#include <optional>
+#include <string_view>
 
 namespace ui::renderers
 {
@@ -36,6 +40,9 @@ namespace ui::renderers
  * - 按钮文本
  * - 标签文本
  * - 文本输入框文本及光标
+ *
+ * 默认使用字形图集：每个字形一个四边形，颜色写在实例中，同一裁剪区域内的文本合并为一个批次；
+ * 图集不可用时回退到 TextTextureCache 的整串纹理
  */
 class TextRenderer : public core::IRenderer
 {
@@ -50,7 +57,8 @@ public:
 
     void collect(entt::entity entity, core::RenderContext& context) override
     {
-        if (context.fontManager == nullptr || context.textTextureCache == nullptr || context.batchManager == nullptr)
+        if (context.fontManager == nullptr || context.batchManager == nullptr ||
+            (context.fontAtlas == nullptr && context.textTextureCache == nullptr))
         {
             return;
         }
@@ -109,53 +117,42 @@ private:
             wrapWidth = context.size.x();
         }
 
-        auto measureFunc = [fontManager = context.fontManager](const std::string& str)
-        { return fontManager->measureTextWidth(str); };
+        if (!context.fontManager->isLoaded()) return;
+
+        const bool wrapping = wrapMode != policies::TextWrap::NONE && wrapWidth > 0.0F;
+        const auto& layout = layoutText(entity,
+                                        textComp.content,
+                                        wrapping ? wrapMode : policies::TextWrap::NONE,
+                                        wrapping ? wrapWidth : 0.0F,
+                                        fontSize,
+                                        context);
 
-        if (wrapMode != policies::TextWrap::NONE && wrapWidth > 0.0F)
+        if (wrapping)
         {
             // 根据换行结果动态修正自动高度，避免滚动区内容高度不匹配
             if (auto* sizeComp = Registry::TryGet<components::Size>(entity))
             {
-                if (policies::HasFlag(sizeComp->sizePolicy, policies::Size::VAuto))
+                if (policies::HasFlag(sizeComp->sizePolicy, policies::Size::VAuto) && layout.lineHeight > 0.0F)
                 {
-                    const float lineHeight = static_cast<float>(context.fontManager->getFontHeight());
-                    if (lineHeight > 0.0F)
+                    const float desiredHeight = ui::utils::LayoutHeight(layout);
+                    if (std::abs(sizeComp->size.y() - desiredHeight) > 0.5F)
                     {
-                        const auto lines = ui::utils::WrapTextLines(
-                            textComp.content, static_cast<int>(wrapWidth), wrapMode, measureFunc);
-                        const float desiredHeight = static_cast<float>(lines.size()) * lineHeight;
-                        if (std::abs(sizeComp->size.y() - desiredHeight) > 0.5F)
-                        {
-                            sizeComp->size.y() = desiredHeight;
-                            Registry::EmplaceOrReplace<components::LayoutDirtyTag>(entity);
-                        }
+                        sizeComp->size.y() = desiredHeight;
+                        Registry::EmplaceOrReplace<components::LayoutDirtyTag>(entity);
                     }
                 }
             }
-
-            addWrappedText(textComp.content,
-                           context.position,
-                           context.size,
-                           color,
-                           textComp.alignment,
-                           wrapMode,
-                           wrapWidth,
-                           context.alpha,
-                           fontSize,
-                           context);
-        }
-        else
-        {
-            addText(textComp.content,
-                    context.position,
-                    context.size,
-                    color,
-                    textComp.alignment,
-                    context.alpha,
-                    fontSize,
-                    context);
         }
+
+        addLayoutText(layout,
+                      context.position,
+                      context.size,
+                      wrapping ? wrapWidth : context.size.x(),
+                      color,
+                      textComp.alignment,
+                      context.alpha,
+                      fontSize,
+                      context);
     }
 
     void renderTextEdit(entt::entity entity,
@@ -163,6 +160,8 @@ private:
                         const components::TextEdit& textEdit,
                         core::RenderContext& context)
     {
+        if (!context.fontManager->isLoaded()) return;
+
         // 获取字体大小
         float fontSize = textComp.fontSize;
 
@@ -186,7 +185,7 @@ private:
         currentScissor.h = static_cast<int>(textSize.y());
         textEditContext.pushScissor(currentScissor);
 
-        std::string displayText = textEdit.buffer;
+        std::string_view displayText = textEdit.buffer;
         Eigen::Vector4f color(textComp.color.red, textComp.color.green, textComp.color.blue, textComp.color.alpha);
 
         // 如果没有内容且有 placeholder，显示 placeholder（灰色）
@@ -197,23 +196,24 @@ private:
             color = Eigen::Vector4f(0.5F, 0.5F, 0.5F, context.alpha);
         }
 
-        const float lineHeight = static_cast<float>(context.fontManager->getFontHeight());
+        const float lineHeight = static_cast<float>(context.fontManager->getSizeMetrics(fontSize).height);
 
         const auto modeVal = static_cast<uint8_t>(textEdit.inputMode);
         const auto multiFlag = static_cast<uint8_t>(policies::TextFlag::Multiline);
 
-        auto measureFunc = [fontManager = context.fontManager](const std::string& str)
-        { return fontManager->measureTextWidth(str); };
-
         if ((modeVal & multiFlag) == 0)
         {
+            auto advanceFunc = [&advances = context.fontManager->getAdvanceCache()](uint32_t codepoint,
+                                                                                 uint32_t previous)
+            { return advances.advance(codepoint, previous); };
+
             // 单行：确保光标所在的区域可见
-            std::string leftOfCursor = displayText.substr(0, textEdit.cursorPosition);
+            std::string leftOfCursor(displayText.substr(0, textEdit.cursorPosition));
             float cursorOffsetInVisible = 0.0F;
             std::string visibleLeft = ui::utils::GetTailThatFits(
-                leftOfCursor, static_cast<int>(textSize.x()), measureFunc, cursorOffsetInVisible);
+                leftOfCursor, static_cast<int>(textSize.x()), advanceFunc, cursorOffsetInVisible);
 
-            std::string rightOfCursor = displayText.substr(textEdit.cursorPosition);
+            std::string rightOfCursor(displayText.substr(textEdit.cursorPosition));
             size_t rightCharsFit = 0;
             context.fontManager->measureString(rightOfCursor.c_str(),
                                                rightOfCursor.size(),
@@ -237,16 +237,12 @@ private:
 
                 if (context.sdlWindow && (SDL_GetTicks() / 500) % 2 == 0)
                 {
-                    render::UiPushConstants pushConstants{};
-                    pushConstants.screen_size[0] = context.screenWidth;
-                    pushConstants.screen_size[1] = context.screenHeight;
-                    pushConstants.rect_size[0] = 2.0F;
-                    pushConstants.rect_size[1] = lineHeight;
-                    pushConstants.opacity = context.alpha;
+                    render::ShapeParams caretShape{};
+                    caretShape.opacity = context.alpha;
 
-                    context.batchManager->beginBatch(
-                        context.whiteTexture, textEditContext.currentScissor, pushConstants);
-                    context.batchManager->addRect({cursorX, cursorY}, {2.0F, lineHeight}, {1.0F, 1.0F, 1.0F, 1.0F});
+                    context.batchManager->beginBatch(context.whiteTexture, textEditContext.currentScissor);
+                    context.batchManager->addRect(
+                        {cursorX, cursorY}, {2.0F, lineHeight}, {1.0F, 1.0F, 1.0F, 1.0F}, caretShape);
 
                     SDL_Rect rect;
                     rect.x = static_cast<int>(cursorX);
@@ -262,8 +258,9 @@ private:
             // 多行：自动换行 + 支持滚动
             policies::TextWrap wrapMode =
                 textComp.wordWrap != policies::TextWrap::NONE ? textComp.wordWrap : policies::TextWrap::Word;
-            std::vector<std::string> lines =
-                ui::utils::WrapTextLines(displayText, static_cast<int>(textSize.x()), wrapMode, measureFunc);
+            // 排版缓存：输入时只从被修改的段落开始重新排版
+            const auto& layout = layoutText(entity, displayText, wrapMode, textSize.x(), fontSize, context);
+            const auto& lines = layout.lines;
 
             // 计算文本总高度并更新 ScrollArea contentSize
             float totalTextHeight = lines.size() * lineHeight;
@@ -320,18 +317,15 @@ private:
                 float y = textPos.y() - (scrollArea->scrollOffset.y() - scrollOffsetLines * lineHeight);
                 for (size_t i = startIndex; i < endIndex; ++i)
                 {
-                    const std::string& line = lines[i];
-                    if (!line.empty())
-                    {
-                        addText(line,
-                                {textPos.x(), y},
-                                {textSize.x(), lineHeight},
-                                color,
-                                policies::Alignment::LEFT,
-                                context.alpha,
-                                fontSize,
-                                textEditContext);
-                    }
+                    addLayoutLine(layout,
+                                  lines[i],
+                                  {textPos.x(), y},
+                                  textSize.x(),
+                                  color,
+                                  policies::Alignment::LEFT,
+                                  context.alpha,
+                                  fontSize,
+                                  textEditContext);
                     y += lineHeight;
                 }
 
@@ -344,8 +338,7 @@ private:
                     if (!lines.empty())
                     {
                         // 光标在最后一行末尾
-                        const std::string& lastLine = lines.back();
-                        float lastWidth = context.fontManager->measureTextWidth(lastLine);
+                        const float lastWidth = std::ceil(lines.back().width);
 
                         // 计算光标在可见区域中的位置
                         const int lastLineIndex = static_cast<int>(lines.size()) - 1;
@@ -368,16 +361,12 @@ private:
 
                     if (context.sdlWindow && cursorX >= 0.0F && cursorY >= 0.0F && (SDL_GetTicks() / 500) % 2 == 0)
                     {
-                        render::UiPushConstants pushConstants{};
-                        pushConstants.screen_size[0] = context.screenWidth;
-                        pushConstants.screen_size[1] = context.screenHeight;
-                        pushConstants.rect_size[0] = 2.0F;
-                        pushConstants.rect_size[1] = lineHeight;
-                        pushConstants.opacity = context.alpha;
+                        render::ShapeParams caretShape{};
+                        caretShape.opacity = context.alpha;
 
-                        context.batchManager->beginBatch(
-                            context.whiteTexture, textEditContext.currentScissor, pushConstants);
-                        context.batchManager->addRect({cursorX, cursorY}, {2.0F, lineHeight}, {1.0F, 1.0F, 1.0F, 1.0F});
+                        context.batchManager->beginBatch(context.whiteTexture, textEditContext.currentScissor);
+                        context.batchManager->addRect(
+                            {cursorX, cursorY}, {2.0F, lineHeight}, {1.0F, 1.0F, 1.0F, 1.0F}, caretShape);
 
                         SDL_Rect rect;
                         rect.x = static_cast<int>(cursorX);
@@ -399,18 +388,15 @@ private:
                 float y = textPos.y();
                 for (size_t i = startIndex; i < lines.size(); ++i)
                 {
-                    const std::string& line = lines[i];
-                    if (!line.empty())
-                    {
-                        addText(line,
-                                {textPos.x(), y},
-                                {textSize.x(), lineHeight},
-                                color,
-                                policies::Alignment::LEFT,
-                                context.alpha,
-                                fontSize,
-                                textEditContext);
-                    }
+                    addLayoutLine(layout,
+                                  lines[i],
+                                  {textPos.x(), y},
+                                  textSize.x(),
+                                  color,
+                                  policies::Alignment::LEFT,
+                                  context.alpha,
+                                  fontSize,
+                                  textEditContext);
                     y += lineHeight;
                 }
 
@@ -423,8 +409,7 @@ private:
                     if (!lines.empty())
                     {
                         // 光标在最后一行末尾
-                        const std::string& lastLine = lines.back();
-                        float lastWidth = context.fontManager->measureTextWidth(lastLine);
+                        const float lastWidth = std::ceil(lines.back().width);
                         cursorX = textPos.x() + lastWidth;
 
                         // 如果有多行，光标在最后一行，垂直居中
@@ -445,16 +430,12 @@ private:
 
                     if (context.sdlWindow && (SDL_GetTicks() / 500) % 2 == 0)
                     {
-                        render::UiPushConstants pushConstants{};
-                        pushConstants.screen_size[0] = context.screenWidth;
-                        pushConstants.screen_size[1] = context.screenHeight;
-                        pushConstants.rect_size[0] = 2.0F;
-                        pushConstants.rect_size[1] = lineHeight;
-                        pushConstants.opacity = context.alpha;
+                        render::ShapeParams caretShape{};
+                        caretShape.opacity = context.alpha;
 
-                        context.batchManager->beginBatch(
-                            context.whiteTexture, textEditContext.currentScissor, pushConstants);
-                        context.batchManager->addRect({cursorX, cursorY}, {2.0F, lineHeight}, {1.0F, 1.0F, 1.0F, 1.0F});
+                        context.batchManager->beginBatch(context.whiteTexture, textEditContext.currentScissor);
+                        context.batchManager->addRect(
+                            {cursorX, cursorY}, {2.0F, lineHeight}, {1.0F, 1.0F, 1.0F, 1.0F}, caretShape);
 
                         SDL_Rect rect;
                         rect.x = static_cast<int>(cursorX);
@@ -507,16 +488,30 @@ private:
     {
         if (!context.fontManager->isLoaded() || text.empty()) return;
 
-        uint32_t textWidth = 0;
-        uint32_t textHeight = 0;
+        std::optional<managers::TextRenderHelper> atlasText;
+        if (context.fontAtlas != nullptr && context.fontAtlas->isLoaded())
+        {
+            atlasText.emplace(*context.fontAtlas);
+        }
 
-        SDL_GPUTexture* textTexture =
-            context.textTextureCache->getOrUpload(text, color, textWidth, textHeight, fontSize);
+        Eigen::Vector2f textSize;
+        SDL_GPUTexture* textTexture = nullptr;
+        if (atlasText.has_value())
+        {
+            textSize = {atlasText->measureLine(text, fontSize), atlasText->lineHeight(fontSize)};
+        }
+        else
+        {
+            if (context.textTextureCache == nullptr) return;
 
-        if (textTexture == nullptr) return;
+            uint32_t textWidth = 0;
+            uint32_t textHeight = 0;
+            textTexture = context.textTextureCache->getOrUpload(text, color, textWidth, textHeight, fontSize);
+            if (textTexture == nullptr) return;
 
-        float scale = context.fontManager->getOversampleScale();
-        Eigen::Vector2f textSize(static_cast<float>(textWidth) / scale, static_cast<float>(textHeight) / scale);
+            float scale = context.fontManager->getOversampleScale();
+            textSize = {static_cast<float>(textWidth) / scale, static_cast<float>(textHeight) / scale};
+        }
 
         float drawX = pos.x();
         float drawY = pos.y();
@@ -545,40 +540,68 @@ private:
         drawX = std::round(drawX);
         drawY = std::round(drawY);
 
-        render::UiPushConstants pushConstants{};
-        pushConstants.screen_size[0] = context.screenWidth;
-        pushConstants.screen_size[1] = context.screenHeight;
-        pushConstants.rect_size[0] = textSize.x();
-        pushConstants.rect_size[1] = textSize.y();
-        pushConstants.opacity = opacity;
-        pushConstants.padding = 1.0F; // 标记纹理为预乘 Alpha
+        if (atlasText.has_value())
+        {
+            atlasText->addLine(
+                *context.batchManager, text, {drawX, drawY}, color, opacity, fontSize, context.currentScissor);
+            return;
+        }
+
+        render::ShapeParams shape{};
+        shape.opacity = opacity;
+        shape.premultiplied = true; // 标记纹理为预乘 Alpha
 
-        context.batchManager->beginBatch(textTexture, context.currentScissor, pushConstants);
-        context.batchManager->addRect({drawX, drawY}, textSize, {1.0f, 1.0f, 1.0f, 1.0f});
+        context.batchManager->beginBatch(textTexture, context.currentScissor);
+        context.batchManager->addRect({drawX, drawY}, textSize, {1.0f, 1.0f, 1.0f, 1.0f}, shape);
     }
 
-    void addWrappedText(const std::string& text,
-                        const Eigen::Vector2f& pos,
-                        const Eigen::Vector2f& size,
-                        const Eigen::Vector4f& color,
-                        policies::Alignment alignment,
-                        policies::TextWrap wrapMode,
-                        float wrapWidth,
-                        float opacity,
-                        float fontSize,
-                        core::RenderContext& context)
+    /**
+     * @brief 获取实体的排版缓存，内容、字体、字号或换行宽度变化时才重新排版
+     * @param maxWidth 换行宽度，wrapMode 为 NONE 时忽略
+     */
+    const components::TextLayout& layoutText(entt::entity entity,
+                                             std::string_view content,
+                                             policies::TextWrap wrapMode,
+                                             float maxWidth,
+                                             float fontSize,
+                                             core::RenderContext& context)
     {
-        if (!context.fontManager->isLoaded() || text.empty() || wrapWidth <= 0.0F) return;
-
-        const float lineHeight = static_cast<float>(context.fontManager->getFontHeight());
-        if (lineHeight <= 0.0F) return;
+        auto& fontManager = *context.fontManager;
+        auto& advances = fontManager.getAdvanceCache(fontSize);
+        const ui::utils::TextLayoutParams params{
+            .fontSize = fontSize,
+            .maxWidth = wrapMode != policies::TextWrap::NONE ? maxWidth : 0.0F,
+            .wrapMode = wrapMode,
+            .fontGeneration = fontManager.getFontGeneration(),
+            .lineHeight = static_cast<float>(fontManager.getSizeMetrics(fontSize).height),
+        };
+
+        auto& layout = Registry::GetOrEmplace<components::TextLayout>(entity);
+        ui::utils::UpdateTextLayout(layout,
+                                    content,
+                                    params,
+                                    [&advances](uint32_t codepoint, uint32_t previous)
+                                    { return advances.advance(codepoint, previous); });
+        return layout;
+    }
 
-        auto measureFunc = [fontManager = context.fontManager](const std::string& str)
-        { return fontManager->measureTextWidth(str); };
+    /**
+     * @brief 绘制排版后的整段文本
+     * @param boxWidth 水平对齐所用的宽度
+     */
+    void addLayoutText(const components::TextLayout& layout,
+                       const Eigen::Vector2f& pos,
+                       const Eigen::Vector2f& size,
+                       float boxWidth,
+                       const Eigen::Vector4f& color,
+                       policies::Alignment alignment,
+                       float opacity,
+                       float fontSize,
+                       core::RenderContext& context)
+    {
+        if (layout.lineHeight <= 0.0F) return;
 
-        std::vector<std::string> lines =
-            ui::utils::WrapTextLines(text, static_cast<int>(wrapWidth), wrapMode, measureFunc);
-        const float totalHeight = static_cast<float>(lines.size()) * lineHeight;
+        const float totalHeight = ui::utils::LayoutHeight(layout);
 
         float startY = pos.y();
         if (ui::utils::HasAlignment(alignment, policies::Alignment::VCENTER))
@@ -601,16 +624,63 @@ private:
         }
 
         float y = startY;
-        for (const auto& line : lines)
+        for (const auto& line : layout.lines)
         {
-            if (!line.empty())
-            {
-                addText(
-                    line, {pos.x(), y}, {wrapWidth, lineHeight}, color, horizontalAlign, opacity, fontSize, context);
-            }
-            y += lineHeight;
+            addLayoutLine(layout, line, {pos.x(), y}, boxWidth, color, horizontalAlign, opacity, fontSize, context);
+            y += layout.lineHeight;
         }
     }
+
+    /**
+     * @brief 绘制排版后的一行：图集可用时直接使用缓存的字形位置，不分配内存
+     */
+    void addLayoutLine(const components::TextLayout& layout,
+                       const components::TextLayoutLine& line,
+                       const Eigen::Vector2f& pos,
+                       float boxWidth,
+                       const Eigen::Vector4f& color,
+                       policies::Alignment alignment,
+                       float opacity,
+                       float fontSize,
+                       core::RenderContext& context)
+    {
+        if (line.glyphCount == 0) return;
+
+        if (context.fontAtlas == nullptr || !context.fontAtlas->isLoaded())
+        {
+            // 回退：整串纹理按字符串缓存
+            addText(std::string(ui::utils::LineText(layout, line)),
+                    pos,
+                    {boxWidth, layout.lineHeight},
+                    color,
+                    alignment,
+                    opacity,
+                    fontSize,
+                    context);
+            return;
+        }
+
+        float drawX = pos.x();
+        const float lineWidth = std::ceil(line.width);
+        if (ui::utils::HasAlignment(alignment, policies::Alignment::HCENTER))
+        {
+            drawX += (boxWidth - lineWidth) * 0.5F;
+        }
+        else if (ui::utils::HasAlignment(alignment, policies::Alignment::RIGHT))
+        {
+            drawX += boxWidth - lineWidth;
+        }
+
+        // 对齐到整数像素
+        managers::TextRenderHelper atlasText(*context.fontAtlas);
+        atlasText.addGlyphs(*context.batchManager,
+                            ui::utils::LineGlyphs(layout, line),
+                            {std::round(drawX), std::round(pos.y())},
+                            color,
+                            opacity,
+                            fontSize,
+                            context.currentScissor);
+    }
 };
 
 } // namespace ui::renderers
@@ -11,6 +11,7 @@
   - 日志文件自动轮转，防止过大
   - 支持源码位置记录，便于调试
   - 线程安全的一次性初始化
+  - 默认异步写出（utils::AsyncLogSink），定义 PMK_SYNC_LOGGING 切回同步
  *
  * ************************************************************************
  * @copyright Copyright (c) 2026 AnakinLiu
@@ -34,6 +35,7 @@
 #include <string>
 #include <vector>
 #include "SingletonBase.hpp"
+#include "src/utils/AsyncLogSink.h"
 
 namespace ui
 {
@@ -97,21 +99,49 @@ public:
         getInstance().log_impl(spdlog::level::debug, msg, std::forward<Args>(args)...);
     }
 
+    /**
+     * @brief 等待已提交的日志全部写出并刷新（退出前调用）
+     */
+    static void flush()
+    {
+        auto& self = getInstance();
+        if (self.m_asyncSink)
+        {
+            self.m_asyncSink->drain();
+        }
+        else
+        {
+            self.m_logger->flush();
+        }
+    }
+
 private:
     Logger()
     {
+#if defined(PMK_SYNC_LOGGING)
+        using ConsoleSink = spdlog::sinks::stdout_color_sink_mt;
+        using FileSink = spdlog::sinks::rotating_file_sink_mt;
+#else
+        // 后端 sink 只由写线程访问，无需加锁
+        using ConsoleSink = spdlog::sinks::stdout_color_sink_st;
+        using FileSink = spdlog::sinks::rotating_file_sink_st;
+#endif
         // 1. 创建控制台 sink
-        auto consoleSink = std::make_shared<spdlog::sinks::stdout_color_sink_mt>();
+        auto consoleSink = std::make_shared<ConsoleSink>();
         consoleSink->set_pattern("%^[%T] [%l] %n: %v%$");
 
         // 2. 创建文件 sink
-        auto fileSink = std::make_shared<spdlog::sinks::rotating_file_sink_mt>(
-            "logs/pestmankill.log", MAX_LOG_FILE_SIZE, MAX_LOG_FILE_COUNT);
+        auto fileSink = std::make_shared<FileSink>("logs/pestmankill.log", MAX_LOG_FILE_SIZE, MAX_LOG_FILE_COUNT);
         fileSink->set_pattern("[%Y-%m-%d %H:%M:%S.%e] [%l] [%s:%# %!] %v");
 
         // 3. 创建 logger
         std::vector<spdlog::sink_ptr> sinks{consoleSink, fileSink};
+#if defined(PMK_SYNC_LOGGING)
         m_logger = std::make_shared<spdlog::logger>("PestManKill", sinks.begin(), sinks.end());
+#else
+        m_asyncSink = std::make_shared<::utils::AsyncLogSink>(std::move(sinks));
+        m_logger = std::make_shared<spdlog::logger>("PestManKill", m_asyncSink);
+#endif
 
         m_logger->set_level(spdlog::level::debug);
         m_logger->flush_on(spdlog::level::warn); // 警告及以上立即刷新
@@ -121,6 +151,10 @@ private:
     template <typename... Args>
     void log_impl(spdlog::level::level_enum lvl, const LogLocation& msg, Args&&... args)
     {
+        if (!m_logger->should_log(lvl))
+        {
+            return;
+        }
         m_logger->log(
             spdlog::source_loc{msg.loc.file_name(), static_cast<int>(msg.loc.line()), msg.loc.function_name()},
             lvl,
@@ -129,6 +163,7 @@ private:
     }
 
     std::shared_ptr<spdlog::logger> m_logger;
+    std::shared_ptr<::utils::AsyncLogSink> m_asyncSink; // 同步模式下为空
 };
 
 // 辅助工具：路径规范化
@@ -30,11 +30,13 @@ RenderSystem::RenderSystem()
     : m_deviceManager(std::make_unique<managers::DeviceManager>()),
       m_fontManager(std::make_unique<managers::FontManager>()),
       m_iconManager(std::make_unique<managers::IconManager>(m_deviceManager.get())), m_pipelineCache(nullptr),
-      m_textTextureCache(nullptr), m_batchManager(std::make_unique<managers::BatchManager>()), m_commandBuffer(nullptr)
+      m_textTextureCache(nullptr), m_fontAtlas(nullptr), m_batchManager(std::make_unique<managers::BatchManager>()),
+      m_commandBuffer(nullptr)
 {
     m_stats.frameCount = 0;
     m_stats.batchCount = 0;
-    m_stats.vertexCount = 0;
+    m_stats.batchCountBeforeOptimize = 0;
+    m_stats.instanceCount = 0;
 }
 
 RenderSystem::~RenderSystem()
@@ -46,7 +48,8 @@ RenderSystem::~RenderSystem()
 RenderSystem::RenderSystem(RenderSystem&& other) noexcept
     : m_deviceManager(std::move(other.m_deviceManager)), m_fontManager(std::move(other.m_fontManager)),
       m_iconManager(std::move(other.m_iconManager)), m_pipelineCache(std::move(other.m_pipelineCache)),
-      m_textTextureCache(std::move(other.m_textTextureCache)), m_batchManager(std::move(other.m_batchManager)),
+      m_textTextureCache(std::move(other.m_textTextureCache)), m_fontAtlas(std::move(other.m_fontAtlas)),
+      m_batchManager(std::move(other.m_batchManager)),
       m_commandBuffer(std::move(other.m_commandBuffer)), m_renderers(std::move(other.m_renderers)),
       m_stats(other.m_stats), m_whiteTexture(std::move(other.m_whiteTexture)), m_screenWidth(other.m_screenWidth),
       m_screenHeight(other.m_screenHeight)
@@ -66,6 +69,7 @@ RenderSystem& RenderSystem::operator=(RenderSystem&& other) noexcept
         m_iconManager = std::move(other.m_iconManager);
         m_pipelineCache = std::move(other.m_pipelineCache);
         m_textTextureCache = std::move(other.m_textTextureCache);
+        m_fontAtlas = std::move(other.m_fontAtlas);
         m_batchManager = std::move(other.m_batchManager);
         m_commandBuffer = std::move(other.m_commandBuffer);
         m_renderers = std::move(other.m_renderers);
@@ -135,6 +139,9 @@ void RenderSystem::cleanup()
     Logger::info("[RenderSystem] 等待 GPU 空闲...");
     SDL_WaitForGPUIdle(device);
 
+    // 缓存的几何引用即将释放的纹理
+    m_renderCaches.clear();
+
     if (m_textTextureCache)
     {
         Logger::info("[RenderSystem] 清理文本纹理缓存");
@@ -153,6 +160,7 @@ void RenderSystem::cleanup()
     m_batchManager.reset();
     m_pipelineCache.reset();
     m_textTextureCache.reset();
+    m_fontAtlas.reset();
     m_fontManager.reset();
     m_iconManager.reset();
 
@@ -249,7 +257,30 @@ void RenderSystem::update() noexcept
 
     m_stats.frameCount++;
     m_stats.batchCount = 0;
-    m_stats.vertexCount = 0;
+    m_stats.batchCountBeforeOptimize = 0;
+    m_stats.instanceCount = 0;
+    m_stats.regeneratedItems = 0;
+    m_stats.reusedItems = 0;
+    m_commandBuffer->resetUploadStats();
+
+    const ResourceVersion resourceVersion{.atlasGeneration = m_fontAtlas->getGeneration(),
+                                          .fontGeneration = m_fontManager->getFontGeneration(),
+                                          .textureEvictions = m_textTextureCache->getStats().evictionCount};
+    if (resourceVersion != m_resourceVersion)
+    {
+        m_resourceVersion = resourceVersion;
+        invalidateRenderCaches();
+    }
+
+    // 不经过脏标记直接修改组件的来源：插值动画改写位置、透明度与颜色，光标随时间闪烁
+    for (auto entity : Registry::View<components::AnimationTime>())
+    {
+        onRenderDirty(entity);
+    }
+    for (auto entity : Registry::View<components::FocusedTag>())
+    {
+        onLayoutDirty(entity);
+    }
 
     for (auto windowEntity : windowView)
     {
@@ -285,59 +316,118 @@ void RenderSystem::update() noexcept
         m_screenHeight = static_cast<float>(height);
 
         m_batchManager->clear();
-        m_renderQueue.clear();
-        m_submissionIndex = 0;
-
+        m_batchManager->setScreenSize(m_screenWidth, m_screenHeight);
+        // 矩形实例直接写入本次提交的上传缓冲区
+        m_batchManager->setInstanceStorage(m_commandBuffer->beginFrame());
+
+        // 整帧共用一个上下文，逐条记录填入位置、大小、透明度与裁剪区域
+        core::RenderContext itemContext;
+        itemContext.screenWidth = m_screenWidth;
+        itemContext.screenHeight = m_screenHeight;
+        itemContext.deviceManager = m_deviceManager.get();
+        itemContext.fontManager = m_fontManager.get();
+        itemContext.textTextureCache = m_textTextureCache.get();
+        itemContext.fontAtlas = m_fontAtlas.get();
+        itemContext.batchManager = m_batchManager.get();
+        itemContext.sdlWindow = sdlWindow;
+        itemContext.whiteTexture = m_whiteTexture.get();
+
+        auto& renderCache = m_renderCaches[windowEntity];
         if (Registry::AnyOf<components::VisibleTag>(windowEntity))
         {
-            core::RenderContext rootContext;
-            rootContext.screenWidth = m_screenWidth;
-            rootContext.screenHeight = m_screenHeight;
-            rootContext.deviceManager = m_deviceManager.get();
-            rootContext.fontManager = m_fontManager.get();
-            rootContext.textTextureCache = m_textTextureCache.get();
-            rootContext.batchManager = m_batchManager.get();
-            rootContext.sdlWindow = sdlWindow;
-            rootContext.whiteTexture = m_whiteTexture.get();
-
             Eigen::Vector2f rootOffset = Eigen::Vector2f(0, 0);
             if (const auto* pos = Registry::TryGet<components::Position>(windowEntity))
             {
                 rootOffset = -pos->value;
             }
 
-            rootContext.position = rootOffset;
-            rootContext.alpha = 1.0F;
-
-            collectRenderData(windowEntity, rootContext);
-        }
-
-        // Sort render queue by RenderKey (Z-Order primarily)
-        std::sort(m_renderQueue.begin(), m_renderQueue.end());
-
-        // Execute collected render commands
-        for (auto& item : m_renderQueue)
-        {
-            item.renderer->collect(item.entity, item.context);
+            const uint32_t atlasGeneration = m_fontAtlas->getGeneration();
+            renderCache.collect(windowEntity, rootOffset, m_renderers, itemContext);
+            if (m_fontAtlas->getGeneration() != atlasGeneration)
+            {
+                // 字形图集在收集过程中扩展，已写入与已缓存的字形 UV 失效，重新收集一次
+                m_resourceVersion.atlasGeneration = m_fontAtlas->getGeneration();
+                invalidateRenderCaches();
+                m_batchManager->clear();
+                m_batchManager->setScreenSize(m_screenWidth, m_screenHeight);
+                renderCache.collect(windowEntity, rootOffset, m_renderers, itemContext);
+            }
+            m_stats.regeneratedItems += renderCache.stats().regeneratedItems;
+            m_stats.reusedItems += renderCache.stats().reusedItems;
         }
+        m_fontAtlas->uploadPending();
 
         m_batchManager->optimize();
 
         const auto& batches = m_batchManager->getBatches();
-        if (!batches.empty())
-        {
-            m_commandBuffer->execute(sdlWindow, width, height, batches);
-            m_stats.batchCount += static_cast<uint32_t>(batches.size());
-            m_stats.vertexCount += static_cast<uint32_t>(m_batchManager->getTotalVertexCount());
-        }
+        m_commandBuffer->execute(sdlWindow, width, height, *m_batchManager);
+        m_stats.batchCount += static_cast<uint32_t>(batches.size());
+        m_stats.batchCountBeforeOptimize += static_cast<uint32_t>(m_batchManager->getCollectedBatchCount());
+        m_stats.instanceCount += static_cast<uint32_t>(m_batchManager->getInstanceCount());
+
+        // 上传缓冲区已解除映射
+        m_batchManager->setInstanceStorage(nullptr);
     }
 
+    m_stats.uploadedBytes = m_commandBuffer->getUploadStats().uploadedBytes;
+    m_stats.bufferAllocations = m_commandBuffer->getUploadStats().bufferAllocations;
+
     auto dirtyView = Registry::View<components::RenderDirtyTag>();
     for (auto entity : dirtyView)
     {
         Registry::Remove<components::RenderDirtyTag>(entity);
     }
 }
+
+void RenderSystem::onRenderDirty(entt::entity entity)
+{
+    // MarkRenderDirty 同时标记所属窗口，窗口本身只需重新生成自己的背景
+    const bool isWindow = Registry::AnyOf<components::WindowTag, components::DialogTag>(entity);
+    for (auto& [window, cache] : m_renderCaches)
+    {
+        if (isWindow)
+        {
+            cache.markGeometryDirty(entity);
+        }
+        else
+        {
+            cache.markDirty(entity);
+        }
+    }
+}
+
+void RenderSystem::onLayoutDirty(entt::entity entity)
+{
+    // 文本等内容变化只标记布局；位置与尺寸的变化由布局系统另行标记渲染脏
+    for (auto& [window, cache] : m_renderCaches)
+    {
+        cache.markGeometryDirty(entity);
+    }
+}
+
+void RenderSystem::onStructureChanged([[maybe_unused]] entt::entity entity)
+{
+    // 与 HitTestSystem 相同，结构变化可能涉及多个窗口，全部重建
+    for (auto& [window, cache] : m_renderCaches)
+    {
+        cache.markStructureChanged();
+    }
+}
+
+void RenderSystem::onHierarchyDestroyed(entt::entity entity)
+{
+    m_renderCaches.erase(entity);
+    onStructureChanged(entity);
+}
+
+void RenderSystem::invalidateRenderCaches()
+{
+    for (auto& [window, cache] : m_renderCaches)
+    {
+        cache.invalidate();
+    }
+}
+
 /**
  * @brief 确保渲染系统已初始化
  */
@@ -378,6 +468,11 @@ void RenderSystem::ensureInitialized()
         m_textTextureCache = std::make_unique<managers::TextTextureCache>(*m_deviceManager, *m_fontManager);
     }
 
+    if (m_fontAtlas == nullptr)
+    {
+        m_fontAtlas = std::make_unique<managers::FontAtlasManager>(*m_deviceManager, *m_fontManager);
+    }
+
     if (m_iconManager)
     {
         static bool iconsLoaded = false;
@@ -445,103 +540,4 @@ void RenderSystem::initializeRenderers()
     Logger::info("[RenderSystem] 初始化了 {} 个渲染器", m_renderers.size());
 }
 
-void RenderSystem::collectRenderData(entt::entity entity, core::RenderContext& context)
-{
-    if (!Registry::AnyOf<components::VisibleTag>(entity)) return;
-    if (Registry::AnyOf<components::SpacerTag>(entity)) return;
-
-    const auto& pos = Registry::Get<components::Position>(entity);
-    const auto& size = Registry::Get<components::Size>(entity);
-    const auto* alphaComp = Registry::TryGet<components::Alpha>(entity);
-    const auto* scaleComp = Registry::TryGet<components::Scale>(entity);
-    const auto* offsetComp = Registry::TryGet<components::RenderOffset>(entity);
-
-    float globalAlpha = context.alpha * (alphaComp != nullptr ? alphaComp->value : 1.0F);
-    Eigen::Vector2f absolutePos = context.position + pos.value;
-    Eigen::Vector2f finalSize = size.size;
-
-    // 应用渲染偏移
-    if (offsetComp != nullptr)
-    {
-        absolutePos += offsetComp->value;
-    }
-
-    // 应用缩放（基于中心点）
-    if (scaleComp != nullptr)
-    {
-        Eigen::Vector2f scaleDiff = size.size.cwiseProduct(Eigen::Vector2f::Ones() - scaleComp->value);
-        absolutePos += scaleDiff * 0.5F;
-        finalSize = size.size.cwiseProduct(scaleComp->value);
-    }
-
-    Eigen::Vector2f contentOffset(0.0F, 0.0F);
-
-    // 更新上下文
-    core::RenderContext entityContext = context;
-    entityContext.position = absolutePos;
-    entityContext.size = finalSize;
-    entityContext.alpha = globalAlpha;
-
-    // 处理 ScrollArea
-    const auto* scrollArea = Registry::TryGet<components::ScrollArea>(entity);
-    bool pushScissor = false;
-    if (scrollArea != nullptr)
-    {
-        SDL_Rect currentScissor;
-        currentScissor.x = static_cast<int>(absolutePos.x());
-        currentScissor.y = static_cast<int>(absolutePos.y());
-        currentScissor.w = static_cast<int>(size.size.x());
-        currentScissor.h = static_cast<int>(size.size.y());
-
-        entityContext.pushScissor(currentScissor);
-        pushScissor = true;
-        contentOffset = -scrollArea->scrollOffset;
-    }
-
-    // Determine Z-Order
-    int32_t zOrder = 0;
-    if (const auto* zOrderComp = Registry::TryGet<components::ZOrderIndex>(entity))
-    {
-        zOrder = zOrderComp->value;
-    }
-
-    // Shift to positive range for unsigned sorting (int32_min -> 0)
-    auto encodedZ = static_cast<uint64_t>(static_cast<int64_t>(zOrder) + 2147483648LL);
-
-    // 使用渲染器收集数据
-    for (auto& renderer : m_renderers)
-    {
-        if (renderer->canHandle(entity))
-        {
-            RenderItem item;
-            item.entity = entity;
-            item.renderer = renderer.get();
-            item.context = entityContext;
-
-            // Build Key: High=Z, Low=Order
-            item.sortKey = (encodedZ << 32) | (m_submissionIndex & 0xFFFFFFFF);
-
-            m_renderQueue.push_back(item);
-            m_submissionIndex++;
-        }
-    }
-
-    // 递归处理子元素
-    const auto* hierarchy = Registry::TryGet<components::Hierarchy>(entity);
-    if (hierarchy != nullptr && !hierarchy->children.empty())
-    {
-        for (entt::entity child : hierarchy->children)
-        {
-            core::RenderContext childContext = entityContext;
-            childContext.position = absolutePos + contentOffset;
-            collectRenderData(child, childContext);
-        }
-    }
-
-    if (pushScissor)
-    {
-        entityContext.popScissor();
-    }
-}
-
 } // namespace ui::systems
@@ -21,6 +21,7 @@
 
 #pragma once
 #include <memory>
+#include <unordered_map>
 #include <vector>
 #include <SDL3/SDL.h>
 #include <SDL3/SDL_gpu.h>
@@ -38,10 +39,12 @@
 #include "../common/GPUWrappers.hpp"
 #include "../managers/PipelineCache.hpp"
 #include "../managers/TextTextureCache.hpp"
+#include "../managers/FontAtlasManager.hpp"
 #include "../managers/BatchManager.hpp"
 #include "../managers/CommandBuffer.hpp"
 #include "../interface/IRenderer.hpp"
 #include "../core/RenderContext.hpp"
+#include "../core/RenderCache.hpp"
 
 CMRC_DECLARE(ui_fonts);
 CMRC_DECLARE(ui_icons);
@@ -71,9 +74,14 @@ public:
     struct RenderStats
     {
         uint64_t frameCount = 0;
-        uint32_t batchCount = 0;
-        uint32_t vertexCount = 0;
+        uint32_t batchCount = 0;               // optimize 之后提交的批次数
+        uint32_t batchCountBeforeOptimize = 0; // optimize 之前收集到的批次数
+        uint32_t instanceCount = 0;            // 矩形实例数
         uint32_t textureCount = 0;
+        uint32_t regeneratedItems = 0;  // 重新生成几何的渲染记录数
+        uint32_t reusedItems = 0;       // 回放缓存几何的渲染记录数
+        uint64_t uploadedBytes = 0;     // 上传到 GPU 的实例字节数
+        uint32_t bufferAllocations = 0; // 创建或扩容的传输 / 实例缓冲区个数
         float lastFrameTime = 0.0F;
     };
 
@@ -87,6 +95,16 @@ public:
         Dispatcher::Sink<events::WindowGraphicsContextUnsetEvent>()
             .connect<&RenderSystem::onWindowsGraphicsContextUnset>(*this);
         Dispatcher::Sink<events::UpdateRendering>().connect<&RenderSystem::update>(*this);
+
+        // 渲染缓存失效：脏标记只重新生成对应实体，结构变化重建渲染队列
+        Registry::OnConstruct<components::RenderDirtyTag>().connect<&RenderSystem::onRenderDirty>(*this);
+        Registry::OnUpdate<components::RenderDirtyTag>().connect<&RenderSystem::onRenderDirty>(*this);
+        Registry::OnConstruct<components::LayoutDirtyTag>().connect<&RenderSystem::onLayoutDirty>(*this);
+        Registry::OnUpdate<components::LayoutDirtyTag>().connect<&RenderSystem::onLayoutDirty>(*this);
+        Registry::OnUpdate<components::Hierarchy>().connect<&RenderSystem::onStructureChanged>(*this);
+        Registry::OnUpdate<components::ZOrderIndex>().connect<&RenderSystem::onStructureChanged>(*this);
+        Registry::OnDestroy<components::Hierarchy>().connect<&RenderSystem::onHierarchyDestroyed>(*this);
+        connectStructureHooks<RenderStructureComponents>(true);
         Logger::info("[RenderSystem] Event handlers registered successfully");
     }
 
@@ -97,25 +115,65 @@ public:
         Dispatcher::Sink<events::WindowGraphicsContextUnsetEvent>()
             .disconnect<&RenderSystem::onWindowsGraphicsContextUnset>(*this);
         Dispatcher::Sink<events::UpdateRendering>().disconnect<&RenderSystem::update>(*this);
+
+        Registry::OnConstruct<components::RenderDirtyTag>().disconnect<&RenderSystem::onRenderDirty>(*this);
+        Registry::OnUpdate<components::RenderDirtyTag>().disconnect<&RenderSystem::onRenderDirty>(*this);
+        Registry::OnConstruct<components::LayoutDirtyTag>().disconnect<&RenderSystem::onLayoutDirty>(*this);
+        Registry::OnUpdate<components::LayoutDirtyTag>().disconnect<&RenderSystem::onLayoutDirty>(*this);
+        Registry::OnUpdate<components::Hierarchy>().disconnect<&RenderSystem::onStructureChanged>(*this);
+        Registry::OnUpdate<components::ZOrderIndex>().disconnect<&RenderSystem::onStructureChanged>(*this);
+        Registry::OnDestroy<components::Hierarchy>().disconnect<&RenderSystem::onHierarchyDestroyed>(*this);
+        connectStructureHooks<RenderStructureComponents>(false);
     }
 
 private:
+    /**
+     * @brief 增删时改变渲染队列的组件：树结构、显隐、Z 序，以及决定由哪些渲染器处理的组件
+     */
+    using RenderStructureComponents = entt::type_list<components::Hierarchy,
+                                                      components::VisibleTag,
+                                                      components::SpacerTag,
+                                                      components::ZOrderIndex,
+                                                      components::ScrollArea,
+                                                      components::Background,
+                                                      components::Border,
+                                                      components::Icon,
+                                                      components::ProgressBar,
+                                                      components::SliderInfo,
+                                                      components::TextTag,
+                                                      components::ButtonTag,
+                                                      components::LabelTag,
+                                                      components::TextEditTag>;
+
+    template <typename TypeList>
+    void connectStructureHooks(bool connect)
+    {
+        [this, connect]<typename... Types>(entt::type_list<Types...>)
+        {
+            if (connect)
+            {
+                (Registry::OnConstruct<Types>().template connect<&RenderSystem::onStructureChanged>(*this), ...);
+                (Registry::OnDestroy<Types>().template connect<&RenderSystem::onStructureChanged>(*this), ...);
+            }
+            else
+            {
+                (Registry::OnConstruct<Types>().template disconnect<&RenderSystem::onStructureChanged>(*this), ...);
+                (Registry::OnDestroy<Types>().template disconnect<&RenderSystem::onStructureChanged>(*this), ...);
+            }
+        }(TypeList{});
+    }
+
+    void onRenderDirty(entt::entity entity);
+    void onLayoutDirty(entt::entity entity);
+    void onStructureChanged(entt::entity entity);
+    void onHierarchyDestroyed(entt::entity entity);
+    void invalidateRenderCaches();
+
     void onWindowsGraphicsContextSet(const events::WindowGraphicsContextSetEvent& event);
     void onWindowsGraphicsContextUnset(const events::WindowGraphicsContextUnsetEvent& event);
     void cleanup();
     void createWhiteTexture();
 
-    struct RenderItem
-    {
-        uint64_t sortKey = 0; // Sort key for rendering order
-        entt::entity entity = entt::null;
-        core::IRenderer* renderer = nullptr;
-        core::RenderContext context;
-
-        // Custom comparator for sorting
-        bool operator<(const RenderItem& other) const { return sortKey < other.sortKey; }
-    };
-
 public:
     void update() noexcept;
 
@@ -123,32 +181,33 @@ private:
     void ensureInitialized();
     void initializeRenderers();
 
-    /**
-     * @brief 递归收集渲染数据
-     * @param entity 当前实体
-     * @param context 渲染上下文
-     */
-    void collectRenderData(entt::entity entity, core::RenderContext& context);
-
-    /**
-     * @brief 收集实体背景的渲染数据
-     */
-    void collectBackgroundData(entt::entity entity, core::RenderContext& context);
-
     std::unique_ptr<managers::DeviceManager> m_deviceManager;
     std::unique_ptr<managers::FontManager> m_fontManager;
     std::unique_ptr<managers::IconManager> m_iconManager;
     std::unique_ptr<managers::PipelineCache> m_pipelineCache;
     std::unique_ptr<managers::TextTextureCache> m_textTextureCache;
+    std::unique_ptr<managers::FontAtlasManager> m_fontAtlas; // 引用 m_fontManager，先于其释放
     std::unique_ptr<managers::BatchManager> m_batchManager;
     std::unique_ptr<managers::CommandBuffer> m_commandBuffer;
 
     // 渲染器列表
     std::vector<std::unique_ptr<core::IRenderer>> m_renderers;
 
-    // 渲染队列
-    std::vector<RenderItem> m_renderQueue;
-    uint32_t m_submissionIndex = 0; // Ensures stability for same Z-order items
+    // 保留模式渲染缓存（渲染队列与每条记录的几何），每个窗口一份
+    std::unordered_map<entt::entity, core::RenderCache> m_renderCaches;
+
+    /**
+     * @brief 缓存几何引用的纹理与 UV 的来源，任一项变化时全部缓存失效
+     */
+    struct ResourceVersion
+    {
+        uint32_t atlasGeneration = 0;
+        uint32_t fontGeneration = 0;
+        size_t textureEvictions = 0;
+
+        bool operator==(const ResourceVersion&) const = default;
+    };
+    ResourceVersion m_resourceVersion;
 
     RenderStats m_stats;
     wrappers::UniqueGPUTexture m_whiteTexture;
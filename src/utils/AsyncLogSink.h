@@ -0,0 +1,326 @@
+#pragma once
+
+#include <spdlog/details/log_msg.h>
+#include <spdlog/pattern_formatter.h>
+#include <spdlog/sinks/sink.h>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "MpmcQueue.h"
+
+namespace utils
+{
+constexpr std::size_t ASYNC_LOG_QUEUE_SIZE = 4096;   // 队列槽位数，向上取整为 2 的幂
+constexpr std::size_t ASYNC_LOG_PAYLOAD_SIZE = 480;  // 单条消息内联存储上限，超出部分截断并计数
+constexpr std::size_t ASYNC_LOG_NAME_SIZE = 31;      // 日志器名称内联存储上限
+
+/**
+ * @brief 异步日志 sink：调用线程只把已格式化的消息拷入无锁环形队列，
+ *        由后台写线程统一做 pattern 格式化与文件/控制台 I/O
+ *
+ * - 队列为有界 utils::MpmcQueue（仅写线程消费），写入不加锁、不分配内存
+ * - 队列满时丢弃新消息并计数，不阻塞游戏 tick；超长消息截断并计数，两者都由写线程补记一条警告
+ * - 写线程排空队列后在条件变量上休眠，生产者只在写线程休眠时才加锁唤醒
+ * - 后端 sink 由 m_backendMutex 保护：写线程写出时持有，set_pattern/set_formatter 同样加锁，
+ *   后端本身可直接使用 *_st 版本
+ * - 文件名/函数名按指针保存，调用方须传入静态字符串（__FILE__、编译期裁剪的路径等）
+ */
+class AsyncLogSink final : public spdlog::sinks::sink
+{
+public:
+    explicit AsyncLogSink(std::vector<spdlog::sink_ptr> backends, std::size_t capacity = ASYNC_LOG_QUEUE_SIZE)
+        : m_backends(std::move(backends)), m_queue(capacity)
+    {
+        m_writer = std::thread([this] { writerLoop(); });
+    }
+
+    AsyncLogSink(const AsyncLogSink&) = delete;
+    AsyncLogSink& operator=(const AsyncLogSink&) = delete;
+    AsyncLogSink(AsyncLogSink&&) = delete;
+    AsyncLogSink& operator=(AsyncLogSink&&) = delete;
+
+    ~AsyncLogSink() override
+    {
+        m_running.store(false, std::memory_order_release);
+        wake();
+        if (m_writer.joinable())
+        {
+            m_writer.join();
+        }
+    }
+
+    /**
+     * @brief 生产者：消息直接构造进队列槽位（无锁，队列满时丢弃）
+     */
+    void log(const spdlog::details::log_msg& msg) override
+    {
+        if (!m_queue.tryPush(msg))
+        {
+            m_dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        if (msg.payload.size() > ASYNC_LOG_PAYLOAD_SIZE)
+        {
+            m_truncated.fetch_add(1, std::memory_order_relaxed);
+        }
+        wakeIfSleeping();
+    }
+
+    /**
+     * @brief 请求写线程刷新（不阻塞调用方）
+     */
+    void flush() override
+    {
+        m_flushRequests.fetch_add(1, std::memory_order_release);
+        wakeIfSleeping();
+    }
+
+    void set_pattern(const std::string& pattern) override
+    {
+        std::lock_guard lock(m_backendMutex);
+        for (auto& backend : m_backends)
+        {
+            backend->set_pattern(pattern);
+        }
+    }
+
+    void set_formatter(std::unique_ptr<spdlog::formatter> sinkFormatter) override
+    {
+        std::lock_guard lock(m_backendMutex);
+        for (auto& backend : m_backends)
+        {
+            backend->set_formatter(sinkFormatter->clone());
+        }
+    }
+
+    /**
+     * @brief 阻塞等待队列中已提交的消息全部写出并刷新
+     * @note 写线程已停止时立即返回，不再等待
+     */
+    void drain()
+    {
+        const uint64_t request = m_flushRequests.fetch_add(1, std::memory_order_acq_rel) + 1;
+        wake();
+        std::unique_lock lock(m_wakeMutex);
+        m_drained.wait(lock,
+                       [&]
+                       {
+                           return m_flushedRequests.load(std::memory_order_acquire) >= request ||
+                                  !m_writerAlive.load(std::memory_order_acquire);
+                       });
+    }
+
+    [[nodiscard]] uint64_t dropped() const { return m_dropped.load(std::memory_order_relaxed); }
+    [[nodiscard]] uint64_t truncated() const { return m_truncated.load(std::memory_order_relaxed); }
+
+private:
+    struct Record
+    {
+        Record() = default;
+        explicit Record(const spdlog::details::log_msg& msg)
+            : time(msg.time), threadId(msg.thread_id), source(msg.source), level(msg.level),
+              nameSize(copyTruncated(name, msg.logger_name)), payloadSize(copyTruncated(payload, msg.payload))
+        {
+        }
+
+        spdlog::log_clock::time_point time;
+        std::size_t threadId = 0;
+        spdlog::source_loc source;
+        spdlog::level::level_enum level = spdlog::level::info;
+        // 缓冲区声明在长度之前，构造时先于 nameSize/payloadSize 就绪；不清零，只读取有效长度
+        std::array<char, ASYNC_LOG_NAME_SIZE> name;
+        std::array<char, ASYNC_LOG_PAYLOAD_SIZE> payload;
+        uint16_t nameSize = 0;
+        uint16_t payloadSize = 0;
+    };
+
+    /**
+     * @brief 拷贝并在必要时截断，截断点回退到 UTF-8 字符边界
+     */
+    template <std::size_t N>
+    static uint16_t copyTruncated(std::array<char, N>& out, spdlog::string_view_t text)
+    {
+        std::size_t size = std::min(text.size(), N);
+        if (size < text.size())
+        {
+            while (size > 0 && (static_cast<unsigned char>(text.data()[size]) & 0xC0U) == 0x80U)
+            {
+                --size;
+            }
+        }
+        std::memcpy(out.data(), text.data(), size);
+        return static_cast<uint16_t>(size);
+    }
+
+    /**
+     * @brief 消费者：取出一条消息并写到所有后端
+     * @return 队列为空时返回 false
+     */
+    bool writeOne()
+    {
+        if (!m_queue.tryPop(m_record))
+        {
+            return false;
+        }
+        const auto& record = m_record;
+        spdlog::details::log_msg msg(record.time,
+                                     record.source,
+                                     spdlog::string_view_t(record.name.data(), record.nameSize),
+                                     record.level,
+                                     spdlog::string_view_t(record.payload.data(), record.payloadSize));
+        msg.thread_id = record.threadId;
+        writeToBackends(msg);
+        return true;
+    }
+
+    void writeToBackends(const spdlog::details::log_msg& msg)
+    {
+        for (auto& backend : m_backends)
+        {
+            if (backend->should_log(msg.level))
+            {
+                backend->log(msg);
+            }
+        }
+        m_dirty = true;
+    }
+
+    /**
+     * @brief 补记上次报告之后新增的丢弃/截断条数
+     */
+    void reportLosses()
+    {
+        const uint64_t dropped = m_dropped.load(std::memory_order_relaxed);
+        if (dropped != m_reportedDropped)
+        {
+            std::string text = "async log queue overflow, dropped " + std::to_string(dropped - m_reportedDropped) +
+                               " messages";
+            m_reportedDropped = dropped;
+            writeToBackends(spdlog::details::log_msg(spdlog::string_view_t{}, spdlog::level::warn, text));
+        }
+        const uint64_t truncated = m_truncated.load(std::memory_order_relaxed);
+        if (truncated != m_reportedTruncated)
+        {
+            std::string text = "async log truncated " + std::to_string(truncated - m_reportedTruncated) +
+                               " messages longer than " + std::to_string(ASYNC_LOG_PAYLOAD_SIZE) + " bytes";
+            m_reportedTruncated = truncated;
+            writeToBackends(spdlog::details::log_msg(spdlog::string_view_t{}, spdlog::level::warn, text));
+        }
+    }
+
+    void flushBackends()
+    {
+        for (auto& backend : m_backends)
+        {
+            backend->flush();
+        }
+        m_dirty = false;
+    }
+
+    /**
+     * @brief 生产者一侧：写线程在休眠时才加锁唤醒
+     *
+     * 与 sleepUntilWork() 构成 Dekker 式握手：两边各自先写自己的标记、经 seq_cst 栅栏后再读对方，
+     * 至少有一方能看到对方的写入，因此不会出现消息已入队而写线程仍在休眠的情况
+     */
+    void wakeIfSleeping()
+    {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (m_sleeping.load(std::memory_order_relaxed))
+        {
+            wake();
+        }
+    }
+
+    void wake()
+    {
+        {
+            std::lock_guard lock(m_wakeMutex);
+            m_sleeping.store(false, std::memory_order_relaxed);
+        }
+        m_wakeup.notify_one();
+    }
+
+    /**
+     * @brief 写线程一侧：队列为空且没有未完成的请求时休眠，直到被唤醒
+     */
+    void sleepUntilWork(uint64_t flushedRequests)
+    {
+        m_sleeping.store(true, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        std::unique_lock lock(m_wakeMutex);
+        if (!m_queue.empty() || m_flushRequests.load(std::memory_order_relaxed) != flushedRequests ||
+            !m_running.load(std::memory_order_relaxed))
+        {
+            m_sleeping.store(false, std::memory_order_relaxed);
+            return;
+        }
+        m_wakeup.wait(lock, [this] { return !m_sleeping.load(std::memory_order_relaxed); });
+    }
+
+    void writerLoop()
+    {
+        for (;;)
+        {
+            const bool running = m_running.load(std::memory_order_acquire);
+            // 先读取请求序号：在此之前提交的消息都会在本轮写出
+            const uint64_t requests = m_flushRequests.load(std::memory_order_acquire);
+            bool completed = false;
+            {
+                std::lock_guard lock(m_backendMutex);
+                while (writeOne())
+                {
+                }
+                reportLosses();
+                // 队列排空后统一刷新，flush_on 之类的请求在此合并处理
+                if (m_dirty || requests != m_flushedRequests.load(std::memory_order_relaxed))
+                {
+                    flushBackends();
+                    completed = requests != m_flushedRequests.load(std::memory_order_relaxed);
+                }
+            }
+            if (completed || !running)
+            {
+                {
+                    std::lock_guard lock(m_wakeMutex);
+                    m_flushedRequests.store(requests, std::memory_order_release);
+                    m_writerAlive.store(running, std::memory_order_release);
+                }
+                m_drained.notify_all();
+            }
+            if (!running)
+            {
+                return;
+            }
+            sleepUntilWork(requests);
+        }
+    }
+
+    std::mutex m_backendMutex; // 保护 m_backends 中各后端的格式与写出
+    std::vector<spdlog::sink_ptr> m_backends;
+    MpmcQueue<Record> m_queue;
+    Record m_record; // 写线程取出的当前消息，仅写线程访问
+    std::atomic<uint64_t> m_dropped{0};
+    std::atomic<uint64_t> m_truncated{0};
+    std::atomic<uint64_t> m_flushRequests{0};   // flush()/drain() 请求序号
+    std::atomic<uint64_t> m_flushedRequests{0}; // 写线程已完成的请求序号
+    std::atomic<bool> m_running{true};
+    std::atomic<bool> m_writerAlive{true}; // 写线程退出后 drain() 不再等待
+    std::atomic<bool> m_sleeping{false};   // 写线程正在（或即将）在 m_wakeup 上休眠
+    std::mutex m_wakeMutex;
+    std::condition_variable m_wakeup;  // 唤醒写线程：新消息、刷新请求、析构
+    std::condition_variable m_drained; // 通知 drain()：请求已完成或写线程已退出
+    uint64_t m_reportedDropped = 0;        // 仅写线程访问
+    uint64_t m_reportedTruncated = 0;      // 仅写线程访问
+    bool m_dirty = false;           // 仅写线程访问
+    std::thread m_writer;
+};
+} // namespace utils
@@ -4,10 +4,12 @@
 #include <spdlog/spdlog.h>
 #include <spdlog/sinks/stdout_color_sinks.h>
 #include <spdlog/sinks/rotating_file_sink.h>
+#include <array>
 #include <memory>
-#include <mutex> // 引入 <mutex>
 #include <source_location>
 #include <string>
+#include <string_view>
+#include "AsyncLogSink.h"
 
 namespace utils
 {
@@ -16,35 +18,31 @@ class Logger
     static constexpr size_t MAX_LOG_FILE_SIZE = static_cast<size_t>(1024 * 1024 * 5); // 5MB
     static constexpr size_t MAX_LOG_FILE_COUNT = 1;                                   // 仅保留 1 个日志文件
 public:
+    /**
+     * @brief 获取全局日志器
+     *
+     * 默认为异步模式：调用线程只做格式化并写入无锁队列，I/O 由后台线程完成；
+     * 定义 PMK_SYNC_LOGGING 可切回同步写出（便于调试崩溃前的最后几条日志）
+     */
     static std::shared_ptr<spdlog::logger>& getLogger()
     {
-        static std::shared_ptr<spdlog::logger> logger;
-        static std::once_flag flag; // 用于一次性初始化
-
-        std::call_once(flag,
-                       [&]()
-                       {
-                           // 1. 创建控制台 sink (stdout_color_mt)
-                           auto consoleSink = std::make_shared<spdlog::sinks::stdout_color_sink_mt>();
-                           consoleSink->set_pattern("%^[%T] [%l] %n: %v%$"); // 可选：设置控制台输出格式
-
-                           // 2. 创建文件 sink (rotating_file_sink_mt)
-                           auto fileSink = std::make_shared<spdlog::sinks::rotating_file_sink_mt>(
-                               "logs/pestmankill.log", MAX_LOG_FILE_SIZE, MAX_LOG_FILE_COUNT);
-                           fileSink->set_pattern("[%Y-%m-%d %H:%M:%S.%e] [%l] [%s:%# %!] %v"); // 可选：设置文件输出格式
-
-                           // 3. 创建 logger
-                           std::vector<spdlog::sink_ptr> sinks{consoleSink, fileSink};
-                           logger = std::make_shared<spdlog::logger>("PestManKill", begin(sinks), end(sinks));
-
-                           // 可选：设置日志级别
-                           logger->set_level(spdlog::level::debug);
-                           // 可选：当日志器满了时异步刷新
-                           // spdlog::flush_every(std::chrono::seconds(3));
-                       });
-
+        static std::shared_ptr<spdlog::logger> logger = createLogger();
         return logger;
     }
+
+    /**
+     * @brief 等待已提交的日志全部写出并刷新
+     */
+    static void flush()
+    {
+#if defined(PMK_SYNC_LOGGING)
+        getLogger()->flush();
+#else
+        getLogger(); // 确保 sink 已创建
+        asyncSink()->drain();
+#endif
+    }
+
     template <typename... Args>
     static void warn(spdlog::format_string_t<Args...> fmt,
                      Args&&... args,
@@ -63,54 +61,128 @@ public:
 private:
     Logger() = default;
     ~Logger() = default;
+
+#if defined(PMK_SYNC_LOGGING)
+    using ConsoleSink = spdlog::sinks::stdout_color_sink_mt;
+    using FileSink = spdlog::sinks::rotating_file_sink_mt;
+#else
+    // 后端 sink 只在 AsyncLogSink 的锁内访问，无需自带锁
+    using ConsoleSink = spdlog::sinks::stdout_color_sink_st;
+    using FileSink = spdlog::sinks::rotating_file_sink_st;
+
+    static std::shared_ptr<AsyncLogSink>& asyncSink()
+    {
+        static std::shared_ptr<AsyncLogSink> sink;
+        return sink;
+    }
+#endif
+
+    static std::shared_ptr<spdlog::logger> createLogger()
+    {
+        // 1. 创建控制台 sink
+        auto consoleSink = std::make_shared<ConsoleSink>();
+        consoleSink->set_pattern("%^[%T] [%l] [%s:%#] %v%$");
+
+        // 2. 创建文件 sink
+        auto fileSink = std::make_shared<FileSink>("logs/pestmankill.log", MAX_LOG_FILE_SIZE, MAX_LOG_FILE_COUNT);
+        fileSink->set_pattern("[%Y-%m-%d %H:%M:%S.%e] [%l] [%s:%# %!] %v");
+
+        // 3. 创建 logger
+        std::vector<spdlog::sink_ptr> sinks{consoleSink, fileSink};
+#if defined(PMK_SYNC_LOGGING)
+        auto logger = std::make_shared<spdlog::logger>("PestManKill", begin(sinks), end(sinks));
+#else
+        asyncSink() = std::make_shared<AsyncLogSink>(std::move(sinks));
+        auto logger = std::make_shared<spdlog::logger>("PestManKill", asyncSink());
+#endif
+        logger->set_level(spdlog::level::debug);
+        return logger;
+    }
 };
 
-inline std::string normalizePath(const char* path)
+namespace detail
+{
+/**
+ * @brief 编译期裁剪源文件路径：去掉 src/ 或 tests/ 之前的部分并统一为 '/'
+ */
+template <std::size_t N>
+consteval std::array<char, N> TrimSourcePath(const char (&path)[N])
 {
-    std::string result = path ? path : "";
-    for (auto& ch : result)
+    auto isSeparator = [](char ch) { return ch == '/' || ch == '\\'; };
+    auto startsWith = [&](std::size_t pos, std::string_view dir)
     {
-        if (ch == '\\') ch = '/';
+        if (pos + dir.size() >= N || (pos != 0 && !isSeparator(path[pos - 1])))
+        {
+            return false;
+        }
+        for (std::size_t index = 0; index < dir.size(); ++index)
+        {
+            if (path[pos + index] != dir[index])
+            {
+                return false;
+            }
+        }
+        return isSeparator(path[pos + dir.size()]);
+    };
+
+    std::size_t start = 0;
+    for (std::size_t pos = 0; pos < N; ++pos)
+    {
+        if (startsWith(pos, "src") || startsWith(pos, "tests"))
+        {
+            start = pos;
+        }
+    }
+    std::array<char, N> result{};
+    for (std::size_t index = start; index < N && path[index] != '\0'; ++index)
+    {
+        result[index - start] = isSeparator(path[index]) ? '/' : path[index];
     }
     return result;
 }
-
+} // namespace detail
 } // namespace utils
 
+/**
+ * @brief 调用处源文件的相对路径（编译期计算，运行时零开销）
+ */
+#define PMK_SOURCE_FILE()                                                                                              \
+    ([]() -> const char*                                                                                               \
+     {                                                                                                                 \
+         static constexpr auto PMK_TRIMMED_PATH = ::utils::detail::TrimSourcePath(__FILE__);                           \
+         return PMK_TRIMMED_PATH.data();                                                                               \
+     }())
+
+/**
+ * @brief 先判断级别再格式化：级别被过滤时参数不会被求值
+ */
+#define PMK_LOG_AT(level, fmt, ...)                                                                                    \
+    do                                                                                                                 \
+    {                                                                                                                  \
+        auto& pmkLogger = ::utils::Logger::getLogger();                                                                \
+        if (pmkLogger->should_log(level))                                                                              \
+        {                                                                                                              \
+            pmkLogger->log(::spdlog::source_loc{PMK_SOURCE_FILE(), __LINE__, SPDLOG_FUNCTION},                         \
+                           level,                                                                                      \
+                           fmt,                                                                                        \
+                           ##__VA_ARGS__);                                                                             \
+        }                                                                                                              \
+    } while (0)
+
 // ----------------- 宏包裹日志 -----------------
 #ifdef LOG_INFO
 #undef LOG_INFO
 #endif
-#define LOG_INFO(fmt, ...)                                                                                             \
-    utils::Logger::getLogger()->info("[{}:{} {}] " fmt,                                                                \
-                                     utils::normalizePath(std::source_location::current().file_name()),                \
-                                     std::source_location::current().line(),                                           \
-                                     std::source_location::current().function_name(),                                  \
-                                     ##__VA_ARGS__)
+#define LOG_INFO(fmt, ...) PMK_LOG_AT(::spdlog::level::info, fmt, ##__VA_ARGS__)
 #ifdef LOG_WARN
 #undef LOG_WARN
 #endif
-#define LOG_WARN(fmt, ...)                                                                                             \
-    utils::Logger::getLogger()->warn("[{}:{} {}] " fmt,                                                                \
-                                     utils::normalizePath(std::source_location::current().file_name()),                \
-                                     std::source_location::current().line(),                                           \
-                                     std::source_location::current().function_name(),                                  \
-                                     ##__VA_ARGS__)
+#define LOG_WARN(fmt, ...) PMK_LOG_AT(::spdlog::level::warn, fmt, ##__VA_ARGS__)
 #ifdef LOG_ERROR
 #undef LOG_ERROR
 #endif
-#define LOG_ERROR(fmt, ...)                                                                                            \
-    utils::Logger::getLogger()->error("[{}:{} {}] " fmt,                                                               \
-                                      utils::normalizePath(std::source_location::current().file_name()),               \
-                                      std::source_location::current().line(),                                          \
-                                      std::source_location::current().function_name(),                                 \
-                                      ##__VA_ARGS__)
+#define LOG_ERROR(fmt, ...) PMK_LOG_AT(::spdlog::level::err, fmt, ##__VA_ARGS__)
 #ifdef LOG_DEBUG
 #undef LOG_DEBUG
 #endif
-#define LOG_DEBUG(fmt, ...)                                                                                            \
-    utils::Logger::getLogger()->debug("[{}:{} {}] " fmt,                                                               \
-                                      utils::normalizePath(std::source_location::current().file_name()),               \
-                                      std::source_location::current().line(),                                          \
-                                      std::source_location::current().function_name(),                                 \
-                                      ##__VA_ARGS__)
+#define LOG_DEBUG(fmt, ...) PMK_LOG_AT(::spdlog::level::debug, fmt, ##__VA_ARGS__)
@@ -0,0 +1,153 @@
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <span>
+#include <utility>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace utils
+{
+/**
+ * @brief 只读内存映射文件
+ *
+ * 页面由操作系统按需载入，多个进程/房间共享同一份物理页；映射在对象析构时解除
+ */
+class MappedFile
+{
+public:
+    MappedFile() = default;
+
+    explicit MappedFile(const std::filesystem::path& path) { open(path); }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    MappedFile(MappedFile&& other) noexcept
+        : m_data(std::exchange(other.m_data, nullptr)), m_size(std::exchange(other.m_size, 0))
+#if defined(_WIN32)
+          ,
+          m_mapping(std::exchange(other.m_mapping, nullptr))
+#endif
+    {
+    }
+
+    MappedFile& operator=(MappedFile&& other) noexcept
+    {
+        if (this != &other)
+        {
+            close();
+            m_data = std::exchange(other.m_data, nullptr);
+            m_size = std::exchange(other.m_size, 0);
+#if defined(_WIN32)
+            m_mapping = std::exchange(other.m_mapping, nullptr);
+#endif
+        }
+        return *this;
+    }
+
+    ~MappedFile() { close(); }
+
+    /**
+     * @brief 映射整个文件；失败（文件不存在、为空等）时 isOpen() 为 false
+     */
+    bool open(const std::filesystem::path& path)
+    {
+        close();
+#if defined(_WIN32)
+        HANDLE file = ::CreateFileW(path.c_str(),
+                                    GENERIC_READ,
+                                    FILE_SHARE_READ,
+                                    nullptr,
+                                    OPEN_EXISTING,
+                                    FILE_ATTRIBUTE_NORMAL,
+                                    nullptr);
+        if (file == INVALID_HANDLE_VALUE)
+        {
+            return false;
+        }
+        LARGE_INTEGER size{};
+        if (::GetFileSizeEx(file, &size) && size.QuadPart > 0)
+        {
+            m_mapping = ::CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            if (m_mapping != nullptr)
+            {
+                m_data = ::MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0);
+                m_size = m_data != nullptr ? static_cast<std::size_t>(size.QuadPart) : 0;
+            }
+        }
+        ::CloseHandle(file);
+#else
+        const int descriptor = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (descriptor < 0)
+        {
+            return false;
+        }
+        struct stat status{};
+        if (::fstat(descriptor, &status) == 0 && status.st_size > 0)
+        {
+            const auto size = static_cast<std::size_t>(status.st_size);
+            void* data = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+            if (data != MAP_FAILED)
+            {
+                m_data = data;
+                m_size = size;
+            }
+        }
+        ::close(descriptor);
+#endif
+        if (m_data == nullptr)
+        {
+            close();
+        }
+        return isOpen();
+    }
+
+    void close() noexcept
+    {
+#if defined(_WIN32)
+        if (m_data != nullptr)
+        {
+            ::UnmapViewOfFile(m_data);
+        }
+        if (m_mapping != nullptr)
+        {
+            ::CloseHandle(m_mapping);
+        }
+        m_mapping = nullptr;
+#else
+        if (m_data != nullptr)
+        {
+            ::munmap(m_data, m_size);
+        }
+#endif
+        m_data = nullptr;
+        m_size = 0;
+    }
+
+    [[nodiscard]] bool isOpen() const noexcept { return m_data != nullptr; }
+
+    [[nodiscard]] std::span<const std::byte> bytes() const noexcept
+    {
+        return {static_cast<const std::byte*>(m_data), m_size};
+    }
+
+private:
+    void* m_data = nullptr;
+    std::size_t m_size = 0;
+#if defined(_WIN32)
+    HANDLE m_mapping = nullptr;
+#endif
+};
+} // namespace utils
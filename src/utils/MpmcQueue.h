@@ -0,0 +1,129 @@
+#pragma once
+
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+
+namespace utils
+{
+/**
+ * @brief 有界无锁多生产者多消费者队列（Vyukov 环形队列）
+ *
+ * 每个槽位带一个序号：生产者/消费者各自用 CAS 抢占下标，再按序号判断槽位是否可写/可读，
+ * 不存在全局锁，满时 tryPush 直接返回 false 由调用方决定背压策略
+ */
+template <typename T>
+class MpmcQueue
+{
+public:
+    explicit MpmcQueue(std::size_t capacity)
+        : m_capacity(std::bit_ceil(capacity < 2 ? std::size_t{2} : capacity)), m_mask(m_capacity - 1),
+          m_cells(std::make_unique<Cell[]>(m_capacity))
+    {
+        for (std::size_t index = 0; index < m_capacity; ++index)
+        {
+            m_cells[index].sequence.store(index, std::memory_order_relaxed);
+        }
+    }
+
+    MpmcQueue(const MpmcQueue&) = delete;
+    MpmcQueue& operator=(const MpmcQueue&) = delete;
+
+    ~MpmcQueue()
+    {
+        T discarded;
+        while (tryPop(discarded))
+        {
+        }
+    }
+
+    template <typename U>
+    bool tryPush(U&& value)
+    {
+        std::size_t position = m_enqueue.load(std::memory_order_relaxed);
+        while (true)
+        {
+            Cell& cell = m_cells[position & m_mask];
+            const std::size_t sequence = cell.sequence.load(std::memory_order_acquire);
+            const auto diff = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position);
+            if (diff == 0)
+            {
+                if (m_enqueue.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                {
+                    std::construct_at(reinterpret_cast<T*>(cell.storage), std::forward<U>(value));
+                    cell.sequence.store(position + 1, std::memory_order_release);
+                    return true;
+                }
+            }
+            else if (diff < 0)
+            {
+                return false; // 已满
+            }
+            else
+            {
+                position = m_enqueue.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    bool tryPop(T& out)
+    {
+        std::size_t position = m_dequeue.load(std::memory_order_relaxed);
+        while (true)
+        {
+            Cell& cell = m_cells[position & m_mask];
+            const std::size_t sequence = cell.sequence.load(std::memory_order_acquire);
+            const auto diff = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position + 1);
+            if (diff == 0)
+            {
+                if (m_dequeue.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                {
+                    out = std::move(*cell.pointer());
+                    std::destroy_at(cell.pointer());
+                    cell.sequence.store(position + m_capacity, std::memory_order_release);
+                    return true;
+                }
+            }
+            else if (diff < 0)
+            {
+                return false; // 为空
+            }
+            else
+            {
+                position = m_dequeue.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /**
+     * @brief 近似元素个数（并发修改时仅供参考）
+     */
+    [[nodiscard]] std::size_t size() const noexcept
+    {
+        const std::size_t enqueue = m_enqueue.load(std::memory_order_relaxed);
+        const std::size_t dequeue = m_dequeue.load(std::memory_order_relaxed);
+        return enqueue > dequeue ? enqueue - dequeue : 0;
+    }
+
+    [[nodiscard]] bool empty() const noexcept { return size() == 0; }
+    [[nodiscard]] std::size_t capacity() const noexcept { return m_capacity; }
+
+private:
+    struct Cell
+    {
+        std::atomic<std::size_t> sequence{0};
+        alignas(T) std::byte storage[sizeof(T)];
+
+        T* pointer() noexcept { return std::launder(reinterpret_cast<T*>(storage)); }
+    };
+
+    const std::size_t m_capacity;
+    const std::size_t m_mask;
+    std::unique_ptr<Cell[]> m_cells;
+    alignas(64) std::atomic<std::size_t> m_enqueue{0};
+    alignas(64) std::atomic<std::size_t> m_dequeue{0};
+};
+} // namespace utils
@@ -0,0 +1,835 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <span>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <asio/execution.hpp>
+#include <asio/execution_context.hpp>
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#endif
+
+namespace utils
+{
+constexpr std::size_t TASK_INLINE_SIZE = 56;       // 任务内联存储，连同操作表指针恰好一条缓存行
+constexpr std::size_t WORK_QUEUE_CAPACITY = 256;   // 工作队列初始容量，必须为 2 的幂
+constexpr std::size_t TASK_BATCH_CHUNK = 64;       // 批量投递时每次入队的任务数
+constexpr std::size_t SPIN_BEFORE_YIELD = 64;      // 自旋锁让出时间片前的自旋次数
+
+/**
+ * @brief 忙等时提示 CPU（降低功耗、让出超线程资源）
+ */
+inline void CpuRelax() noexcept
+{
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    _mm_pause();
+#elif defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__)
+    asm volatile("yield");
+#endif
+}
+
+/**
+ * @brief 临界区只有几条指令的自旋锁，自旋一段时间后让出时间片
+ */
+class SpinLock
+{
+public:
+    void lock() noexcept
+    {
+        while (m_locked.exchange(true, std::memory_order_acquire))
+        {
+            for (std::size_t spin = 0; m_locked.load(std::memory_order_relaxed); ++spin)
+            {
+                if (spin < SPIN_BEFORE_YIELD)
+                {
+                    CpuRelax();
+                }
+                else
+                {
+                    std::this_thread::yield();
+                }
+            }
+        }
+    }
+
+    bool try_lock() noexcept
+    {
+        return !m_locked.load(std::memory_order_relaxed) && !m_locked.exchange(true, std::memory_order_acquire);
+    }
+
+    void unlock() noexcept { m_locked.store(false, std::memory_order_release); }
+
+private:
+    std::atomic<bool> m_locked{false};
+};
+
+/**
+ * @brief 只可移动、只执行一次的 void() 任务
+ *
+ * 捕获不超过 TASK_INLINE_SIZE 字节的可调用对象直接存放在任务内部，投递时不分配内存；
+ * 更大的可调用对象退化为一次堆分配
+ */
+class Task
+{
+public:
+    Task() noexcept = default;
+
+    template <typename F>
+        requires(!std::is_same_v<std::remove_cvref_t<F>, Task> && std::is_invocable_v<std::decay_t<F>&>)
+    Task(F&& func) // NOLINT(google-explicit-constructor)
+    {
+        using Fn = std::decay_t<F>;
+        if constexpr (FitsInline<Fn>())
+        {
+            ::new (static_cast<void*>(m_storage)) Fn(std::forward<F>(func));
+            m_ops = &INLINE_OPS<Fn>;
+        }
+        else
+        {
+            ::new (static_cast<void*>(m_storage)) Fn*(new Fn(std::forward<F>(func)));
+            m_ops = &HEAP_OPS<Fn>;
+        }
+    }
+
+    Task(Task&& other) noexcept : m_ops(std::exchange(other.m_ops, nullptr))
+    {
+        if (m_ops != nullptr)
+        {
+            m_ops->relocate(other.m_storage, m_storage);
+        }
+    }
+
+    Task& operator=(Task&& other) noexcept
+    {
+        if (this != &other)
+        {
+            reset();
+            m_ops = std::exchange(other.m_ops, nullptr);
+            if (m_ops != nullptr)
+            {
+                m_ops->relocate(other.m_storage, m_storage);
+            }
+        }
+        return *this;
+    }
+
+    Task(const Task&) = delete;
+    Task& operator=(const Task&) = delete;
+    ~Task() { reset(); }
+
+    explicit operator bool() const noexcept { return m_ops != nullptr; }
+
+    /**
+     * @brief 执行任务，执行后（包括抛出异常时）任务即被销毁
+     */
+    void operator()()
+    {
+        const Ops* ops = std::exchange(m_ops, nullptr);
+        ops->run(m_storage);
+    }
+
+    void reset() noexcept
+    {
+        if (const Ops* ops = std::exchange(m_ops, nullptr))
+        {
+            ops->destroy(m_storage);
+        }
+    }
+
+private:
+    struct Ops
+    {
+        void (*run)(void* storage);
+        void (*relocate)(void* from, void* to) noexcept;
+        void (*destroy)(void* storage) noexcept;
+    };
+
+    template <typename Fn>
+    static consteval bool FitsInline()
+    {
+        return sizeof(Fn) <= TASK_INLINE_SIZE && alignof(Fn) <= alignof(std::max_align_t) &&
+               std::is_nothrow_move_constructible_v<Fn>;
+    }
+
+    template <typename Fn>
+    static Fn* As(void* storage) noexcept
+    {
+        return std::launder(static_cast<Fn*>(storage));
+    }
+
+    template <typename Fn>
+    static constexpr Ops INLINE_OPS{
+        .run =
+            [](void* storage)
+        {
+            struct Destroy
+            {
+                Fn* fn;
+                ~Destroy() { fn->~Fn(); }
+            } guard{As<Fn>(storage)};
+            (*guard.fn)();
+        },
+        .relocate =
+            [](void* from, void* to) noexcept
+        {
+            Fn* source = As<Fn>(from);
+            ::new (to) Fn(std::move(*source));
+            source->~Fn();
+        },
+        .destroy = [](void* storage) noexcept { As<Fn>(storage)->~Fn(); },
+    };
+
+    template <typename Fn>
+    static constexpr Ops HEAP_OPS{
+        .run =
+            [](void* storage)
+        {
+            std::unique_ptr<Fn> fn(*As<Fn*>(storage));
+            (*fn)();
+        },
+        .relocate = [](void* from, void* to) noexcept { ::new (to) Fn*(*As<Fn*>(from)); },
+        .destroy = [](void* storage) noexcept { delete *As<Fn*>(storage); },
+    };
+
+    alignas(std::max_align_t) std::byte m_storage[TASK_INLINE_SIZE]{};
+    const Ops* m_ops = nullptr;
+};
+
+/**
+ * @brief 工作线程的任务队列（环形缓冲，容量不足时翻倍）
+ *
+ * 所有者在队尾压入/弹出（LIFO，刚投递的子任务数据还在缓存里），窃取者从队首取（FIFO，拿走最早的大块工作）；
+ * 临界区只有一次任务搬移，用自旋锁保护。size() 为无锁近似值，用于空队列时跳过加锁
+ */
+class WorkQueue
+{
+public:
+    /**
+     * @param capacity 初始容量（2 的幂，可为 0：首次入队时才分配）
+     */
+    explicit WorkQueue(std::size_t capacity = WORK_QUEUE_CAPACITY) : m_ring(capacity) {}
+
+    void push(Task&& task)
+    {
+        std::lock_guard lock(m_lock);
+        reserveFor(1);
+        m_ring[(m_head + m_count) & (m_ring.size() - 1)] = std::move(task);
+        m_size.store(++m_count, std::memory_order_relaxed);
+    }
+
+    void pushBatch(std::span<Task> tasks)
+    {
+        std::lock_guard lock(m_lock);
+        reserveFor(tasks.size());
+        for (auto& task : tasks)
+        {
+            m_ring[(m_head + m_count++) & (m_ring.size() - 1)] = std::move(task);
+        }
+        m_size.store(m_count, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief 所有者从队尾取
+     */
+    bool popBack(Task& out)
+    {
+        if (size() == 0)
+        {
+            return false;
+        }
+        std::lock_guard lock(m_lock);
+        if (m_count == 0)
+        {
+            return false;
+        }
+        out = std::move(m_ring[(m_head + --m_count) & (m_ring.size() - 1)]);
+        m_size.store(m_count, std::memory_order_relaxed);
+        return true;
+    }
+
+    /**
+     * @brief 从队首取；trying 为 true 时拿不到锁直接放弃（窃取时不与所有者争抢）
+     */
+    bool popFront(Task& out, bool trying = false)
+    {
+        if (size() == 0)
+        {
+            return false;
+        }
+        std::unique_lock lock(m_lock, std::defer_lock);
+        if (trying)
+        {
+            if (!lock.try_lock())
+            {
+                return false;
+            }
+        }
+        else
+        {
+            lock.lock();
+        }
+        if (m_count == 0)
+        {
+            return false;
+        }
+        out = std::move(m_ring[m_head]);
+        m_head = (m_head + 1) & (m_ring.size() - 1);
+        m_size.store(--m_count, std::memory_order_relaxed);
+        return true;
+    }
+
+    [[nodiscard]] std::size_t size() const noexcept { return m_size.load(std::memory_order_relaxed); }
+
+private:
+    void reserveFor(std::size_t extra)
+    {
+        if (m_count + extra <= m_ring.size())
+        {
+            return;
+        }
+        std::vector<Task> ring(std::bit_ceil(m_count + extra));
+        for (std::size_t index = 0; index < m_count; ++index)
+        {
+            ring[index] = std::move(m_ring[(m_head + index) & (m_ring.size() - 1)]);
+        }
+        m_ring = std::move(ring);
+        m_head = 0;
+    }
+
+    SpinLock m_lock;
+    std::vector<Task> m_ring;
+    std::size_t m_head = 0;
+    std::size_t m_count = 0;
+    std::atomic<std::size_t> m_size{0};
+};
+
+/**
+ * @brief 进程共享的工作窃取调度器
+ *
+ * - 每个工作线程一个 WorkQueue；工作线程内投递的任务进本地队列，外部线程投递的进注入队列
+ * - 空闲线程依次查看本地队列、注入队列，再从其他线程队首窃取，都没有时在原子量上休眠
+ * - 房间 tick、AI 模拟、网络会话协程共用同一组线程，线程总数不超过硬件线程数
+ * - 继承 asio::execution_context 并提供 executor()，可直接用于 asio::co_spawn / make_strand
+ *
+ * 任务抛出的异常不会被调度器捕获（与 std::thread 一致会终止进程），需要传播异常时使用 TaskGroup
+ */
+class TaskScheduler : public asio::execution_context
+{
+public:
+    class Executor;
+
+    explicit TaskScheduler(std::size_t threadCount = DefaultThreadCount())
+    {
+        threadCount = std::max<std::size_t>(threadCount, 1);
+        m_workers.reserve(threadCount);
+        for (std::size_t index = 0; index < threadCount; ++index)
+        {
+            m_workers.push_back(std::make_unique<Worker>());
+        }
+        for (std::size_t index = 0; index < threadCount; ++index)
+        {
+            m_workers[index]->thread = std::thread([this, index] { workerLoop(index); });
+        }
+    }
+
+    TaskScheduler(const TaskScheduler&) = delete;
+    TaskScheduler& operator=(const TaskScheduler&) = delete;
+    TaskScheduler(TaskScheduler&&) = delete;
+    TaskScheduler& operator=(TaskScheduler&&) = delete;
+
+    ~TaskScheduler()
+    {
+        stop();
+        // 工作线程退出后再销毁 asio 服务（定时器等），避免服务在任务运行期间失效
+        shutdown();
+        destroy();
+    }
+
+    /**
+     * @brief 进程共享的调度器，线程数等于硬件线程数
+     */
+    static TaskScheduler& global()
+    {
+        static TaskScheduler scheduler;
+        return scheduler;
+    }
+
+    static std::size_t DefaultThreadCount() { return std::max(1U, std::thread::hardware_concurrency()); }
+
+    [[nodiscard]] std::size_t threadCount() const noexcept { return m_workers.size(); }
+
+    /**
+     * @brief 当前线程是否为本调度器的工作线程
+     */
+    [[nodiscard]] bool isWorkerThread() const noexcept { return CurrentWorker().scheduler == this; }
+
+    void spawn(Task task)
+    {
+        auto& current = CurrentWorker();
+        if (current.scheduler == this)
+        {
+            m_workers[current.index]->queue.push(std::move(task));
+        }
+        else
+        {
+            m_injector.push(std::move(task));
+        }
+        wake(1);
+    }
+
+    /**
+     * @brief 批量投递：一次加锁入队、一次唤醒（任务从 tasks 中移出）
+     */
+    void spawnBatch(std::span<Task> tasks)
+    {
+        if (tasks.empty())
+        {
+            return;
+        }
+        auto& current = CurrentWorker();
+        if (current.scheduler == this)
+        {
+            m_workers[current.index]->queue.pushBatch(tasks);
+        }
+        else
+        {
+            m_injector.pushBatch(tasks);
+        }
+        wake(tasks.size());
+    }
+
+    /**
+     * @brief 在调用线程上执行一个待处理任务（等待时协助调度器），没有可执行任务时返回 false
+     */
+    bool runOne()
+    {
+        auto& current = CurrentWorker();
+        Task task;
+        if (!findTask(current.scheduler == this ? current.index : m_workers.size(), task))
+        {
+            return false;
+        }
+        task();
+        return true;
+    }
+
+    /**
+     * @brief 停止调度器：执行完已投递的任务后工作线程退出（可重复调用）
+     */
+    void stop()
+    {
+        if (m_running.exchange(false, std::memory_order_acq_rel))
+        {
+            m_epoch.fetch_add(1, std::memory_order_release);
+            m_epoch.notify_all();
+            for (auto& worker : m_workers)
+            {
+                if (worker->thread.joinable())
+                {
+                    worker->thread.join();
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief co_await scheduler.schedule() 将协程后续部分切换到调度器上执行
+     */
+    [[nodiscard]] auto schedule() noexcept
+    {
+        struct Awaiter
+        {
+            TaskScheduler* scheduler;
+            static bool await_ready() noexcept { return false; }
+            void await_suspend(std::coroutine_handle<> handle) const
+            {
+                scheduler->spawn([handle] { handle.resume(); });
+            }
+            void await_resume() const noexcept {}
+        };
+        return Awaiter{this};
+    }
+
+    [[nodiscard]] Executor executor() noexcept;
+
+private:
+    struct WorkerSlot
+    {
+        const TaskScheduler* scheduler = nullptr;
+        std::size_t index = 0;
+    };
+
+    struct Worker
+    {
+        WorkQueue queue;
+        std::thread thread;
+    };
+
+    static WorkerSlot& CurrentWorker() noexcept
+    {
+        thread_local WorkerSlot slot;
+        return slot;
+    }
+
+    /**
+     * @brief 依次查看本地队列、注入队列、其他线程的队列；self 为越界值时表示外部线程
+     */
+    bool findTask(std::size_t self, Task& out)
+    {
+        const std::size_t count = m_workers.size();
+        if (self < count && m_workers[self]->queue.popBack(out))
+        {
+            return true;
+        }
+        if (m_injector.popFront(out))
+        {
+            return true;
+        }
+        const std::size_t start = self < count ? self + 1 : 0;
+        for (std::size_t offset = 0; offset < count; ++offset)
+        {
+            const std::size_t victim = (start + offset) % count;
+            if (victim != self && m_workers[victim]->queue.popFront(out, true))
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * @brief 有线程休眠时唤醒；入队与读取休眠数之间的全屏障与 workerLoop 中的屏障配对，不会丢失唤醒
+     */
+    void wake(std::size_t tasks)
+    {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        const uint32_t sleepers = m_sleepers.load(std::memory_order_relaxed);
+        if (sleepers == 0)
+        {
+            return;
+        }
+        m_epoch.fetch_add(1, std::memory_order_release);
+        if (tasks >= sleepers)
+        {
+            m_epoch.notify_all();
+        }
+        else
+        {
+            for (std::size_t index = 0; index < tasks; ++index)
+            {
+                m_epoch.notify_one();
+            }
+        }
+    }
+
+    void workerLoop(std::size_t index)
+    {
+        CurrentWorker() = WorkerSlot{.scheduler = this, .index = index};
+        Task task;
+        for (;;)
+        {
+            if (findTask(index, task))
+            {
+                task();
+                continue;
+            }
+            // 先记下纪元再登记休眠并复查队列：复查之后的投递必然推进纪元，wait 会立即返回
+            const uint32_t epoch = m_epoch.load(std::memory_order_acquire);
+            m_sleepers.fetch_add(1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (findTask(index, task))
+            {
+                m_sleepers.fetch_sub(1, std::memory_order_relaxed);
+                task();
+                continue;
+            }
+            if (!m_running.load(std::memory_order_acquire))
+            {
+                m_sleepers.fetch_sub(1, std::memory_order_relaxed);
+                return;
+            }
+            m_epoch.wait(epoch, std::memory_order_acquire);
+            m_sleepers.fetch_sub(1, std::memory_order_relaxed);
+        }
+    }
+
+    std::vector<std::unique_ptr<Worker>> m_workers;
+    WorkQueue m_injector; // 外部线程投递的任务
+    alignas(64) std::atomic<uint32_t> m_sleepers{0};
+    std::atomic<uint32_t> m_epoch{0};
+    std::atomic<bool> m_running{true};
+};
+
+/**
+ * @brief asio 标准执行器：asio 的完成处理器与协程在调度器线程上运行
+ */
+class TaskScheduler::Executor
+{
+public:
+    explicit Executor(TaskScheduler& scheduler) noexcept : m_scheduler(&scheduler) {}
+
+    [[nodiscard]] TaskScheduler& query(asio::execution::context_t /*unused*/) const noexcept { return *m_scheduler; }
+
+    static constexpr asio::execution::blocking_t query(asio::execution::blocking_t /*unused*/) noexcept
+    {
+        return asio::execution::blocking.never;
+    }
+
+    template <typename F>
+    void execute(F&& func) const
+    {
+        m_scheduler->spawn(Task(std::forward<F>(func)));
+    }
+
+    bool operator==(const Executor& other) const noexcept = default;
+
+private:
+    TaskScheduler* m_scheduler;
+};
+
+inline TaskScheduler::Executor TaskScheduler::executor() noexcept
+{
+    return Executor(*this);
+}
+
+/**
+ * @brief 一组任务的完成计数，替代逐个任务的 promise/future
+ *
+ * - run()/runBatch() 把任务放进组内队列，再向调度器投递同样数量的取任务项，由工作线程取出执行
+ * - wait() 阻塞到全部完成，等待期间先执行本组尚未被取走的任务；只有工作线程会再协助执行其他任务
+ *   （避免嵌套等待占满所有线程），外部线程不会替调度器执行无关的任务
+ * - then() 注册全部完成后的续延任务，co_await group 在完成后恢复协程
+ * - 任务抛出的第一个异常在 wait()/co_await 处重新抛出
+ */
+class TaskGroup
+{
+public:
+    explicit TaskGroup(TaskScheduler& scheduler = TaskScheduler::global()) : m_scheduler(&scheduler) {}
+
+    TaskGroup(const TaskGroup&) = delete;
+    TaskGroup& operator=(const TaskGroup&) = delete;
+    TaskGroup(TaskGroup&&) = delete;
+    TaskGroup& operator=(TaskGroup&&) = delete;
+
+    ~TaskGroup() { waitIdle(); }
+
+    template <typename F>
+    void run(F&& func)
+    {
+        add(SHARES_PER_TASK);
+        m_local.push(Task([this, fn = std::forward<F>(func)]() mutable { invoke(fn); }));
+        m_scheduler->spawn(Task([this] { runLocal(); }));
+    }
+
+    /**
+     * @brief 批量投递 count 个任务 func(index)，按块入队，不分配内存
+     */
+    template <typename F>
+        requires std::is_invocable_v<F&, std::size_t>
+    void runBatch(std::size_t count, const F& func)
+    {
+        add(count * SHARES_PER_TASK);
+        std::array<Task, TASK_BATCH_CHUNK> chunk;
+        for (std::size_t begin = 0; begin < count; begin += TASK_BATCH_CHUNK)
+        {
+            const std::size_t size = std::min(TASK_BATCH_CHUNK, count - begin);
+            for (std::size_t offset = 0; offset < size; ++offset)
+            {
+                chunk[offset] = Task([this, func, index = begin + offset]() mutable { invoke(func, index); });
+            }
+            m_local.pushBatch(std::span(chunk.data(), size));
+            for (std::size_t offset = 0; offset < size; ++offset)
+            {
+                chunk[offset] = Task([this] { runLocal(); });
+            }
+            m_scheduler->spawnBatch(std::span(chunk.data(), size));
+        }
+    }
+
+    /**
+     * @brief 手动计数：add(n) 后由外部在 n 个工作完成时各调用一次 done()
+     */
+    void add(std::size_t count) { m_pending.fetch_add(count, std::memory_order_relaxed); }
+
+    void done()
+    {
+        // 非最后一个完成者只做一次 CAS，不碰锁
+        std::size_t pending = m_pending.load(std::memory_order_relaxed);
+        while (pending > 1)
+        {
+            if (m_pending.compare_exchange_weak(pending, pending - 1, std::memory_order_acq_rel))
+            {
+                return;
+            }
+        }
+        // 可能是最后一个：在锁内归零并取走续延，等待方须拿到锁才返回，保证此后不再访问 this
+        std::vector<Task> continuations;
+        TaskScheduler* scheduler = m_scheduler;
+        {
+            std::lock_guard lock(m_lock);
+            if (m_pending.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            {
+                continuations.swap(m_continuations);
+                m_pending.notify_all();
+            }
+        }
+        for (auto& continuation : continuations)
+        {
+            scheduler->spawn(std::move(continuation));
+        }
+    }
+
+    [[nodiscard]] bool finished() const noexcept { return m_pending.load(std::memory_order_acquire) == 0; }
+
+    /**
+     * @brief 等待全部任务完成，并重新抛出其中第一个异常
+     */
+    void wait()
+    {
+        waitIdle();
+        rethrow();
+    }
+
+    /**
+     * @brief 全部完成后在调度器上执行 continuation；已完成时立即投递
+     */
+    template <typename F>
+    void then(F&& continuation)
+    {
+        {
+            std::lock_guard lock(m_lock);
+            if (m_pending.load(std::memory_order_acquire) != 0)
+            {
+                m_continuations.emplace_back(std::forward<F>(continuation));
+                return;
+            }
+        }
+        m_scheduler->spawn(Task(std::forward<F>(continuation)));
+    }
+
+    [[nodiscard]] auto operator co_await() noexcept
+    {
+        struct Awaiter
+        {
+            TaskGroup* group;
+            [[nodiscard]] bool await_ready() const noexcept { return group->finished(); }
+            void await_suspend(std::coroutine_handle<> handle) const
+            {
+                group->then([handle] { handle.resume(); });
+            }
+            void await_resume() const { group->rethrow(); }
+        };
+        return Awaiter{this};
+    }
+
+private:
+    // run() 投递的每个任务计两份：任务本身与取出它的调度器任务，两者都结束后组才算完成，
+    // 保证调度器中不会残留引用本组的任务
+    static constexpr std::size_t SHARES_PER_TASK = 2;
+
+    /**
+     * @brief 调度器任务：从组内队列取一个任务执行；任务已被等待方取走时只计数
+     */
+    void runLocal()
+    {
+        Task task;
+        if (m_local.popFront(task))
+        {
+            task();
+        }
+        done();
+    }
+
+    template <typename F, typename... Args>
+    void invoke(F& func, Args... args) noexcept
+    {
+        try
+        {
+            func(args...);
+        }
+        catch (...)
+        {
+            if (!m_failed.test_and_set(std::memory_order_relaxed))
+            {
+                m_error = std::current_exception();
+            }
+        }
+        done();
+    }
+
+    void waitIdle()
+    {
+        const bool onWorker = m_scheduler->isWorkerThread();
+        Task task;
+        for (;;)
+        {
+            const std::size_t pending = m_pending.load(std::memory_order_acquire);
+            if (pending == 0)
+            {
+                break;
+            }
+            if (m_local.popBack(task))
+            {
+                task();
+                continue;
+            }
+            if (!onWorker || !m_scheduler->runOne())
+            {
+                m_pending.wait(pending, std::memory_order_acquire);
+            }
+        }
+        // 与 done() 的临界区同步：最后一个完成者离开临界区之后才返回
+        std::lock_guard lock(m_lock);
+    }
+
+    void rethrow()
+    {
+        if (m_failed.test(std::memory_order_acquire))
+        {
+            std::exception_ptr error = std::exchange(m_error, nullptr);
+            m_failed.clear(std::memory_order_relaxed);
+            std::rethrow_exception(error);
+        }
+    }
+
+    TaskScheduler* m_scheduler;
+    alignas(64) std::atomic<std::size_t> m_pending{0};
+    SpinLock m_lock;
+    WorkQueue m_local{0}; // run()/runBatch() 投递、尚未被取走的任务；组常为临时对象，首次投递时才分配
+    std::vector<Task> m_continuations;
+    std::atomic_flag m_failed;
+    std::exception_ptr m_error;
+};
+
+/**
+ * @brief 即发即弃的协程返回类型：创建后立即运行，结束时自行销毁
+ *
+ * 典型用法：在协程中 co_await scheduler.schedule() 切到调度器线程，再 co_await 若干 TaskGroup
+ */
+struct DetachedTask
+{
+    struct promise_type
+    {
+        DetachedTask get_return_object() noexcept { return {}; }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() noexcept {}
+        void unhandled_exception() noexcept { std::terminate(); }
+    };
+};
+} // namespace utils
@@ -1,14 +1,18 @@
 #pragma once
 
-#include <cstddef>
-#include <thread>
-
-// 防止 Windows.h 宏污染 ASIO 的 execution 命名空间
-#include <asio.hpp>
+#include <functional>
+#include <future>
+#include <type_traits>
+#include "TaskScheduler.h"
 
 namespace utils
 {
 
+/**
+ * @brief 基于 future 的兼容接口，任务运行在共享的 TaskScheduler 上
+ *
+ * 每次 enqueue 都要分配 promise 共享状态，新代码请直接使用 TaskGroup
+ */
 class ThreadPool
 {
 public:
@@ -21,8 +25,7 @@ public:
         std::promise<R> promise;
         auto future = promise.get_future();
 
-        // C++23：使用 move_only_function，语义明确
-        std::move_only_function<void()> task = [pro = std::move(promise), fn = std::forward<F>(func)]() mutable
+        TaskScheduler::global().spawn([pro = std::move(promise), fn = std::forward<F>(func)]() mutable
         {
             try
             {
@@ -40,17 +43,11 @@ public:
             {
                 pro.set_exception(std::current_exception());
             }
-        };
-
-        asio::post(instance(), std::move(task));
+        });
         return future;
     }
 
-    static void shutdown() noexcept
-    {
-        instance().stop();
-        instance().join();
-    }
+    static void shutdown() noexcept { TaskScheduler::global().stop(); }
 
     // 禁止拷贝和移动
     ThreadPool(const ThreadPool&) = delete;
@@ -59,12 +56,6 @@ public:
     ThreadPool& operator=(ThreadPool&&) = delete;
 
 private:
-    // 获取全局线程池实例(单例模式)
-    static asio::thread_pool& instance(size_t threadCount = std::thread::hardware_concurrency())
-    {
-        static asio::thread_pool instance(threadCount);
-        return instance;
-    }
     ThreadPool() = default;
     ~ThreadPool() = default;
 };
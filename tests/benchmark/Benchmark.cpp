@@ -0,0 +1,317 @@
+/**
+ * ************************************************************************
+ *
+ * @file Benchmark.cpp
+ * @author AnakinLiu (azrael2759@qq.com)
+ * @date 2026-10-16
+ * @version 0.1
+ * @brief 微基准框架运行器：迭代次数校准、控制台表格与 JSON 输出
+ *
+ * ************************************************************************
+ * @copyright Copyright (c) 2026 AnakinLiu
+ * For study and research only, no reprinting.
+ * ************************************************************************
+ */
+#include "Benchmark.h"
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <regex>
+#include <string_view>
+#include <thread>
+#include <nlohmann/json.hpp>
+
+namespace bench
+{
+namespace
+{
+constexpr uint64_t MAX_ITERATIONS = 1'000'000'000;
+constexpr double DEFAULT_MIN_TIME = 0.5;
+
+struct Options
+{
+    std::string filter = ".*";
+    double minTime = DEFAULT_MIN_TIME;
+    int repetitions = 1;
+    bool jsonToStdout = false;
+    bool listOnly = false;
+    std::string outFile;
+};
+
+struct RunResult
+{
+    std::string name;
+    int repetitionIndex = 0;
+    uint64_t iterations = 0;
+    double realNsPerIter = 0.0;
+    double cpuNsPerIter = 0.0;
+    double itemsPerSecond = 0.0;
+    double bytesPerSecond = 0.0;
+    std::string label;
+    std::map<std::string, double> counters;
+};
+
+bool parseFlag(std::string_view arg, std::string_view flag, std::string& value)
+{
+    if (!arg.starts_with(flag))
+    {
+        return false;
+    }
+    arg.remove_prefix(flag.size());
+    if (arg.empty())
+    {
+        value.clear();
+        return true;
+    }
+    if (arg.front() != '=')
+    {
+        return false;
+    }
+    value = std::string(arg.substr(1));
+    return true;
+}
+
+Options parseOptions(int argc, char** argv)
+{
+    Options options;
+    for (int index = 1; index < argc; ++index)
+    {
+        std::string_view arg = argv[index];
+        std::string value;
+        if (parseFlag(arg, "--benchmark_filter", value))
+        {
+            options.filter = value;
+        }
+        else if (parseFlag(arg, "--benchmark_min_time", value))
+        {
+            // 兼容 "0.5s" 写法
+            if (!value.empty() && value.back() == 's')
+            {
+                value.pop_back();
+            }
+            options.minTime = std::stod(value);
+        }
+        else if (parseFlag(arg, "--benchmark_repetitions", value))
+        {
+            options.repetitions = std::max(1, std::stoi(value));
+        }
+        else if (parseFlag(arg, "--benchmark_format", value))
+        {
+            options.jsonToStdout = value == "json";
+        }
+        else if (parseFlag(arg, "--benchmark_out", value))
+        {
+            options.outFile = value;
+        }
+        else if (parseFlag(arg, "--benchmark_list_tests", value))
+        {
+            options.listOnly = true;
+        }
+        else
+        {
+            std::cerr << "unknown argument: " << arg << "\n";
+        }
+    }
+    return options;
+}
+
+std::string instanceName(const Benchmark& benchmark, const std::vector<int64_t>& args)
+{
+    std::string name = benchmark.name();
+    for (auto arg : args)
+    {
+        name += "/" + std::to_string(arg);
+    }
+    return name;
+}
+
+/**
+ * @brief 运行一次固定迭代次数的基准
+ */
+State runOnce(const Benchmark& benchmark, const std::vector<int64_t>& args, uint64_t iterations)
+{
+    State state(iterations, args);
+    benchmark.function()(state);
+    return state;
+}
+
+/**
+ * @brief 校准迭代次数直至耗时达到 minTime，返回最终一次的结果
+ */
+RunResult runInstance(const Benchmark& benchmark, const std::vector<int64_t>& args, double minTime)
+{
+    const double minNs = minTime * 1e9;
+    uint64_t iterations = benchmark.fixedIterations() != 0 ? benchmark.fixedIterations() : 1;
+    State state = runOnce(benchmark, args, iterations);
+    while (benchmark.fixedIterations() == 0 && state.realNs() < minNs && iterations < MAX_ITERATIONS)
+    {
+        // 与 Google Benchmark 相同的增长策略：按比例外推，单次最多放大 10 倍
+        double multiplier = state.realNs() <= 0.0 ? 10.0 : std::min(10.0, minNs * 1.4 / state.realNs());
+        iterations = std::min(MAX_ITERATIONS,
+                              std::max(iterations + 1, static_cast<uint64_t>(static_cast<double>(iterations) * multiplier)));
+        state = runOnce(benchmark, args, iterations);
+    }
+
+    RunResult result;
+    result.name = instanceName(benchmark, args);
+    result.iterations = iterations;
+    result.realNsPerIter = state.realNs() / static_cast<double>(iterations);
+    result.cpuNsPerIter = state.cpuNs() / static_cast<double>(iterations);
+    const double seconds = state.realNs() / 1e9;
+    if (seconds > 0.0)
+    {
+        result.itemsPerSecond = static_cast<double>(state.itemsProcessed()) / seconds;
+        result.bytesPerSecond = static_cast<double>(state.bytesProcessed()) / seconds;
+    }
+    result.label = state.label();
+    result.counters = state.counters;
+    return result;
+}
+
+nlohmann::json toJson(const std::vector<RunResult>& results, int repetitions)
+{
+    nlohmann::json context{
+        {"date", std::to_string(std::chrono::system_clock::to_time_t(std::chrono::system_clock::now()))},
+        {"num_cpus", std::thread::hardware_concurrency()},
+#ifdef NDEBUG
+        {"library_build_type", "release"},
+#else
+        {"library_build_type", "debug"},
+#endif
+    };
+    nlohmann::json benchmarks = nlohmann::json::array();
+    for (const auto& run : results)
+    {
+        nlohmann::json entry{{"name", run.name},
+                             {"run_name", run.name},
+                             {"run_type", "iteration"},
+                             {"repetitions", repetitions},
+                             {"repetition_index", run.repetitionIndex},
+                             {"threads", 1},
+                             {"iterations", run.iterations},
+                             {"real_time", run.realNsPerIter},
+                             {"cpu_time", run.cpuNsPerIter},
+                             {"time_unit", "ns"}};
+        if (run.itemsPerSecond > 0.0)
+        {
+            entry["items_per_second"] = run.itemsPerSecond;
+        }
+        if (run.bytesPerSecond > 0.0)
+        {
+            entry["bytes_per_second"] = run.bytesPerSecond;
+        }
+        if (!run.label.empty())
+        {
+            entry["label"] = run.label;
+        }
+        for (const auto& [key, value] : run.counters)
+        {
+            entry[key] = value;
+        }
+        benchmarks.push_back(std::move(entry));
+    }
+    return {{"context", std::move(context)}, {"benchmarks", std::move(benchmarks)}};
+}
+
+void printConsoleHeader()
+{
+    std::printf("%-48s %15s %15s %12s\n", "Benchmark", "Time(ns)", "CPU(ns)", "Iterations");
+    std::printf("%s\n", std::string(93, '-').c_str());
+}
+
+void printConsoleRow(const RunResult& run)
+{
+    std::printf("%-48s %15.1f %15.1f %12llu",
+                run.name.c_str(),
+                run.realNsPerIter,
+                run.cpuNsPerIter,
+                static_cast<unsigned long long>(run.iterations));
+    if (run.itemsPerSecond > 0.0)
+    {
+        std::printf(" items/s=%.4g", run.itemsPerSecond);
+    }
+    if (run.bytesPerSecond > 0.0)
+    {
+        std::printf(" bytes/s=%.4g", run.bytesPerSecond);
+    }
+    for (const auto& [key, value] : run.counters)
+    {
+        std::printf(" %s=%.4g", key.c_str(), value);
+    }
+    if (!run.label.empty())
+    {
+        std::printf(" %s", run.label.c_str());
+    }
+    std::printf("\n");
+    std::fflush(stdout);
+}
+} // namespace
+
+int RunSpecifiedBenchmarks(int argc, char** argv)
+{
+    Options options = parseOptions(argc, argv);
+    std::regex filter(options.filter);
+
+    std::vector<RunResult> results;
+    if (!options.jsonToStdout && !options.listOnly)
+    {
+        printConsoleHeader();
+    }
+    for (const auto& benchmark : Registry())
+    {
+        auto argSets = benchmark->argSets();
+        if (argSets.empty())
+        {
+            argSets.emplace_back();
+        }
+        for (const auto& args : argSets)
+        {
+            std::string name = instanceName(*benchmark, args);
+            if (!std::regex_search(name, filter))
+            {
+                continue;
+            }
+            if (options.listOnly)
+            {
+                std::printf("%s\n", name.c_str());
+                continue;
+            }
+            double minTime = benchmark->minTime() > 0.0 ? benchmark->minTime() : options.minTime;
+            for (int repetition = 0; repetition < options.repetitions; ++repetition)
+            {
+                RunResult run = runInstance(*benchmark, args, minTime);
+                run.repetitionIndex = repetition;
+                if (!options.jsonToStdout)
+                {
+                    printConsoleRow(run);
+                }
+                results.push_back(std::move(run));
+            }
+        }
+    }
+    if (options.listOnly)
+    {
+        return 0;
+    }
+
+    nlohmann::json json = toJson(results, options.repetitions);
+    if (options.jsonToStdout)
+    {
+        std::cout << json.dump(2) << "\n";
+    }
+    if (!options.outFile.empty())
+    {
+        std::ofstream out(options.outFile);
+        if (!out)
+        {
+            std::cerr << "failed to open " << options.outFile << "\n";
+            return 1;
+        }
+        out << json.dump(2) << "\n";
+    }
+    return 0;
+}
+} // namespace bench
+
+BENCHMARK_MAIN()
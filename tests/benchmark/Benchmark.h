@@ -0,0 +1,301 @@
+/**
+ * ************************************************************************
+ *
+ * @file Benchmark.h
+ * @author AnakinLiu (azrael2759@qq.com)
+ * @date 2026-10-16
+ * @version 0.1
+ * @brief 仓库内置的微基准框架（接口仿照 Google Benchmark）
+    - BENCHMARK(func) 注册基准，func 签名为 void(bench::State&)
+    - for (auto _ : state) { ... } 为计时循环，迭代次数自动校准到 --benchmark_min_time
+    - 结果以 Google Benchmark 兼容的 JSON 输出 (--benchmark_out / --benchmark_format=json)，
+      可直接用 compare.py 等工具对比两次运行
+ *
+ * ************************************************************************
+ * @copyright Copyright (c) 2026 AnakinLiu
+ * For study and research only, no reprinting.
+ * ************************************************************************
+ */
+
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <ctime>
+#include <functional>
+#include <initializer_list>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace bench
+{
+/**
+ * @brief 阻止编译器优化掉 value 的计算
+ */
+template <typename T>
+inline void DoNotOptimize(const T& value)
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+    static_cast<void>(*reinterpret_cast<const volatile char*>(&value));
+    std::atomic_signal_fence(std::memory_order_acq_rel);
+#else
+    asm volatile("" : : "r,m"(value) : "memory");
+#endif
+}
+
+template <typename T>
+inline void DoNotOptimize(T& value)
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+    static_cast<void>(*reinterpret_cast<volatile char*>(&value));
+    std::atomic_signal_fence(std::memory_order_acq_rel);
+#else
+    asm volatile("" : "+r,m"(value) : : "memory");
+#endif
+}
+
+/**
+ * @brief 阻止编译器跨越此点重排内存读写
+ */
+inline void ClobberMemory()
+{
+    std::atomic_signal_fence(std::memory_order_acq_rel);
+}
+
+/**
+ * @brief 单次基准运行的状态，负责计时与计数
+ */
+class State
+{
+public:
+    using clock = std::chrono::steady_clock;
+
+    State(uint64_t iterations, std::vector<int64_t> args) : m_maxIterations(iterations), m_args(std::move(args)) {}
+
+    struct Sentinel
+    {
+    };
+
+    class Iterator
+    {
+    public:
+        explicit Iterator(State* state) : m_state(state), m_remaining(state->m_maxIterations) {}
+
+        // 非平凡析构，避免 for (auto _ : state) 触发未使用变量警告
+        struct Value
+        {
+            ~Value() {} // NOLINT(modernize-use-equals-default)
+        };
+        Value operator*() const { return {}; }
+        Iterator& operator++()
+        {
+            --m_remaining;
+            return *this;
+        }
+        bool operator!=(Sentinel /*unused*/)
+        {
+            if (m_remaining != 0) [[likely]]
+            {
+                return true;
+            }
+            m_state->finishKeepRunning();
+            return false;
+        }
+
+    private:
+        State* m_state;
+        uint64_t m_remaining;
+    };
+
+    Iterator begin()
+    {
+        startKeepRunning();
+        return Iterator(this);
+    }
+    static Sentinel end() { return {}; }
+
+    /**
+     * @brief while (state.KeepRunning()) 形式的计时循环
+     */
+    bool KeepRunning()
+    {
+        if (!m_started) [[unlikely]]
+        {
+            startKeepRunning();
+        }
+        if (m_completed < m_maxIterations) [[likely]]
+        {
+            ++m_completed;
+            return true;
+        }
+        finishKeepRunning();
+        return false;
+    }
+
+    void PauseTiming()
+    {
+        if (!m_running)
+        {
+            return;
+        }
+        m_realNs += elapsedNs(m_realStart, clock::now());
+        m_cpuTicks += std::clock() - m_cpuStart;
+        m_running = false;
+    }
+
+    void ResumeTiming()
+    {
+        if (m_running)
+        {
+            return;
+        }
+        m_realStart = clock::now();
+        m_cpuStart = std::clock();
+        m_running = true;
+    }
+
+    [[nodiscard]] int64_t range(std::size_t index = 0) const { return index < m_args.size() ? m_args[index] : 0; }
+    [[nodiscard]] uint64_t iterations() const { return m_maxIterations; }
+    [[nodiscard]] uint64_t max_iterations() const { return m_maxIterations; }
+
+    void SetItemsProcessed(int64_t items) { m_itemsProcessed = items; }
+    void SetBytesProcessed(int64_t bytes) { m_bytesProcessed = bytes; }
+    void SetLabel(std::string label) { m_label = std::move(label); }
+
+    /**
+     * @brief 自定义计数器，原样写入 JSON
+     */
+    std::map<std::string, double> counters;
+
+    // ---------- 以下为框架内部使用 ----------
+    [[nodiscard]] double realNs() const { return m_realNs; }
+    [[nodiscard]] double cpuNs() const
+    {
+        return static_cast<double>(m_cpuTicks) * 1e9 / static_cast<double>(CLOCKS_PER_SEC);
+    }
+    [[nodiscard]] int64_t itemsProcessed() const { return m_itemsProcessed; }
+    [[nodiscard]] int64_t bytesProcessed() const { return m_bytesProcessed; }
+    [[nodiscard]] const std::string& label() const { return m_label; }
+    [[nodiscard]] const std::vector<int64_t>& args() const { return m_args; }
+
+private:
+    static double elapsedNs(clock::time_point begin, clock::time_point end)
+    {
+        return std::chrono::duration<double, std::nano>(end - begin).count();
+    }
+
+    void startKeepRunning()
+    {
+        m_started = true;
+        ResumeTiming();
+    }
+
+    void finishKeepRunning() { PauseTiming(); }
+
+    uint64_t m_maxIterations;
+    uint64_t m_completed = 0;
+    std::vector<int64_t> m_args;
+    clock::time_point m_realStart;
+    std::clock_t m_cpuStart = 0;
+    double m_realNs = 0.0;
+    std::clock_t m_cpuTicks = 0;
+    bool m_running = false;
+    bool m_started = false;
+    int64_t m_itemsProcessed = 0;
+    int64_t m_bytesProcessed = 0;
+    std::string m_label;
+};
+
+/**
+ * @brief 已注册的基准，支持 Arg/Args 形成参数化实例
+ */
+class Benchmark
+{
+public:
+    using Function = std::function<void(State&)>;
+
+    Benchmark(std::string name, Function func) : m_name(std::move(name)), m_func(std::move(func)) {}
+
+    Benchmark* Arg(int64_t arg)
+    {
+        m_argSets.push_back({arg});
+        return this;
+    }
+
+    Benchmark* Args(std::initializer_list<int64_t> args)
+    {
+        m_argSets.emplace_back(args);
+        return this;
+    }
+
+    Benchmark* MinTime(double seconds)
+    {
+        m_minTime = seconds;
+        return this;
+    }
+
+    /**
+     * @brief 固定迭代次数（用于宏观基准，跳过自动校准）
+     */
+    Benchmark* Iterations(uint64_t iterations)
+    {
+        m_iterations = iterations;
+        return this;
+    }
+
+    [[nodiscard]] const std::string& name() const { return m_name; }
+    [[nodiscard]] const Function& function() const { return m_func; }
+    [[nodiscard]] const std::vector<std::vector<int64_t>>& argSets() const { return m_argSets; }
+    [[nodiscard]] double minTime() const { return m_minTime; }
+    [[nodiscard]] uint64_t fixedIterations() const { return m_iterations; }
+
+private:
+    std::string m_name;
+    Function m_func;
+    std::vector<std::vector<int64_t>> m_argSets;
+    double m_minTime = 0.0; // 0 表示使用命令行默认值
+    uint64_t m_iterations = 0;
+};
+
+inline std::vector<std::unique_ptr<Benchmark>>& Registry()
+{
+    static std::vector<std::unique_ptr<Benchmark>> benchmarks;
+    return benchmarks;
+}
+
+inline Benchmark* RegisterBenchmark(std::string name, Benchmark::Function func)
+{
+    Registry().push_back(std::make_unique<Benchmark>(std::move(name), std::move(func)));
+    return Registry().back().get();
+}
+
+/**
+ * @brief 解析命令行并运行所有匹配的基准
+ * @return 进程退出码
+ *
+ * 支持的参数:
+ *   --benchmark_filter=<regex>        只运行名称匹配的基准
+ *   --benchmark_min_time=<seconds>    每个基准的最短计时（默认 0.5）
+ *   --benchmark_repetitions=<n>       重复次数（默认 1）
+ *   --benchmark_format=<console|json> 标准输出格式
+ *   --benchmark_out=<file>            额外写出 JSON 结果文件
+ *   --benchmark_list_tests            仅列出基准名称
+ */
+int RunSpecifiedBenchmarks(int argc, char** argv);
+} // namespace bench
+
+#define BENCH_CONCAT_IMPL(a, b) a##b
+#define BENCH_CONCAT(a, b) BENCH_CONCAT_IMPL(a, b)
+
+#define BENCHMARK(func)                                                                                                \
+    [[maybe_unused]] static ::bench::Benchmark* BENCH_CONCAT(g_benchmark_, __LINE__) =                                 \
+        ::bench::RegisterBenchmark(#func, func)
+
+#define BENCHMARK_MAIN()                                                                                               \
+    int main(int argc, char** argv)                                                                                    \
+    {                                                                                                                  \
+        return ::bench::RunSpecifiedBenchmarks(argc, argv);                                                            \
+    }
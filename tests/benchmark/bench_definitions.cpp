@@ -0,0 +1,101 @@
+/**
+ * ************************************************************************
+ *
+ * @file bench_definitions.cpp
+ * @author AnakinLiu (azrael2759@qq.com)
+ * @date 2026-10-16
+ * @version 0.1
+ * @brief 定义加载基准：启动时解析 JSON 并编译，与直接 mmap 预编译的二进制表对比
+ *
+ * ************************************************************************
+ * @copyright Copyright (c) 2026 AnakinLiu
+ * For study and research only, no reprinting.
+ * ************************************************************************
+ */
+#include <array>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <vector>
+#include <nlohmann/json.hpp>
+#include "Benchmark.h"
+#include "src/server/data/DefinitionCompiler.h"
+#include "src/server/data/DefinitionTable.h"
+
+namespace
+{
+#ifdef PMK_DEFINITION_SOURCE_DIR
+const std::filesystem::path DEFINITION_SOURCE_DIR = PMK_DEFINITION_SOURCE_DIR;
+#else
+const std::filesystem::path DEFINITION_SOURCE_DIR = "resource/Definitions";
+#endif
+
+const std::array<std::filesystem::path, 2> DEFINITION_SOURCES{DEFINITION_SOURCE_DIR / "cards.json",
+                                                              DEFINITION_SOURCE_DIR / "characters.json"};
+
+/**
+ * @brief 从 JSON 源文件得到可用的定义表：读文件、解析、合并、编译、校验
+ */
+std::vector<std::byte> LoadFromJson()
+{
+    nlohmann::json root = nlohmann::json::object();
+    for (const auto& path : DEFINITION_SOURCES)
+    {
+        std::ifstream input(path);
+        data::MergeDefinitions(root, nlohmann::json::parse(input));
+    }
+    auto table = data::CompileDefinitions(root);
+    if (!table)
+    {
+        std::cerr << "definition error: " << table.error() << "\n";
+        std::abort();
+    }
+    return std::move(*table);
+}
+
+/**
+ * @brief 由源文件现编一份二进制表，保证两个基准读取同样的内容
+ */
+const std::filesystem::path& BinaryTablePath()
+{
+    static const std::filesystem::path path = []
+    {
+        auto target = std::filesystem::temp_directory_path() / "pmk_bench_definitions.pmkd";
+        const auto bytes = LoadFromJson();
+        std::ofstream output(target, std::ios::binary | std::ios::trunc);
+        output.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+        return target;
+    }();
+    return path;
+}
+
+void BM_DefinitionsLoadJson(bench::State& state)
+{
+    for (auto _ : state)
+    {
+        auto bytes = LoadFromJson();
+        auto table = data::DefinitionTable::view(bytes);
+        bench::DoNotOptimize(table->cards().size());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_DefinitionsLoadJson);
+
+void BM_DefinitionsLoadBinary(bench::State& state)
+{
+    const auto& path = BinaryTablePath();
+    for (auto _ : state)
+    {
+        auto table = data::DefinitionTable::load(path);
+        if (!table)
+        {
+            state.SetLabel("load failed");
+            break;
+        }
+        bench::DoNotOptimize((*table)->cards().size());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_DefinitionsLoadBinary);
+} // namespace
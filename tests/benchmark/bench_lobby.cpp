@@ -0,0 +1,118 @@
+/**
+ * ************************************************************************
+ *
+ * @file bench_lobby.cpp
+ * @author AnakinLiu (azrael2759@qq.com)
+ * @date 2026-10-16
+ * @version 0.1
+ * @brief 大厅基准：快速匹配吞吐，以及 ROOM_LIST 快照与逐次遍历编码的对比
+ *
+ * ************************************************************************
+ * @copyright Copyright (c) 2026 AnakinLiu
+ * For study and research only, no reprinting.
+ * ************************************************************************
+ */
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include "Benchmark.h"
+#include "src/server/lobby/Lobby.h"
+
+namespace
+{
+/**
+ * @brief count 名玩家快速匹配（每 8 人开一局），全部处理完后再离开，使房间回收
+ */
+void BM_LobbyQuickMatch(bench::State& state)
+{
+    const auto count = static_cast<uint32_t>(state.range(0));
+    std::atomic<uint64_t> frames{0};
+    lobby::Lobby lobby({.send = [&frames](uint32_t, const SharedFrame&)
+                        { frames.fetch_add(1, std::memory_order_relaxed); },
+                        .roomStarted = {}});
+    const JoinRoomRequest quickMatch;
+    for (auto _ : state)
+    {
+        for (uint32_t player = 1; player <= count; ++player)
+        {
+            lobby.join(player, quickMatch);
+        }
+        lobby.flush();
+
+        state.PauseTiming();
+        for (uint32_t player = 1; player <= count; ++player)
+        {
+            lobby.leave(player);
+        }
+        lobby.flush();
+        state.ResumeTiming();
+    }
+    bench::DoNotOptimize(frames);
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * count));
+}
+BENCHMARK(BM_LobbyQuickMatch)->Arg(64)->Arg(1024);
+
+/**
+ * @brief 准备 rooms 个等待中的自建房间
+ */
+void FillRooms(lobby::Lobby& lobby, uint32_t rooms)
+{
+    CreateRoomRequest request;
+    request.maxPlayers = lobby::ROOM_CAPACITY;
+    for (uint32_t owner = 1; owner <= rooms; ++owner)
+    {
+        request.roomName = "room " + std::to_string(owner);
+        lobby.create(owner, request);
+    }
+    lobby.flush();
+}
+
+/**
+ * @brief 改动前的做法：每个 ROOM_LIST 请求遍历所有房间并重新编码
+ */
+void BM_RoomListRebuild(bench::State& state)
+{
+    const auto rooms = static_cast<uint32_t>(state.range(0));
+    std::deque<lobby::Room> table; // Room 不可移动
+    for (uint32_t id = 1; id <= rooms; ++id)
+    {
+        table.emplace_back(id, "room " + std::to_string(id), "", lobby::ROOM_CAPACITY, utils::TaskScheduler::global());
+        table.back().takeSeat(id);
+    }
+    for (auto _ : state)
+    {
+        RoomListResponse response;
+        for (const auto& room : table)
+        {
+            if (room.state == lobby::RoomState::Waiting)
+            {
+                response.rooms.push_back(RoomListResponse::RoomInfo{.roomId = room.id,
+                                                                     .name = room.name,
+                                                                     .players = room.occupied,
+                                                                     .maxPlayers = room.capacity,
+                                                                     .hasPassword = !room.password.empty()});
+            }
+        }
+        auto frame = encodeSharedMessage(response);
+        bench::DoNotOptimize(frame);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_RoomListRebuild)->Arg(64)->Arg(512);
+
+void BM_RoomListSnapshot(bench::State& state)
+{
+    const auto rooms = static_cast<uint32_t>(state.range(0));
+    std::size_t bytes = 0;
+    lobby::Lobby lobby({.send = [&bytes](uint32_t, const SharedFrame& frame) { bytes += frame.size(); },
+                        .roomStarted = {}});
+    FillRooms(lobby, rooms);
+    for (auto _ : state)
+    {
+        lobby.sendRoomList(0);
+    }
+    bench::DoNotOptimize(bytes);
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_RoomListSnapshot)->Arg(64)->Arg(512);
+} // namespace
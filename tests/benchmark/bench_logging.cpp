@@ -0,0 +1,145 @@
+/**
+ * ************************************************************************
+ *
+ * @file bench_logging.cpp
+ * @author AnakinLiu (azrael2759@qq.com)
+ * @date 2026-10-16
+ * @version 0.1
+ * @brief 日志调用开销基准：被级别过滤的调用与实际输出的调用（同步 / 异步）
+ *
+ * ************************************************************************
+ * @copyright Copyright (c) 2026 AnakinLiu
+ * For study and research only, no reprinting.
+ * ************************************************************************
+ */
+#include <filesystem>
+#include <memory>
+#include <source_location>
+#include <string>
+#include <spdlog/sinks/basic_file_sink.h>
+#include "Benchmark.h"
+#include "src/utils/AsyncLogSink.h"
+#include "src/utils/Logger.h"
+
+namespace
+{
+/**
+ * @brief 临时替换全局日志器，析构时恢复
+ */
+class ScopedLogger
+{
+public:
+    explicit ScopedLogger(std::shared_ptr<spdlog::logger> logger)
+        : m_previous(std::exchange(utils::Logger::getLogger(), std::move(logger)))
+    {
+    }
+    ScopedLogger(const ScopedLogger&) = delete;
+    ScopedLogger& operator=(const ScopedLogger&) = delete;
+    ScopedLogger(ScopedLogger&&) = delete;
+    ScopedLogger& operator=(ScopedLogger&&) = delete;
+    ~ScopedLogger() { utils::Logger::getLogger() = std::move(m_previous); }
+
+private:
+    std::shared_ptr<spdlog::logger> m_previous;
+};
+
+std::string benchLogPath(const char* name)
+{
+    return (std::filesystem::temp_directory_path() / name).string();
+}
+
+/**
+ * @brief 改动前 LOG_DEBUG 使用的运行时路径归一化
+ */
+std::string legacyNormalizePath(const char* path)
+{
+    std::string result = path ? path : "";
+    for (auto& ch : result)
+    {
+        if (ch == '\\')
+        {
+            ch = '/';
+        }
+    }
+    return result;
+}
+
+/**
+ * @brief 改动前的 LOG_DEBUG 写法：先拼路径再交给 spdlog 判断级别
+ */
+#define LEGACY_LOG_DEBUG(fmt, ...)                                                                                     \
+    utils::Logger::getLogger()->debug("[{}:{} {}] " fmt,                                                               \
+                                      legacyNormalizePath(std::source_location::current().file_name()),                \
+                                      std::source_location::current().line(),                                          \
+                                      std::source_location::current().function_name(),                                 \
+                                      ##__VA_ARGS__)
+
+void BM_LogSuppressed(bench::State& state)
+{
+    auto logger = std::make_shared<spdlog::logger>("bench_suppressed");
+    logger->set_level(spdlog::level::info);
+    ScopedLogger scoped(logger);
+    int value = 0;
+    for (auto _ : state)
+    {
+        LOG_DEBUG("player {} drew {} cards", value, 2);
+        ++value;
+    }
+    bench::DoNotOptimize(value);
+}
+BENCHMARK(BM_LogSuppressed);
+
+void BM_LogSuppressedLegacy(bench::State& state)
+{
+    auto logger = std::make_shared<spdlog::logger>("bench_suppressed_legacy");
+    logger->set_level(spdlog::level::info);
+    ScopedLogger scoped(logger);
+    int value = 0;
+    for (auto _ : state)
+    {
+        LEGACY_LOG_DEBUG("player {} drew {} cards", value, 2);
+        ++value;
+    }
+    bench::DoNotOptimize(value);
+}
+BENCHMARK(BM_LogSuppressedLegacy);
+
+void BM_LogEmittedSync(bench::State& state)
+{
+    auto sink = std::make_shared<spdlog::sinks::basic_file_sink_mt>(benchLogPath("pmk_bench_sync.log"), true);
+    sink->set_pattern("[%Y-%m-%d %H:%M:%S.%e] [%l] [%s:%# %!] %v");
+    auto logger = std::make_shared<spdlog::logger>("bench_sync", sink);
+    logger->set_level(spdlog::level::debug);
+    ScopedLogger scoped(logger);
+    int value = 0;
+    for (auto _ : state)
+    {
+        LOG_INFO("player {} drew {} cards", value, 2);
+        ++value;
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+BENCHMARK(BM_LogEmittedSync);
+
+void BM_LogEmittedAsync(bench::State& state)
+{
+    auto fileSink = std::make_shared<spdlog::sinks::basic_file_sink_st>(benchLogPath("pmk_bench_async.log"), true);
+    fileSink->set_pattern("[%Y-%m-%d %H:%M:%S.%e] [%l] [%s:%# %!] %v");
+    auto sink = std::make_shared<utils::AsyncLogSink>(std::vector<spdlog::sink_ptr>{fileSink});
+    auto logger = std::make_shared<spdlog::logger>("bench_async", sink);
+    logger->set_level(spdlog::level::debug);
+    ScopedLogger scoped(logger);
+    int value = 0;
+    for (auto _ : state)
+    {
+        LOG_INFO("player {} drew {} cards", value, 2);
+        ++value;
+    }
+    // 计时循环已结束，排空不计入耗时
+    sink->drain();
+    // 写线程跟不上时的丢弃数，用于判断队列容量是否足够
+    state.counters["dropped"] = static_cast<double>(sink->dropped());
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+BENCHMARK(BM_LogEmittedAsync);
+} // namespace
@@ -0,0 +1,139 @@
+/**
+ * ************************************************************************
+ *
+ * @file bench_net.cpp
+ * @author AnakinLiu (azrael2759@qq.com)
+ * @date 2026-10-16
+ * @version 0.1
+ * @brief 广播开销基准：逐个接收者序列化/编码/拷贝与一次编码、共享引用的对比
+    计数 items 为接收者，items/s 的倒数即每个接收者的 CPU 开销
+ *
+ * ************************************************************************
+ * @copyright Copyright (c) 2026 AnakinLiu
+ * For study and research only, no reprinting.
+ * ************************************************************************
+ */
+#include <memory>
+#include <span>
+#include <string>
+#include <vector>
+#include <asio/any_io_executor.hpp>
+#include <asio/io_context.hpp>
+#include "Benchmark.h"
+#include "src/net/Session/KcpSession.h"
+#include "src/shared/messages/MessageDispatcher.h"
+#include "src/shared/messages/request/SendMessageRequest.h"
+
+namespace
+{
+constexpr uint64_t RESET_INTERVAL = 256; // 没有对端确认，定期重建会话以免 KCP 发送队列无限增长
+
+/**
+ * @brief 丢弃所有数据报的传输层
+ */
+class NullTransport final : public IUdpTransport
+{
+public:
+    void send(const NetAddress& /*address*/, std::span<const uint8_t> data) override { m_bytes += data.size(); }
+
+private:
+    size_t m_bytes = 0;
+};
+
+/**
+ * @brief 一组已建立的会话，模拟房间内的玩家与观战者
+ */
+struct Audience
+{
+    asio::io_context ioc;
+    asio::any_io_executor executor = ioc.get_executor();
+    NullTransport transport;
+    std::vector<std::shared_ptr<KcpSession>> sessions;
+    size_t count;
+
+    explicit Audience(size_t count) : count(count) { reset(); }
+
+    void reset()
+    {
+        sessions.clear();
+        for (size_t index = 0; index < count; ++index)
+        {
+            auto session =
+                std::make_shared<KcpSession>(static_cast<uint32_t>(index + 1), transport, NetAddress{}, executor);
+            session->update(0);
+            sessions.push_back(std::move(session));
+        }
+    }
+
+    void update()
+    {
+        for (const auto& session : sessions)
+        {
+            session->update(0);
+        }
+    }
+};
+
+SendMessageRequest makeChat()
+{
+    SendMessageRequest message;
+    message.channelId = 1;
+    message.content = std::string(96, 'x');
+    return message;
+}
+
+/**
+ * @brief 改动前的写法：每个接收者各自 serialize、encodeFrame 再 send
+ */
+void BM_BroadcastPerRecipient(bench::State& state)
+{
+    Audience audience(static_cast<size_t>(state.range(0)));
+    const auto message = makeChat();
+    uint64_t sent = 0;
+    for (auto _ : state)
+    {
+        for (const auto& session : audience.sessions)
+        {
+            auto payload = message.serialize();
+            std::vector<uint8_t> frame(sizeof(FrameHeader) + payload.size());
+            auto encoded = encodeFrame(frame, SendMessageRequest::CMD_ID, payload);
+            session->send(*encoded);
+        }
+        audience.update();
+        if (++sent % RESET_INTERVAL == 0)
+        {
+            state.PauseTiming();
+            audience.reset();
+            state.ResumeTiming();
+        }
+    }
+    state.counters["recipients"] = static_cast<double>(audience.count);
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * audience.count));
+}
+BENCHMARK(BM_BroadcastPerRecipient)->Arg(1)->Arg(8)->Arg(64);
+
+/**
+ * @brief 一次编码为 SharedFrame，各会话只持有引用，update 时拷入 KCP 分段
+ */
+void BM_BroadcastShared(bench::State& state)
+{
+    Audience audience(static_cast<size_t>(state.range(0)));
+    const auto message = makeChat();
+    uint64_t sent = 0;
+    for (auto _ : state)
+    {
+        auto frame = encodeSharedMessage(message);
+        KcpSession::broadcast(audience.sessions, *frame);
+        audience.update();
+        if (++sent % RESET_INTERVAL == 0)
+        {
+            state.PauseTiming();
+            audience.reset();
+            state.ResumeTiming();
+        }
+    }
+    state.counters["recipients"] = static_cast<double>(audience.count);
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * audience.count));
+}
+BENCHMARK(BM_BroadcastShared)->Arg(1)->Arg(8)->Arg(64);
+} // namespace
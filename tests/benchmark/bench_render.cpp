@@ -0,0 +1,488 @@
+/**
+ * ************************************************************************
+ *
+ * @file bench_render.cpp
+ * @author AnakinLiu (azrael2759@qq.com)
+ * @date 2026-10-16
+ * @version 0.1
+ * @brief 渲染收集基准：5000 个节点的 UI 树
+ *
+ * - RenderQueue 紧凑记录 vs 改动前逐节点复制 RenderContext（渲染器为空实现，只测遍历与排序）
+ * - RenderCache 悬停一行（只重新生成该行）vs 每帧全部重新生成（渲染器写入背景与 12 个字形的矩形）
+ * - SoftwareRasterizer 把整帧批次光栅化到 1920x1080 的内存缓冲区（多线程 vs 单线程），输出帧率
+ * 不涉及 GPU；树结构：窗口 → 50 个面板（每 5 个带 ScrollArea）→ 每个面板 99 行，部分行带 Alpha / ZOrderIndex
+ *
+ * ************************************************************************
+ * @copyright Copyright (c) 2026 AnakinLiu
+ * For study and research only, no reprinting.
+ * ************************************************************************
+ */
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <vector>
+#include "Benchmark.h"
+#include "src/ui/core/RenderCache.hpp"
+#include "src/ui/managers/SoftwareRasterizer.hpp"
+
+namespace
+{
+constexpr int PANEL_COUNT = 50;
+constexpr int ROWS_PER_PANEL = 99;
+
+namespace components = ui::components;
+using ui::Registry;
+
+/**
+ * @brief 空渲染器：按实体编号决定是否处理，模拟背景 / 文本 / 图标渲染器的组合
+ */
+class StubRenderer : public ui::core::IRenderer
+{
+public:
+    explicit StubRenderer(uint32_t modulo) : m_modulo(modulo) {}
+    [[nodiscard]] bool canHandle(entt::entity entity) const override
+    {
+        return static_cast<uint32_t>(entity) % m_modulo == 0;
+    }
+    void collect(entt::entity /*entity*/, ui::core::RenderContext& /*context*/) override {}
+
+private:
+    uint32_t m_modulo;
+};
+
+std::vector<std::unique_ptr<ui::core::IRenderer>> MakeRenderers()
+{
+    std::vector<std::unique_ptr<ui::core::IRenderer>> renderers;
+    renderers.push_back(std::make_unique<StubRenderer>(1));
+    renderers.push_back(std::make_unique<StubRenderer>(2));
+    renderers.push_back(std::make_unique<StubRenderer>(7));
+    return renderers;
+}
+
+SDL_GPUTexture* FakeTexture(std::uintptr_t id)
+{
+    return reinterpret_cast<SDL_GPUTexture*>(id * 0x100);
+}
+
+/**
+ * @brief 背景：一个带圆角的矩形，颜色取自 Background
+ */
+class BackgroundRenderer : public ui::core::IRenderer
+{
+public:
+    [[nodiscard]] bool canHandle(entt::entity entity) const override
+    {
+        return Registry::AnyOf<components::Background>(entity);
+    }
+    void collect(entt::entity entity, ui::core::RenderContext& context) override
+    {
+        const auto& color = Registry::Get<components::Background>(entity).color;
+        ui::render::ShapeParams shape{};
+        std::fill(std::begin(shape.radius), std::end(shape.radius), 4.0F);
+        shape.opacity = context.alpha;
+        context.batchManager->beginBatch(FakeTexture(1), context.currentScissor);
+        context.batchManager->addRect(
+            context.position, context.size, {color.red, color.green, color.blue, color.alpha}, shape);
+    }
+};
+
+/**
+ * @brief 文本：每行 12 个字形矩形，共用一张图集
+ */
+class LabelRenderer : public ui::core::IRenderer
+{
+public:
+    [[nodiscard]] bool canHandle(entt::entity entity) const override
+    {
+        return Registry::AnyOf<components::LabelTag>(entity);
+    }
+    void collect(entt::entity /*entity*/, ui::core::RenderContext& context) override
+    {
+        ui::render::ShapeParams shape{};
+        shape.opacity = context.alpha;
+        shape.premultiplied = true;
+        context.batchManager->beginBatch(FakeTexture(2), context.currentScissor);
+        for (int glyph = 0; glyph < 12; ++glyph)
+        {
+            const Eigen::Vector2f pos{context.position.x() + 6.0F + static_cast<float>(glyph) * 8.0F,
+                                      context.position.y() + 3.0F};
+            context.batchManager->addRect(
+                pos, {7.0F, 12.0F}, {1.0F, 1.0F, 1.0F, 1.0F}, shape, {0.0F, 0.0F}, {0.1F, 0.1F});
+        }
+    }
+};
+
+std::vector<std::unique_ptr<ui::core::IRenderer>> MakeGeometryRenderers()
+{
+    std::vector<std::unique_ptr<ui::core::IRenderer>> renderers;
+    renderers.push_back(std::make_unique<BackgroundRenderer>());
+    renderers.push_back(std::make_unique<LabelRenderer>());
+    return renderers;
+}
+
+entt::entity CreateNode(entt::entity parent, const Eigen::Vector2f& position, const Eigen::Vector2f& size)
+{
+    const entt::entity entity = Registry::Create();
+    Registry::Emplace<components::Position>(entity).value = position;
+    Registry::Emplace<components::Size>(entity).size = size;
+    Registry::Emplace<components::VisibleTag>(entity);
+    Registry::Emplace<components::Background>(entity).color = {0.2F, 0.2F, 0.2F, 1.0F};
+    Registry::Emplace<components::Hierarchy>(entity).parent = parent;
+    if (parent != entt::null)
+    {
+        Registry::Get<components::Hierarchy>(parent).children.push_back(entity);
+    }
+    return entity;
+}
+
+/**
+ * @brief 建一棵 1 + 50 + 50 × 99 = 5001 个节点的树，返回窗口实体
+ */
+entt::entity BuildTree()
+{
+    static const entt::entity window = []
+    {
+        const entt::entity root = CreateNode(entt::null, {0.0F, 0.0F}, {1920.0F, 1080.0F});
+        for (int panelIndex = 0; panelIndex < PANEL_COUNT; ++panelIndex)
+        {
+            const auto column = static_cast<float>(panelIndex % 10);
+            const auto row = static_cast<float>(panelIndex / 10);
+            const entt::entity panel = CreateNode(root, {column * 190.0F, row * 210.0F}, {180.0F, 200.0F});
+            if (panelIndex % 5 == 0)
+            {
+                Registry::Emplace<components::ScrollArea>(panel).scrollOffset = {0.0F, 40.0F};
+            }
+            for (int rowIndex = 0; rowIndex < ROWS_PER_PANEL; ++rowIndex)
+            {
+                const entt::entity item =
+                    CreateNode(panel, {4.0F, static_cast<float>(rowIndex) * 20.0F}, {172.0F, 18.0F});
+                Registry::Emplace<components::LabelTag>(item);
+                if (rowIndex % 4 == 0)
+                {
+                    Registry::Emplace<components::Alpha>(item).value = 0.8F;
+                }
+                if (rowIndex % 33 == 0)
+                {
+                    Registry::Emplace<components::ZOrderIndex>(item).value = 10;
+                }
+            }
+        }
+        return root;
+    }();
+    return window;
+}
+
+/**
+ * @brief 改动前的 RenderContext：裁剪栈为 std::vector，复制即分配
+ */
+struct LegacyContext
+{
+    Eigen::Vector2f position{0.0F, 0.0F};
+    Eigen::Vector2f size{0.0F, 0.0F};
+    float alpha = 1.0F;
+    float screenWidth = 0.0F;
+    float screenHeight = 0.0F;
+    std::vector<SDL_Rect> scissorStack;
+    std::optional<SDL_Rect> currentScissor;
+    void* managers[7] = {};
+
+    void pushScissor(const SDL_Rect& rect)
+    {
+        SDL_Rect newScissor = rect;
+        if (!scissorStack.empty())
+        {
+            const SDL_Rect& parent = scissorStack.back();
+            if (!SDL_GetRectIntersection(&newScissor, &parent, &newScissor))
+            {
+                newScissor.w = 0;
+                newScissor.h = 0;
+            }
+        }
+        scissorStack.push_back(newScissor);
+        currentScissor = newScissor;
+    }
+
+    void popScissor()
+    {
+        if (scissorStack.empty()) return;
+        scissorStack.pop_back();
+        currentScissor = scissorStack.empty() ? std::nullopt : std::optional<SDL_Rect>(scissorStack.back());
+    }
+};
+
+struct LegacyItem
+{
+    uint64_t sortKey = 0;
+    entt::entity entity = entt::null;
+    ui::core::IRenderer* renderer = nullptr;
+    LegacyContext context;
+
+    bool operator<(const LegacyItem& other) const { return sortKey < other.sortKey; }
+};
+
+/**
+ * @brief 改动前的 RenderSystem::collectRenderData
+ */
+class LegacyCollector
+{
+public:
+    explicit LegacyCollector(const std::vector<std::unique_ptr<ui::core::IRenderer>>& renderers)
+        : m_renderers(renderers)
+    {
+    }
+
+    void collect(entt::entity entity, LegacyContext& context)
+    {
+        if (!Registry::AnyOf<components::VisibleTag>(entity)) return;
+        if (Registry::AnyOf<components::SpacerTag>(entity)) return;
+
+        const auto& pos = Registry::Get<components::Position>(entity);
+        const auto& size = Registry::Get<components::Size>(entity);
+        const auto* alphaComp = Registry::TryGet<components::Alpha>(entity);
+        const auto* scaleComp = Registry::TryGet<components::Scale>(entity);
+        const auto* offsetComp = Registry::TryGet<components::RenderOffset>(entity);
+
+        const float globalAlpha = context.alpha * (alphaComp != nullptr ? alphaComp->value : 1.0F);
+        Eigen::Vector2f absolutePos = context.position + pos.value;
+        Eigen::Vector2f finalSize = size.size;
+        if (offsetComp != nullptr)
+        {
+            absolutePos += offsetComp->value;
+        }
+        if (scaleComp != nullptr)
+        {
+            Eigen::Vector2f scaleDiff = size.size.cwiseProduct(Eigen::Vector2f::Ones() - scaleComp->value);
+            absolutePos += scaleDiff * 0.5F;
+            finalSize = size.size.cwiseProduct(scaleComp->value);
+        }
+
+        Eigen::Vector2f contentOffset(0.0F, 0.0F);
+        LegacyContext entityContext = context;
+        entityContext.position = absolutePos;
+        entityContext.size = finalSize;
+        entityContext.alpha = globalAlpha;
+
+        const auto* scrollArea = Registry::TryGet<components::ScrollArea>(entity);
+        bool pushScissor = false;
+        if (scrollArea != nullptr)
+        {
+            SDL_Rect currentScissor;
+            currentScissor.x = static_cast<int>(absolutePos.x());
+            currentScissor.y = static_cast<int>(absolutePos.y());
+            currentScissor.w = static_cast<int>(size.size.x());
+            currentScissor.h = static_cast<int>(size.size.y());
+            entityContext.pushScissor(currentScissor);
+            pushScissor = true;
+            contentOffset = -scrollArea->scrollOffset;
+        }
+
+        int32_t zOrder = 0;
+        if (const auto* zOrderComp = Registry::TryGet<components::ZOrderIndex>(entity))
+        {
+            zOrder = zOrderComp->value;
+        }
+        auto encodedZ = static_cast<uint64_t>(static_cast<int64_t>(zOrder) + 2147483648LL);
+
+        for (const auto& renderer : m_renderers)
+        {
+            if (renderer->canHandle(entity))
+            {
+                LegacyItem item;
+                item.entity = entity;
+                item.renderer = renderer.get();
+                item.context = entityContext;
+                item.sortKey = (encodedZ << 32) | (m_submissionIndex & 0xFFFFFFFF);
+                queue.push_back(item);
+                m_submissionIndex++;
+            }
+        }
+
+        const auto* hierarchy = Registry::TryGet<components::Hierarchy>(entity);
+        if (hierarchy != nullptr && !hierarchy->children.empty())
+        {
+            for (entt::entity child : hierarchy->children)
+            {
+                LegacyContext childContext = entityContext;
+                childContext.position = absolutePos + contentOffset;
+                collect(child, childContext);
+            }
+        }
+
+        if (pushScissor)
+        {
+            entityContext.popScissor();
+        }
+    }
+
+    void clear()
+    {
+        queue.clear();
+        m_submissionIndex = 0;
+    }
+
+    std::vector<LegacyItem> queue;
+
+private:
+    const std::vector<std::unique_ptr<ui::core::IRenderer>>& m_renderers;
+    uint32_t m_submissionIndex = 0;
+};
+
+void BM_CollectRenderQueue(bench::State& state)
+{
+    const entt::entity window = BuildTree();
+    const auto renderers = MakeRenderers();
+    ui::core::RenderQueue queue;
+    ui::core::RenderContext context;
+
+    for (auto _ : state)
+    {
+        queue.clear();
+        queue.build(window, {0.0F, 0.0F}, renderers);
+        queue.sort();
+        for (const uint32_t index : queue.order())
+        {
+            const auto& item = queue.items()[index];
+            queue.apply(item, context);
+            item.renderer->collect(item.entity, context);
+        }
+        bench::DoNotOptimize(context);
+    }
+    state.counters["items"] = static_cast<double>(queue.items().size());
+    state.counters["scissors"] = static_cast<double>(queue.scissorCount());
+    state.counters["item_bytes"] = static_cast<double>(sizeof(ui::core::RenderItem));
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * queue.items().size()));
+}
+BENCHMARK(BM_CollectRenderQueue);
+
+void BM_CollectRenderQueueLegacy(bench::State& state)
+{
+    const entt::entity window = BuildTree();
+    const auto renderers = MakeRenderers();
+    LegacyCollector collector(renderers);
+
+    for (auto _ : state)
+    {
+        collector.clear();
+        LegacyContext rootContext;
+        collector.collect(window, rootContext);
+        std::sort(collector.queue.begin(), collector.queue.end());
+        for (auto& item : collector.queue)
+        {
+            ui::core::RenderContext context;
+            context.position = item.context.position;
+            context.size = item.context.size;
+            context.alpha = item.context.alpha;
+            context.currentScissor = item.context.currentScissor;
+            item.renderer->collect(item.entity, context);
+        }
+        bench::DoNotOptimize(collector.queue);
+    }
+    state.counters["items"] = static_cast<double>(collector.queue.size());
+    state.counters["item_bytes"] = static_cast<double>(sizeof(LegacyItem));
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * collector.queue.size()));
+}
+BENCHMARK(BM_CollectRenderQueueLegacy);
+
+/**
+ * @brief 保留模式：每帧悬停一行（改变背景颜色并标记为脏），只重新生成这一行
+ */
+void BM_RenderCacheHover(bench::State& state)
+{
+    const entt::entity window = BuildTree();
+    const auto renderers = MakeGeometryRenderers();
+    ui::managers::BatchManager batchManager;
+    ui::core::RenderContext context;
+    context.screenWidth = 1920.0F;
+    context.screenHeight = 1080.0F;
+    context.batchManager = &batchManager;
+    ui::core::RenderCache cache;
+    cache.collect(window, {0.0F, 0.0F}, renderers, context);
+
+    const auto& panel = Registry::Get<components::Hierarchy>(window).children[7];
+    const auto& rows = Registry::Get<components::Hierarchy>(panel).children;
+    size_t frame = 0;
+    for (auto _ : state)
+    {
+        const entt::entity hovered = rows[frame % rows.size()];
+        Registry::Get<components::Background>(hovered).color.red = (frame % 2 == 0) ? 0.4F : 0.2F;
+        cache.markDirty(hovered);
+        ++frame;
+
+        batchManager.clear();
+        cache.collect(window, {0.0F, 0.0F}, renderers, context);
+        bench::DoNotOptimize(batchManager.getInstanceCount());
+    }
+    state.counters["regenerated"] = static_cast<double>(cache.stats().regeneratedItems);
+    state.counters["reused"] = static_cast<double>(cache.stats().reusedItems);
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * cache.queue().items().size()));
+}
+BENCHMARK(BM_RenderCacheHover);
+
+/**
+ * @brief 改动前的行为：任何脏标记都重新遍历整棵树并重新生成全部几何
+ */
+void BM_RenderCacheFullRebuild(bench::State& state)
+{
+    const entt::entity window = BuildTree();
+    const auto renderers = MakeGeometryRenderers();
+    ui::managers::BatchManager batchManager;
+    ui::core::RenderContext context;
+    context.screenWidth = 1920.0F;
+    context.screenHeight = 1080.0F;
+    context.batchManager = &batchManager;
+    ui::core::RenderCache cache;
+
+    for (auto _ : state)
+    {
+        cache.invalidate();
+        batchManager.clear();
+        cache.collect(window, {0.0F, 0.0F}, renderers, context);
+        bench::DoNotOptimize(batchManager.getInstanceCount());
+    }
+    state.counters["regenerated"] = static_cast<double>(cache.stats().regeneratedItems);
+    state.counters["upload_bytes"] =
+        static_cast<double>(batchManager.getInstanceCount() * sizeof(ui::render::QuadInstance));
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * cache.queue().items().size()));
+}
+BENCHMARK(BM_RenderCacheFullRebuild);
+
+/**
+ * @brief 整帧软件光栅化：收集一次，每次迭代清屏并绘制全部实例（scheduler 为空时单线程）
+ */
+void RunSoftwareRasterize(bench::State& state, utils::TaskScheduler* scheduler)
+{
+    const entt::entity window = BuildTree();
+    const auto renderers = MakeGeometryRenderers();
+    ui::managers::BatchManager batchManager;
+    ui::core::RenderContext context;
+    context.screenWidth = 1920.0F;
+    context.screenHeight = 1080.0F;
+    context.batchManager = &batchManager;
+    ui::core::RenderCache cache;
+    cache.collect(window, {0.0F, 0.0F}, renderers, context);
+    batchManager.optimize();
+
+    ui::managers::SoftwareRasterizer rasterizer(scheduler);
+    rasterizer.resize(1920, 1080);
+    for (auto _ : state)
+    {
+        rasterizer.execute(batchManager);
+        bench::DoNotOptimize(rasterizer.pixels().data());
+    }
+    state.counters["instances"] = static_cast<double>(batchManager.getInstanceCount());
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations())); // items_per_second 即帧率
+}
+
+void BM_SoftwareRasterize(bench::State& state)
+{
+    RunSoftwareRasterize(state, &utils::TaskScheduler::global());
+}
+BENCHMARK(BM_SoftwareRasterize);
+
+void BM_SoftwareRasterizeSingleThread(bench::State& state)
+{
+    RunSoftwareRasterize(state, nullptr);
+}
+BENCHMARK(BM_SoftwareRasterizeSingleThread);
+} // namespace
@@ -0,0 +1,433 @@
+/**
+ * ************************************************************************
+ *
+ * @file bench_server.cpp
+ * @author AnakinLiu (azrael2759@qq.com)
+ * @date 2026-10-16
+ * @version 0.1
+ * @brief 服务端系统基准：DeckSystem 发牌/弃牌、DamageSystem 伤害结算、分发器开销与整回合宏观基准
+    整回合基准使用真实的 lobby::Room：tick 驱动 GameFlowSystem 的阶段状态机，玩家操作由挂在 TurnPhase 上的脚本完成
+    BM_DamageDrawCycle/BM_FindCardInHands 在玩家持有起始手牌时衡量 group 与内联手牌的效果
+    BM_AreaDamage* 对比群体伤害逐目标结算与整批结算（两者都注册了修正与防止处理函数）
+ *
+ * ************************************************************************
+ * @copyright Copyright (c) 2026 AnakinLiu
+ * For study and research only, no reprinting.
+ * ************************************************************************
+ */
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <vector>
+#include <entt/entt.hpp>
+#include "Benchmark.h"
+#include "src/server/components/Card.h"
+#include "src/server/components/Character.h"
+#include "src/server/components/Player.h"
+#include "src/server/context/GameContext.h"
+#include "src/server/events/DeckEvents.h"
+#include "src/server/events/Events.h"
+#include "src/server/events/GameFlowEvents.h"
+#include "src/server/lobby/Room.h"
+#include "src/server/rules/CardRules.h"
+#include "src/server/systems/DamageSystem.h"
+#include "src/server/systems/DeckSystem.h"
+#include "src/utils/TaskScheduler.h"
+
+namespace
+{
+constexpr uint32_t SEATS = 8;
+constexpr uint8_t DRAW_PER_TURN = rules::DRAW_PER_TURN;
+constexpr uint8_t OPENING_HAND = 4;
+constexpr int RESET_HEALTH = 1000;
+
+/**
+ * @brief 8 人房间：牌堆、伤害系统与玩家实体
+ */
+struct Room
+{
+    std::unique_ptr<GameContext> context = std::make_unique<GameContext>();
+    std::unique_ptr<DeckSystem> deckSystem;
+    std::unique_ptr<DamageSystem> damageSystem;
+    std::vector<entt::entity> players;
+
+    Room()
+    {
+        // 基准中不写日志文件
+        context->logger->set_level(spdlog::level::warn);
+        deckSystem = std::make_unique<DeckSystem>(*context);
+        deckSystem->registerEvents();
+        damageSystem = std::make_unique<DamageSystem>(*context);
+        damageSystem->init();
+        for (uint32_t seat = 0; seat < SEATS; ++seat)
+        {
+            auto player = context->registry.create();
+            context->registry.emplace<HandCards>(player, HandCards{HandCards::Zone(context->registry.get_allocator())});
+            context->registry.emplace<Equipments>(player);
+            context->registry.emplace<CombatState>(
+                player, CombatState{.currentHealth = RESET_HEALTH, .maxHealth = RESET_HEALTH});
+            context->registry.emplace<Attributes>(player);
+            players.push_back(player);
+        }
+    }
+
+    Room(const Room&) = delete;
+    Room& operator=(const Room&) = delete;
+    Room(Room&&) = delete;
+    Room& operator=(Room&&) = delete;
+
+    ~Room()
+    {
+        damageSystem->destroy();
+        deckSystem->unregisterEvents();
+    }
+
+    /**
+     * @brief 玩家摸牌后立即弃掉所摸的牌并结算完成
+     */
+    void drawAndDiscard(entt::entity player)
+    {
+        auto& dispatcher = context->dispatcher;
+        dispatcher.trigger(events::DealCards{.player = player, .count = DRAW_PER_TURN});
+        auto& hand = context->registry.get<HandCards>(player).handCards;
+        memory::Vector<entt::entity> cards(hand.end() - DRAW_PER_TURN, hand.end(), context->registry.get_allocator());
+        dispatcher.trigger(events::CardDiscarded{.player = player, .card = cards, .count = DRAW_PER_TURN});
+        dispatcher.trigger(events::DetailFinish{.player = player, .cards = std::move(cards)});
+    }
+
+    void resetHealth()
+    {
+        for (auto player : players)
+        {
+            context->registry.get<CombatState>(player).currentHealth = RESET_HEALTH;
+        }
+    }
+
+    void playRound()
+    {
+        for (std::size_t seat = 0; seat < SEATS; ++seat)
+        {
+            auto player = players[seat];
+            drawAndDiscard(player);
+            context->dispatcher.trigger(events::Damage{.from = player, .to = players[(seat + 1) % SEATS], .amount = 1});
+            context->dispatcher.trigger(events::SettleEffects{});
+        }
+    }
+
+    /**
+     * @brief 每人发起始手牌，之后的回合手牌保持在 OPENING_HAND 张左右
+     */
+    void dealOpeningHands()
+    {
+        for (auto player : players)
+        {
+            context->dispatcher.trigger(events::DealCards{.player = player, .count = OPENING_HAND});
+        }
+    }
+
+    void reportMemory(bench::State& state) const
+    {
+        auto stats = context->roomMemory.stats();
+        state.counters["room_reserved_bytes"] = static_cast<double>(stats.reservedBytes);
+        state.counters["room_peak_bytes"] = static_cast<double>(stats.peakInUseBytes);
+    }
+};
+
+void BM_DeckDrawDiscard(bench::State& state)
+{
+    Room room;
+    std::size_t seat = 0;
+    for (auto _ : state)
+    {
+        room.drawAndDiscard(room.players[seat]);
+        seat = (seat + 1) % SEATS;
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * DRAW_PER_TURN));
+}
+BENCHMARK(BM_DeckDrawDiscard);
+
+void BM_DamageEvent(bench::State& state)
+{
+    Room room;
+    std::size_t seat = 0;
+    uint64_t dealt = 0;
+    for (auto _ : state)
+    {
+        room.context->dispatcher.trigger(
+            events::Damage{.from = room.players[0], .to = room.players[seat], .amount = 1});
+        room.context->dispatcher.trigger(events::SettleEffects{});
+        seat = (seat + 1) % SEATS;
+        if (++dealt % (RESET_HEALTH / 2) == 0)
+        {
+            state.PauseTiming();
+            room.resetHealth();
+            state.ResumeTiming();
+        }
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+BENCHMARK(BM_DamageEvent);
+
+/**
+ * @brief 群体伤害的处理函数：来源加 1（修正），目标持有护甲时防止群体伤害（防止）
+ */
+void addAreaPasses(Room& room, entt::entity armored)
+{
+    room.damageSystem->addPass(rules::EffectPhase::Modify,
+                               [source = room.players[0]](std::span<rules::PendingEffect> effects)
+                               {
+                                   for (auto& effect : effects)
+                                   {
+                                       effect.amount += static_cast<int32_t>(effect.source == source);
+                                   }
+                               });
+    room.damageSystem->addPass(rules::EffectPhase::Prevent,
+                               [armored](std::span<rules::PendingEffect> effects)
+                               {
+                                   for (auto& effect : effects)
+                                   {
+                                       if ((effect.tags & rules::EFFECT_TAG_AREA) != 0 && effect.target == armored)
+                                       {
+                                           effect.amount = 0;
+                                       }
+                                   }
+                               });
+}
+
+/**
+ * @brief 群体伤害逐目标结算：每个目标触发一次 Damage 并单独结算（原先的级联方式）
+ */
+void BM_AreaDamageCascade(bench::State& state)
+{
+    Room room;
+    addAreaPasses(room, room.players[2]);
+    std::span<const entt::entity> targets(room.players.begin() + 1, room.players.end());
+    uint64_t rounds = 0;
+    for (auto _ : state)
+    {
+        for (auto target : targets)
+        {
+            room.context->dispatcher.trigger(events::Damage{.from = room.players[0], .to = target, .amount = 1});
+            room.context->dispatcher.trigger(events::SettleEffects{});
+        }
+        if (++rounds % (RESET_HEALTH / 4) == 0)
+        {
+            state.PauseTiming();
+            room.resetHealth();
+            state.ResumeTiming();
+        }
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * targets.size()));
+}
+BENCHMARK(BM_AreaDamageCascade);
+
+/**
+ * @brief 群体伤害整批结算：所有目标写入缓冲区，一次结算
+ */
+void BM_AreaDamageBatched(bench::State& state)
+{
+    Room room;
+    addAreaPasses(room, room.players[2]);
+    std::span<const entt::entity> targets(room.players.begin() + 1, room.players.end());
+    uint64_t rounds = 0;
+    for (auto _ : state)
+    {
+        room.damageSystem->enqueueArea(room.players[0], targets, 1);
+        room.context->dispatcher.trigger(events::SettleEffects{});
+        if (++rounds % (RESET_HEALTH / 4) == 0)
+        {
+            state.PauseTiming();
+            room.resetHealth();
+            state.ResumeTiming();
+        }
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * targets.size()));
+}
+BENCHMARK(BM_AreaDamageBatched);
+
+/**
+ * @brief 无监听者的 trigger，衡量分发器本身的开销
+ */
+void BM_DispatcherTriggerNoListener(bench::State& state)
+{
+    GameDispatcher dispatcher;
+    for (auto _ : state)
+    {
+        dispatcher.trigger(events::NextTurn{});
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+BENCHMARK(BM_DispatcherTriggerNoListener);
+
+/**
+ * @brief 真实房间：Room::start 创建系统与玩家，Room::tick 推进阶段状态机
+ *
+ * 摸牌阶段由 GameFlowSystem 发牌；玩家脚本挂在 TurnPhase 上：出牌阶段对下家造成 1 点伤害并结束出牌，弃牌阶段弃掉所摸的牌
+ */
+struct FlowRoom
+{
+    lobby::Room room{1, "bench", "", static_cast<uint8_t>(SEATS), utils::TaskScheduler::global()};
+    uint64_t turns = 0; // 已结束的回合数
+
+    FlowRoom()
+    {
+        for (uint32_t seat = 0; seat < SEATS; ++seat)
+        {
+            room.takeSeat(seat + 1);
+        }
+        room.start(room.seats);
+        room.context->logger->set_level(spdlog::level::warn);
+        room.context->dispatcher.sink<events::TurnPhase>().connect<&FlowRoom::onPhase>(*this);
+        resetHealth();
+    }
+
+    FlowRoom(const FlowRoom&) = delete;
+    FlowRoom& operator=(const FlowRoom&) = delete;
+    FlowRoom(FlowRoom&&) = delete;
+    FlowRoom& operator=(FlowRoom&&) = delete;
+
+    ~FlowRoom() { room.context->dispatcher.sink<events::TurnPhase>().disconnect<&FlowRoom::onPhase>(*this); }
+
+    void onPhase(const events::TurnPhase& event)
+    {
+        auto& dispatcher = room.context->dispatcher;
+        switch (event.currentPhase)
+        {
+            case TurnPhase::PLAY:
+                dispatcher.trigger(events::Damage{.from = event.player, .to = nextOf(event.player), .amount = 1});
+                dispatcher.trigger(events::EndPlayPhase{.player = event.player});
+                break;
+            case TurnPhase::DISCARD:
+            {
+                auto& hand = room.context->registry.get<HandCards>(event.player).handCards;
+                memory::Vector<entt::entity> cards(
+                    hand.end() - DRAW_PER_TURN, hand.end(), room.context->registry.get_allocator());
+                dispatcher.trigger(
+                    events::CardDiscarded{.player = event.player, .card = cards, .count = DRAW_PER_TURN});
+                dispatcher.trigger(events::DetailFinish{.player = event.player, .cards = std::move(cards)});
+                break;
+            }
+            case TurnPhase::END: ++turns; break;
+            default: break;
+        }
+    }
+
+    [[nodiscard]] entt::entity nextOf(entt::entity player) const
+    {
+        for (uint32_t seat = 0; seat < SEATS; ++seat)
+        {
+            if (room.players[seat] == player)
+            {
+                return room.players[(seat + 1) % SEATS];
+            }
+        }
+        return player;
+    }
+
+    /**
+     * @brief tick 直到每个座位都走完一个回合；单次 tick 最多执行 MAX_PHASE_STEPS_PER_TICK 个阶段
+     * @return 本轮执行的 tick 数
+     */
+    std::size_t playRound()
+    {
+        const uint64_t target = turns + SEATS;
+        std::size_t ticks = 0;
+        while (turns < target)
+        {
+            room.tick(0);
+            ++ticks;
+        }
+        return ticks;
+    }
+
+    void resetHealth()
+    {
+        for (uint32_t seat = 0; seat < SEATS; ++seat)
+        {
+            room.context->registry.get<CombatState>(room.players[seat]).currentHealth = RESET_HEALTH;
+        }
+    }
+
+    void reportMemory(bench::State& state) const
+    {
+        auto stats = room.context->roomMemory.stats();
+        state.counters["room_reserved_bytes"] = static_cast<double>(stats.reservedBytes);
+        state.counters["room_peak_bytes"] = static_cast<double>(stats.peakInUseBytes);
+    }
+};
+
+/**
+ * @brief 宏观基准：8 名玩家各走一个完整回合（阶段状态机 + 摸牌、出杀造成伤害、弃牌、结算）
+ */
+void BM_RoomTurnCycle(bench::State& state)
+{
+    FlowRoom flow;
+    std::size_t ticks = 0;
+    for (auto _ : state)
+    {
+        ticks += flow.playRound();
+        state.PauseTiming();
+        flow.resetHealth();
+        state.ResumeTiming();
+    }
+    state.counters["turns_per_iter"] = SEATS;
+    state.counters["ticks_per_iter"] =
+        static_cast<double>(ticks) / static_cast<double>(std::max<uint64_t>(state.iterations(), 1));
+    flow.reportMemory(state);
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * SEATS));
+}
+BENCHMARK(BM_RoomTurnCycle);
+
+/**
+ * @brief 完整的伤害与摸牌循环：每人摸牌、对下家造成伤害、弃牌、结算，随后做一次存活判定
+ */
+void BM_DamageDrawCycle(bench::State& state)
+{
+    Room room;
+    room.dealOpeningHands();
+    std::size_t alive = 0;
+    for (auto _ : state)
+    {
+        room.playRound();
+        alive += room.damageSystem->aliveCount();
+        state.PauseTiming();
+        room.resetHealth();
+        state.ResumeTiming();
+    }
+    bench::DoNotOptimize(alive);
+    room.reportMemory(state);
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * SEATS));
+}
+BENCHMARK(BM_DamageDrawCycle);
+
+/**
+ * @brief 在所有玩家手牌中查找一张不存在的牌（遍历全部手牌）
+ */
+void BM_FindCardInHands(bench::State& state)
+{
+    Room room;
+    room.dealOpeningHands();
+    const events::FindCardInHandCardsArea query{.cardName = "不存在的牌", .suitType = {}, .rank = 0};
+    for (auto _ : state)
+    {
+        room.context->dispatcher.trigger(query);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * SEATS * OPENING_HAND));
+}
+BENCHMARK(BM_FindCardInHands);
+
+/**
+ * @brief 房间完整生命周期：开局（创建系统与玩家）、一轮回合、销毁（房间内存整体归还）
+ */
+void BM_RoomLifecycle(bench::State& state)
+{
+    for (auto _ : state)
+    {
+        FlowRoom flow;
+        flow.playRound();
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+BENCHMARK(BM_RoomLifecycle);
+} // namespace
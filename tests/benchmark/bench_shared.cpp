@@ -0,0 +1,125 @@
+/**
+ * ************************************************************************
+ *
+ * @file bench_shared.cpp
+ * @author AnakinLiu (azrael2759@qq.com)
+ * @date 2026-10-16
+ * @version 0.1
+ * @brief 共享层与协议层热点路径基准：PacketWriter/PacketReader、FrameCodec、MessageDispatcher
+ *
+ * ************************************************************************
+ * @copyright Copyright (c) 2026 AnakinLiu
+ * For study and research only, no reprinting.
+ * ************************************************************************
+ */
+#include <string>
+#include <vector>
+#include "Benchmark.h"
+#include "src/net/protocol/FrameCodec.h"
+#include "src/shared/common/PacketStream.h"
+#include "src/shared/messages/MessageDispatcher.h"
+#include "src/shared/messages/request/SendMessageRequest.h"
+#include "src/shared/messages/response/SendMessageToChatResponse.h"
+
+namespace
+{
+void BM_PacketWriterMixed(bench::State& state)
+{
+    const std::string text(static_cast<std::size_t>(state.range(0)), 'x');
+    for (auto _ : state)
+    {
+        shared::PacketWriter writer;
+        writer.writeUint32(0x12345678);
+        writer.writeUint16(0x1234);
+        writer.writeUint8(7);
+        writer.writeBool(true);
+        writer.writeString(text);
+        bench::DoNotOptimize(writer.buffer.data());
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+BENCHMARK(BM_PacketWriterMixed)->Arg(16)->Arg(256);
+
+void BM_PacketReaderMixed(bench::State& state)
+{
+    shared::PacketWriter writer;
+    writer.writeUint32(0x12345678);
+    writer.writeUint16(0x1234);
+    writer.writeUint8(7);
+    writer.writeBool(true);
+    writer.writeString(std::string(static_cast<std::size_t>(state.range(0)), 'x'));
+    const std::vector<uint8_t> bytes = writer.buffer;
+    for (auto _ : state)
+    {
+        shared::PacketReader reader(bytes);
+        bench::DoNotOptimize(reader.readUint32());
+        bench::DoNotOptimize(reader.readUint16());
+        bench::DoNotOptimize(reader.readUint8());
+        bench::DoNotOptimize(reader.readBool());
+        auto text = reader.readString();
+        bench::DoNotOptimize(text);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+BENCHMARK(BM_PacketReaderMixed)->Arg(16)->Arg(256);
+
+void BM_FrameEncode(bench::State& state)
+{
+    std::vector<uint8_t> payload(static_cast<std::size_t>(state.range(0)), 0xAB);
+    std::vector<uint8_t> buffer(sizeof(FrameHeader) + payload.size());
+    for (auto _ : state)
+    {
+        auto frame = encodeFrame(buffer, CommandID::SEND_MESSAGE_REQ, payload);
+        bench::DoNotOptimize(frame);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * payload.size()));
+}
+BENCHMARK(BM_FrameEncode)->Arg(64)->Arg(1024);
+
+void BM_FrameDecode(bench::State& state)
+{
+    std::vector<uint8_t> payload(static_cast<std::size_t>(state.range(0)), 0xAB);
+    std::vector<uint8_t> buffer(sizeof(FrameHeader) + payload.size());
+    auto frame = encodeFrame(buffer, CommandID::SEND_MESSAGE_REQ, payload);
+    std::span<const uint8_t> encoded = *frame;
+    for (auto _ : state)
+    {
+        auto decoded = decodeFrame(encoded);
+        bench::DoNotOptimize(decoded);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * payload.size()));
+}
+BENCHMARK(BM_FrameDecode)->Arg(64)->Arg(1024);
+
+/**
+ * @brief 完整的收包路径：解帧 -> 分发 -> 反序列化 -> 处理 -> 序列化响应
+ */
+void BM_MessageDispatchChat(bench::State& state)
+{
+    MessageDispatcher dispatcher;
+    dispatcher.registerHandler<SendMessageRequest>(
+        [](const SendMessageRequest& req) -> std::expected<std::vector<uint8_t>, MessageError>
+        {
+            SendMessageToChatResponse resp;
+            resp.sender = req.channelId;
+            resp.chatMessage = req.content;
+            return resp.serialize();
+        });
+
+    SendMessageRequest request;
+    request.channelId = 1;
+    request.content = std::string(static_cast<std::size_t>(state.range(0)), 'm');
+    auto payload = request.serialize();
+    std::vector<uint8_t> buffer(sizeof(FrameHeader) + payload.size());
+    std::span<const uint8_t> frame = *encodeFrame(buffer, SendMessageRequest::CMD_ID, payload);
+
+    for (auto _ : state)
+    {
+        auto decoded = decodeFrame(frame);
+        auto response = dispatcher.dispatch(decoded->cmd, decoded->payload);
+        bench::DoNotOptimize(response);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+BENCHMARK(BM_MessageDispatchChat)->Arg(32)->Arg(512);
+} // namespace
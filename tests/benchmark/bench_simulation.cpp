@@ -0,0 +1,134 @@
+/**
+ * ************************************************************************
+ *
+ * @file bench_simulation.cpp
+ * @author AnakinLiu (azrael2759@qq.com)
+ * @date 2026-10-16
+ * @version 0.1
+ * @brief 蒙特卡洛模拟吞吐基准（局/秒）
+ *
+ * ************************************************************************
+ * @copyright Copyright (c) 2026 AnakinLiu
+ * For study and research only, no reprinting.
+ * ************************************************************************
+ */
+#include <algorithm>
+#include <vector>
+#include <entt/entt.hpp>
+#include "Benchmark.h"
+#include "src/server/components/Card.h"
+#include "src/server/components/Character.h"
+#include "src/server/components/Deck.h"
+#include "src/server/components/Player.h"
+#include "src/server/context/RoomMemory.h"
+#include "src/server/simulation/SimState.h"
+#include "src/server/simulation/Simulator.h"
+
+namespace
+{
+constexpr uint32_t SEATS = 8;
+constexpr uint32_t DECK_COPIES = 16;
+constexpr uint32_t GAMES_PER_ITERATION = 256;
+
+/**
+ * @brief 搭建一个 8 人房间：每人 4 张手牌，牌堆为基础牌与锦囊的混合
+ */
+std::vector<entt::entity> buildRoom(RoomRegistry& registry, Deck& deck)
+{
+    for (uint32_t copy = 0; copy < DECK_COPIES; ++copy)
+    {
+        CardPointAndSuit pointAndSuit{.point = static_cast<uint8_t>(copy % 13 + 1), .suit = SuitType::SPADE};
+        for (int strike = 0; strike < 4; ++strike)
+        {
+            deck.drawPile.push_back(CreateStrickCard(registry, pointAndSuit));
+        }
+        deck.drawPile.push_back(CreateDodgeCard(registry, pointAndSuit));
+        deck.drawPile.push_back(CreateDodgeCard(registry, pointAndSuit));
+        deck.drawPile.push_back(CreatePeachCard(registry, pointAndSuit));
+        deck.drawPile.push_back(CreateAlcoholCard(registry, pointAndSuit));
+        deck.drawPile.push_back(CreateDuelCard(registry, pointAndSuit));
+        deck.drawPile.push_back(CreateFireAttackCard(registry, pointAndSuit));
+    }
+
+    std::vector<entt::entity> players;
+    for (uint32_t seat = 0; seat < SEATS; ++seat)
+    {
+        auto player = registry.create();
+        auto& hand = registry.emplace<HandCards>(player, HandCards{HandCards::Zone(registry.get_allocator())});
+        hand.handCards.assign(deck.drawPile.end() - 4, deck.drawPile.end());
+        deck.drawPile.resize(deck.drawPile.size() - 4);
+        registry.emplace<Equipments>(player);
+        registry.emplace<CombatState>(player);
+        registry.emplace<Attributes>(player);
+        registry.emplace<StatusFlags>(player, StatusFlags{memory::Vector<Status>(registry.get_allocator())});
+        players.push_back(player);
+    }
+    return players;
+}
+
+/**
+ * @brief 房间与由其派生的根状态，供各基准共享
+ */
+struct SimulationFixture
+{
+    memory::RoomMemory memory; // 须先于注册表与牌堆构造
+    RoomRegistry registry{memory::Allocator<entt::entity>{memory.resource()}};
+    Deck deck{.drawPile = memory::Vector<entt::entity>(registry.get_allocator()),
+              .discardPile = memory::Vector<entt::entity>(registry.get_allocator()),
+              .processingArea = memory::Vector<entt::entity>(registry.get_allocator())};
+    std::vector<entt::entity> players;
+    simulation::SimCardTable table;
+    simulation::SimState root{};
+
+    SimulationFixture() : players(buildRoom(registry, deck))
+    {
+        root = simulation::Capture(registry, deck, players, players.front(), table);
+    }
+};
+
+void BM_SimulationCapture(bench::State& state)
+{
+    SimulationFixture fixture;
+    for (auto _ : state)
+    {
+        simulation::SimCardTable table;
+        auto root =
+            simulation::Capture(fixture.registry, fixture.deck, fixture.players, fixture.players.front(), table);
+        bench::DoNotOptimize(root);
+    }
+}
+BENCHMARK(BM_SimulationCapture);
+
+void BM_SimulationRolloutSerial(bench::State& state)
+{
+    SimulationFixture fixture;
+    simulation::Simulator simulator(fixture.table);
+    const auto games = static_cast<uint32_t>(state.range(0));
+    simulation::RolloutStats stats;
+    uint64_t seed = 1;
+    for (auto _ : state)
+    {
+        stats.merge(simulator.runBatch(fixture.root, games, seed++));
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * games));
+    state.counters["avg_turns"] = static_cast<double>(stats.turns) / std::max(1U, stats.games);
+    state.SetLabel("items = games");
+}
+BENCHMARK(BM_SimulationRolloutSerial)->Arg(GAMES_PER_ITERATION);
+
+void BM_SimulationRolloutParallel(bench::State& state)
+{
+    SimulationFixture fixture;
+    simulation::Simulator simulator(fixture.table);
+    const auto games = static_cast<uint32_t>(state.range(0));
+    uint64_t seed = 1;
+    for (auto _ : state)
+    {
+        auto stats = simulator.runParallel(fixture.root, games, seed++);
+        bench::DoNotOptimize(stats);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * games));
+    state.SetLabel("items = games");
+}
+BENCHMARK(BM_SimulationRolloutParallel)->Arg(GAMES_PER_ITERATION * 8);
+} // namespace
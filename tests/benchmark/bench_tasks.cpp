@@ -0,0 +1,161 @@
+/**
+ * ************************************************************************
+ *
+ * @file bench_tasks.cpp
+ * @author AnakinLiu (azrael2759@qq.com)
+ * @date 2026-10-16
+ * @version 0.1
+ * @brief 任务投递/汇合开销基准：旧的 asio::thread_pool + promise/future 与工作窃取调度器对比
+ *
+ * ************************************************************************
+ * @copyright Copyright (c) 2026 AnakinLiu
+ * For study and research only, no reprinting.
+ * ************************************************************************
+ */
+#include <atomic>
+#include <functional>
+#include <future>
+#include <vector>
+#include <asio/post.hpp>
+#include <asio/thread_pool.hpp>
+#include "Benchmark.h"
+#include "src/utils/TaskScheduler.h"
+#include "src/utils/ThreadPool.h"
+
+namespace
+{
+/**
+ * @brief 改动前 utils::ThreadPool::enqueue 的实现：每个任务一个 promise 与一个 move_only_function
+ */
+template <typename F>
+std::future<void> LegacyEnqueue(asio::thread_pool& pool, F&& func)
+{
+    std::promise<void> promise;
+    auto future = promise.get_future();
+    std::move_only_function<void()> task = [pro = std::move(promise), fn = std::forward<F>(func)]() mutable
+    {
+        fn();
+        pro.set_value();
+    };
+    asio::post(pool, std::move(task));
+    return future;
+}
+
+asio::thread_pool& LegacyPool()
+{
+    static asio::thread_pool pool(utils::TaskScheduler::DefaultThreadCount());
+    return pool;
+}
+
+void BM_LegacyPoolSpawnJoin(bench::State& state)
+{
+    const auto count = static_cast<std::size_t>(state.range(0));
+    std::atomic<uint64_t> sum{0};
+    std::vector<std::future<void>> futures;
+    futures.reserve(count);
+    for (auto _ : state)
+    {
+        for (std::size_t index = 0; index < count; ++index)
+        {
+            futures.push_back(
+                LegacyEnqueue(LegacyPool(), [&sum, index] { sum.fetch_add(index, std::memory_order_relaxed); }));
+        }
+        for (auto& future : futures)
+        {
+            future.get();
+        }
+        futures.clear();
+    }
+    bench::DoNotOptimize(sum);
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * count));
+}
+BENCHMARK(BM_LegacyPoolSpawnJoin)->Arg(64)->Arg(1024);
+
+/**
+ * @brief 兼容接口：future 语义不变，任务改由共享调度器执行
+ */
+void BM_ThreadPoolShimSpawnJoin(bench::State& state)
+{
+    const auto count = static_cast<std::size_t>(state.range(0));
+    std::atomic<uint64_t> sum{0};
+    std::vector<std::future<void>> futures;
+    futures.reserve(count);
+    for (auto _ : state)
+    {
+        for (std::size_t index = 0; index < count; ++index)
+        {
+            futures.push_back(
+                utils::ThreadPool::enqueue([&sum, index] { sum.fetch_add(index, std::memory_order_relaxed); }));
+        }
+        for (auto& future : futures)
+        {
+            future.get();
+        }
+        futures.clear();
+    }
+    bench::DoNotOptimize(sum);
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * count));
+}
+BENCHMARK(BM_ThreadPoolShimSpawnJoin)->Arg(64)->Arg(1024);
+
+void BM_TaskGroupSpawnJoin(bench::State& state)
+{
+    const auto count = static_cast<std::size_t>(state.range(0));
+    std::atomic<uint64_t> sum{0};
+    utils::TaskGroup group;
+    for (auto _ : state)
+    {
+        for (std::size_t index = 0; index < count; ++index)
+        {
+            group.run([&sum, index] { sum.fetch_add(index, std::memory_order_relaxed); });
+        }
+        group.wait();
+    }
+    bench::DoNotOptimize(sum);
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * count));
+}
+BENCHMARK(BM_TaskGroupSpawnJoin)->Arg(64)->Arg(1024);
+
+void BM_TaskGroupBatch(bench::State& state)
+{
+    const auto count = static_cast<std::size_t>(state.range(0));
+    std::atomic<uint64_t> sum{0};
+    utils::TaskGroup group;
+    for (auto _ : state)
+    {
+        group.runBatch(count, [&sum](std::size_t index) { sum.fetch_add(index, std::memory_order_relaxed); });
+        group.wait();
+    }
+    bench::DoNotOptimize(sum);
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * count));
+}
+BENCHMARK(BM_TaskGroupBatch)->Arg(64)->Arg(1024);
+
+/**
+ * @brief 工作线程内的嵌套分叉：子任务进本地队列，空闲线程窃取
+ */
+void BM_TaskGroupNested(bench::State& state)
+{
+    constexpr std::size_t FANOUT = 16;
+    std::atomic<uint64_t> sum{0};
+    for (auto _ : state)
+    {
+        utils::TaskGroup outer;
+        for (std::size_t branch = 0; branch < FANOUT; ++branch)
+        {
+            outer.run(
+                [&sum]
+                {
+                    utils::TaskGroup inner;
+                    inner.runBatch(FANOUT,
+                                   [&sum](std::size_t index) { sum.fetch_add(index, std::memory_order_relaxed); });
+                    inner.wait();
+                });
+        }
+        outer.wait();
+    }
+    bench::DoNotOptimize(sum);
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * FANOUT * FANOUT));
+}
+BENCHMARK(BM_TaskGroupNested);
+} // namespace
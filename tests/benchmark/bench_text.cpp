@@ -0,0 +1,211 @@
+/**
+ * ************************************************************************
+ *
+ * @file bench_text.cpp
+ * @author AnakinLiu (azrael2759@qq.com)
+ * @date 2026-10-16
+ * @version 0.1
+ * @brief 文本换行基准：约 10 KB 中英混排聊天记录，单次遍历 + 前进量缓存 vs 改动前的前缀重复测量
+ *
+ * 字形度量由合成的加载函数提供（ASCII 7px，其余 14px），不依赖 FreeType；
+ * 旧实现每次测量还要调用 FT_Load_Glyph，实际差距比这里更大
+ *
+ * ************************************************************************
+ * @copyright Copyright (c) 2026 AnakinLiu
+ * For study and research only, no reprinting.
+ * ************************************************************************
+ */
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "Benchmark.h"
+#include "src/ui/core/TextUtils.hpp"
+#include "src/ui/managers/GlyphAdvanceCache.hpp"
+
+namespace
+{
+constexpr size_t CHAT_LOG_BYTES = 10 * 1024;
+
+ui::managers::GlyphAdvance SyntheticGlyph(uint32_t codepoint)
+{
+    return {.advance = codepoint < 0x80 ? 7.0F : 14.0F, .glyphIndex = codepoint};
+}
+
+/**
+ * @brief 生成聊天记录：短消息、英文长句与不含空格的中文长句交替
+ */
+const std::string& ChatLog()
+{
+    static const std::string log = []
+    {
+        const std::vector<std::string> messages = {
+            "[12:03] Alice: gg",
+            "[12:03] 小明: 这回合先出火球术，对 Boss 造成 12 点伤害，然后把护盾留给下回合",
+            "[12:04] Bob: I think we should hold the shield until the boss charges its ultimate, "
+            "otherwise the whole party gets wiped before the healer can react",
+            "[12:04] 阿杰: 收到收到我这边手牌里还有两张治疗和一张群体护盾等你们打完这一轮我再统一放下去应该来得及",
+            "[12:05] Carol: ok",
+        };
+        std::string text;
+        for (size_t index = 0; text.size() < CHAT_LOG_BYTES; ++index)
+        {
+            text += messages[index % messages.size()];
+            text += '\n';
+        }
+        return text;
+    }();
+    return log;
+}
+
+/**
+ * @brief 改动前的测量：每次从头解码整串并累加前进量
+ */
+int LegacyMeasure(const std::string& text)
+{
+    float width = 0.0F;
+    for (size_t pos = 0; pos < text.size();)
+    {
+        uint32_t codepoint = 0;
+        const size_t length = ui::utils::DecodeUtf8(std::string_view(text).substr(pos), codepoint);
+        if (length == 0) break;
+        width += SyntheticGlyph(codepoint).advance;
+        pos += length;
+    }
+    return static_cast<int>(width);
+}
+
+/**
+ * @brief 改动前的 Word 模式段落换行：每追加一个单词/字符都重新测量整行
+ */
+std::vector<std::string> LegacyWrapParagraph(const std::string& paragraph, int maxWidth)
+{
+    std::vector<std::string> lines;
+    std::string currentLine;
+    std::string word;
+
+    auto pushWord = [&](const std::string& w)
+    {
+        if (w.empty()) return;
+        if (LegacyMeasure(w) > maxWidth)
+        {
+            if (!currentLine.empty())
+            {
+                lines.push_back(currentLine);
+                currentLine.clear();
+            }
+            std::string tempWord;
+            for (size_t i = 0; i < w.size();)
+            {
+                const size_t next = ui::utils::NextCharPos(w, i);
+                const std::string ch = w.substr(i, next - i);
+                if (LegacyMeasure(tempWord + ch) > maxWidth && !tempWord.empty())
+                {
+                    lines.push_back(tempWord);
+                    tempWord = ch;
+                }
+                else
+                {
+                    tempWord += ch;
+                }
+                i = next;
+            }
+            currentLine = tempWord;
+            return;
+        }
+
+        const std::string testLine = currentLine.empty() ? w : currentLine + " " + w;
+        if (LegacyMeasure(testLine) > maxWidth && !currentLine.empty())
+        {
+            lines.push_back(currentLine);
+            currentLine = w;
+        }
+        else
+        {
+            currentLine = testLine;
+        }
+    };
+
+    for (size_t i = 0; i < paragraph.size();)
+    {
+        if (paragraph[i] == ' ' || paragraph[i] == '\t')
+        {
+            pushWord(word);
+            word.clear();
+            ++i;
+        }
+        else
+        {
+            const size_t next = ui::utils::NextCharPos(paragraph, i);
+            word += paragraph.substr(i, next - i);
+            i = next;
+        }
+    }
+    pushWord(word);
+    if (!currentLine.empty()) lines.push_back(currentLine);
+    return lines;
+}
+
+void BM_WrapChatLog(bench::State& state)
+{
+    const std::string& text = ChatLog();
+    const auto width = static_cast<int>(state.range(0));
+    ui::managers::GlyphAdvanceCache advances(SyntheticGlyph);
+    auto advanceFunc = [&advances](uint32_t codepoint, uint32_t previous)
+    { return advances.advance(codepoint, previous); };
+
+    size_t lineCount = 0;
+    for (auto _ : state)
+    {
+        auto lines = ui::utils::WrapTextLines(text, width, ui::policies::TextWrap::Word, advanceFunc);
+        lineCount = lines.size();
+        bench::DoNotOptimize(lines);
+    }
+    state.counters["lines"] = static_cast<double>(lineCount);
+    state.counters["loads"] = static_cast<double>(advances.loadCount());
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * text.size()));
+}
+BENCHMARK(BM_WrapChatLog)->Arg(240)->Arg(480);
+
+// 每次迭代新建缓存：首帧（或切换字号后）的开销
+void BM_WrapChatLogColdCache(bench::State& state)
+{
+    const std::string& text = ChatLog();
+    const auto width = static_cast<int>(state.range(0));
+    for (auto _ : state)
+    {
+        ui::managers::GlyphAdvanceCache advances(SyntheticGlyph);
+        auto lines = ui::utils::WrapTextLines(text,
+                                              width,
+                                              ui::policies::TextWrap::Word,
+                                              [&advances](uint32_t codepoint, uint32_t previous)
+                                              { return advances.advance(codepoint, previous); });
+        bench::DoNotOptimize(lines);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * text.size()));
+}
+BENCHMARK(BM_WrapChatLogColdCache)->Arg(240)->Arg(480);
+
+void BM_WrapChatLogLegacy(bench::State& state)
+{
+    const std::string& text = ChatLog();
+    const auto width = static_cast<int>(state.range(0));
+    size_t lineCount = 0;
+    for (auto _ : state)
+    {
+        std::vector<std::string> lines;
+        size_t start = 0;
+        for (size_t end = text.find('\n'); end != std::string::npos; end = text.find('\n', start))
+        {
+            auto wrapped = LegacyWrapParagraph(text.substr(start, end - start), width);
+            lines.insert(lines.end(), wrapped.begin(), wrapped.end());
+            lines.emplace_back();
+            start = end + 1;
+        }
+        lineCount = lines.size();
+        bench::DoNotOptimize(lines);
+    }
+    state.counters["lines"] = static_cast<double>(lineCount);
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * text.size()));
+}
+BENCHMARK(BM_WrapChatLogLegacy)->Arg(240)->Arg(480);
+} // namespace
@@ -0,0 +1,46 @@
+/**
+ * ************************************************************************
+ *
+ * @file LoopbackTransport.h
+ * @author AnakinLiu (azrael2759@qq.com)
+ * @date 2026-10-16
+ * @version 0.1
+ * @brief 排队的回环 UDP 传输（用于单元测试）
+ *
+ * 发送的报文只进入队列，由测试取出后决定投递给哪个端点、以什么源地址投递，
+ * 从而在单线程上模拟丢包与客户端地址变化
+ *
+ * ************************************************************************
+ * @copyright Copyright (c) 2026 AnakinLiu
+ * For study and research only, no reprinting.
+ * ************************************************************************
+ */
+#pragma once
+#include "src/net/transport/IUdpTransport.h"
+#include <cstdint>
+#include <span>
+#include <utility>
+#include <vector>
+
+class LoopbackTransport : public IUdpTransport
+{
+public:
+    struct Datagram
+    {
+        NetAddress to;
+        std::vector<uint8_t> data;
+    };
+
+    void send(const NetAddress& address, std::span<const uint8_t> data) override
+    {
+        m_queue.push_back({address, std::vector<uint8_t>(data.begin(), data.end())});
+    }
+
+    /**
+     * @brief 取走目前排队的全部报文
+     */
+    std::vector<Datagram> take() { return std::exchange(m_queue, {}); }
+
+private:
+    std::vector<Datagram> m_queue;
+};
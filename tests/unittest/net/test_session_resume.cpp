@@ -0,0 +1,181 @@
+/**
+ * ************************************************************************
+ *
+ * @file test_session_resume.cpp
+ * @author AnakinLiu (azrael2759@qq.com)
+ * @date 2026-10-16
+ * @version 0.1
+ * @brief 会话令牌、地址迁移与恢复的回环测试
+ *
+ * 客户端与服务器各用一个排队的回环传输，测试按轮次驱动 update 并交换报文；
+ * 改变客户端地址即模拟 NAT 重绑定，发往旧地址的报文视为丢失
+ *
+ * ************************************************************************
+ * @copyright Copyright (c) 2026 AnakinLiu
+ * For study and research only, no reprinting.
+ * ************************************************************************
+ */
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+#include <vector>
+#include "LoopbackTransport.h"
+#include "src/net/App/Client.h"
+#include "src/net/App/Server.h"
+#include "src/net/protocol/SessionControl.h"
+#include "src/net/protocol/SharedFrame.h"
+#include "src/shared/common/CommandID.h"
+
+namespace
+{
+constexpr uint32_t CONV = 0x1234;
+constexpr uint32_t STEP_MS = 10;
+constexpr int HANDSHAKE_ROUNDS = 20;
+
+class SessionResumeTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        m_server.setSessionHandlers(
+            {.opened = {},
+             .detached = {},
+             .resumed = [this](uint32_t, const std::shared_ptr<KcpSession>&) { ++m_serverResumed; },
+             .closed = {},
+             .received = [this](uint32_t, KcpSession::Packet packet) { m_serverFrames.push_back(std::move(packet)); }});
+        m_client.setSessionHandlers(
+            {.received = [this](uint32_t, KcpSession::Packet packet) { m_clientFrames.push_back(std::move(packet)); },
+             .resumed = [this](uint32_t) { ++m_clientResumed; }});
+        m_session = m_client.connect(CONV, SERVER_ADDR);
+    }
+
+    static SharedFrame heartbeat() { return *SharedFrame::encode(CommandID::HEARTBEAT, {}); }
+
+    /**
+     * @brief 驱动若干轮：双方 update，交换排队的报文，再执行接收回调
+     */
+    void pump(int rounds)
+    {
+        for (int round = 0; round < rounds; ++round)
+        {
+            m_nowMs += STEP_MS;
+            m_client.update(m_nowMs);
+            m_server.update(m_nowMs);
+            for (auto& datagram : m_clientTransport.take())
+            {
+                m_server.input(m_clientAddr, datagram.data);
+            }
+            m_server.poll();
+            for (auto& datagram : m_serverTransport.take())
+            {
+                if (datagram.to == m_clientAddr)
+                {
+                    m_client.input(SERVER_ADDR, datagram.data);
+                }
+                else
+                {
+                    ++m_lostToOldAddress;
+                }
+            }
+            m_client.poll();
+        }
+    }
+
+    void handshake()
+    {
+        m_session->send(heartbeat());
+        pump(HANDSHAKE_ROUNDS);
+        ASSERT_EQ(m_serverFrames.size(), 1U);
+        m_serverFrames.clear();
+    }
+
+    const NetAddress SERVER_ADDR{"127.0.0.1", 9000};
+    const NetAddress FIRST_CLIENT_ADDR{"127.0.0.1", 50001};
+    const NetAddress MIGRATED_CLIENT_ADDR{"10.0.0.2", 50002};
+
+    LoopbackTransport m_clientTransport;
+    LoopbackTransport m_serverTransport;
+    Server m_server{m_serverTransport};
+    Client m_client{m_clientTransport};
+    std::shared_ptr<KcpSession> m_session;
+    NetAddress m_clientAddr = FIRST_CLIENT_ADDR;
+    uint32_t m_nowMs = 0;
+
+    std::vector<KcpSession::Packet> m_serverFrames;
+    std::vector<KcpSession::Packet> m_clientFrames;
+    int m_serverResumed = 0;
+    int m_clientResumed = 0;
+    int m_lostToOldAddress = 0;
+};
+
+TEST_F(SessionResumeTest, ClientKeepsTokenWithoutSurfacingIt)
+{
+    EXPECT_FALSE(m_client.resume(CONV)); // 令牌尚未下发
+
+    handshake();
+
+    EXPECT_TRUE(m_clientFrames.empty()); // SESSION_TOKEN 由客户端自己处理
+    EXPECT_TRUE(m_client.resume(CONV));
+}
+
+TEST_F(SessionResumeTest, MigratedAddressIsIgnoredUntilResumed)
+{
+    handshake();
+    m_clientAddr = MIGRATED_CLIENT_ADDR;
+
+    m_session->send(heartbeat());
+    pump(HANDSHAKE_ROUNDS);
+    EXPECT_TRUE(m_serverFrames.empty());
+    EXPECT_EQ(m_serverResumed, 0);
+
+    ASSERT_TRUE(m_client.resume(CONV));
+    pump(HANDSHAKE_ROUNDS);
+
+    EXPECT_EQ(m_serverResumed, 1);
+    EXPECT_EQ(m_clientResumed, 1);
+    // 迁移前未确认的分段重传到服务器，服务器的回复发往新地址
+    EXPECT_EQ(m_serverFrames.size(), 1U);
+    ASSERT_TRUE(m_server.send(CONV, heartbeat()));
+    const int lostBefore = m_lostToOldAddress;
+    pump(HANDSHAKE_ROUNDS);
+    ASSERT_EQ(m_clientFrames.size(), 1U);
+    EXPECT_EQ(decodeFrame(m_clientFrames.front())->cmd, CommandID::HEARTBEAT);
+    EXPECT_EQ(m_lostToOldAddress, lostBefore);
+}
+
+TEST_F(SessionResumeTest, RetriedResumeNotifiesOnce)
+{
+    handshake();
+    m_clientAddr = MIGRATED_CLIENT_ADDR;
+
+    // 第一次应答未到达前重试：服务器应答两次，双方各只通知一次
+    ASSERT_TRUE(m_client.resume(CONV));
+    ASSERT_TRUE(m_client.resume(CONV));
+    pump(1);
+
+    EXPECT_EQ(m_serverResumed, 1);
+    EXPECT_EQ(m_clientResumed, 1);
+}
+
+TEST_F(SessionResumeTest, SendToDetachedSessionIsDropped)
+{
+    handshake();
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    m_server.update(m_nowMs, std::chrono::seconds(0)); // 立即视为空闲超时，会话挂起
+
+    // 挂起期间的帧直接丢弃，恢复后由房间补发局面
+    EXPECT_FALSE(m_server.send(CONV, heartbeat()));
+}
+
+TEST_F(SessionResumeTest, ForgedTokenDoesNotMigrate)
+{
+    handshake();
+
+    const auto forged = encodeSessionControl(SessionControl{.conv = CONV, .cmd = SESSION_CMD_RESUME, .token = 1});
+    m_server.input(MIGRATED_CLIENT_ADDR, forged);
+
+    EXPECT_EQ(m_serverResumed, 0);
+    EXPECT_TRUE(m_serverTransport.take().empty());
+}
+} // namespace
@@ -0,0 +1,122 @@
+/**
+ * ************************************************************************
+ *
+ * @file test_shared_frame.cpp
+ * @author AnakinLiu (azrael2759@qq.com)
+ * @date 2026-10-16
+ * @version 0.1
+ * @brief 共享帧的引用与发送顺序测试
+ *
+ * 广播时各会话只持有同一帧的引用，update 把帧拷入 KCP 后释放；
+ * 登记的共享帧与随后直接发送的数据在对端按发送顺序到达
+ *
+ * ************************************************************************
+ * @copyright Copyright (c) 2026 AnakinLiu
+ * For study and research only, no reprinting.
+ * ************************************************************************
+ */
+#include <gtest/gtest.h>
+#include <array>
+#include <cstdint>
+#include <expected>
+#include <functional>
+#include <memory>
+#include <vector>
+#include <asio.hpp>
+#include "LoopbackTransport.h"
+#include "src/net/Session/KcpSession.h"
+#include "src/net/protocol/FrameCodec.h"
+#include "src/net/protocol/SharedFrame.h"
+#include "src/shared/common/CommandID.h"
+
+namespace
+{
+constexpr uint32_t CONV = 0x2345;
+constexpr uint32_t STEP_MS = 10;
+constexpr int ROUNDS = 10;
+
+class SharedFrameTest : public ::testing::Test
+{
+protected:
+    [[nodiscard]] std::shared_ptr<KcpSession> session(LoopbackTransport& transport) const
+    {
+        return std::make_shared<KcpSession>(CONV, transport, PEER_ADDR, m_io.get_executor());
+    }
+
+    const NetAddress PEER_ADDR{"127.0.0.1", 9000};
+    mutable asio::io_context m_io;
+};
+
+TEST_F(SharedFrameTest, BroadcastSharesOneFrameUntilFlushed)
+{
+    std::array<LoopbackTransport, 3> transports;
+    std::vector<std::shared_ptr<KcpSession>> sessions;
+    for (auto& transport : transports)
+    {
+        sessions.push_back(session(transport));
+    }
+    const uint8_t payload[] = {1, 2, 3};
+    auto frame = SharedFrame::encode(CommandID::HEARTBEAT, payload);
+    ASSERT_TRUE(frame.has_value());
+
+    EXPECT_EQ(KcpSession::broadcast(sessions, *frame), sessions.size());
+    // 每个会话登记一份引用，帧数据本身只有一份
+    EXPECT_EQ(frame->useCount(), static_cast<long>(sessions.size() + 1));
+
+    for (auto& target : sessions)
+    {
+        target->update(STEP_MS);
+    }
+    EXPECT_EQ(frame->useCount(), 1);
+    for (auto& transport : transports)
+    {
+        EXPECT_FALSE(transport.take().empty());
+    }
+}
+
+TEST_F(SharedFrameTest, SharedFrameIsSentBeforeLaterDirectSend)
+{
+    LoopbackTransport senderTransport;
+    LoopbackTransport receiverTransport;
+    auto sender = session(senderTransport);
+    auto receiver = session(receiverTransport);
+    std::vector<uint16_t> received;
+    std::function<void(std::expected<KcpSession::Packet, std::error_code>)> onPacket =
+        [&](std::expected<KcpSession::Packet, std::error_code> packet)
+    {
+        if (!packet)
+        {
+            return;
+        }
+        received.push_back(decodeFrame(*packet)->cmd);
+        receiver->recvAsync(onPacket);
+    };
+    receiver->recvAsync(onPacket);
+
+    sender->send(*SharedFrame::encode(CommandID::HEARTBEAT, {}));
+    // 直接发送前先送出已登记的共享帧
+    std::vector<uint8_t> direct(sizeof(FrameHeader));
+    ASSERT_TRUE(encodeFrame(direct, CommandID::DISCONNECT, {}).has_value());
+    sender->send(direct);
+
+    uint32_t now = 0;
+    for (int round = 0; round < ROUNDS; ++round)
+    {
+        now += STEP_MS;
+        sender->update(now);
+        receiver->update(now);
+        for (auto& datagram : senderTransport.take())
+        {
+            receiver->input(datagram.data);
+        }
+        for (auto& datagram : receiverTransport.take())
+        {
+            sender->input(datagram.data);
+        }
+        m_io.poll();
+    }
+
+    const std::vector<uint16_t> expected{CommandID::HEARTBEAT, CommandID::DISCONNECT};
+    EXPECT_EQ(received, expected);
+}
+} // namespace
@@ -0,0 +1,311 @@
+/**
+ * ************************************************************************
+ *
+ * @file test_DamageSystem.cpp
+ * @author AnakinLiu (azrael2759@qq.com)
+ * @date 2026-10-16
+ * @version 0.1
+ * @brief 伤害结算单元测试
+ *
+ * rules::RedirectDamage / rules::PreventDamage 对整批效果的作用，
+ * 以及 DamageSystem 中 修正 -> 转移 -> 防止 的处理顺序、濒死结算与阶段结束时的结算
+ *
+ * ************************************************************************
+ * @copyright Copyright (c) 2026 AnakinLiu
+ * For study and research only, no reprinting.
+ * ************************************************************************
+ */
+#include <gtest/gtest.h>
+#include <array>
+#include <span>
+#include <vector>
+#include <entt/entt.hpp>
+#include "src/server/components/Character.h"
+#include "src/server/components/GameData.h"
+#include "src/server/context/GameContext.h"
+#include "src/server/events/Events.h"
+#include "src/server/events/GameFlowEvents.h"
+#include "src/server/rules/Effects.h"
+#include "src/server/systems/DamageSystem.h"
+#include "src/server/systems/GameFlowSystem.h"
+
+namespace
+{
+const entt::entity SOURCE{1};
+const entt::entity OTHER_SOURCE{2};
+const entt::entity TARGET{3};
+const entt::entity NEW_TARGET{4};
+
+rules::PendingEffect damage(entt::entity source, entt::entity target, int32_t amount)
+{
+    return rules::PendingEffect{
+        .kind = rules::EffectKind::Damage, .amount = amount, .source = source, .target = target};
+}
+
+TEST(EffectRulesTest, RedirectMovesOnlyFirstMatchingDamage)
+{
+    std::array effects{rules::PendingEffect{.kind = rules::EffectKind::LoseHealth, .amount = 1, .target = TARGET},
+                       damage(OTHER_SOURCE, TARGET, 1),
+                       damage(SOURCE, TARGET, 1),
+                       damage(SOURCE, TARGET, 2)};
+
+    EXPECT_TRUE(rules::RedirectDamage(effects, SOURCE, TARGET, NEW_TARGET, 1).matched);
+
+    EXPECT_EQ(effects[0].target, TARGET); // 失去体力不是伤害，不能转移
+    EXPECT_EQ(effects[1].target, TARGET); // 来源不匹配
+    EXPECT_EQ(effects[2].target, NEW_TARGET);
+    EXPECT_EQ(effects[3].target, TARGET);
+}
+
+TEST(EffectRulesTest, RedirectWithNullSourceMatchesAnySourceAndSkipsCancelled)
+{
+    std::array effects{damage(OTHER_SOURCE, TARGET, 0), damage(OTHER_SOURCE, TARGET, 1)};
+
+    EXPECT_TRUE(rules::RedirectDamage(effects, entt::null, TARGET, NEW_TARGET, 1).matched);
+    EXPECT_EQ(effects[0].target, TARGET); // 数值为 0 的效果已取消
+    EXPECT_EQ(effects[1].target, NEW_TARGET);
+
+    EXPECT_FALSE(rules::RedirectDamage(effects, entt::null, SOURCE, NEW_TARGET, 1).matched);
+}
+
+TEST(EffectRulesTest, PartialRedirectSplitsDamage)
+{
+    std::array effects{damage(SOURCE, TARGET, 3)};
+
+    const auto result = rules::RedirectDamage(effects, SOURCE, TARGET, NEW_TARGET, 1);
+
+    ASSERT_TRUE(result.matched);
+    EXPECT_EQ(effects[0].target, TARGET);
+    EXPECT_EQ(effects[0].amount, 2);
+    ASSERT_TRUE(result.split.has_value());
+    EXPECT_EQ(result.split->source, SOURCE);
+    EXPECT_EQ(result.split->target, NEW_TARGET);
+    EXPECT_EQ(result.split->amount, 1);
+}
+
+TEST(EffectRulesTest, RedirectCoveringWholeDamageDoesNotSplit)
+{
+    std::array effects{damage(SOURCE, TARGET, 2)};
+
+    const auto result = rules::RedirectDamage(effects, SOURCE, TARGET, NEW_TARGET, 3);
+
+    EXPECT_TRUE(result.matched);
+    EXPECT_FALSE(result.split.has_value());
+    EXPECT_EQ(effects[0].target, NEW_TARGET);
+    EXPECT_EQ(effects[0].amount, 2);
+}
+
+TEST(EffectRulesTest, PreventSpendsAmountAcrossEffectsInOrder)
+{
+    std::array effects{damage(SOURCE, TARGET, 2),
+                       damage(OTHER_SOURCE, TARGET, 2),
+                       rules::PendingEffect{.kind = rules::EffectKind::LoseHealth, .amount = 1, .target = TARGET},
+                       damage(SOURCE, TARGET, 2)};
+
+    EXPECT_EQ(rules::PreventDamage(effects, entt::null, TARGET, 3), 3);
+
+    EXPECT_EQ(effects[0].amount, 0);
+    EXPECT_EQ(effects[1].amount, 1);
+    EXPECT_EQ(effects[2].amount, 1); // 失去体力不能防止
+    EXPECT_EQ(effects[3].amount, 2);
+}
+
+TEST(EffectRulesTest, PreventHonoursSourceAndReportsActualAmount)
+{
+    std::array effects{damage(OTHER_SOURCE, TARGET, 2), damage(SOURCE, TARGET, 1)};
+
+    EXPECT_EQ(rules::PreventDamage(effects, SOURCE, TARGET, 5), 1);
+    EXPECT_EQ(effects[0].amount, 2);
+    EXPECT_EQ(effects[1].amount, 0);
+}
+
+class DamageSystemTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        m_context.logger->set_level(spdlog::level::err);
+        m_damage.init();
+        for (auto& character : m_characters)
+        {
+            character = m_context.registry.create();
+            m_context.registry.emplace<CombatState>(character);
+            m_context.registry.emplace<Attributes>(character);
+        }
+    }
+
+    void TearDown() override { m_damage.destroy(); }
+
+    [[nodiscard]] int32_t health(entt::entity character) const
+    {
+        return m_context.registry.get<CombatState>(character).currentHealth;
+    }
+
+    void setHealth(entt::entity character, int32_t value)
+    {
+        m_context.registry.get<CombatState>(character).currentHealth = value;
+    }
+
+    GameContext m_context;
+    DamageSystem m_damage{m_context};
+    std::array<entt::entity, 3> m_characters{};
+};
+
+TEST_F(DamageSystemTest, DamageIsBufferedUntilSettle)
+{
+    const auto [source, target, _] = m_characters;
+    m_context.dispatcher.trigger(events::Damage{.from = source, .to = target, .amount = 1});
+
+    EXPECT_EQ(health(target), 4);
+    EXPECT_EQ(m_damage.pendingCount(), 1U);
+
+    m_context.dispatcher.trigger(events::SettleEffects{});
+    EXPECT_EQ(health(target), 3);
+    EXPECT_EQ(m_damage.pendingCount(), 0U);
+}
+
+TEST_F(DamageSystemTest, ModifyThenRedirectThenPrevent)
+{
+    const auto [source, target, helper] = m_characters;
+    std::vector<rules::EffectPhase> order;
+    m_damage.addPass(rules::EffectPhase::Modify,
+                     [&order](std::span<rules::PendingEffect> effects)
+                     {
+                         order.push_back(rules::EffectPhase::Modify);
+                         for (auto& effect : effects)
+                         {
+                             ++effect.amount;
+                         }
+                     });
+    m_damage.addPass(rules::EffectPhase::Redirect,
+                     [&order](std::span<rules::PendingEffect>) { order.push_back(rules::EffectPhase::Redirect); });
+    m_damage.addPass(rules::EffectPhase::Prevent,
+                     [&order, helper](std::span<rules::PendingEffect> effects)
+                     {
+                         order.push_back(rules::EffectPhase::Prevent);
+                         // 防止阶段看到的是已转移的目标
+                         EXPECT_EQ(effects.front().target, helper);
+                     });
+
+    // 事件的触发顺序与处理顺序无关：先登记防止，再登记转移
+    m_context.dispatcher.trigger(
+        events::DamagePrevention{.source = source, .healer = helper, .target = helper, .amount = 1});
+    m_context.dispatcher.trigger(
+        events::DamageRedirection{.source = source, .originalTarget = target, .newTarget = helper, .amount = 2});
+    m_context.dispatcher.trigger(events::Damage{.from = source, .to = target, .amount = 1});
+    m_context.dispatcher.trigger(events::SettleEffects{});
+
+    const std::vector expected{rules::EffectPhase::Modify, rules::EffectPhase::Redirect, rules::EffectPhase::Prevent};
+    EXPECT_EQ(order, expected);
+    EXPECT_EQ(health(target), 4);
+    // 修正后 2 点，转移给 helper，再防止 1 点
+    EXPECT_EQ(health(helper), 3);
+}
+
+TEST_F(DamageSystemTest, PartialRedirectionSplitsDamageBeforePrevention)
+{
+    const auto [source, target, helper] = m_characters;
+    m_context.dispatcher.trigger(
+        events::DamageRedirection{.source = source, .originalTarget = target, .newTarget = helper, .amount = 1});
+    m_context.dispatcher.trigger(
+        events::DamagePrevention{.source = source, .healer = helper, .target = helper, .amount = 1});
+    m_context.dispatcher.trigger(events::Damage{.from = source, .to = target, .amount = 3});
+    m_context.dispatcher.trigger(events::SettleEffects{});
+
+    // 3 点伤害中 1 点转移给 helper 并被防止，其余 2 点仍由原目标承受
+    EXPECT_EQ(health(target), 2);
+    EXPECT_EQ(health(helper), 4);
+}
+
+TEST_F(DamageSystemTest, PreventionOnlyAppliesToItsSettlementStep)
+{
+    const auto [source, target, _] = m_characters;
+    m_context.dispatcher.trigger(
+        events::DamagePrevention{.source = source, .healer = target, .target = target, .amount = 1});
+    m_context.dispatcher.trigger(events::Damage{.from = source, .to = target, .amount = 1});
+    m_context.dispatcher.trigger(events::SettleEffects{});
+    EXPECT_EQ(health(target), 4);
+
+    m_context.dispatcher.trigger(events::Damage{.from = source, .to = target, .amount = 1});
+    m_context.dispatcher.trigger(events::SettleEffects{});
+    EXPECT_EQ(health(target), 3);
+}
+
+/**
+ * @brief 濒死时销毁另一名同样濒死的角色
+ */
+struct DyingListener
+{
+    GameContext* context = nullptr;
+    entt::entity victim = entt::null;
+    std::vector<entt::entity> deaths;
+
+    void onNearDeath(const events::NearDeath& event)
+    {
+        if (event.character != victim && context->registry.valid(victim))
+        {
+            context->registry.destroy(victim);
+        }
+    }
+
+    void onDeath(const events::CharacterDeath& event) { deaths.push_back(event.character); }
+};
+
+TEST_F(DamageSystemTest, DyingSkipsCharactersDestroyedMeanwhile)
+{
+    const auto [source, first, second] = m_characters;
+    setHealth(first, 1);
+    setHealth(second, 1);
+    DyingListener listener{.context = &m_context, .victim = second};
+    m_context.dispatcher.sink<events::NearDeath>().connect<&DyingListener::onNearDeath>(listener);
+    m_context.dispatcher.sink<events::CharacterDeath>().connect<&DyingListener::onDeath>(listener);
+
+    m_context.dispatcher.trigger(events::Damage{.from = source, .to = first, .amount = 1});
+    m_context.dispatcher.trigger(events::Damage{.from = source, .to = second, .amount = 1});
+    m_context.dispatcher.trigger(events::SettleEffects{});
+
+    EXPECT_EQ(listener.deaths, std::vector<entt::entity>{first});
+    EXPECT_FALSE(m_context.registry.valid(second));
+
+    m_context.dispatcher.sink<events::NearDeath>().disconnect(&listener);
+    m_context.dispatcher.sink<events::CharacterDeath>().disconnect(&listener);
+}
+
+/**
+ * @brief 准备阶段开始时对当前玩家造成 1 点伤害
+ */
+struct StartPhaseDamage
+{
+    GameContext* context = nullptr;
+    entt::entity source = entt::null;
+
+    void onPhase(const events::TurnPhase& event)
+    {
+        if (event.currentPhase == TurnPhase::START)
+        {
+            context->dispatcher.trigger(events::Damage{.from = source, .to = event.player, .amount = 1});
+        }
+    }
+};
+
+TEST_F(DamageSystemTest, PhaseEndSettlesDamageRaisedDuringThePhase)
+{
+    const auto [source, first, second] = m_characters;
+    m_context.registry.ctx().emplace<GameData>();
+    GameFlowSystem flow(m_context);
+    flow.registerEvents();
+    StartPhaseDamage listener{.context = &m_context, .source = source};
+    m_context.dispatcher.sink<events::TurnPhase>().connect<&StartPhaseDamage::onPhase>(listener);
+
+    events::GameStart start;
+    start.players = {first, second};
+    m_context.dispatcher.trigger(start);
+    flow.tick(0);
+
+    EXPECT_EQ(health(first), 3);
+    EXPECT_EQ(m_damage.pendingCount(), 0U);
+
+    m_context.dispatcher.sink<events::TurnPhase>().disconnect(&listener);
+    flow.unregisterEvents();
+}
+} // namespace
@@ -0,0 +1,257 @@
+/**
+ * ************************************************************************
+ *
+ * @file test_DefinitionTable.cpp
+ * @author AnakinLiu (azrael2759@qq.com)
+ * @date 2026-10-16
+ * @version 0.1
+ * @brief 定义表编译与只读视图单元测试
+ *
+ * 表由 CompileDefinitions 在内存中生成，再逐项篡改头部或内容，检查 view() 的各条拒绝路径；
+ * 篡改头部之后的内容时重新计算校验和，使错误落到引用校验上
+ *
+ * ************************************************************************
+ * @copyright Copyright (c) 2026 AnakinLiu
+ * For study and research only, no reprinting.
+ * ************************************************************************
+ */
+#include <gtest/gtest.h>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <vector>
+#include <nlohmann/json.hpp>
+#include "src/server/data/DefinitionCompiler.h"
+#include "src/server/data/DefinitionTable.h"
+
+namespace
+{
+const nlohmann::json DEFINITIONS = nlohmann::json::parse(R"({
+    "cards": [
+        { "key": "strike", "name": "杀", "type": "BASIC", "subType": "STRIKE" }
+    ],
+    "deck": [
+        { "card": "strike", "suit": "SPADE", "points": [7, 8] }
+    ],
+    "skills": [
+        { "name": "奸雄", "description": "受到伤害后获得造成伤害的牌",
+          "triggers": [{ "phase": "PLAY", "moment": "DURING" }] }
+    ],
+    "characters": [
+        { "id": 1, "name": "Pest", "maxHealth": 3, "skills": ["奸雄"] }
+    ]
+})");
+
+class DefinitionTableTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        auto compiled = data::CompileDefinitions(DEFINITIONS);
+        ASSERT_TRUE(compiled.has_value()) << compiled.error();
+        m_bytes = std::move(*compiled);
+    }
+
+    [[nodiscard]] data::TableHeader header() const
+    {
+        data::TableHeader value;
+        std::memcpy(&value, m_bytes.data(), sizeof(value));
+        return value;
+    }
+
+    void setHeader(const data::TableHeader& value) { std::memcpy(m_bytes.data(), &value, sizeof(value)); }
+
+    /**
+     * @brief 改写内容区中的一条记录并重新计算校验和
+     */
+    template <typename T>
+    void patch(const data::Section& section, std::size_t index, const T& value)
+    {
+        std::memcpy(m_bytes.data() + section.offset + index * sizeof(T), &value, sizeof(T));
+        auto patched = header();
+        patched.checksum = data::DefinitionChecksum(std::span(m_bytes).subspan(sizeof(data::TableHeader)));
+        setHeader(patched);
+    }
+
+    [[nodiscard]] data::CharacterDef character() const
+    {
+        data::CharacterDef value;
+        std::memcpy(&value, m_bytes.data() + header().characters.offset, sizeof(value));
+        return value;
+    }
+
+    template <typename T>
+    [[nodiscard]] T record(const data::Section& section, std::size_t index = 0) const
+    {
+        T value;
+        std::memcpy(&value, m_bytes.data() + section.offset + index * sizeof(T), sizeof(T));
+        return value;
+    }
+
+    [[nodiscard]] auto view() const { return data::DefinitionTable::view(m_bytes); }
+
+    std::vector<std::byte> m_bytes;
+};
+
+TEST_F(DefinitionTableTest, CompiledTableResolvesCharacterSkills)
+{
+    auto table = view();
+    ASSERT_TRUE(table.has_value());
+
+    ASSERT_EQ(table->cards().size(), 1U);
+    EXPECT_EQ(table->deck().size(), 2U);
+    const auto* pest = table->findCharacter(1);
+    ASSERT_NE(pest, nullptr);
+    EXPECT_EQ(table->text(pest->name), "Pest");
+    EXPECT_EQ(pest->maxHealth, 3);
+    const auto skills = table->skillsOf(*pest);
+    ASSERT_EQ(skills.size(), 1U);
+    const auto& skill = table->skills()[skills.front()];
+    EXPECT_EQ(table->text(skill.name), "奸雄");
+    ASSERT_EQ(table->triggersOf(skill).size(), 1U);
+    EXPECT_EQ(table->triggersOf(skill).front().phase, TurnPhase::PLAY);
+}
+
+TEST_F(DefinitionTableTest, BufferShorterThanHeaderIsTruncated)
+{
+    auto table = data::DefinitionTable::view(std::span(m_bytes).first(sizeof(data::TableHeader) - 1));
+    EXPECT_EQ(table.error(), data::DefinitionError::Truncated);
+}
+
+TEST_F(DefinitionTableTest, DeclaredSizeBeyondBufferIsTruncated)
+{
+    auto table = data::DefinitionTable::view(std::span(m_bytes).first(m_bytes.size() - 1));
+    EXPECT_EQ(table.error(), data::DefinitionError::Truncated);
+}
+
+TEST_F(DefinitionTableTest, DeclaredSizeSmallerThanHeaderIsTruncated)
+{
+    auto patched = header();
+    patched.totalSize = sizeof(data::TableHeader) - 1;
+    setHeader(patched);
+
+    EXPECT_EQ(view().error(), data::DefinitionError::Truncated);
+}
+
+TEST_F(DefinitionTableTest, BadMagicIsRejected)
+{
+    auto patched = header();
+    patched.magic[0] = 'X';
+    setHeader(patched);
+
+    EXPECT_EQ(view().error(), data::DefinitionError::BadMagic);
+}
+
+TEST_F(DefinitionTableTest, OtherVersionIsRejected)
+{
+    auto patched = header();
+    patched.version = data::DEFINITION_VERSION + 1;
+    setHeader(patched);
+
+    EXPECT_EQ(view().error(), data::DefinitionError::VersionMismatch);
+}
+
+TEST_F(DefinitionTableTest, CorruptedContentFailsChecksum)
+{
+    m_bytes.back() ^= std::byte{0x01};
+
+    EXPECT_EQ(view().error(), data::DefinitionError::ChecksumMismatch);
+}
+
+TEST_F(DefinitionTableTest, SectionOutOfBoundsIsRejected)
+{
+    // 头部不在校验范围内，改写段描述不会触发校验和错误
+    auto patched = header();
+    patched.characters.count = static_cast<uint32_t>(m_bytes.size());
+    setHeader(patched);
+
+    EXPECT_EQ(view().error(), data::DefinitionError::InvalidSection);
+}
+
+TEST_F(DefinitionTableTest, MisalignedSectionIsRejected)
+{
+    auto patched = header();
+    patched.cards.offset += 1;
+    setHeader(patched);
+
+    EXPECT_EQ(view().error(), data::DefinitionError::InvalidSection);
+}
+
+TEST_F(DefinitionTableTest, StringReferenceOutsidePoolIsRejected)
+{
+    auto pest = character();
+    pest.name.offset = header().strings.count;
+    pest.name.size = 1;
+    patch(header().characters, 0, pest);
+
+    EXPECT_EQ(view().error(), data::DefinitionError::InvalidSection);
+}
+
+TEST_F(DefinitionTableTest, CharacterSkillRangeOutsideSectionIsRejected)
+{
+    auto pest = character();
+    pest.skillCount = 2;
+    patch(header().characters, 0, pest);
+
+    EXPECT_EQ(view().error(), data::DefinitionError::InvalidSection);
+}
+
+TEST_F(DefinitionTableTest, UnknownSkillIndexIsRejected)
+{
+    patch(header().characterSkills, 0, static_cast<uint16_t>(header().skills.count));
+
+    EXPECT_EQ(view().error(), data::DefinitionError::InvalidSection);
+}
+
+TEST_F(DefinitionTableTest, DeckEntryWithUnknownCardIsRejected)
+{
+    data::DeckEntry entry{.card = static_cast<uint16_t>(header().cards.count), .point = 7, .suit = SuitType::SPADE};
+    patch(header().deck, 0, entry);
+
+    EXPECT_EQ(view().error(), data::DefinitionError::InvalidSection);
+}
+TEST_F(DefinitionTableTest, OutOfRangeSuitIsRejected)
+{
+    auto entry = record<data::DeckEntry>(header().deck);
+    entry.suit = static_cast<SuitType>(data::SUIT_COUNT);
+    patch(header().deck, 0, entry);
+
+    EXPECT_EQ(view().error(), data::DefinitionError::InvalidValue);
+}
+
+TEST_F(DefinitionTableTest, OutOfRangeCardSubTypeIsRejected)
+{
+    auto strike = record<data::CardDef>(header().cards);
+    strike.subType = data::BASIC_CARD_COUNT;
+    patch(header().cards, 0, strike);
+
+    EXPECT_EQ(view().error(), data::DefinitionError::InvalidValue);
+}
+
+TEST_F(DefinitionTableTest, OutOfRangeTriggerMomentIsRejected)
+{
+    auto trigger = record<data::TriggerDef>(header().triggers);
+    trigger.moment = static_cast<TriggerMoment>(data::MOMENT_COUNT);
+    patch(header().triggers, 0, trigger);
+
+    EXPECT_EQ(view().error(), data::DefinitionError::InvalidValue);
+}
+
+TEST_F(DefinitionTableTest, OutOfRangeFactionIsRejected)
+{
+    auto pest = character();
+    pest.faction = static_cast<FactionType>(data::FACTION_COUNT);
+    patch(header().characters, 0, pest);
+
+    EXPECT_EQ(view().error(), data::DefinitionError::InvalidValue);
+}
+
+TEST(DefinitionCompilerTest, NumericEnumOutOfRangeFailsCompilation)
+{
+    auto definitions = DEFINITIONS;
+    definitions["characters"][0]["gender"] = data::GENDER_COUNT;
+
+    EXPECT_FALSE(data::CompileDefinitions(definitions).has_value());
+}
+} // namespace
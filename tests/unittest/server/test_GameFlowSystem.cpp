@@ -0,0 +1,203 @@
+/**
+ * ************************************************************************
+ *
+ * @file test_GameFlowSystem.cpp
+ * @author AnakinLiu (azrael2759@qq.com)
+ * @date 2026-10-16
+ * @version 0.1
+ * @brief GameFlowSystem 阶段状态机单元测试
+ *
+ * 阶段只在 tick() 中从运行队列取出执行，单次 tick 最多执行 MAX_PHASE_STEPS_PER_TICK 个；
+ * 出牌阶段打开响应窗口，超时进入弃牌阶段，玩家主动结束出牌 (EndPlayPhase) 则提前关闭窗口。
+ * 进入的阶段通过 events::TurnPhase 记录
+ *
+ * ************************************************************************
+ * @copyright Copyright (c) 2026 AnakinLiu
+ * For study and research only, no reprinting.
+ * ************************************************************************
+ */
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+#include <entt/entt.hpp>
+#include "src/server/components/GameData.h"
+#include "src/server/context/GameContext.h"
+#include "src/server/events/Events.h"
+#include "src/server/events/GameFlowEvents.h"
+#include "src/server/systems/GameFlowSystem.h"
+
+namespace
+{
+constexpr uint8_t RESPONSE_SECONDS = 1;
+constexpr uint32_t RESPONSE_MS = RESPONSE_SECONDS * 1000U;
+
+/**
+ * @brief 记录进入的阶段；autoEndPlay 为 true 时一进入出牌阶段就结束出牌
+ */
+struct PhaseRecorder
+{
+    GameContext* context = nullptr;
+    bool autoEndPlay = false;
+    std::vector<TurnPhase> phases;
+    std::vector<entt::entity> players;
+
+    void onPhase(const events::TurnPhase& event)
+    {
+        phases.push_back(event.currentPhase);
+        players.push_back(event.player);
+        if (autoEndPlay && event.currentPhase == TurnPhase::PLAY)
+        {
+            context->dispatcher.trigger(events::EndPlayPhase{.player = event.player});
+        }
+    }
+};
+
+class GameFlowSystemTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        m_context.logger->set_level(spdlog::level::warn);
+        m_context.registry.ctx().emplace<GameData>(GameData{.responseTime = RESPONSE_SECONDS});
+        m_recorder.context = &m_context;
+        m_context.dispatcher.sink<events::TurnPhase>().connect<&PhaseRecorder::onPhase>(m_recorder);
+        m_flow.registerEvents();
+        m_first = m_context.registry.create();
+        m_second = m_context.registry.create();
+    }
+
+    void TearDown() override
+    {
+        m_flow.unregisterEvents();
+        m_context.dispatcher.sink<events::TurnPhase>().disconnect<&PhaseRecorder::onPhase>(m_recorder);
+    }
+
+    void startGame()
+    {
+        events::GameStart start;
+        start.players = {m_first, m_second};
+        m_context.dispatcher.trigger(start);
+    }
+
+    GameContext m_context;
+    GameFlowSystem m_flow{m_context};
+    PhaseRecorder m_recorder;
+    entt::entity m_first = entt::null;
+    entt::entity m_second = entt::null;
+};
+
+TEST_F(GameFlowSystemTest, GameStartOnlyQueuesFirstPhase)
+{
+    startGame();
+
+    EXPECT_TRUE(m_recorder.phases.empty());
+    EXPECT_TRUE(m_flow.hasPendingPhases());
+}
+
+TEST_F(GameFlowSystemTest, QueueDrainsInPhaseOrderUntilPlayWaits)
+{
+    startGame();
+
+    const std::size_t steps = m_flow.tick(0);
+
+    const std::vector<TurnPhase> expected{
+        TurnPhase::GAME_START, TurnPhase::START, TurnPhase::JUDGE, TurnPhase::DRAW, TurnPhase::PLAY};
+    EXPECT_EQ(steps, expected.size());
+    EXPECT_EQ(m_recorder.phases, expected);
+    EXPECT_EQ(m_recorder.players.back(), m_first);
+    EXPECT_FALSE(m_flow.hasPendingPhases());
+    EXPECT_TRUE(m_flow.isWaitingForResponse());
+    EXPECT_EQ(m_context.registry.ctx().get<GameData>().currentPhase, TurnPhase::PLAY);
+    EXPECT_EQ(m_context.registry.ctx().get<GameData>().currentPlayer, m_first);
+}
+
+TEST_F(GameFlowSystemTest, TickRunsAtMostStepBudget)
+{
+    // 每个出牌阶段立即结束，回合循环永不等待：单次 tick 只能执行预算内的阶段
+    m_recorder.autoEndPlay = true;
+    startGame();
+
+    EXPECT_EQ(m_flow.tick(0), GameFlowSystem::MAX_PHASE_STEPS_PER_TICK);
+    EXPECT_EQ(m_recorder.phases.size(), GameFlowSystem::MAX_PHASE_STEPS_PER_TICK);
+    EXPECT_TRUE(m_flow.hasPendingPhases());
+
+    EXPECT_EQ(m_flow.tick(0), GameFlowSystem::MAX_PHASE_STEPS_PER_TICK);
+    EXPECT_EQ(m_recorder.phases.size(), 2 * GameFlowSystem::MAX_PHASE_STEPS_PER_TICK);
+}
+
+TEST_F(GameFlowSystemTest, AutoEndedTurnsAlternatePlayers)
+{
+    m_recorder.autoEndPlay = true;
+    startGame();
+    m_flow.tick(0);
+
+    // GAME_START 之后每个回合 6 个阶段：START JUDGE DRAW PLAY DISCARD END
+    const std::vector<TurnPhase> firstTurn{TurnPhase::GAME_START,
+                                           TurnPhase::START,
+                                           TurnPhase::JUDGE,
+                                           TurnPhase::DRAW,
+                                           TurnPhase::PLAY,
+                                           TurnPhase::DISCARD,
+                                           TurnPhase::END,
+                                           TurnPhase::START};
+    ASSERT_GE(m_recorder.phases.size(), firstTurn.size());
+    EXPECT_TRUE(std::equal(firstTurn.begin(), firstTurn.end(), m_recorder.phases.begin()));
+    EXPECT_EQ(m_recorder.players[6], m_first);  // END 属于结束回合的玩家
+    EXPECT_EQ(m_recorder.players[7], m_second); // 下一个 START 轮到下家
+    EXPECT_FALSE(m_flow.isWaitingForResponse());
+}
+
+TEST_F(GameFlowSystemTest, ResponseWindowTimesOutIntoDiscard)
+{
+    startGame();
+    m_flow.tick(0);
+    m_recorder.phases.clear();
+
+    EXPECT_EQ(m_flow.tick(RESPONSE_MS - 1), 0U);
+    EXPECT_TRUE(m_flow.isWaitingForResponse());
+    EXPECT_TRUE(m_recorder.phases.empty());
+
+    // 剩余 1 毫秒：本次 tick 超时，超时阶段在同一 tick 内执行，随后进入下家的出牌阶段再次等待
+    m_flow.tick(1);
+    const std::vector<TurnPhase> expected{TurnPhase::DISCARD,
+                                          TurnPhase::END,
+                                          TurnPhase::START,
+                                          TurnPhase::JUDGE,
+                                          TurnPhase::DRAW,
+                                          TurnPhase::PLAY};
+    EXPECT_EQ(m_recorder.phases, expected);
+    EXPECT_EQ(m_recorder.players.back(), m_second);
+    EXPECT_TRUE(m_flow.isWaitingForResponse());
+}
+
+TEST_F(GameFlowSystemTest, EndPlayPhaseClosesWindowEarly)
+{
+    startGame();
+    m_flow.tick(0);
+    m_recorder.phases.clear();
+
+    m_context.dispatcher.trigger(events::EndPlayPhase{.player = m_first});
+    EXPECT_FALSE(m_flow.isWaitingForResponse());
+    EXPECT_TRUE(m_flow.hasPendingPhases());
+
+    m_flow.tick(0);
+    ASSERT_FALSE(m_recorder.phases.empty());
+    EXPECT_EQ(m_recorder.phases.front(), TurnPhase::DISCARD);
+    // 新窗口属于下家，计时重新开始
+    EXPECT_EQ(m_recorder.players.back(), m_second);
+    EXPECT_EQ(m_flow.tick(RESPONSE_MS - 1), 0U);
+    EXPECT_TRUE(m_flow.isWaitingForResponse());
+}
+
+TEST_F(GameFlowSystemTest, EndPlayPhaseFromOtherPlayerIsIgnored)
+{
+    startGame();
+    m_flow.tick(0);
+
+    m_context.dispatcher.trigger(events::EndPlayPhase{.player = m_second});
+
+    EXPECT_TRUE(m_flow.isWaitingForResponse());
+    EXPECT_FALSE(m_flow.hasPendingPhases());
+}
+} // namespace
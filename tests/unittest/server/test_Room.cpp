@@ -0,0 +1,179 @@
+/**
+ * ************************************************************************
+ *
+ * @file test_Room.cpp
+ * @author AnakinLiu (azrael2759@qq.com)
+ * @date 2026-10-16
+ * @version 0.1
+ * @brief 房间开局与 tick 单元测试
+ *
+ * 开局时创建系统与玩家（武将取自构建生成的定义表），首个 tick 开始执行回合；响应计时按 tick 的时间增量推进；
+ * tick 末尾结算本 tick 产生的效果；断线恢复时向座位补发局面快照。测试在单线程上直接调用，不经过 strand
+ *
+ * ************************************************************************
+ * @copyright Copyright (c) 2026 AnakinLiu
+ * For study and research only, no reprinting.
+ * ************************************************************************
+ */
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <vector>
+#include "src/server/components/Character.h"
+#include "src/server/components/GameData.h"
+#include "src/server/components/Player.h"
+#include "src/server/events/Events.h"
+#include "src/server/lobby/Room.h"
+#include "src/server/rules/CardRules.h"
+#include "src/shared/messages/response/RoomSnapshotResponse.h"
+#include "src/utils/TaskScheduler.h"
+
+namespace
+{
+constexpr uint32_t FIRST_PLAYER = 101;
+constexpr uint32_t SECOND_PLAYER = 102;
+constexpr uint8_t OPENING_HAND = 4;
+
+class RoomTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        m_room.takeSeat(FIRST_PLAYER);
+        m_room.takeSeat(SECOND_PLAYER);
+        m_room.start(m_room.seats);
+        m_room.context->logger->set_level(spdlog::level::err);
+    }
+
+    [[nodiscard]] const GameData& gameData() const { return m_room.context->registry.ctx().get<GameData>(); }
+
+    utils::TaskScheduler m_scheduler{1};
+    lobby::Room m_room{1, "test", "", 2, m_scheduler};
+};
+
+TEST_F(RoomTest, StartSeatsPlayersInSeatOrder)
+{
+    const auto& registry = m_room.context->registry;
+    EXPECT_EQ(registry.get<MetaPlayerInfo>(m_room.players[0]).playerID, FIRST_PLAYER);
+    EXPECT_EQ(registry.get<MetaPlayerInfo>(m_room.players[1]).playerID, SECOND_PLAYER);
+    // 开局阶段只入队，尚未执行
+    EXPECT_TRUE(m_room.flow->hasPendingPhases());
+    EXPECT_TRUE(registry.get<HandCards>(m_room.players[0]).handCards.empty());
+}
+
+TEST_F(RoomTest, PlayersTakeCharactersFromDefinitionTable)
+{
+    const auto& definitions = m_room.context->definitions;
+    ASSERT_NE(definitions, nullptr) << "definition table not found at " << data::DefinitionTable::defaultPath();
+    const auto& registry = m_room.context->registry;
+    for (uint8_t seat = 0; seat < m_room.capacity; ++seat)
+    {
+        const entt::entity card = registry.get<CharacterInfo>(m_room.players[seat]).characterCard;
+        ASSERT_TRUE(registry.valid(card));
+        const auto* definition = definitions->findCharacter(registry.get<MetaCharacterInfo>(card).id);
+        ASSERT_NE(definition, nullptr);
+        EXPECT_EQ(registry.get<CombatState>(m_room.players[seat]).maxHealth, definition->maxHealth);
+        EXPECT_EQ(registry.get<Skills>(card).skillList.size(), definition->skillCount);
+    }
+}
+
+TEST_F(RoomTest, FirstTickRunsTurnUntilPlayPhaseWaits)
+{
+    m_room.tick(0);
+
+    EXPECT_EQ(m_room.flow->currentPhase(), TurnPhase::PLAY);
+    EXPECT_TRUE(m_room.flow->isWaitingForResponse());
+    EXPECT_EQ(gameData().currentPlayer, m_room.players[0]);
+    // 摸牌阶段由 GameFlowSystem 自己发牌，只有当前玩家多摸 DRAW_PER_TURN 张
+    const auto& registry = m_room.context->registry;
+    EXPECT_EQ(registry.get<HandCards>(m_room.players[0]).handCards.size(), OPENING_HAND + rules::DRAW_PER_TURN);
+    EXPECT_EQ(registry.get<HandCards>(m_room.players[1]).handCards.size(), OPENING_HAND);
+}
+
+TEST_F(RoomTest, TickDeltaAdvancesResponseWindowToNextSeat)
+{
+    m_room.tick(0);
+    const uint32_t responseMs = gameData().responseTime * 1000U;
+
+    m_room.tick(responseMs - 1);
+    EXPECT_EQ(gameData().currentPlayer, m_room.players[0]);
+
+    m_room.tick(1);
+    EXPECT_EQ(m_room.flow->currentPhase(), TurnPhase::PLAY);
+    EXPECT_EQ(gameData().currentPlayer, m_room.players[1]);
+}
+
+TEST_F(RoomTest, TickSettlesEffectsQueuedDuringTheTick)
+{
+    m_room.tick(0);
+    auto& registry = m_room.context->registry;
+    const int32_t before = registry.get<CombatState>(m_room.players[1]).currentHealth;
+
+    m_room.context->dispatcher.enqueue(
+        events::Damage{.from = m_room.players[0], .to = m_room.players[1], .amount = 1});
+    m_room.tick(0);
+
+    EXPECT_EQ(registry.get<CombatState>(m_room.players[1]).currentHealth, before - 1);
+}
+
+TEST_F(RoomTest, SnapshotCarriesTableStateAndOnlyOwnHand)
+{
+    m_room.tick(0);
+    std::vector<events::SendNetworkPacket> drained;
+    m_room.drainOutbox(drained);
+
+    m_room.offline.set(0);
+    m_room.sendSnapshot(1);
+    std::vector<events::SendNetworkPacket> sent;
+    m_room.drainOutbox(sent);
+
+    ASSERT_EQ(sent.size(), 1U);
+    EXPECT_EQ(sent.front().connectionId, SECOND_PLAYER);
+    auto frame = decodeFrame(sent.front().frame.bytes());
+    ASSERT_TRUE(frame.has_value());
+    ASSERT_EQ(frame->cmd, CommandID::ROOM_SNAPSHOT);
+    auto snapshot = RoomSnapshotResponse::deserialize(frame->payload);
+    ASSERT_TRUE(snapshot.has_value());
+    EXPECT_EQ(snapshot->roomId, m_room.id);
+    EXPECT_EQ(snapshot->seat, 1);
+    EXPECT_EQ(snapshot->phase, static_cast<uint8_t>(TurnPhase::PLAY));
+    EXPECT_EQ(snapshot->currentSeat, 0);
+    ASSERT_EQ(snapshot->seats.size(), 2U);
+    EXPECT_EQ(snapshot->seats[0].playerId, FIRST_PLAYER);
+    EXPECT_TRUE(snapshot->seats[0].offline);
+    EXPECT_FALSE(snapshot->seats[1].offline);
+    const auto& hand = m_room.context->registry.get<HandCards>(m_room.players[1]).handCards;
+    EXPECT_EQ(snapshot->seats[1].handCount, hand.size());
+    ASSERT_EQ(snapshot->hand.size(), hand.size());
+    EXPECT_EQ(snapshot->hand.front().cardId, entt::to_integral(hand.front()));
+}
+
+TEST_F(RoomTest, SeatLeftDuringPlayKeepsPlayerAndReportsOffline)
+{
+    m_room.tick(0);
+    std::vector<events::SendNetworkPacket> drained;
+    m_room.drainOutbox(drained);
+
+    // 大厅让出座位后，对局中的座位不受影响，只经 strand 标记离线
+    m_room.leaveSeat(FIRST_PLAYER);
+    m_room.seatLeft(0);
+    m_room.sendSnapshot(1);
+    std::vector<events::SendNetworkPacket> sent;
+    m_room.drainOutbox(sent);
+
+    ASSERT_EQ(sent.size(), 1U);
+    auto frame = decodeFrame(sent.front().frame.bytes());
+    ASSERT_TRUE(frame.has_value());
+    auto snapshot = RoomSnapshotResponse::deserialize(frame->payload);
+    ASSERT_TRUE(snapshot.has_value());
+    ASSERT_EQ(snapshot->seats.size(), 2U);
+    EXPECT_EQ(snapshot->seats[0].playerId, FIRST_PLAYER);
+    EXPECT_TRUE(snapshot->seats[0].offline);
+    EXPECT_TRUE(m_room.context->registry.valid(m_room.players[0]));
+}
+
+TEST_F(RoomTest, ElapsedSinceStartsAtZero)
+{
+    EXPECT_EQ(m_room.elapsedSince(1000), 0U);
+    EXPECT_EQ(m_room.elapsedSince(1033), 33U);
+}
+} // namespace
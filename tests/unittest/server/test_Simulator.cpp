@@ -0,0 +1,159 @@
+/**
+ * ************************************************************************
+ *
+ * @file test_Simulator.cpp
+ * @author AnakinLiu (azrael2759@qq.com)
+ * @date 2026-10-16
+ * @version 0.1
+ * @brief 模拟状态派生与模拟结果单元测试
+ *
+ * 牌堆与伤害由真实的 DeckSystem / DamageSystem 处理（牌取自构建生成的定义表），
+ * 检查 Capture() 得到的状态与注册表一致、卡牌表登记不下的牌被跳过，以及一局确定的模拟与系统结算结果一致
+ *
+ * ************************************************************************
+ * @copyright Copyright (c) 2026 AnakinLiu
+ * For study and research only, no reprinting.
+ * ************************************************************************
+ */
+#include <gtest/gtest.h>
+#include <array>
+#include <cstdint>
+#include <entt/entt.hpp>
+#include "src/server/components/Card.h"
+#include "src/server/components/Character.h"
+#include "src/server/components/Player.h"
+#include "src/server/context/GameContext.h"
+#include "src/server/events/Events.h"
+#include "src/server/rules/CardRules.h"
+#include "src/server/simulation/SimState.h"
+#include "src/server/simulation/Simulator.h"
+#include "src/server/systems/DamageSystem.h"
+#include "src/server/systems/DeckSystem.h"
+
+namespace
+{
+constexpr uint32_t OPENING_HAND = 4;
+
+class SimulatorTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        m_context.logger->set_level(spdlog::level::err);
+        m_deck.registerEvents();
+        m_damage.init();
+        for (auto& player : m_players)
+        {
+            player = m_context.registry.create();
+            m_context.registry.emplace<HandCards>(
+                player, HandCards{HandCards::Zone(m_context.registry.get_allocator())});
+            m_context.registry.emplace<Equipments>(player);
+            m_context.registry.emplace<CombatState>(player);
+            m_context.registry.emplace<Attributes>(player);
+            m_context.dispatcher.trigger(events::DealCards{.player = player, .count = OPENING_HAND});
+        }
+    }
+
+    void TearDown() override
+    {
+        m_damage.destroy();
+        m_deck.unregisterEvents();
+    }
+
+    [[nodiscard]] simulation::SimState capture()
+    {
+        return simulation::Capture(m_context.registry, m_deck.deck(), m_players, m_players.front(), m_table);
+    }
+
+    GameContext m_context;
+    DeckSystem m_deck{m_context};
+    DamageSystem m_damage{m_context};
+    std::array<entt::entity, 2> m_players{};
+    simulation::SimCardTable m_table;
+};
+
+TEST_F(SimulatorTest, CaptureMirrorsDeckSystemZones)
+{
+    const auto state = capture();
+
+    ASSERT_EQ(state.seatCount, m_players.size());
+    for (uint8_t seat = 0; seat < state.seatCount; ++seat)
+    {
+        const auto& hand = m_context.registry.get<HandCards>(m_players[seat]).handCards;
+        const auto simulated = state.seats[seat].hand.view();
+        ASSERT_EQ(simulated.size(), hand.size());
+        for (std::size_t index = 0; index < hand.size(); ++index)
+        {
+            EXPECT_EQ(simulated[index], m_table.ids.at(hand[index]));
+        }
+    }
+    const auto& drawPile = m_deck.deck().drawPile;
+    ASSERT_EQ(state.drawPile.count, drawPile.size());
+    ASSERT_FALSE(drawPile.empty());
+    // 模拟牌堆逆序存放，栈顶即 DeckSystem 下一张要发的牌
+    EXPECT_EQ(state.drawPile.cards[state.drawPile.count - 1], m_table.ids.at(drawPile.front()));
+}
+
+TEST_F(SimulatorTest, CaptureSkipsCardsTheTableCannotHold)
+{
+    m_table.cards.resize(simulation::MAX_CARDS);
+
+    const auto state = capture();
+
+    EXPECT_TRUE(state.seats[0].hand.empty());
+    EXPECT_TRUE(state.drawPile.empty());
+    EXPECT_TRUE(m_table.ids.empty());
+}
+
+TEST_F(SimulatorTest, LethalStrikeRolloutMatchesDamageSystem)
+{
+    auto& registry = m_context.registry;
+    const entt::entity attacker = m_players[0];
+    const entt::entity victim = m_players[1];
+    auto& attackerHand = registry.get<HandCards>(attacker).handCards;
+    attackerHand.clear();
+    attackerHand.push_back(CreateStrickCard(registry, CardPointAndSuit{.point = 7, .suit = SuitType::SPADE}));
+    registry.get<HandCards>(victim).handCards.clear();
+    registry.get<CombatState>(victim).currentHealth = 1;
+
+    // 模拟：进攻方先打出手里的杀，没有手牌的目标无法出闪，也没有桃自救
+    const simulation::Simulator simulator(m_table);
+    const auto result = simulator.rollout(capture(), 7, 1);
+
+    // 系统：同一张杀未被抵消时的伤害经 DamageSystem 结算
+    m_context.dispatcher.trigger(events::Damage{.from = attacker, .to = victim, .amount = rules::STRIKE_RULE.damage});
+    m_context.dispatcher.trigger(events::SettleEffects{});
+
+    EXPECT_EQ(result.turns, 1U);
+    EXPECT_EQ(result.winner, 0);
+    EXPECT_FALSE(registry.get<CombatState>(victim).isAlive);
+}
+
+TEST(CardRulesTest, AttackTimesLimitOnlyStrikes)
+{
+    EXPECT_TRUE(rules::CanAttack(rules::STRIKE_RULE, 1));
+    EXPECT_FALSE(rules::CanAttack(rules::STRIKE_RULE, 0));
+    EXPECT_TRUE(rules::CanAttack(rules::FIRE_ATTACK_RULE, 0));
+}
+
+TEST(CardRulesTest, DuelLoserIsFirstSideWithoutStrike)
+{
+    int targetStrikes = 1;
+    int userStrikes = 0;
+    const bool targetLoses = rules::ResolveDuel(
+        [&](bool targetTurn)
+        {
+            int& strikes = targetTurn ? targetStrikes : userStrikes;
+            return strikes-- > 0;
+        });
+
+    EXPECT_FALSE(targetLoses);
+}
+
+TEST(CardRulesTest, DiscardCountKeepsHandWithinHealth)
+{
+    EXPECT_EQ(rules::DiscardCount(5, 3), 2U);
+    EXPECT_EQ(rules::DiscardCount(2, 3), 0U);
+    EXPECT_EQ(rules::DiscardCount(2, -1), 2U);
+}
+} // namespace
@@ -0,0 +1,202 @@
+/**
+ * ************************************************************************
+ *
+ * @file test_SkillSystem.cpp
+ * @author AnakinLiu (azrael2759@qq.com)
+ * @date 2026-10-16
+ * @version 0.1
+ * @brief SkillSystem 挂钩索引单元测试
+ *
+ * Skills 组件创建/替换/销毁时只重建该角色的挂钩；
+ * 晚于 Skills 注册的技能实现会补建挂钩；TargetMask 按候选下标输出
+ *
+ * ************************************************************************
+ * @copyright Copyright (c) 2026 AnakinLiu
+ * For study and research only, no reprinting.
+ * ************************************************************************
+ */
+#include <gtest/gtest.h>
+#include <span>
+#include <vector>
+#include <entt/entt.hpp>
+#include "src/server/components/Character.h"
+#include "src/server/components/Skill.h"
+#include "src/server/context/GameContext.h"
+#include "src/server/events/Events.h"
+#include "src/server/systems/SkillSystem.h"
+
+namespace
+{
+/**
+ * @brief 记录调用次数与最近一次触发的持有者；筛选目标时排除使用者自身
+ */
+struct CountingSkill
+{
+    int* uses = nullptr;
+    entt::entity* lastOwner = nullptr;
+
+    void onUse(entt::entity owner, [[maybe_unused]] const events::TriggerMoment& event) const
+    {
+        ++*uses;
+        if (lastOwner != nullptr)
+        {
+            *lastOwner = owner;
+        }
+    }
+
+    void filterTargets(entt::entity user, std::span<const entt::entity> candidates, TargetMask& out) const
+    {
+        for (std::size_t index = 0; index < candidates.size(); ++index)
+        {
+            out.set(index, candidates[index] != user);
+        }
+    }
+};
+
+class SkillSystemTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        m_context.logger->set_level(spdlog::level::err);
+        m_skills.registerEvents();
+        m_owner = m_context.registry.create();
+    }
+
+    void TearDown() override { m_skills.unregisterEvents(); }
+
+    entt::entity createSkill(std::string_view name, TurnPhase phase)
+    {
+        auto skill = m_context.registry.create();
+        m_context.registry.emplace<MetaSkillInfo>(skill, MetaSkillInfo{.name = name});
+        SkillTriggers triggers;
+        triggers.triggers.push_back(SkillTrigger{.phase = phase, .moment = TriggerMoment::DURING});
+        m_context.registry.emplace<SkillTriggers>(skill, std::move(triggers));
+        return skill;
+    }
+
+    [[nodiscard]] Skills skillsOf(std::initializer_list<entt::entity> skills)
+    {
+        return Skills{memory::Vector<entt::entity>(skills.begin(), skills.end(), m_context.registry.get_allocator())};
+    }
+
+    GameContext m_context;
+    SkillSystem m_skills{m_context};
+    entt::entity m_owner = entt::null;
+    int m_uses = 0;
+};
+
+TEST_F(SkillSystemTest, AddingSkillsBuildsHooksForItsTriggers)
+{
+    m_skills.registerSkill("A", CountingSkill{.uses = &m_uses});
+    auto skill = createSkill("A", TurnPhase::PLAY);
+
+    m_context.registry.emplace<Skills>(m_owner, skillsOf({skill}));
+
+    auto hooks = m_skills.hooksFor(TriggerMoment::DURING, TurnPhase::PLAY);
+    ASSERT_EQ(hooks.size(), 1U);
+    EXPECT_EQ(hooks.front().owner, m_owner);
+    EXPECT_EQ(hooks.front().skill, skill);
+    EXPECT_TRUE(m_skills.hooksFor(TriggerMoment::DURING, TurnPhase::DRAW).empty());
+}
+
+TEST_F(SkillSystemTest, RegisteringImplementationLaterRebuildsHooks)
+{
+    auto skill = createSkill("A", TurnPhase::PLAY);
+    m_context.registry.emplace<Skills>(m_owner, skillsOf({skill}));
+    ASSERT_TRUE(m_skills.hooksFor(TriggerMoment::DURING, TurnPhase::PLAY).empty());
+
+    m_skills.registerSkill("A", CountingSkill{.uses = &m_uses});
+
+    EXPECT_EQ(m_skills.hooksFor(TriggerMoment::DURING, TurnPhase::PLAY).size(), 1U);
+}
+
+TEST_F(SkillSystemTest, ReplacingSkillsMovesHooks)
+{
+    m_skills.registerSkill("A", CountingSkill{.uses = &m_uses});
+    m_skills.registerSkill("B", CountingSkill{.uses = &m_uses});
+    auto first = createSkill("A", TurnPhase::PLAY);
+    auto second = createSkill("B", TurnPhase::DISCARD);
+    m_context.registry.emplace<Skills>(m_owner, skillsOf({first}));
+
+    m_context.registry.replace<Skills>(m_owner, skillsOf({second}));
+
+    EXPECT_TRUE(m_skills.hooksFor(TriggerMoment::DURING, TurnPhase::PLAY).empty());
+    auto hooks = m_skills.hooksFor(TriggerMoment::DURING, TurnPhase::DISCARD);
+    ASSERT_EQ(hooks.size(), 1U);
+    EXPECT_EQ(hooks.front().skill, second);
+}
+
+TEST_F(SkillSystemTest, DestroyingSkillsRemovesOnlyThatOwnersHooks)
+{
+    m_skills.registerSkill("A", CountingSkill{.uses = &m_uses});
+    auto skill = createSkill("A", TurnPhase::PLAY);
+    auto other = m_context.registry.create();
+    m_context.registry.emplace<Skills>(m_owner, skillsOf({skill}));
+    m_context.registry.emplace<Skills>(other, skillsOf({skill}));
+    ASSERT_EQ(m_skills.hooksFor(TriggerMoment::DURING, TurnPhase::PLAY).size(), 2U);
+
+    m_context.registry.destroy(m_owner);
+
+    auto hooks = m_skills.hooksFor(TriggerMoment::DURING, TurnPhase::PLAY);
+    ASSERT_EQ(hooks.size(), 1U);
+    EXPECT_EQ(hooks.front().owner, other);
+}
+
+TEST_F(SkillSystemTest, TriggerMomentInvokesOnlyMatchingHooks)
+{
+    m_skills.registerSkill("A", CountingSkill{.uses = &m_uses});
+    m_context.registry.emplace<Skills>(m_owner, skillsOf({createSkill("A", TurnPhase::PLAY)}));
+
+    m_context.dispatcher.trigger(events::TriggerMoment{.phase = TurnPhase::DRAW, .moment = TriggerMoment::DURING});
+    EXPECT_EQ(m_uses, 0);
+
+    m_context.dispatcher.trigger(events::TriggerMoment{.phase = TurnPhase::PLAY, .moment = TriggerMoment::DURING});
+    EXPECT_EQ(m_uses, 1);
+}
+
+TEST_F(SkillSystemTest, FilterTargetsResetsAndFillsMaskByCandidateIndex)
+{
+    m_skills.registerSkill("A", CountingSkill{.uses = &m_uses});
+    m_context.registry.emplace<Skills>(m_owner, skillsOf({createSkill("A", TurnPhase::PLAY)}));
+    const auto& hook = m_skills.hooksFor(TriggerMoment::DURING, TurnPhase::PLAY).front();
+    const entt::entity candidates[] = {m_context.registry.create(), m_owner, m_context.registry.create()};
+
+    TargetMask mask;
+    mask.set(); // 输出位集由 filterTargets 清空，候选之外的位不应残留
+    m_skills.filterTargets(hook, candidates, mask);
+
+    EXPECT_TRUE(mask.test(0));
+    EXPECT_FALSE(mask.test(1));
+    EXPECT_TRUE(mask.test(2));
+    EXPECT_EQ(mask.count(), 2U);
+}
+
+TEST_F(SkillSystemTest, TriggerMomentPassesHookOwner)
+{
+    entt::entity owner = entt::null;
+    m_skills.registerSkill("A", CountingSkill{.uses = &m_uses, .lastOwner = &owner});
+    m_context.registry.emplace<Skills>(m_owner, skillsOf({createSkill("A", TurnPhase::PLAY)}));
+
+    m_context.dispatcher.trigger(events::TriggerMoment{.phase = TurnPhase::PLAY, .moment = TriggerMoment::DURING});
+
+    EXPECT_EQ(owner, m_owner);
+}
+
+TEST_F(SkillSystemTest, FilterTargetsIgnoresCandidatesBeyondMask)
+{
+    m_skills.registerSkill("A", CountingSkill{.uses = &m_uses});
+    m_context.registry.emplace<Skills>(m_owner, skillsOf({createSkill("A", TurnPhase::PLAY)}));
+    const auto& hook = m_skills.hooksFor(TriggerMoment::DURING, TurnPhase::PLAY).front();
+    std::vector<entt::entity> candidates(MAX_SKILL_TARGETS + 2);
+    for (auto& candidate : candidates)
+    {
+        candidate = m_context.registry.create();
+    }
+
+    TargetMask mask;
+    m_skills.filterTargets(hook, candidates, mask);
+
+    EXPECT_EQ(mask.count(), MAX_SKILL_TARGETS);
+}
+} // namespace
@@ -0,0 +1,318 @@
+/**
+ * ************************************************************************
+ *
+ * @file test_BatchManager.cpp
+ * @author AnakinLiu (azrael2759@qq.com)
+ * @date 2026-10-16
+ * @version 0.1
+ * @brief BatchManager 批次合并单元测试
+ *
+ * 每个矩形打包成一条实例，形状参数（尺寸、圆角、阴影、透明度）随实例传入，只有纹理或裁剪区域变化才会切分批次；
+ * optimize 只在同一 Z 层内、越过互不重叠的批次进行合并（只串接实例区间）；
+ * 录制的几何回放后与直接绘制一致。
+ * 纹理指针只用于比较，测试中使用伪造的地址，不需要 GPU 设备
+ *
+ * ************************************************************************
+ * @copyright Copyright (c) 2026 AnakinLiu
+ * For study and research only, no reprinting.
+ * ************************************************************************
+ */
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <vector>
+#include "src/ui/managers/BatchManager.hpp"
+
+namespace
+{
+constexpr int WIDGET_COUNT = 500;
+constexpr float WIDGET_WIDTH = 120.0F;
+constexpr float WIDGET_HEIGHT = 32.0F;
+constexpr int COLUMNS = 10;
+
+SDL_GPUTexture* FakeTexture(std::uintptr_t id)
+{
+    return reinterpret_cast<SDL_GPUTexture*>(id * 0x100);
+}
+
+/**
+ * @brief 与 ShapeRenderer 相同的绘制顺序：背景（圆角/阴影/透明度各不相同），偶数控件再画 4 条边框
+ */
+void DrawWidget(ui::managers::BatchManager& batches,
+                SDL_GPUTexture* white,
+                const std::optional<SDL_Rect>& scissor,
+                int index)
+{
+    const Eigen::Vector2f pos{static_cast<float>(index % COLUMNS) * WIDGET_WIDTH,
+                              static_cast<float>(index / COLUMNS) * WIDGET_HEIGHT};
+    const Eigen::Vector2f size{WIDGET_WIDTH - static_cast<float>(index % 7), WIDGET_HEIGHT};
+
+    ui::render::ShapeParams background{};
+    for (float& radius : background.radius)
+    {
+        radius = static_cast<float>(index % 9);
+    }
+    if (index % 3 == 0)
+    {
+        background.shadowSoft = 4.0F;
+        background.shadowOffset[0] = 2.0F;
+        background.shadowOffset[1] = 2.0F;
+    }
+    background.opacity = 0.5F + static_cast<float>(index % 5) * 0.1F;
+
+    batches.beginBatch(white, scissor);
+    batches.addRect(pos, size, {0.2F, 0.2F, 0.2F, 1.0F}, background);
+
+    if (index % 2 == 0)
+    {
+        ui::render::ShapeParams border{};
+        border.opacity = background.opacity;
+        batches.beginBatch(white, scissor);
+        batches.addRect(pos, {size.x(), 1.0F}, {1.0F, 1.0F, 1.0F, 1.0F}, border);
+        batches.addRect({pos.x() + size.x(), pos.y()}, {1.0F, size.y()}, {1.0F, 1.0F, 1.0F, 1.0F}, border);
+        batches.addRect({pos.x(), pos.y() + size.y()}, {size.x(), 1.0F}, {1.0F, 1.0F, 1.0F, 1.0F}, border);
+        batches.addRect(pos, {1.0F, size.y()}, {1.0F, 1.0F, 1.0F, 1.0F}, border);
+    }
+}
+
+constexpr size_t RectsPerScene()
+{
+    return static_cast<size_t>(WIDGET_COUNT) + static_cast<size_t>(WIDGET_COUNT / 2) * 4;
+}
+} // namespace
+
+class BatchManagerTest : public ::testing::Test
+{
+protected:
+    void SetUp() override { m_batches.setScreenSize(1280.0F, 720.0F); }
+
+    ui::managers::BatchManager m_batches;
+    SDL_GPUTexture* m_white = FakeTexture(1);
+};
+
+// 500 个形状参数各不相同的控件只产生一个批次
+TEST_F(BatchManagerTest, ShapeParamsDoNotSplitBatches)
+{
+    for (int index = 0; index < WIDGET_COUNT; ++index)
+    {
+        DrawWidget(m_batches, m_white, std::nullopt, index);
+    }
+    m_batches.optimize();
+
+    ASSERT_EQ(m_batches.getBatchCount(), 1U);
+    EXPECT_EQ(m_batches.getInstanceCount(), RectsPerScene());
+
+    // 形状参数写在实例里：第 1 个控件（index 1）背景的圆角为 1，透明度为 0.6
+    const auto& secondBackground = m_batches.getInstances()[5]; // 控件 0 的背景 + 4 条边框之后
+    EXPECT_FLOAT_EQ(ui::render::unpackHalf(secondBackground.radius[0]), 1.0F);
+    EXPECT_NEAR(ui::render::unpackHalf(secondBackground.shadow[3]), 0.6F, 1e-3F);
+    EXPECT_FLOAT_EQ(m_batches.getBatches().front().pushConstants.screen_size[0], 1280.0F);
+}
+
+// 裁剪区域变化切分批次：后一半控件位于滚动区域内
+TEST_F(BatchManagerTest, ScissorChangeSplitsBatch)
+{
+    const SDL_Rect scrollArea{0, 360, 1280, 360};
+    for (int index = 0; index < WIDGET_COUNT; ++index)
+    {
+        const auto scissor = index < WIDGET_COUNT / 2 ? std::nullopt : std::optional<SDL_Rect>(scrollArea);
+        DrawWidget(m_batches, m_white, scissor, index);
+    }
+    m_batches.optimize();
+
+    ASSERT_EQ(m_batches.getBatchCount(), 2U);
+    EXPECT_FALSE(m_batches.getBatches()[0].scissorRect.has_value());
+    EXPECT_TRUE(m_batches.getBatches()[1].scissorRect.has_value());
+    EXPECT_EQ(m_batches.getInstanceCount(), RectsPerScene());
+}
+
+// 纹理交替时，optimize 把互不重叠的同纹理批次合并：每 50 个控件后在最后一个控件上画一个图集中的图标
+TEST_F(BatchManagerTest, OptimizeGroupsNonOverlappingByTexture)
+{
+    SDL_GPUTexture* iconAtlas = FakeTexture(2);
+    constexpr int ICON_EVERY = 50;
+    for (int index = 0; index < WIDGET_COUNT; ++index)
+    {
+        DrawWidget(m_batches, m_white, std::nullopt, index);
+        if ((index + 1) % ICON_EVERY == 0)
+        {
+            const Eigen::Vector2f pos{static_cast<float>(index % COLUMNS) * WIDGET_WIDTH,
+                                      static_cast<float>(index / COLUMNS) * WIDGET_HEIGHT};
+            ui::render::ShapeParams icon{};
+            icon.premultiplied = true;
+            m_batches.beginBatch(iconAtlas, std::nullopt);
+            m_batches.addRect(pos, {24.0F, 24.0F}, {1.0F, 1.0F, 1.0F, 1.0F}, icon);
+        }
+    }
+    m_batches.optimize();
+
+    // 收集时白色纹理与图集交替 10 次；图标只压在各自的控件上，合并后白色在前、图集在后
+    EXPECT_EQ(m_batches.getCollectedBatchCount(), static_cast<size_t>(WIDGET_COUNT / ICON_EVERY) * 2);
+    ASSERT_EQ(m_batches.getBatchCount(), 2U);
+    EXPECT_EQ(m_batches.getBatches()[0].texture, m_white);
+    EXPECT_EQ(m_batches.getBatches()[1].texture, iconAtlas);
+    EXPECT_EQ(m_batches.getBatches()[0].firstInstance, 0U);
+    EXPECT_EQ(m_batches.getBatches()[1].firstInstance, m_batches.getBatches()[0].instanceCount);
+    EXPECT_EQ(m_batches.getInstanceCount(), RectsPerScene() + WIDGET_COUNT / ICON_EVERY);
+
+    // 实例留在提交位置：白色批次由 10 段组成，图集批次的 10 段各是一个图标，上传时按批次顺序复制
+    EXPECT_EQ(m_batches.getRanges(m_batches.getBatches()[0]).size(), static_cast<size_t>(WIDGET_COUNT / ICON_EVERY));
+    const auto iconRanges = m_batches.getRanges(m_batches.getBatches()[1]);
+    ASSERT_EQ(iconRanges.size(), static_cast<size_t>(WIDGET_COUNT / ICON_EVERY));
+    EXPECT_EQ(iconRanges[1].instanceCount, 1U);
+    EXPECT_EQ(m_batches.getInstances()[iconRanges[1].firstInstance].flags,
+              ui::render::QuadInstance::FLAG_PREMULTIPLIED);
+    EXPECT_EQ(m_batches.getRanges().size(), static_cast<size_t>(WIDGET_COUNT / ICON_EVERY) * 2);
+}
+
+// 重叠的元素保持提交顺序：图标上方再画白色遮罩时不能被提前到图标之前
+TEST_F(BatchManagerTest, OptimizeKeepsOrderOfOverlappingBatches)
+{
+    SDL_GPUTexture* iconAtlas = FakeTexture(2);
+    const Eigen::Vector2f pos{10.0F, 10.0F};
+    const Eigen::Vector2f size{24.0F, 24.0F};
+    m_batches.beginBatch(m_white, std::nullopt);
+    m_batches.addRect(pos, size, {0.2F, 0.2F, 0.2F, 1.0F});
+    m_batches.beginBatch(iconAtlas, std::nullopt);
+    m_batches.addRect(pos, size, {1.0F, 1.0F, 1.0F, 1.0F});
+    m_batches.beginBatch(m_white, std::nullopt);
+    m_batches.addRect(pos, size, {0.0F, 0.0F, 0.0F, 0.5F});
+
+    // 不同 Z 层之间也不重排，即使互不重叠
+    m_batches.setLayer(1);
+    m_batches.beginBatch(iconAtlas, std::nullopt);
+    m_batches.addRect({500.0F, 500.0F}, size, {1.0F, 1.0F, 1.0F, 1.0F});
+    m_batches.setLayer(2);
+    m_batches.beginBatch(m_white, std::nullopt);
+    m_batches.addRect({800.0F, 500.0F}, size, {1.0F, 1.0F, 1.0F, 1.0F});
+    m_batches.optimize();
+
+    // 最后一个批次只能与紧邻的前一个批次合并，而它的纹理不同
+    ASSERT_EQ(m_batches.getBatchCount(), 5U);
+    EXPECT_EQ(m_batches.getBatches()[2].texture, m_white);
+    EXPECT_EQ(m_batches.getBatches()[3].layer, 1U);
+    EXPECT_EQ(m_batches.getBatches()[4].layer, 2U);
+}
+
+// 没有 16 位索引的限制：超过 65536 个顶点对应的矩形数仍是一个批次
+TEST_F(BatchManagerTest, LargeBatchIsNotSplit)
+{
+    constexpr size_t RECTS = 65536 / 4 + 1;
+    m_batches.beginBatch(m_white, std::nullopt);
+    for (size_t rect = 0; rect < RECTS; ++rect)
+    {
+        m_batches.addRect({0.0F, 0.0F}, {1.0F, 1.0F}, {1.0F, 1.0F, 1.0F, 1.0F});
+    }
+    m_batches.optimize();
+
+    ASSERT_EQ(m_batches.getBatchCount(), 1U);
+    EXPECT_EQ(m_batches.getBatches()[0].instanceCount, RECTS);
+    ASSERT_EQ(m_batches.getRanges().size(), 1U);
+    EXPECT_EQ(m_batches.getRanges()[0].instanceCount, RECTS);
+}
+
+// 实例打包：矩形为 float，UV 为 unorm16，颜色为 RGBA8（截断到 [0, 1]），圆角、阴影与透明度为半精度
+TEST_F(BatchManagerTest, PacksInstance)
+{
+    ui::render::ShapeParams shape{};
+    shape.radius[0] = 4.0F;
+    shape.radius[1] = 0.5F;
+    shape.radius[2] = 1000.0F;
+    shape.radius[3] = 1.0e6F; // 超出半精度范围，饱和
+    shape.shadowSoft = 6.0F;
+    shape.shadowOffset[0] = -2.0F;
+    shape.shadowOffset[1] = 3.0F;
+    shape.opacity = 0.25F;
+    shape.premultiplied = true;
+    const auto instance = ui::managers::BatchManager::packInstance(
+        {10.5F, 20.0F}, {100.0F, 32.0F}, {1.5F, 0.5F, -0.1F, 1.0F}, shape, {0.25F, 0.0F}, {0.5F, 1.0F});
+
+    EXPECT_FLOAT_EQ(instance.rect[0], 10.5F);
+    EXPECT_FLOAT_EQ(instance.rect[1], 20.0F);
+    EXPECT_FLOAT_EQ(instance.rect[2], 100.0F);
+    EXPECT_FLOAT_EQ(instance.rect[3], 32.0F);
+    EXPECT_EQ(instance.uvRect[0], 16384U);
+    EXPECT_EQ(instance.uvRect[1], 0U);
+    EXPECT_EQ(instance.uvRect[2], 32768U);
+    EXPECT_EQ(instance.uvRect[3], 65535U);
+    EXPECT_EQ(instance.color[0], 255U);
+    EXPECT_EQ(instance.color[1], 128U);
+    EXPECT_EQ(instance.color[2], 0U);
+    EXPECT_EQ(instance.color[3], 255U);
+    EXPECT_EQ(instance.radius[0], 0x4400U);
+    EXPECT_FLOAT_EQ(ui::render::unpackHalf(instance.radius[1]), 0.5F);
+    EXPECT_FLOAT_EQ(ui::render::unpackHalf(instance.radius[2]), 1000.0F);
+    EXPECT_FLOAT_EQ(ui::render::unpackHalf(instance.radius[3]), 65504.0F);
+    EXPECT_FLOAT_EQ(ui::render::unpackHalf(instance.shadow[0]), 6.0F);
+    EXPECT_FLOAT_EQ(ui::render::unpackHalf(instance.shadow[1]), -2.0F);
+    EXPECT_FLOAT_EQ(ui::render::unpackHalf(instance.shadow[2]), 3.0F);
+    EXPECT_FLOAT_EQ(ui::render::unpackHalf(instance.shadow[3]), 0.25F);
+    EXPECT_EQ(instance.flags, ui::render::QuadInstance::FLAG_PREMULTIPLIED);
+
+    // 半精度就近舍入（含非规格化数）
+    EXPECT_EQ(ui::render::packHalf(0.1F), 0x2E66U);
+    EXPECT_EQ(ui::render::packHalf(-1.0F), 0xBC00U);
+    EXPECT_EQ(ui::render::packHalf(1.0e-5F), 0x00A8U);
+    EXPECT_EQ(ui::render::packHalf(1.0e-9F), 0x0000U);
+}
+
+// 录制每个控件的几何后整段回放，批次、实例与区间与逐个 addRect 的结果完全相同
+TEST_F(BatchManagerTest, ReplayMatchesRecordedDraws)
+{
+    SDL_GPUTexture* iconAtlas = FakeTexture(2);
+    const SDL_Rect scrollArea{0, 360, 1280, 360};
+    std::vector<ui::render::RecordedGeometry> recorded(WIDGET_COUNT);
+    for (int index = 0; index < WIDGET_COUNT; ++index)
+    {
+        const auto scissor = index < WIDGET_COUNT / 2 ? std::nullopt : std::optional<SDL_Rect>(scrollArea);
+        m_batches.setLayer(static_cast<uint32_t>(index / 100));
+        m_batches.beginRecording(recorded[index]);
+        DrawWidget(m_batches, m_white, scissor, index);
+        if (index % 50 == 0)
+        {
+            m_batches.beginBatch(iconAtlas, scissor);
+            m_batches.addRect({0.0F, 0.0F}, {24.0F, 24.0F}, {1.0F, 1.0F, 1.0F, 1.0F});
+        }
+        m_batches.endRecording();
+    }
+    m_batches.optimize();
+
+    ui::managers::BatchManager replayed;
+    replayed.setScreenSize(1280.0F, 720.0F);
+    for (int index = 0; index < WIDGET_COUNT; ++index)
+    {
+        replayed.setLayer(static_cast<uint32_t>(index / 100));
+        replayed.replay(recorded[index]);
+    }
+    replayed.optimize();
+
+    ASSERT_EQ(replayed.getCollectedBatchCount(), m_batches.getCollectedBatchCount());
+    ASSERT_EQ(replayed.getBatchCount(), m_batches.getBatchCount());
+    for (size_t batch = 0; batch < m_batches.getBatchCount(); ++batch)
+    {
+        const auto& expected = m_batches.getBatches()[batch];
+        const auto& actual = replayed.getBatches()[batch];
+        EXPECT_EQ(actual.texture, expected.texture);
+        EXPECT_EQ(actual.scissorRect.has_value(), expected.scissorRect.has_value());
+        EXPECT_EQ(actual.layer, expected.layer);
+        EXPECT_EQ(actual.instanceCount, expected.instanceCount);
+        EXPECT_EQ(actual.firstInstance, expected.firstInstance);
+        EXPECT_EQ(actual.rangeCount, expected.rangeCount);
+    }
+
+    const auto expectedInstances = m_batches.getInstances();
+    const auto actualInstances = replayed.getInstances();
+    ASSERT_EQ(actualInstances.size(), expectedInstances.size());
+    EXPECT_EQ(std::memcmp(actualInstances.data(), expectedInstances.data(), expectedInstances.size_bytes()), 0);
+
+    const auto expectedRanges = m_batches.getRanges();
+    const auto actualRanges = replayed.getRanges();
+    ASSERT_EQ(actualRanges.size(), expectedRanges.size());
+    for (size_t range = 0; range < expectedRanges.size(); ++range)
+    {
+        EXPECT_EQ(actualRanges[range].firstInstance, expectedRanges[range].firstInstance);
+        EXPECT_EQ(actualRanges[range].instanceCount, expectedRanges[range].instanceCount);
+    }
+}
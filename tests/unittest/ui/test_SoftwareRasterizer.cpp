@@ -0,0 +1,167 @@
+/**
+ * ************************************************************************
+ *
+ * @file test_SoftwareRasterizer.cpp
+ * @author AnakinLiu (azrael2759@qq.com)
+ * @date 2026-10-16
+ * @version 0.1
+ * @brief SoftwareRasterizer 像素测试
+ *
+ * 批次经 BatchManager 组装与 optimize 后交给 CPU 光栅化，逐像素检查结果：
+ * 填充与绘制顺序、圆角、阴影、预乘 / 直通 Alpha 纹理、裁剪区域，以及多线程与单线程结果一致。
+ * 期望值按 frag.hlsl 手算，清屏颜色 0.15 对应 38
+ *
+ * ************************************************************************
+ * @copyright Copyright (c) 2026 AnakinLiu
+ * For study and research only, no reprinting.
+ * ************************************************************************
+ */
+#include <gtest/gtest.h>
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <vector>
+#include "src/ui/managers/SoftwareRasterizer.hpp"
+
+namespace
+{
+using Pixel = std::array<uint8_t, 4>;
+constexpr Pixel CLEAR = {38, 38, 38, 255};
+constexpr uint32_t TARGET_SIZE = 160; // 跨多个图块
+
+SDL_GPUTexture* FakeTexture(std::uintptr_t id)
+{
+    return reinterpret_cast<SDL_GPUTexture*>(id * 0x100);
+}
+
+ui::render::ShapeParams Rounded(float radius, float shadowSoft = 0.0F, float shadowOffset = 0.0F)
+{
+    ui::render::ShapeParams shape{};
+    for (float& corner : shape.radius)
+    {
+        corner = radius;
+    }
+    shape.shadowSoft = shadowSoft;
+    shape.shadowOffset[0] = shadowOffset;
+    shape.shadowOffset[1] = shadowOffset;
+    return shape;
+}
+
+class SoftwareRasterizerTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        m_batches.setScreenSize(static_cast<float>(TARGET_SIZE), static_cast<float>(TARGET_SIZE));
+        m_rasterizer.resize(TARGET_SIZE, TARGET_SIZE);
+    }
+
+    void render()
+    {
+        m_batches.optimize();
+        m_rasterizer.execute(m_batches);
+    }
+
+    ui::managers::BatchManager m_batches;
+    ui::managers::SoftwareRasterizer m_rasterizer;
+};
+
+TEST_F(SoftwareRasterizerTest, FillsRectsInDrawOrder)
+{
+    m_batches.beginBatch(nullptr, std::nullopt);
+    m_batches.addRect({10.0F, 10.0F}, {20.0F, 20.0F}, {1.0F, 0.0F, 0.0F, 1.0F});
+    m_batches.addRect({20.0F, 20.0F}, {20.0F, 20.0F}, {0.0F, 0.0F, 1.0F, 1.0F});
+    render();
+
+    EXPECT_EQ(m_rasterizer.pixel(12, 12), (Pixel{255, 0, 0, 255}));
+    EXPECT_EQ(m_rasterizer.pixel(25, 25), (Pixel{0, 0, 255, 255}));
+    EXPECT_EQ(m_rasterizer.pixel(5, 5), CLEAR);
+    // 像素中心在右边界上不着色
+    EXPECT_EQ(m_rasterizer.pixel(40, 30), CLEAR);
+}
+
+TEST_F(SoftwareRasterizerTest, RoundedCornersAreCut)
+{
+    m_batches.beginBatch(nullptr, std::nullopt);
+    m_batches.addRect({10.0F, 10.0F}, {40.0F, 40.0F}, {1.0F, 1.0F, 1.0F, 1.0F}, Rounded(10.0F));
+    render();
+
+    EXPECT_EQ(m_rasterizer.pixel(10, 10), CLEAR);
+    EXPECT_EQ(m_rasterizer.pixel(49, 49), CLEAR);
+    EXPECT_EQ(m_rasterizer.pixel(11, 30), (Pixel{255, 255, 255, 255}));
+    EXPECT_EQ(m_rasterizer.pixel(30, 30), (Pixel{255, 255, 255, 255}));
+}
+
+TEST_F(SoftwareRasterizerTest, ShadowDarkensOutsideTheBody)
+{
+    m_batches.beginBatch(nullptr, std::nullopt);
+    m_batches.addRect({20.0F, 20.0F}, {20.0F, 20.0F}, {1.0F, 1.0F, 1.0F, 1.0F}, Rounded(10.0F, 4.0F, 4.0F));
+    render();
+
+    // 右下角在主体外、阴影内：alpha ≈ 0.437，只压暗背景
+    const Pixel shadowed = m_rasterizer.pixel(39, 39);
+    EXPECT_NEAR(shadowed[0], 21, 1);
+    EXPECT_EQ(shadowed[0], shadowed[1]);
+    EXPECT_EQ(shadowed[3], 255);
+    // 左上角远离阴影
+    EXPECT_EQ(m_rasterizer.pixel(20, 20), CLEAR);
+}
+
+TEST_F(SoftwareRasterizerTest, SamplesPremultipliedAndStraightTextures)
+{
+    // 预乘的半透明红色：(128, 0, 0, 128)
+    std::vector<uint8_t> red(2 * 2 * 4, 0);
+    for (size_t offset = 0; offset < red.size(); offset += 4)
+    {
+        red[offset] = 128;
+        red[offset + 3] = 128;
+    }
+    SDL_GPUTexture* texture = FakeTexture(1);
+    m_rasterizer.setTexture(texture, 2, 2, red);
+
+    ui::render::ShapeParams premultiplied{};
+    premultiplied.premultiplied = true;
+    m_batches.beginBatch(texture, std::nullopt);
+    m_batches.addRect({0.0F, 0.0F}, {10.0F, 10.0F}, {1.0F, 1.0F, 1.0F, 1.0F}, premultiplied);
+    m_batches.addRect({20.0F, 0.0F}, {10.0F, 10.0F}, {1.0F, 1.0F, 1.0F, 1.0F});
+    render();
+
+    // 预乘：0.502 + 0.15 * 0.498；直通：0.502 * 0.502 + 0.15 * 0.498
+    EXPECT_EQ(m_rasterizer.pixel(5, 5), (Pixel{147, 19, 19, 255}));
+    EXPECT_EQ(m_rasterizer.pixel(25, 5), (Pixel{83, 19, 19, 255}));
+}
+
+TEST_F(SoftwareRasterizerTest, ClipsToScissor)
+{
+    m_batches.beginBatch(nullptr, SDL_Rect{0, 0, 15, 100});
+    m_batches.addRect({10.0F, 10.0F}, {20.0F, 20.0F}, {0.0F, 1.0F, 0.0F, 1.0F});
+    render();
+
+    EXPECT_EQ(m_rasterizer.pixel(14, 20), (Pixel{0, 255, 0, 255}));
+    EXPECT_EQ(m_rasterizer.pixel(15, 20), CLEAR);
+}
+
+TEST_F(SoftwareRasterizerTest, ThreadedOutputMatchesSerial)
+{
+    // 半透明、圆角、带阴影的矩形互相重叠并跨越图块边界
+    m_batches.beginBatch(nullptr, std::nullopt);
+    for (int index = 0; index < 200; ++index)
+    {
+        ui::render::ShapeParams shape = Rounded(static_cast<float>(index % 9), (index % 3 == 0) ? 3.0F : 0.0F, 2.0F);
+        shape.radius[1] = static_cast<float>(index % 5);
+        shape.opacity = 0.5F + (static_cast<float>(index % 4) * 0.125F);
+        const float offset = static_cast<float>((index * 37) % 140);
+        m_batches.addRect({offset, static_cast<float>((index * 53) % 140)},
+                          {17.5F + static_cast<float>(index % 11), 13.25F},
+                          {0.1F * static_cast<float>(index % 10), 0.5F, 0.8F, 0.6F},
+                          shape);
+    }
+    render();
+    const std::vector<uint8_t> threaded(m_rasterizer.pixels().begin(), m_rasterizer.pixels().end());
+
+    ui::managers::SoftwareRasterizer serial(nullptr);
+    serial.resize(TARGET_SIZE, TARGET_SIZE);
+    serial.execute(m_batches);
+    EXPECT_EQ(threaded, std::vector<uint8_t>(serial.pixels().begin(), serial.pixels().end()));
+}
+} // namespace
@@ -0,0 +1,142 @@
+/**
+ * ************************************************************************
+ *
+ * @file test_TaskScheduler.cpp
+ * @author AnakinLiu (azrael2759@qq.com)
+ * @date 2026-10-16
+ * @version 0.1
+ * @brief 工作窃取调度器单元测试
+ *
+ * 工作线程队列中的任务被空闲线程窃取、TaskGroup 在外部线程上等待时只执行本组的任务，
+ * 以及 stop() 先执行完已投递的任务再退出
+ *
+ * ************************************************************************
+ * @copyright Copyright (c) 2026 AnakinLiu
+ * For study and research only, no reprinting.
+ * ************************************************************************
+ */
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+#include "src/utils/TaskScheduler.h"
+
+namespace
+{
+constexpr auto WAIT_LIMIT = std::chrono::seconds(10); // 等待其他线程的上限，超时即判失败而不是挂住
+
+/**
+ * @brief 自旋等待条件成立，超过 WAIT_LIMIT 返回 false
+ */
+template <typename Predicate>
+bool waitFor(Predicate&& predicate)
+{
+    const auto deadline = std::chrono::steady_clock::now() + WAIT_LIMIT;
+    while (!predicate())
+    {
+        if (std::chrono::steady_clock::now() > deadline)
+        {
+            return false;
+        }
+        std::this_thread::yield();
+    }
+    return true;
+}
+
+TEST(TaskSchedulerTest, IdleWorkersStealFromBusyWorker)
+{
+    constexpr int SUBTASKS = 64;
+    utils::TaskScheduler scheduler(4);
+    std::atomic<int> completed{0};
+    std::atomic<int> ranOnParent{0};
+    std::atomic<bool> parentDone{false};
+    std::atomic<bool> allStolen{false};
+
+    scheduler.spawn(
+        [&]
+        {
+            const auto parent = std::this_thread::get_id();
+            // 在工作线程上投递，子任务进入本线程队列；本线程一直占用，子任务只能被其他线程窃取
+            for (int index = 0; index < SUBTASKS; ++index)
+            {
+                scheduler.spawn(
+                    [&, parent]
+                    {
+                        ranOnParent.fetch_add(static_cast<int>(std::this_thread::get_id() == parent));
+                        completed.fetch_add(1);
+                    });
+            }
+            allStolen = waitFor([&] { return completed.load() == SUBTASKS; });
+            parentDone = true;
+        });
+
+    ASSERT_TRUE(waitFor([&] { return parentDone.load(); }));
+    EXPECT_TRUE(allStolen.load());
+    EXPECT_EQ(ranOnParent.load(), 0);
+}
+
+TEST(TaskSchedulerTest, ExternalWaitRunsOnlyGroupTasks)
+{
+    utils::TaskScheduler scheduler(1);
+    const auto waiter = std::this_thread::get_id();
+    std::atomic<bool> release{false};
+    std::atomic<bool> unrelatedOnWaiter{false};
+    std::atomic<bool> unrelatedRan{false};
+    std::thread::id groupThread;
+
+    // 占住唯一的工作线程，之后投递的任务都留在队列里
+    scheduler.spawn([&] { waitFor([&] { return release.load(); }); });
+    scheduler.spawn(
+        [&]
+        {
+            unrelatedOnWaiter = std::this_thread::get_id() == waiter;
+            unrelatedRan = true;
+        });
+
+    utils::TaskGroup group(scheduler);
+    group.run(
+        [&]
+        {
+            groupThread = std::this_thread::get_id();
+            release = true;
+        });
+    group.wait();
+
+    // 本组任务由等待方直接执行；无关任务留给工作线程
+    EXPECT_EQ(groupThread, waiter);
+    ASSERT_TRUE(waitFor([&] { return unrelatedRan.load(); }));
+    EXPECT_FALSE(unrelatedOnWaiter.load());
+}
+
+TEST(TaskSchedulerTest, WaitRethrowsTaskException)
+{
+    utils::TaskScheduler scheduler(2);
+    utils::TaskGroup group(scheduler);
+    std::atomic<int> completed{0};
+
+    group.runBatch(8, [&](std::size_t) { completed.fetch_add(1); });
+    group.run([] { throw std::runtime_error("task failed"); });
+
+    EXPECT_THROW(group.wait(), std::runtime_error);
+    EXPECT_EQ(completed.load(), 8);
+    EXPECT_TRUE(group.finished());
+}
+
+TEST(TaskSchedulerTest, StopRunsQueuedTasksBeforeExit)
+{
+    constexpr int TASKS = 256;
+    utils::TaskScheduler scheduler(2);
+    std::atomic<int> completed{0};
+
+    for (int index = 0; index < TASKS; ++index)
+    {
+        scheduler.spawn([&completed] { completed.fetch_add(1); });
+    }
+    scheduler.stop();
+
+    EXPECT_EQ(completed.load(), TASKS);
+    EXPECT_FALSE(scheduler.isWorkerThread());
+    scheduler.stop(); // 重复调用不再等待
+}
+} // namespace